@@ -0,0 +1,270 @@
+/* The Clear BSD License
+ *
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _EI_CLASSIFIER_ANOMALY_FIXED_H_
+#define _EI_CLASSIFIER_ANOMALY_FIXED_H_
+
+#include <string.h>
+#include "edge-impulse-sdk/classifier/ei_model_types.h"
+#include "edge-impulse-sdk/classifier/ei_classifier_types.h"
+#include "edge-impulse-sdk/porting/ei_classifier_porting.h"
+
+/**
+ * Fixed-point anomaly score over the int8 feature map of a compiled (EON) graph.
+ *
+ * The float K-means / GMM blocks (inferencing_engines/anomaly.h) need their own feature vector,
+ * and the GMM one a second network pass. Here the embedding is an intermediate activation of the
+ * detector itself: the graph hands the output of one node to a tap during invoke, it is copied
+ * out (later nodes reuse that memory), and after run_classifier every detection is scored on the
+ * cell under its centre. Nothing is dequantized, the score is
+ *
+ *     min over clusters k of  sum_d w[d][k] * (x_d - c[d][k])^2 / 256  +  bias[k]
+ *
+ * with x and c in the int8 quantization of the tapped tensor. w = 256 everywhere (weights NULL)
+ * is K-means on squared distance, per-dimension weights make it a diagonal GMM (w ~ 1 / variance,
+ * bias ~ log determinant). Centres and weights are stored dimension-major ([d][k]), so the inner
+ * loop runs over clusters with contiguous loads and no dependency between lanes, which the
+ * compiler vectorizes where the target has SIMD.
+ */
+
+// Clusters and embedding channels the scorer handles (keeps the accumulators on the stack and
+// the weighted sum within 32 bits: 65025 * 65535 / 256 * 128 < 2^31)
+#ifndef EI_ANOMALY_FIXED_MAX_CLUSTERS
+#define EI_ANOMALY_FIXED_MAX_CLUSTERS 32
+#endif // EI_ANOMALY_FIXED_MAX_CLUSTERS
+#ifndef EI_ANOMALY_FIXED_MAX_DIMS
+#define EI_ANOMALY_FIXED_MAX_DIMS 128
+#endif // EI_ANOMALY_FIXED_MAX_DIMS
+
+/** Clusters fitted on embeddings of one node of the graph */
+typedef struct {
+    int16_t tap_node;           // node whose output is the embedding
+    uint16_t dims;              // channels of that output
+    uint16_t clusters;
+    const int8_t *centres;      // [dims][clusters], in the quantization of the tapped tensor
+    const uint16_t *weights;    // [dims][clusters], 256 = 1.0, NULL for plain K-means
+    const int32_t *bias;        // [clusters], added to the distance, NULL for 0
+    float score_scale;          // score = raw * score_scale
+} ei_anomaly_fixed_model_t;
+
+/** Feature map captured during the last run_classifier */
+typedef struct {
+    const ei_anomaly_fixed_model_t *model;
+    const ei_config_tflite_eon_graph_t *graph;
+    int8_t *map;                // height x width x dims, owned by the caller
+    size_t map_bytes;
+    uint16_t height;
+    uint16_t width;
+    bool valid;                 // set by the tap, cleared by ei_anomaly_fixed_begin
+} ei_anomaly_fixed_state_t;
+
+/**
+ * Raw score of one embedding
+ *
+ * @param model Clusters
+ * @param embedding model->dims int8 values
+ * @return int32_t Smallest weighted distance over the clusters, bias included
+ */
+__attribute__((unused)) static int32_t ei_anomaly_fixed_score_raw(
+    const ei_anomaly_fixed_model_t *model,
+    const int8_t *embedding)
+{
+    const size_t clusters = model->clusters;
+    uint32_t acc[EI_ANOMALY_FIXED_MAX_CLUSTERS] = { 0 };
+
+    const int8_t *c = model->centres;
+    if (model->weights) {
+        const uint16_t *w = model->weights;
+        for (size_t d = 0; d < model->dims; d++, c += clusters, w += clusters) {
+            const int32_t x = embedding[d];
+            for (size_t k = 0; k < clusters; k++) {
+                const int32_t diff = x - c[k];
+                acc[k] += ((uint32_t)(diff * diff) * w[k]) >> 8;
+            }
+        }
+    }
+    else {
+        for (size_t d = 0; d < model->dims; d++, c += clusters) {
+            const int32_t x = embedding[d];
+            for (size_t k = 0; k < clusters; k++) {
+                const int32_t diff = x - c[k];
+                acc[k] += (uint32_t)(diff * diff);
+            }
+        }
+    }
+
+    int64_t best = INT32_MAX;
+    for (size_t k = 0; k < clusters; k++) {
+        int64_t score = (int64_t)acc[k] + (model->bias ? model->bias[k] : 0);
+        if (score < best) {
+            best = score;
+        }
+    }
+    return best < INT32_MIN ? INT32_MIN : (int32_t)best;
+}
+
+static void ei_anomaly_fixed_tap(const ei_tensor_tap_t *tap, void *ctx)
+{
+    ei_anomaly_fixed_state_t *state = (ei_anomaly_fixed_state_t *)ctx;
+    if (tap->type != kTfLiteInt8 || tap->channels != state->model->dims || tap->bytes > state->map_bytes) {
+        return;
+    }
+    memcpy(state->map, tap->data, tap->bytes);
+    state->height = tap->height;
+    state->width = tap->width;
+    state->valid = true;
+}
+
+/**
+ * Start capturing the embeddings of a learning block on every inference
+ *
+ * @param impulse The impulse (e.g. ei_default_impulse.impulse)
+ * @param learn_block_index Index of the EON learning block
+ * @param model Clusters, must outlive the state
+ * @param state Output
+ * @param map Buffer for the feature map (height x width x dims of the tapped node)
+ * @param map_bytes Size of map
+ * @return EI_IMPULSE_OK if successful
+ */
+__attribute__((unused)) static EI_IMPULSE_ERROR ei_anomaly_fixed_attach(
+    const ei_impulse_t *impulse,
+    uint32_t learn_block_index,
+    const ei_anomaly_fixed_model_t *model,
+    ei_anomaly_fixed_state_t *state,
+    int8_t *map,
+    size_t map_bytes)
+{
+    memset(state, 0, sizeof(ei_anomaly_fixed_state_t));
+
+    if (model->clusters == 0 || model->clusters > EI_ANOMALY_FIXED_MAX_CLUSTERS ||
+        model->dims == 0 || model->dims > EI_ANOMALY_FIXED_MAX_DIMS) {
+        ei_printf("ERR: anomaly model has %u clusters of %u dims, at most %d x %d supported\n",
+            model->clusters, model->dims, EI_ANOMALY_FIXED_MAX_CLUSTERS, EI_ANOMALY_FIXED_MAX_DIMS);
+        return EI_IMPULSE_INFERENCE_ERROR;
+    }
+    if (learn_block_index >= impulse->learning_blocks_size) {
+        return EI_IMPULSE_INFERENCE_ERROR;
+    }
+    const ei_learning_block_config_tflite_graph_t *block_config =
+        (const ei_learning_block_config_tflite_graph_t *)impulse->learning_blocks[learn_block_index].config;
+    if (!block_config || !block_config->compiled ||
+        !((const ei_config_tflite_eon_graph_t *)block_config->graph_config)->model_set_tap) {
+        ei_printf("ERR: anomaly scoring requires a compiled (EON) graph that exports its activations\n");
+        return EI_IMPULSE_UNSUPPORTED_INFERENCING_ENGINE;
+    }
+
+    state->model = model;
+    state->graph = (const ei_config_tflite_eon_graph_t *)block_config->graph_config;
+    state->map = map;
+    state->map_bytes = map_bytes;
+    if (state->graph->model_set_tap(model->tap_node, &ei_anomaly_fixed_tap, state) != kTfLiteOk) {
+        ei_printf("ERR: node %d can't be tapped for anomaly scoring\n", model->tap_node);
+        state->graph = NULL;
+        return EI_IMPULSE_INFERENCE_ERROR;
+    }
+    return EI_IMPULSE_OK;
+}
+
+/**
+ * Stop capturing embeddings
+ */
+__attribute__((unused)) static void ei_anomaly_fixed_detach(ei_anomaly_fixed_state_t *state)
+{
+    if (state->graph) {
+        state->graph->model_set_tap(-1, NULL, NULL);
+        state->graph = NULL;
+    }
+    state->valid = false;
+}
+
+/**
+ * Forget the feature map of the previous frame, call before run_classifier
+ */
+__attribute__((unused)) static void ei_anomaly_fixed_begin(ei_anomaly_fixed_state_t *state)
+{
+    state->valid = false;
+}
+
+/**
+ * Embedding of the cell under a point of the model input
+ *
+ * @param state Feature map of the last run_classifier
+ * @param x Point in model input pixels
+ * @param y Point in model input pixels
+ * @param input_width Model input width (e.g. EI_CLASSIFIER_INPUT_WIDTH)
+ * @param input_height Model input height
+ * @return const int8_t* model->dims values, or NULL if no feature map was captured
+ */
+__attribute__((unused)) static const int8_t *ei_anomaly_fixed_embedding(
+    const ei_anomaly_fixed_state_t *state,
+    uint32_t x,
+    uint32_t y,
+    uint32_t input_width,
+    uint32_t input_height)
+{
+    if (!state->valid || x >= input_width || y >= input_height) {
+        return NULL;
+    }
+    const uint32_t cx = x * state->width / input_width;
+    const uint32_t cy = y * state->height / input_height;
+    return state->map + ((size_t)cy * state->width + cx) * state->model->dims;
+}
+
+/**
+ * Score a detection on the cell under its centre
+ *
+ * @param state Feature map of the last run_classifier
+ * @param bb Detection, in model input pixels
+ * @param input_width Model input width (e.g. EI_CLASSIFIER_INPUT_WIDTH)
+ * @param input_height Model input height
+ * @param score Output, above 0 outside every cluster when the bias is -radius^2
+ * @return EI_IMPULSE_OK if successful
+ */
+__attribute__((unused)) static EI_IMPULSE_ERROR ei_anomaly_fixed_score_box(
+    const ei_anomaly_fixed_state_t *state,
+    const ei_impulse_result_bounding_box_t *bb,
+    uint32_t input_width,
+    uint32_t input_height,
+    float *score)
+{
+    const int8_t *embedding = ei_anomaly_fixed_embedding(state, bb->x + bb->width / 2, bb->y + bb->height / 2,
+                                                          input_width, input_height);
+    if (!embedding) {
+        return EI_IMPULSE_INFERENCE_ERROR;
+    }
+    *score = (float)ei_anomaly_fixed_score_raw(state->model, embedding) * state->model->score_scale;
+    return EI_IMPULSE_OK;
+}
+
+#endif // _EI_CLASSIFIER_ANOMALY_FIXED_H_
@@ -0,0 +1,129 @@
+/* The Clear BSD License
+ *
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _EI_CLASSIFIER_ARENA_TYPES_H_
+#define _EI_CLASSIFIER_ARENA_TYPES_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * Memory layout information exported by compiled (EON) graphs. Kept separate
+ * from ei_model_types.h so the generated model sources can include it.
+ */
+
+/** Usage of a single tensor in a compiled (EON) graph */
+typedef struct {
+    size_t offset;          // offset into the tensor arena, only valid if in_arena is set
+    size_t bytes;
+    int16_t first_node;     // first node that reads or writes the tensor, -1 if unused
+    int16_t last_node;      // last node that reads or writes the tensor, -1 if unused
+    uint16_t accesses;      // number of node inputs/outputs referring to the tensor
+    bool in_arena;          // false for constant (flash) tensors
+} ei_tensor_lifetime_t;
+
+/** Constant tensor of a compiled (EON) graph and the memory its data is read from */
+typedef struct {
+    int16_t index;          // tensor index in the graph
+    uint8_t type;           // TfLiteType
+    uint32_t bytes;
+    const void *data;       // NULL in EI_CLASSIFIER_WEIGHTS_BLOB builds until the weights are set
+} ei_weights_tensor_t;
+
+/** Output of a node handed out during invoke, valid only for the duration of the callback */
+typedef struct {
+    int16_t node;
+    int16_t tensor;         // tensor index in the graph
+    uint8_t type;           // TfLiteType
+    uint16_t height;        // NHWC shape, batch of 1
+    uint16_t width;
+    uint16_t channels;
+    float scale;            // per-tensor quantization
+    int32_t zero_point;
+    const void *data;
+    size_t bytes;
+} ei_tensor_tap_t;
+
+typedef void (*ei_tensor_tap_fn)(const ei_tensor_tap_t *tap, void *ctx);
+
+/** Slice of the tensor arena layout that lives at its own address */
+typedef struct {
+    size_t offset;
+    size_t bytes;
+    uint8_t *ptr;
+} ei_arena_region_t;
+
+/** Scratch buffer requested by a node during prepare, and where the memory plan puts it */
+typedef struct {
+    int16_t node;           // node that requested the buffer
+    uint32_t bytes;
+    uint32_t offset;        // offset into the tensor arena (planned buffers only)
+} ei_scratch_buffer_plan_t;
+
+/**
+ * Joint layout of activations and scratch buffers for a compiled (EON) graph.
+ * Scratch buffers are listed in the order in which they are requested.
+ */
+typedef struct {
+    const uint32_t *tensor_offsets;             // arena offset per tensor, ignored for constant tensors
+    size_t tensors_count;
+    const ei_scratch_buffer_plan_t *scratch;
+    size_t scratch_count;
+    size_t planned_bytes;                       // high water mark of activations + scratch buffers
+    size_t persistent_bytes;                    // persistent buffers, allocated from the top of the arena
+    uint32_t patch_tile_rows;                   // rows per tile of the patch stage, 0 if the graph runs untiled
+} ei_memory_plan_t;
+
+#ifndef EI_MAX_PATCH_NODES
+#define EI_MAX_PATCH_NODES 8
+#endif // EI_MAX_PATCH_NODES
+
+/**
+ * Chain of early nodes in a compiled (EON) graph that can run tile by tile: the stage
+ * output is computed in bands of rows (full width), each band pulls the rows it needs
+ * (plus halo) through the whole chain, so intermediate tensors only ever hold one tile.
+ */
+typedef struct {
+    int16_t first_node;                         // -1 if the graph has no stage that can be tiled
+    int16_t last_node;
+    int16_t input_tensor;
+    int16_t tensors[EI_MAX_PATCH_NODES];        // output of every node in the stage, the last one is the stage output
+    uint32_t tile_bytes[EI_MAX_PATCH_NODES];    // bytes the intermediate outputs need for the largest tile
+    uint16_t out_height;                        // rows of the stage output
+    uint16_t tile_rows;                         // stage output rows per tile, 0 if the stage runs untiled
+    size_t untiled_bytes;                       // input + intermediates + output when running untiled
+    size_t tiled_bytes;                         // input + one tile of every intermediate + output
+} ei_patch_stage_t;
+
+#endif // _EI_CLASSIFIER_ARENA_TYPES_H_
@@ -0,0 +1,610 @@
+/* The Clear BSD License
+ *
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _EI_CLASSIFIER_CAPTURE_H_
+#define _EI_CLASSIFIER_CAPTURE_H_
+
+#include <stddef.h>
+#include <string.h>
+#include "edge-impulse-sdk/classifier/ei_model_types.h"
+#include "edge-impulse-sdk/classifier/ei_classifier_types.h"
+#include "edge-impulse-sdk/classifier/ei_run_classifier.h"
+#include "edge-impulse-sdk/dsp/ei_signal_view.h"
+#include "edge-impulse-sdk/porting/ei_classifier_porting.h"
+
+/**
+ * Capture format for field data: the frames a device saw, each with the result the device got
+ * for it, so the same frames can be replayed through the impulse on the host (benchmarks,
+ * regression runs) and the results compared.
+ *
+ * The format is append only and written front to back, a writer never seeks and never holds
+ * more than the record it is writing. Layout, all fields little endian:
+ *
+ *   ei_capture_header_t
+ *   record, record, ...                      until the end of the file
+ *
+ *   record:
+ *     ei_capture_record_t
+ *     ei_capture_box_t[boxes_count]           bounding boxes with a label, in result order
+ *     float[classification_count]             result.classification[].value
+ *     uint8_t[raw_output_bytes]               output tensor of the graph, as the writer's kernels left it
+ *     padding to the alignment
+ *     frame, frame_bytes                      raw pixels, row major, header.pixel_format
+ *     padding to the alignment
+ *
+ * Records and frames start at a multiple of EI_CAPTURE_ALIGNMENT from the start of the file,
+ * so a file mapped at a page boundary can be read in place: the reader hands out pointers into
+ * the mapping and a frame goes straight into a signal_view (see ei_capture_run_classifier).
+ * A record whose checksum does not match is skipped, a record cut short (the writer lost its
+ * connection mid-record) ends the capture.
+ */
+
+#define EI_CAPTURE_MAGIC                    0x50414345  // "ECAP"
+#define EI_CAPTURE_RECORD_MAGIC             0x44524345  // "ECRD"
+#define EI_CAPTURE_VERSION                  1
+#define EI_CAPTURE_ALIGNMENT                8
+
+// ei_capture_header_t::pixel_format, the value is the number of bytes per pixel
+#define EI_CAPTURE_PIXEL_GRAY8              1
+#define EI_CAPTURE_PIXEL_RGB888             3
+
+// ei_capture_record_t::flags
+#define EI_CAPTURE_FLAG_RESULT              0x01    // the classifier ran, the result fields are set
+#define EI_CAPTURE_FLAG_RAW_OUTPUT          0x02    // the record carries the raw output tensor
+#define EI_CAPTURE_FLAG_STATE_RESET         0x04    // post-processing history (FOMO fusion) was reset before the run
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t header_bytes;      // sizeof(ei_capture_header_t)
+    uint32_t project_id;        // of the impulse that produced the results
+    uint32_t impulse_id;
+    uint32_t deploy_version;
+    uint16_t input_width;       // model input, frames may be larger
+    uint16_t input_height;
+    uint8_t pixel_format;       // EI_CAPTURE_PIXEL_*
+    uint8_t reserved0;
+    uint16_t label_count;
+    uint32_t reserved;
+} ei_capture_header_t;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t record_bytes;      // whole record with padding, a multiple of the alignment
+    uint32_t frame_id;
+    uint32_t timestamp_ms;
+    uint16_t frame_width;
+    uint16_t frame_height;
+    uint32_t frame_bytes;
+    uint32_t dsp_us;
+    uint32_t classification_us;
+    uint32_t postprocessing_us;
+    uint32_t frame_us;          // capture to result, as the writer measured it
+    float anomaly;
+    int8_t error;               // EI_IMPULSE_ERROR of the run
+    uint8_t status;             // application defined
+    uint8_t flags;              // EI_CAPTURE_FLAG_*
+    uint8_t reserved0;
+    uint16_t dropped;           // records the writer lost right before this one
+    uint16_t boxes_count;
+    uint16_t classification_count;
+    uint16_t raw_output_bytes;  // 0 without EI_CAPTURE_FLAG_RAW_OUTPUT
+    uint32_t checksum;          // FNV-1a of the fields above, the boxes, classification, raw output and frame
+} ei_capture_record_t;
+
+typedef struct {
+    float value;
+    uint16_t x;                 // in model input pixels
+    uint16_t y;
+    uint16_t width;
+    uint16_t height;
+    uint8_t label_ix;           // index into the impulse categories
+    uint8_t reserved[3];
+} ei_capture_box_t;
+
+/**
+ * A frame as the application captured it, plus what the application measured around the run
+ */
+typedef struct {
+    const uint8_t *data;
+    uint32_t bytes;
+    uint16_t width;
+    uint16_t height;
+    uint32_t frame_id;
+    uint32_t timestamp_ms;
+    uint32_t frame_us;
+    uint8_t status;
+    uint16_t dropped;
+    const void *raw_output;     // output tensor of the run (see ei_set_output_tap), or NULL
+    uint16_t raw_output_bytes;
+    bool state_reset;           // the application reset the post-processing history before the run
+} ei_capture_frame_t;
+
+/**
+ * Output of the writer. Returns the number of bytes taken, anything short of len is an error.
+ */
+typedef size_t (*ei_capture_write_fn)(const void *data, size_t len, void *ctx);
+
+typedef struct {
+    const ei_impulse_t *impulse;
+    ei_capture_write_fn write;
+    void *ctx;
+    uint8_t pixel_format;
+} ei_capture_writer_t;
+
+static inline uint32_t ei_capture_fnv1a(uint32_t hash, const void *data, size_t bytes) {
+    const uint8_t *p = (const uint8_t *)data;
+    for (size_t ix = 0; ix < bytes; ix++) {
+        hash = (hash ^ p[ix]) * 16777619u;
+    }
+    return hash;
+}
+
+static inline size_t ei_capture_align(size_t bytes) {
+    return (bytes + EI_CAPTURE_ALIGNMENT - 1) & ~(size_t)(EI_CAPTURE_ALIGNMENT - 1);
+}
+
+static inline size_t ei_capture_boxes_offset(void) {
+    return sizeof(ei_capture_record_t);
+}
+
+static inline size_t ei_capture_frame_offset(
+    uint32_t boxes_count,
+    uint32_t classification_count,
+    uint32_t raw_output_bytes)
+{
+    return ei_capture_align(sizeof(ei_capture_record_t) + boxes_count * sizeof(ei_capture_box_t) +
+                            classification_count * sizeof(float) + raw_output_bytes);
+}
+
+// Boxes of a result that go into a record (the ones with a label)
+static inline uint32_t ei_capture_boxes_count(const ei_impulse_result_t *result) {
+    uint32_t count = 0;
+    if (result != NULL && result->bounding_boxes != NULL) {
+        for (uint32_t ix = 0; ix < result->bounding_boxes_count; ix++) {
+            if (result->bounding_boxes[ix].label != NULL) {
+                count++;
+            }
+        }
+    }
+    return count > UINT16_MAX ? UINT16_MAX : count;
+}
+
+// Record form of a result box, false for boxes that are left out
+static inline bool ei_capture_box_from_result(
+    const ei_impulse_t *impulse,
+    const ei_impulse_result_bounding_box_t *bb,
+    ei_capture_box_t *box)
+{
+    if (bb->label == NULL) {
+        return false;
+    }
+    memset(box, 0, sizeof(ei_capture_box_t));
+    box->value = bb->value;
+    box->x = (uint16_t)bb->x;
+    box->y = (uint16_t)bb->y;
+    box->width = (uint16_t)bb->width;
+    box->height = (uint16_t)bb->height;
+    box->label_ix = 0xFF;
+    for (uint16_t ix = 0; ix < impulse->label_count; ix++) {
+        if (strcmp(bb->label, impulse->categories[ix]) == 0) {
+            box->label_ix = (uint8_t)ix;
+            break;
+        }
+    }
+    return true;
+}
+
+/**
+ * Size of the record for a frame of frame_bytes and a result (NULL if the classifier didn't run),
+ * for applications that hand records over through a buffer
+ */
+static inline size_t ei_capture_record_bytes(
+    const ei_impulse_t *impulse,
+    uint32_t frame_bytes,
+    const ei_impulse_result_t *result,
+    uint32_t raw_output_bytes = 0)
+{
+    const uint32_t classification_count = result != NULL ? impulse->label_count : 0;
+    return ei_capture_frame_offset(ei_capture_boxes_count(result), classification_count,
+                                   result != NULL ? raw_output_bytes : 0) +
+           ei_capture_align(frame_bytes);
+}
+
+__attribute__((unused)) static EI_IMPULSE_ERROR ei_capture_writer_init(
+    ei_capture_writer_t *writer,
+    const ei_impulse_t *impulse,
+    uint8_t pixel_format,
+    ei_capture_write_fn write,
+    void *ctx)
+{
+    if (pixel_format != EI_CAPTURE_PIXEL_GRAY8 && pixel_format != EI_CAPTURE_PIXEL_RGB888) {
+        return EI_IMPULSE_INVALID_SIZE;
+    }
+    writer->impulse = impulse;
+    writer->write = write;
+    writer->ctx = ctx;
+    writer->pixel_format = pixel_format;
+    return EI_IMPULSE_OK;
+}
+
+/**
+ * Header of a capture, written once before the first record
+ */
+__attribute__((unused)) static EI_IMPULSE_ERROR ei_capture_write_header(const ei_capture_writer_t *writer) {
+    ei_capture_header_t header;
+    memset(&header, 0, sizeof(header));
+    header.magic = EI_CAPTURE_MAGIC;
+    header.version = EI_CAPTURE_VERSION;
+    header.header_bytes = sizeof(ei_capture_header_t);
+    header.project_id = writer->impulse->project_id;
+    header.impulse_id = writer->impulse->impulse_id;
+    header.deploy_version = writer->impulse->deploy_version;
+    header.input_width = (uint16_t)writer->impulse->input_width;
+    header.input_height = (uint16_t)writer->impulse->input_height;
+    header.pixel_format = writer->pixel_format;
+    header.label_count = writer->impulse->label_count;
+    if (writer->write(&header, sizeof(header), writer->ctx) != sizeof(header)) {
+        return EI_IMPULSE_CANCELED;
+    }
+    return EI_IMPULSE_OK;
+}
+
+/**
+ * Write one record: the frame and the result of the run on it (NULL if the classifier didn't
+ * run, e.g. the application rejected the frame). The frame is passed to the output as it is,
+ * the only copies are the fixed fields and the boxes, a few bytes each.
+ *
+ * @param error EI_IMPULSE_ERROR of the run (with a result that isn't usable, pass it anyway)
+ * @return EI_IMPULSE_OK, EI_IMPULSE_INVALID_SIZE if the frame doesn't match its dimensions,
+ *  or EI_IMPULSE_CANCELED if the output took less than it was given (the record is then cut
+ *  short, the reader drops it)
+ */
+__attribute__((unused)) static EI_IMPULSE_ERROR ei_capture_write_record(
+    const ei_capture_writer_t *writer,
+    const ei_capture_frame_t *frame,
+    const ei_impulse_result_t *result,
+    EI_IMPULSE_ERROR error)
+{
+    const ei_impulse_t *impulse = writer->impulse;
+    if (frame->data == NULL ||
+        frame->bytes != (uint32_t)frame->width * frame->height * writer->pixel_format) {
+        return EI_IMPULSE_INVALID_SIZE;
+    }
+
+    ei_capture_record_t record;
+    memset(&record, 0, sizeof(record));
+    record.magic = EI_CAPTURE_RECORD_MAGIC;
+    record.frame_id = frame->frame_id;
+    record.timestamp_ms = frame->timestamp_ms;
+    record.frame_width = frame->width;
+    record.frame_height = frame->height;
+    record.frame_bytes = frame->bytes;
+    record.frame_us = frame->frame_us;
+    record.error = (int8_t)error;
+    record.status = frame->status;
+    record.dropped = frame->dropped;
+    if (result != NULL) {
+        record.flags = EI_CAPTURE_FLAG_RESULT;
+        record.dsp_us = (uint32_t)result->timing.dsp_us;
+        record.classification_us = (uint32_t)result->timing.classification_us;
+        record.postprocessing_us = (uint32_t)result->timing.postprocessing_us;
+        record.anomaly = result->anomaly;
+        record.boxes_count = (uint16_t)ei_capture_boxes_count(result);
+        record.classification_count = impulse->label_count;
+        if (frame->raw_output != NULL && frame->raw_output_bytes > 0) {
+            record.flags |= EI_CAPTURE_FLAG_RAW_OUTPUT;
+            record.raw_output_bytes = frame->raw_output_bytes;
+        }
+        if (frame->state_reset) {
+            record.flags |= EI_CAPTURE_FLAG_STATE_RESET;
+        }
+    }
+    const size_t frame_offset = ei_capture_frame_offset(record.boxes_count, record.classification_count,
+                                                        record.raw_output_bytes);
+    record.record_bytes = (uint32_t)(frame_offset + ei_capture_align(frame->bytes));
+
+    // boxes and scores go out one by one, so the checksum is taken over the same values first
+    uint32_t hash = ei_capture_fnv1a(2166136261u, &record, offsetof(ei_capture_record_t, checksum));
+    ei_capture_box_t box;
+    for (uint32_t ix = 0, count = 0; count < record.boxes_count; ix++) {
+        if (ei_capture_box_from_result(impulse, &result->bounding_boxes[ix], &box)) {
+            hash = ei_capture_fnv1a(hash, &box, sizeof(box));
+            count++;
+        }
+    }
+    for (uint16_t ix = 0; ix < record.classification_count; ix++) {
+        hash = ei_capture_fnv1a(hash, &result->classification[ix].value, sizeof(float));
+    }
+    hash = ei_capture_fnv1a(hash, frame->raw_output, record.raw_output_bytes);
+    record.checksum = ei_capture_fnv1a(hash, frame->data, frame->bytes);
+
+    if (writer->write(&record, sizeof(record), writer->ctx) != sizeof(record)) {
+        return EI_IMPULSE_CANCELED;
+    }
+    for (uint32_t ix = 0, count = 0; count < record.boxes_count; ix++) {
+        if (ei_capture_box_from_result(impulse, &result->bounding_boxes[ix], &box)) {
+            if (writer->write(&box, sizeof(box), writer->ctx) != sizeof(box)) {
+                return EI_IMPULSE_CANCELED;
+            }
+            count++;
+        }
+    }
+    for (uint16_t ix = 0; ix < record.classification_count; ix++) {
+        if (writer->write(&result->classification[ix].value, sizeof(float), writer->ctx) != sizeof(float)) {
+            return EI_IMPULSE_CANCELED;
+        }
+    }
+    if (record.raw_output_bytes > 0 &&
+        writer->write(frame->raw_output, record.raw_output_bytes, writer->ctx) != record.raw_output_bytes) {
+        return EI_IMPULSE_CANCELED;
+    }
+
+    static const uint8_t padding[EI_CAPTURE_ALIGNMENT] = { 0 };
+    const size_t head_bytes = sizeof(record) + record.boxes_count * sizeof(ei_capture_box_t) +
+                              record.classification_count * sizeof(float) + record.raw_output_bytes;
+    const size_t pad_head = frame_offset - head_bytes;
+    const size_t pad_frame = ei_capture_align(frame->bytes) - frame->bytes;
+    if ((pad_head > 0 && writer->write(padding, pad_head, writer->ctx) != pad_head) ||
+        writer->write(frame->data, frame->bytes, writer->ctx) != frame->bytes ||
+        (pad_frame > 0 && writer->write(padding, pad_frame, writer->ctx) != pad_frame)) {
+        return EI_IMPULSE_CANCELED;
+    }
+    return EI_IMPULSE_OK;
+}
+
+/**
+ * A record of a capture, all pointers into the capture data
+ */
+typedef struct {
+    const ei_capture_record_t *record;
+    const ei_capture_box_t *boxes;          // record->boxes_count
+    const float *classification;            // record->classification_count
+    const uint8_t *raw_output;              // record->raw_output_bytes, NULL without
+    const uint8_t *frame;                   // record->frame_bytes
+} ei_capture_view_t;
+
+typedef struct {
+    const uint8_t *data;
+    size_t bytes;
+    size_t offset;                          // of the next record
+    const ei_capture_header_t *header;
+    uint32_t records;                       // handed out so far
+    uint32_t corrupt;                       // skipped, checksum or sizes didn't match
+    bool truncated;                         // the last record was cut short
+} ei_capture_reader_t;
+
+/**
+ * Read a capture in place. The data has to stay valid while the reader is used and be aligned to
+ * EI_CAPTURE_ALIGNMENT (a mapping or a malloc'd buffer is).
+ */
+__attribute__((unused)) static EI_IMPULSE_ERROR ei_capture_reader_open(
+    ei_capture_reader_t *reader,
+    const void *data,
+    size_t bytes)
+{
+    memset(reader, 0, sizeof(ei_capture_reader_t));
+    const ei_capture_header_t *header = (const ei_capture_header_t *)data;
+    if (data == NULL || ((uintptr_t)data & (EI_CAPTURE_ALIGNMENT - 1)) != 0 ||
+        bytes < sizeof(ei_capture_header_t) || header->magic != EI_CAPTURE_MAGIC) {
+        ei_printf("ERR: not a capture\n");
+        return EI_IMPULSE_INVALID_SIZE;
+    }
+    if (header->version != EI_CAPTURE_VERSION || header->header_bytes < sizeof(ei_capture_header_t) ||
+        (header->header_bytes & (EI_CAPTURE_ALIGNMENT - 1)) != 0 || header->header_bytes > bytes) {
+        ei_printf("ERR: capture version %d is not supported (expected %d)\n",
+            (int)header->version, EI_CAPTURE_VERSION);
+        return EI_IMPULSE_INVALID_SIZE;
+    }
+    reader->data = (const uint8_t *)data;
+    reader->bytes = bytes;
+    reader->offset = header->header_bytes;
+    reader->header = header;
+    return EI_IMPULSE_OK;
+}
+
+/**
+ * Next record of the capture. Records that don't check out are counted in reader->corrupt and
+ * skipped; when the record magic itself is gone the reader looks for the next one.
+ *
+ * @return false at the end of the capture
+ */
+__attribute__((unused)) static bool ei_capture_reader_next(ei_capture_reader_t *reader, ei_capture_view_t *view) {
+    const size_t pixel_bytes = reader->header->pixel_format;
+    while (reader->offset + sizeof(ei_capture_record_t) <= reader->bytes) {
+        const ei_capture_record_t *record = (const ei_capture_record_t *)(reader->data + reader->offset);
+        if (record->magic != EI_CAPTURE_RECORD_MAGIC) {
+            reader->offset += EI_CAPTURE_ALIGNMENT;
+            continue;
+        }
+        const size_t frame_offset = ei_capture_frame_offset(record->boxes_count, record->classification_count,
+                                                            record->raw_output_bytes);
+        const bool sizes_ok =
+            record->frame_bytes == (uint32_t)record->frame_width * record->frame_height * pixel_bytes &&
+            record->record_bytes == frame_offset + ei_capture_align(record->frame_bytes);
+        if (sizes_ok && reader->offset + record->record_bytes > reader->bytes) {
+            reader->truncated = true;
+            break;
+        }
+        const uint8_t *base = (const uint8_t *)record;
+        const ei_capture_box_t *boxes = (const ei_capture_box_t *)(base + ei_capture_boxes_offset());
+        const float *classification = (const float *)(boxes + record->boxes_count);
+        uint32_t hash = 0;
+        if (sizes_ok) {
+            hash = ei_capture_fnv1a(2166136261u, record, offsetof(ei_capture_record_t, checksum));
+            hash = ei_capture_fnv1a(hash, boxes, record->boxes_count * sizeof(ei_capture_box_t) +
+                                                 record->classification_count * sizeof(float) +
+                                                 record->raw_output_bytes);
+            hash = ei_capture_fnv1a(hash, base + frame_offset, record->frame_bytes);
+        }
+        if (!sizes_ok || hash != record->checksum) {
+            reader->corrupt++;
+            reader->offset += EI_CAPTURE_ALIGNMENT;
+            continue;
+        }
+        view->record = record;
+        view->boxes = boxes;
+        view->classification = classification;
+        view->raw_output = record->raw_output_bytes > 0 ?
+            (const uint8_t *)(classification + record->classification_count) : NULL;
+        view->frame = base + frame_offset;
+        reader->offset += record->record_bytes;
+        reader->records++;
+        return true;
+    }
+    if (reader->offset < reader->bytes && reader->offset + sizeof(ei_capture_record_t) > reader->bytes) {
+        reader->truncated = true;
+    }
+    reader->offset = reader->bytes;
+    return false;
+}
+
+/**
+ * The frame of a record as the model input, read in place: the frame is cropped to the aspect
+ * ratio of the model input (centre, as EI_CLASSIFIER_RESIZE_FIT_SHORTEST) and box averaged down
+ * to it. A frame of the model input size is passed through as it is. Use it with
+ * ei::signal_view_from_crop, or to_signal() on the view for code that takes a signal_t.
+ * The samples match resize_image_using_mode when the frame is a whole multiple of the input;
+ * for other ratios they differ slightly (see crop_resize_init), resize into a buffer to match.
+ *
+ * @return EIDSP_OK, or EIDSP_PARAMETER_INVALID for a frame smaller than the model input
+ */
+__attribute__((unused)) static int ei_capture_crop_init(
+    ei::image::processing::crop_resize_t *crop,
+    const ei_capture_reader_t *reader,
+    const ei_capture_view_t *view)
+{
+    const ei_capture_header_t *header = reader->header;
+    const ei_capture_record_t *record = view->record;
+    if (record->frame_width < header->input_width || record->frame_height < header->input_height) {
+        return EIDSP_PARAMETER_INVALID;
+    }
+    const bool model_size = record->frame_width == header->input_width &&
+                            record->frame_height == header->input_height;
+    return ei::image::processing::crop_resize_init(
+        crop, view->frame, record->frame_width, record->frame_height, header->pixel_format,
+        0, 0, record->frame_width, record->frame_height, header->input_width, header->input_height,
+        model_size ? EI_CLASSIFIER_RESIZE_NONE : EI_CLASSIFIER_RESIZE_FIT_SHORTEST,
+        EI_CLASSIFIER_RESIZE_FILTER_AREA);
+}
+
+/**
+ * Bytes of resize buffer ei_capture_run_classifier needs for the frame of a record: 0 for a frame
+ * it reads in place (input size or a whole multiple of it), else what resize_image_using_mode
+ * writes. That is the model input when the crop is boxed in place (area filter, 2x or more), but
+ * the whole crop when it falls back to crop_and_interpolate_image, which copies the crop into the
+ * buffer and interpolates it down there.
+ */
+__attribute__((unused)) static size_t ei_capture_resize_buffer_bytes(
+    const ei_capture_reader_t *reader,
+    const ei_capture_view_t *view)
+{
+    const ei_capture_header_t *header = reader->header;
+    ei::image::processing::crop_resize_t crop;
+    if (ei_capture_crop_init(&crop, reader, view) != ei::EIDSP_OK ||
+        (crop.win_width % crop.out_width == 0 && crop.win_height % crop.out_height == 0)) {
+        return 0;
+    }
+    const size_t input = (size_t)header->input_width * header->input_height * header->pixel_format;
+    // area filter of resize_image_using_mode: 2x or more on either axis
+    if (crop.win_width >= 2 * crop.out_width || crop.win_height >= 2 * crop.out_height) {
+        return input;
+    }
+    const size_t window = (size_t)crop.win_width * crop.win_height * header->pixel_format;
+    return window > input ? window : input;
+}
+
+#if EIDSP_SIGNAL_C_FN_POINTER == 0 && !defined(__MBED__)
+/**
+ * Run the classifier on the frame of a record, the way the device fed it to the model: a frame
+ * of the input size or a whole multiple of it is read in place from the capture, a frame at any
+ * other ratio is first resized into resize_buffer exactly as resize_image_using_mode does on the
+ * device.
+ *
+ * @param resize_buffer Scratch for frames at a fractional ratio, or NULL to read them in place too
+ *  (results then differ slightly from the device)
+ * @param resize_buffer_bytes Size of resize_buffer, at least ei_capture_resize_buffer_bytes of the
+ *  record (a frame that shrinks less than 2x needs room for its whole crop, not just the input)
+ * @return EI_IMPULSE_OK, the error of run_classifier, EI_IMPULSE_INVALID_SIZE for a frame
+ *  smaller than the model input, or EI_IMPULSE_OUT_OF_MEMORY when resize_buffer is too small
+ */
+__attribute__((unused)) static EI_IMPULSE_ERROR ei_capture_run_classifier(
+    ei_impulse_handle_t *handle,
+    const ei_capture_reader_t *reader,
+    const ei_capture_view_t *view,
+    ei_impulse_result_t *result,
+    uint8_t *resize_buffer,
+    size_t resize_buffer_bytes,
+    bool debug = false)
+{
+    const ei_capture_header_t *header = reader->header;
+    const size_t pixels = (size_t)header->input_width * header->input_height;
+    ei::image::processing::crop_resize_t crop;
+    if (ei_capture_crop_init(&crop, reader, view) != ei::EIDSP_OK) {
+        return EI_IMPULSE_INVALID_SIZE;
+    }
+    const bool whole = crop.win_width % crop.out_width == 0 && crop.win_height % crop.out_height == 0;
+
+    if (!whole && resize_buffer != NULL && resize_buffer_bytes < ei_capture_resize_buffer_bytes(reader, view)) {
+        return EI_IMPULSE_OUT_OF_MEMORY;
+    }
+    if (whole || resize_buffer == NULL) {
+        if (view->record->frame_width == header->input_width && view->record->frame_height == header->input_height) {
+            if (header->pixel_format == EI_CAPTURE_PIXEL_GRAY8) {
+                ei::signal_view<ei::signal_source_gray8> signal = ei::signal_view_from_gray8(view->frame, pixels);
+                return run_classifier(handle, &signal, result, debug);
+            }
+            ei::signal_view<ei::signal_source_rgb888> signal = ei::signal_view_from_rgb888(view->frame, pixels);
+            return run_classifier(handle, &signal, result, debug);
+        }
+        ei::signal_view<ei::signal_source_crop_resize> signal = ei::signal_view_from_crop(crop);
+        return run_classifier(handle, &signal, result, debug);
+    }
+
+    if (ei::image::processing::resize_image_using_mode(
+            view->frame, view->record->frame_width, view->record->frame_height, resize_buffer,
+            header->input_width, header->input_height, header->pixel_format,
+            EI_CLASSIFIER_RESIZE_FIT_SHORTEST, EI_CLASSIFIER_RESIZE_FILTER_AREA) != ei::EIDSP_OK) {
+        return EI_IMPULSE_DSP_ERROR;
+    }
+    if (header->pixel_format == EI_CAPTURE_PIXEL_GRAY8) {
+        ei::signal_view<ei::signal_source_gray8> signal = ei::signal_view_from_gray8(resize_buffer, pixels);
+        return run_classifier(handle, &signal, result, debug);
+    }
+    ei::signal_view<ei::signal_source_rgb888> signal = ei::signal_view_from_rgb888(resize_buffer, pixels);
+    return run_classifier(handle, &signal, result, debug);
+}
+#endif // EIDSP_SIGNAL_C_FN_POINTER == 0 && !defined(__MBED__)
+
+#endif // _EI_CLASSIFIER_CAPTURE_H_
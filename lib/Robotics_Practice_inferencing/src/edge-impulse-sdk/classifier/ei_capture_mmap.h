@@ -0,0 +1,105 @@
+/* The Clear BSD License
+ *
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _EI_CLASSIFIER_CAPTURE_MMAP_H_
+#define _EI_CLASSIFIER_CAPTURE_MMAP_H_
+
+/**
+ * Captures (ei_capture.h) read from a file through mmap, for host tools on Linux and macOS.
+ * The file is mapped read only and the reader points into the mapping, so frames go to the
+ * classifier straight from the page cache, however long the capture is.
+ *
+ *     ei_capture_file_t file;
+ *     if (ei_capture_file_open(&file, "field.cap") == EI_IMPULSE_OK) {
+ *         ei_capture_view_t view;
+ *         while (ei_capture_reader_next(&file.reader, &view)) { ... }
+ *         ei_capture_file_close(&file);
+ *     }
+ */
+
+#include "edge-impulse-sdk/classifier/ei_capture.h"
+
+#if defined(__linux__) || defined(__APPLE__)
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+typedef struct {
+    void *map;
+    size_t bytes;
+    ei_capture_reader_t reader;
+} ei_capture_file_t;
+
+__attribute__((unused)) static void ei_capture_file_close(ei_capture_file_t *file) {
+    if (file->map != NULL) {
+        munmap(file->map, file->bytes);
+    }
+    file->map = NULL;
+    file->bytes = 0;
+}
+
+__attribute__((unused)) static EI_IMPULSE_ERROR ei_capture_file_open(ei_capture_file_t *file, const char *path) {
+    memset(file, 0, sizeof(ei_capture_file_t));
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        ei_printf("ERR: cannot open capture %s\n", path);
+        return EI_IMPULSE_INVALID_SIZE;
+    }
+    struct stat st;
+    void *map = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    if (map == MAP_FAILED) {
+        ei_printf("ERR: cannot map capture %s\n", path);
+        return EI_IMPULSE_INVALID_SIZE;
+    }
+    // records are read front to back
+    madvise(map, (size_t)st.st_size, MADV_SEQUENTIAL);
+    file->map = map;
+    file->bytes = (size_t)st.st_size;
+
+    EI_IMPULSE_ERROR res = ei_capture_reader_open(&file->reader, file->map, file->bytes);
+    if (res != EI_IMPULSE_OK) {
+        ei_capture_file_close(file);
+    }
+    return res;
+}
+
+#endif // defined(__linux__) || defined(__APPLE__)
+
+#endif // _EI_CLASSIFIER_CAPTURE_MMAP_H_
@@ -95,6 +95,20 @@
     #define ESP_NN                                  1
 #endif
 
+// Compiled (EON) graphs can run conv, depthwise conv and add with kernels instantiated for the
+// fixed shape of each node. Off by default: the gain over the generic (or ESP-NN) kernels has
+// not been measured on a target yet, and the instantiated kernels add flash per node. Makes no
+// sense where hand written SIMD kernels are available (CMSIS-NN, ARC MLI, ESP-NN on S3/P4).
+#ifndef EI_CLASSIFIER_TFLITE_FIXED_SHAPE_KERNELS
+#define EI_CLASSIFIER_TFLITE_FIXED_SHAPE_KERNELS    0
+#endif // EI_CLASSIFIER_TFLITE_FIXED_SHAPE_KERNELS
+
+// Compiled (EON) graphs built with EI_CLASSIFIER_WEIGHTS_BLOB=1 leave their constant tensors out of
+// the binary, the application points them at a weights blob (see ei_weights_blob.h) before init.
+#ifndef EI_CLASSIFIER_WEIGHTS_BLOB
+#define EI_CLASSIFIER_WEIGHTS_BLOB                  0
+#endif // EI_CLASSIFIER_WEIGHTS_BLOB
+
 // no include checks in the compiler? then just include metadata and then ops_define (optional if on EON model)
 #ifndef __has_include
     #include "model-parameters/model_metadata.h"
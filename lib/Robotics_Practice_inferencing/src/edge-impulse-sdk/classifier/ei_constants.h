@@ -6,6 +6,10 @@
 #define EI_CLASSIFIER_RESIZE_FIT_LONGEST         2
 #define EI_CLASSIFIER_RESIZE_SQUASH              3
 
+// Sampling used by resize_image_using_mode
+#define EI_CLASSIFIER_RESIZE_FILTER_BILINEAR     0
+#define EI_CLASSIFIER_RESIZE_FILTER_AREA         1 // box average when downscaling 2x or more
+
 // This exists for linux runner, etc
 __attribute__((unused)) static const char *EI_RESIZE_STRINGS[] = { "none", "fit-shortest", "fit-longest", "squash" };
 
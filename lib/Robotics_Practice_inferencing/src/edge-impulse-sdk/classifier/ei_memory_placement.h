@@ -0,0 +1,511 @@
+/* The Clear BSD License
+ *
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _EI_CLASSIFIER_MEMORY_PLACEMENT_H_
+#define _EI_CLASSIFIER_MEMORY_PLACEMENT_H_
+
+#include <string.h>
+#include "edge-impulse-sdk/classifier/ei_model_types.h"
+#include "edge-impulse-sdk/porting/ei_classifier_porting.h"
+
+/**
+ * Placement of the memory used by a compiled (EON) graph over internal and external RAM.
+ *
+ * The activation arena is cut into slices at offsets that no tensor straddles, using the
+ * per-tensor offsets and node lifetimes that the compiled graph exports. Every slice gets
+ * a "heat" value: the number of times each byte is read or written per inference. Scratch
+ * and persistent buffers are touched by every kernel and are always hottest; the input
+ * frame is written once and read once and is always cold. Regions are then placed hottest
+ * first in internal RAM until the budget is used up, the rest spills to external RAM (PSRAM).
+ * A slice can only be as small as the tensors that straddle it allow, so one hot slice may be
+ * larger than what is left of the budget; it is then demoted to external RAM with a warning,
+ * and report.demoted_bytes says how much hot memory missed internal RAM.
+ * Constant tensors stay where the linker put them (flash) and are only reported.
+ *
+ * Several graphs (e.g. a detector and a second model that checks its crops) can share one
+ * placement: their layouts are overlaid, so every region is as large as the largest graph
+ * needs rather than the sum. That works because a compiled graph only holds its arena between
+ * init and reset, i.e. for one inference; the graphs must run one after the other, never
+ * concurrently.
+ */
+
+typedef enum {
+    EI_MEMORY_INTERNAL = 0,
+    EI_MEMORY_EXTERNAL = 1,
+    EI_MEMORY_FLASH = 2
+} ei_memory_location_t;
+
+typedef enum {
+    EI_MEMORY_REGION_SCRATCH = 0,
+    EI_MEMORY_REGION_ACTIVATIONS = 1,
+    EI_MEMORY_REGION_INPUT_FRAME = 2,
+    EI_MEMORY_REGION_WEIGHTS = 3
+} ei_memory_region_kind_t;
+
+// scratch + input frame + weights + activation slices
+#ifndef EI_MEMORY_PLACEMENT_MAX_REGIONS
+#define EI_MEMORY_PLACEMENT_MAX_REGIONS    9
+#endif // EI_MEMORY_PLACEMENT_MAX_REGIONS
+#define EI_MEMORY_PLACEMENT_MAX_SLICES     (EI_MEMORY_PLACEMENT_MAX_REGIONS - 3)
+
+#define EI_MEMORY_PLACEMENT_HEAT_MAX       0xFFFFFFFF
+
+// graphs that can share one placement
+#ifndef EI_MEMORY_PLACEMENT_MAX_GRAPHS
+#define EI_MEMORY_PLACEMENT_MAX_GRAPHS     4
+#endif // EI_MEMORY_PLACEMENT_MAX_GRAPHS
+
+/** Learning block whose compiled graph takes part in a shared placement */
+typedef struct {
+    const ei_impulse_t *impulse;
+    uint32_t learn_block_index;
+} ei_memory_placement_block_t;
+
+typedef struct {
+    ei_memory_region_kind_t kind;
+    ei_memory_location_t location;
+    size_t offset;      // offset in the arena layout (activation slices only)
+    size_t bytes;
+    uint32_t heat;      // accesses per byte per inference
+    uint8_t *ptr;
+} ei_memory_placement_t;
+
+typedef struct {
+    /** Bytes of internal RAM the graph may use */
+    size_t internal_budget;
+    /** Size of the application input frame to place as well, 0 for none */
+    size_t input_frame_bytes;
+    void *(*alloc_internal)(size_t align, size_t size);
+    /** May be NULL if there is no external RAM, everything then goes to internal RAM */
+    void *(*alloc_external)(size_t align, size_t size);
+    void (*free_fn)(void *ptr);
+} ei_memory_placement_policy_t;
+
+typedef struct {
+    ei_memory_placement_t regions[EI_MEMORY_PLACEMENT_MAX_REGIONS];
+    size_t regions_count;
+    size_t internal_bytes;
+    size_t external_bytes;
+    size_t flash_bytes;
+    /** Bytes of scratch and activation regions that did not fit the internal budget */
+    size_t demoted_bytes;
+    const ei_config_tflite_eon_graph_t *graphs[EI_MEMORY_PLACEMENT_MAX_GRAPHS];
+    size_t graphs_count;
+} ei_memory_placement_report_t;
+
+__attribute__((unused)) static const char *ei_memory_region_kind_name(ei_memory_region_kind_t kind) {
+    switch (kind) {
+        case EI_MEMORY_REGION_SCRATCH: return "scratch";
+        case EI_MEMORY_REGION_ACTIVATIONS: return "activations";
+        case EI_MEMORY_REGION_INPUT_FRAME: return "input frame";
+        case EI_MEMORY_REGION_WEIGHTS: return "weights";
+        default: return "unknown";
+    }
+}
+
+__attribute__((unused)) static const char *ei_memory_location_name(ei_memory_location_t location) {
+    switch (location) {
+        case EI_MEMORY_INTERNAL: return "internal";
+        case EI_MEMORY_EXTERNAL: return "external";
+        case EI_MEMORY_FLASH: return "flash";
+        default: return "unknown";
+    }
+}
+
+/**
+ * Cut the activation arena into slices that no tensor straddles
+ * @param lifetimes Tensor lifetimes exported by the graph
+ * @param lifetimes_count Number of tensors
+ * @param slices Output, offset/bytes/heat are filled in
+ * @param max_slices Capacity of slices; neighbouring slices are merged until they fit
+ * @return Number of slices
+ */
+__attribute__((unused)) static size_t ei_memory_placement_slice_arena(
+    const ei_tensor_lifetime_t *lifetimes,
+    size_t lifetimes_count,
+    ei_memory_placement_t *slices,
+    size_t max_slices)
+{
+    size_t activation_end = 0;
+    for (size_t ix = 0; ix < lifetimes_count; ix++) {
+        if (lifetimes[ix].in_arena && lifetimes[ix].offset + lifetimes[ix].bytes > activation_end) {
+            activation_end = lifetimes[ix].offset + lifetimes[ix].bytes;
+        }
+    }
+    if (activation_end == 0 || max_slices == 0) {
+        return 0;
+    }
+
+    // walk the arena and close a slice at every tensor start / end that nothing crosses
+    size_t count = 0;
+    size_t slice_start = 0;
+    size_t pos = 0;
+    while (pos < activation_end) {
+        // next candidate boundary after pos
+        size_t next = activation_end;
+        for (size_t ix = 0; ix < lifetimes_count; ix++) {
+            const ei_tensor_lifetime_t *l = &lifetimes[ix];
+            if (!l->in_arena || l->bytes == 0) {
+                continue;
+            }
+            if (l->offset > pos && l->offset < next) {
+                next = l->offset;
+            }
+            if (l->offset + l->bytes > pos && l->offset + l->bytes < next) {
+                next = l->offset + l->bytes;
+            }
+        }
+        bool crossed = false;
+        for (size_t ix = 0; ix < lifetimes_count; ix++) {
+            const ei_tensor_lifetime_t *l = &lifetimes[ix];
+            if (l->in_arena && l->offset < next && l->offset + l->bytes > next) {
+                crossed = true;
+                break;
+            }
+        }
+        pos = next;
+        if (crossed && pos < activation_end) {
+            continue;
+        }
+
+        if (count == max_slices) {
+            // out of slots, merge the smallest adjacent pair to make room
+            size_t best = 0;
+            for (size_t ix = 1; ix + 1 < count; ix++) {
+                if (slices[ix].bytes + slices[ix + 1].bytes < slices[best].bytes + slices[best + 1].bytes) {
+                    best = ix;
+                }
+            }
+            if (count == 1) {
+                slice_start = slices[0].offset;
+                count = 0;
+            }
+            else {
+                slices[best].bytes += slices[best + 1].bytes;
+                memmove(&slices[best + 1], &slices[best + 2], (count - best - 2) * sizeof(ei_memory_placement_t));
+                count--;
+            }
+        }
+
+        memset(&slices[count], 0, sizeof(ei_memory_placement_t));
+        slices[count].kind = EI_MEMORY_REGION_ACTIVATIONS;
+        slices[count].offset = slice_start;
+        slices[count].bytes = pos - slice_start;
+        count++;
+        slice_start = pos;
+    }
+
+    // heat: bytes moved through the slice per inference, per byte of slice
+    for (size_t s = 0; s < count; s++) {
+        uint64_t traffic = 0;
+        for (size_t ix = 0; ix < lifetimes_count; ix++) {
+            const ei_tensor_lifetime_t *l = &lifetimes[ix];
+            if (l->in_arena && l->offset >= slices[s].offset && l->offset < slices[s].offset + slices[s].bytes) {
+                traffic += (uint64_t)l->bytes * l->accesses;
+            }
+        }
+        slices[s].heat = slices[s].bytes ? (uint32_t)(traffic / slices[s].bytes) : 0;
+    }
+
+    return count;
+}
+
+/**
+ * Release everything allocated by ei_memory_placement_apply and restore the default arena allocation
+ */
+__attribute__((unused)) static void ei_memory_placement_release(
+    ei_memory_placement_report_t *report,
+    const ei_memory_placement_policy_t *policy)
+{
+    for (size_t ix = 0; ix < report->graphs_count; ix++) {
+        report->graphs[ix]->model_set_arena_regions(NULL, 0, NULL, 0);
+    }
+    for (size_t ix = 0; ix < report->regions_count; ix++) {
+        ei_memory_placement_t *r = &report->regions[ix];
+        if (r->ptr && r->location != EI_MEMORY_FLASH) {
+            policy->free_fn(r->ptr);
+        }
+        r->ptr = NULL;
+    }
+    memset(report, 0, sizeof(ei_memory_placement_report_t));
+}
+
+/**
+ * Find the compiled graph of a learning block, or NULL if it's not an EON graph exposing its layout
+ */
+__attribute__((unused)) static const ei_config_tflite_eon_graph_t *ei_memory_placement_get_graph(
+    const ei_impulse_t *impulse,
+    uint32_t learn_block_index)
+{
+    if (learn_block_index >= impulse->learning_blocks_size) {
+        return NULL;
+    }
+    const ei_learning_block_config_tflite_graph_t *block_config =
+        (const ei_learning_block_config_tflite_graph_t *)impulse->learning_blocks[learn_block_index].config;
+    if (!block_config || !block_config->compiled) {
+        return NULL;
+    }
+    const ei_config_tflite_eon_graph_t *graph = (const ei_config_tflite_eon_graph_t *)block_config->graph_config;
+    if (!graph->model_tensor_lifetimes || !graph->model_set_arena_regions || !graph->model_arena_size) {
+        return NULL;
+    }
+    return graph;
+}
+
+/**
+ * Place the memory of several compiled graphs that run one after the other (never concurrently)
+ * in one set of regions. Every activation slice and the scratch region is sized to the largest
+ * graph, slice boundaries are cut where no tensor of any graph straddles them, and heat adds up
+ * over the graphs. Must be called before run_classifier(); the placement stays in effect until
+ * ei_memory_placement_release.
+ *
+ * @param blocks EON learning blocks that share the placement
+ * @param blocks_count Number of blocks, at most EI_MEMORY_PLACEMENT_MAX_GRAPHS
+ * @param policy Budget and allocators
+ * @param report Output, what was placed where. regions[].ptr of the input frame is the
+ *               buffer the application should capture into; demoted_bytes is non-zero when
+ *               a hot region had to go to external RAM
+ * @return EI_IMPULSE_OK if successful, also when regions were demoted (see report->demoted_bytes)
+ */
+__attribute__((unused)) static EI_IMPULSE_ERROR ei_memory_placement_apply_shared(
+    const ei_memory_placement_block_t *blocks,
+    size_t blocks_count,
+    const ei_memory_placement_policy_t *policy,
+    ei_memory_placement_report_t *report)
+{
+    memset(report, 0, sizeof(ei_memory_placement_report_t));
+
+    if (blocks_count == 0 || blocks_count > EI_MEMORY_PLACEMENT_MAX_GRAPHS) {
+        ei_printf("ERR: a placement can be shared by 1 to %d graphs\n", EI_MEMORY_PLACEMENT_MAX_GRAPHS);
+        return EI_IMPULSE_INFERENCE_ERROR;
+    }
+    const ei_config_tflite_eon_graph_t *graphs[EI_MEMORY_PLACEMENT_MAX_GRAPHS];
+    size_t lifetimes_count = 0;
+    for (size_t g = 0; g < blocks_count; g++) {
+        graphs[g] = ei_memory_placement_get_graph(blocks[g].impulse, blocks[g].learn_block_index);
+        if (!graphs[g]) {
+            ei_printf("ERR: memory placement requires a compiled (EON) graph that exports its layout\n");
+            return EI_IMPULSE_UNSUPPORTED_INFERENCING_ENGINE;
+        }
+        lifetimes_count += graphs[g]->model_tensor_lifetimes(NULL, 0);
+    }
+    if (!policy->alloc_internal || !policy->free_fn) {
+        return EI_IMPULSE_INFERENCE_ERROR;
+    }
+
+    // all graphs lay out their arena from offset 0, so their lifetimes can be sliced as one list
+    ei_tensor_lifetime_t *lifetimes = (ei_tensor_lifetime_t *)ei_malloc(lifetimes_count * sizeof(ei_tensor_lifetime_t));
+    if (!lifetimes) {
+        return EI_IMPULSE_OUT_OF_MEMORY;
+    }
+    size_t filled = 0;
+    size_t scratch_bytes = 0;
+    for (size_t g = 0; g < blocks_count; g++) {
+        ei_tensor_lifetime_t *graph_lifetimes = lifetimes + filled;
+        size_t graph_count = graphs[g]->model_tensor_lifetimes(graph_lifetimes, lifetimes_count - filled);
+        size_t graph_activation_end = 0;
+        for (size_t ix = 0; ix < graph_count; ix++) {
+            if (!graph_lifetimes[ix].in_arena) {
+                report->flash_bytes += graph_lifetimes[ix].bytes;
+            }
+            else if (graph_lifetimes[ix].offset + graph_lifetimes[ix].bytes > graph_activation_end) {
+                graph_activation_end = graph_lifetimes[ix].offset + graph_lifetimes[ix].bytes;
+            }
+        }
+        // persistent and scratch buffers come from the arena above the activations of each graph
+        size_t arena_size = graphs[g]->model_arena_size();
+        if (arena_size > graph_activation_end && arena_size - graph_activation_end > scratch_bytes) {
+            scratch_bytes = arena_size - graph_activation_end;
+        }
+        filled += graph_count;
+    }
+
+    // 1. build the list of regions
+    ei_memory_placement_t *regions = report->regions;
+    size_t count = ei_memory_placement_slice_arena(lifetimes, filled, regions, EI_MEMORY_PLACEMENT_MAX_SLICES);
+    ei_free(lifetimes);
+
+    if (scratch_bytes > 0) {
+        ei_memory_placement_t *r = &regions[count++];
+        memset(r, 0, sizeof(ei_memory_placement_t));
+        r->kind = EI_MEMORY_REGION_SCRATCH;
+        r->bytes = scratch_bytes;
+        r->heat = EI_MEMORY_PLACEMENT_HEAT_MAX;
+    }
+    if (policy->input_frame_bytes > 0) {
+        ei_memory_placement_t *r = &regions[count++];
+        memset(r, 0, sizeof(ei_memory_placement_t));
+        r->kind = EI_MEMORY_REGION_INPUT_FRAME;
+        r->bytes = policy->input_frame_bytes;
+        r->heat = 0;
+    }
+
+    // 2. hottest first into internal RAM while it fits, cold regions to external RAM
+    bool placed[EI_MEMORY_PLACEMENT_MAX_REGIONS] = { 0 };
+    for (size_t n = 0; n < count; n++) {
+        size_t pick = count;
+        for (size_t ix = 0; ix < count; ix++) {
+            if (!placed[ix] && (pick == count || regions[ix].heat > regions[pick].heat)) {
+                pick = ix;
+            }
+        }
+        placed[pick] = true;
+        ei_memory_placement_t *r = &regions[pick];
+
+        bool cold = r->kind == EI_MEMORY_REGION_INPUT_FRAME;
+        bool want_internal = !cold && report->internal_bytes + r->bytes <= policy->internal_budget;
+        if (!cold && !want_internal && policy->alloc_external) {
+            ei_printf("WARN: %s region of %u bytes (heat %u) does not fit the internal budget "
+                "(%u of %u bytes used), placing it in external RAM\n",
+                ei_memory_region_kind_name(r->kind), (unsigned)r->bytes, (unsigned)r->heat,
+                (unsigned)report->internal_bytes, (unsigned)policy->internal_budget);
+            report->demoted_bytes += r->bytes;
+        }
+
+        if (want_internal || !policy->alloc_external) {
+            r->ptr = (uint8_t *)policy->alloc_internal(16, r->bytes);
+            r->location = EI_MEMORY_INTERNAL;
+        }
+        if (!r->ptr && policy->alloc_external) {
+            r->ptr = (uint8_t *)policy->alloc_external(16, r->bytes);
+            r->location = EI_MEMORY_EXTERNAL;
+        }
+        if (!r->ptr) {
+            ei_printf("ERR: failed to place %s region of %u bytes\n",
+                ei_memory_region_kind_name(r->kind), (unsigned)r->bytes);
+            report->regions_count = count;
+            ei_memory_placement_release(report, policy);
+            return EI_IMPULSE_OUT_OF_MEMORY;
+        }
+        if (r->location == EI_MEMORY_INTERNAL) {
+            report->internal_bytes += r->bytes;
+        }
+        else {
+            report->external_bytes += r->bytes;
+        }
+    }
+
+    if (report->flash_bytes > 0) {
+        ei_memory_placement_t *r = &regions[count++];
+        memset(r, 0, sizeof(ei_memory_placement_t));
+        r->kind = EI_MEMORY_REGION_WEIGHTS;
+        r->location = EI_MEMORY_FLASH;
+        r->bytes = report->flash_bytes;
+    }
+    report->regions_count = count;
+
+    // 3. hand the slices to every graph, each one only touches the slices its tensors fall in
+    ei_arena_region_t arena_regions[EI_MEMORY_PLACEMENT_MAX_SLICES];
+    size_t arena_regions_count = 0;
+    uint8_t *persistent = NULL;
+    size_t persistent_bytes = 0;
+    for (size_t ix = 0; ix < count; ix++) {
+        if (regions[ix].kind == EI_MEMORY_REGION_ACTIVATIONS) {
+            arena_regions[arena_regions_count].offset = regions[ix].offset;
+            arena_regions[arena_regions_count].bytes = regions[ix].bytes;
+            arena_regions[arena_regions_count].ptr = regions[ix].ptr;
+            arena_regions_count++;
+        }
+        else if (regions[ix].kind == EI_MEMORY_REGION_SCRATCH) {
+            persistent = regions[ix].ptr;
+            persistent_bytes = regions[ix].bytes;
+        }
+    }
+
+    for (size_t g = 0; g < blocks_count; g++) {
+        if (graphs[g]->model_set_arena_regions(arena_regions, arena_regions_count, persistent, persistent_bytes) != kTfLiteOk) {
+            ei_memory_placement_release(report, policy);
+            return EI_IMPULSE_TFLITE_ARENA_ALLOC_FAILED;
+        }
+        report->graphs[report->graphs_count++] = graphs[g];
+    }
+
+    return EI_IMPULSE_OK;
+}
+
+/**
+ * Place the memory of a compiled graph according to a policy. Must be called before
+ * run_classifier(); the placement stays in effect until ei_memory_placement_release.
+ *
+ * @param impulse The impulse (e.g. &ei_default_impulse.impulse)
+ * @param learn_block_index Index of the EON learning block
+ * @param policy Budget and allocators
+ * @param report Output, what was placed where. regions[].ptr of the input frame is the
+ *               buffer the application should capture into
+ * @return EI_IMPULSE_OK if successful
+ */
+__attribute__((unused)) static EI_IMPULSE_ERROR ei_memory_placement_apply(
+    const ei_impulse_t *impulse,
+    uint32_t learn_block_index,
+    const ei_memory_placement_policy_t *policy,
+    ei_memory_placement_report_t *report)
+{
+    const ei_memory_placement_block_t block = { impulse, learn_block_index };
+    return ei_memory_placement_apply_shared(&block, 1, policy, report);
+}
+
+/**
+ * Find the buffer that was placed for a region kind (e.g. the input frame)
+ */
+__attribute__((unused)) static uint8_t *ei_memory_placement_find(
+    const ei_memory_placement_report_t *report,
+    ei_memory_region_kind_t kind)
+{
+    for (size_t ix = 0; ix < report->regions_count; ix++) {
+        if (report->regions[ix].kind == kind) {
+            return report->regions[ix].ptr;
+        }
+    }
+    return NULL;
+}
+
+__attribute__((unused)) static void ei_memory_placement_print(const ei_memory_placement_report_t *report) {
+    ei_printf("Memory placement (internal %u bytes, external %u bytes, flash %u bytes):\n",
+        (unsigned)report->internal_bytes, (unsigned)report->external_bytes, (unsigned)report->flash_bytes);
+    for (size_t ix = 0; ix < report->regions_count; ix++) {
+        const ei_memory_placement_t *r = &report->regions[ix];
+        ei_printf("    %-12s %7u bytes -> %-8s", ei_memory_region_kind_name(r->kind),
+            (unsigned)r->bytes, ei_memory_location_name(r->location));
+        if (r->kind == EI_MEMORY_REGION_ACTIVATIONS) {
+            ei_printf(" (arena offset %u, heat %u)", (unsigned)r->offset, (unsigned)r->heat);
+        }
+        ei_printf("\n");
+    }
+    if (report->demoted_bytes > 0) {
+        ei_printf("    WARN: %u bytes of hot memory over the internal budget are in external RAM\n",
+            (unsigned)report->demoted_bytes);
+    }
+}
+
+#endif // _EI_CLASSIFIER_MEMORY_PLACEMENT_H_
@@ -0,0 +1,398 @@
+/* The Clear BSD License
+ *
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _EI_CLASSIFIER_MEMORY_PLAN_H_
+#define _EI_CLASSIFIER_MEMORY_PLAN_H_
+
+#include <string.h>
+#include "edge-impulse-sdk/classifier/ei_model_types.h"
+#include "edge-impulse-sdk/porting/ei_classifier_porting.h"
+#include "edge-impulse-sdk/tensorflow/lite/micro/memory_planner/greedy_memory_planner.h"
+
+/**
+ * Offline memory plan for compiled (EON) graphs.
+ *
+ * The compiled graph comes with a layout for its activations only; scratch buffers that the
+ * kernels request during prepare are bump-allocated from the top of the arena and are never
+ * reused between nodes. The plan lays out activations and scratch buffers together with the
+ * GreedyMemoryPlanner, so a scratch buffer can share memory with activations that are not live
+ * while its node runs. Scratch buffer sizes depend on the kernels that are compiled in (e.g.
+ * ESP-NN), so the plan is computed with the same kernels as the target: either on the target,
+ * after which it can be applied directly, or offline on a host build with those kernels, printed
+ * with ei_memory_plan_print_source() and compiled into the model with
+ * EI_CLASSIFIER_TFLITE_MEMORY_PLAN=1; ei_memory_plan_check() tells whether such a plan fits the
+ * kernels of the build.
+ *
+ * With a patch budget the plan also runs the first layers tile by tile (patch-based inference):
+ * the graph picks the chain of nodes around its peak and the tile size that fits the budget,
+ * and the intermediates of that chain only get room for a single tile in the layout.
+ */
+
+#ifndef EI_MEMORY_PLAN_MAX_TENSORS
+#define EI_MEMORY_PLAN_MAX_TENSORS         128
+#endif // EI_MEMORY_PLAN_MAX_TENSORS
+
+#ifndef EI_MEMORY_PLAN_MAX_SCRATCH
+#define EI_MEMORY_PLAN_MAX_SCRATCH         32
+#endif // EI_MEMORY_PLAN_MAX_SCRATCH
+
+/** Backing storage for a plan computed at runtime */
+typedef struct {
+    uint32_t tensor_offsets[EI_MEMORY_PLAN_MAX_TENSORS];
+    ei_scratch_buffer_plan_t scratch[EI_MEMORY_PLAN_MAX_SCRATCH];
+    ei_memory_plan_t plan;
+    size_t default_arena_size;  // arena size without the plan, for reporting
+    ei_patch_stage_t patch;     // tiled stage, patch.tile_rows is 0 when the plan runs untiled
+} ei_memory_plan_storage_t;
+
+/**
+ * Find the compiled graph of a learning block, or NULL if it does not support memory plans
+ */
+__attribute__((unused)) static const ei_config_tflite_eon_graph_t *ei_memory_plan_get_graph(
+    const ei_impulse_t *impulse,
+    uint32_t learn_block_index)
+{
+    if (learn_block_index >= impulse->learning_blocks_size) {
+        return NULL;
+    }
+    const ei_learning_block_config_tflite_graph_t *block_config =
+        (const ei_learning_block_config_tflite_graph_t *)impulse->learning_blocks[learn_block_index].config;
+    if (!block_config || !block_config->compiled) {
+        return NULL;
+    }
+    const ei_config_tflite_eon_graph_t *graph = (const ei_config_tflite_eon_graph_t *)block_config->graph_config;
+    if (!graph->model_tensor_lifetimes || !graph->model_scratch_requests ||
+        !graph->model_set_memory_plan || !graph->model_arena_size) {
+        return NULL;
+    }
+    return graph;
+}
+
+static inline int ei_memory_plan_align(size_t bytes) {
+    return (int)((bytes + 15) & ~(size_t)15);
+}
+
+/**
+ * Compute a joint layout of activations and scratch buffers. Runs init on the graph once
+ * (without a plan) to find out which scratch buffers the kernels on this target request.
+ *
+ * @param impulse The impulse (e.g. ei_default_impulse.impulse)
+ * @param learn_block_index Index of the EON learning block
+ * @param patch_budget Bytes the tiled stage may use (input, output and tiles), 0 to run untiled
+ * @param storage Output, storage->plan is the computed plan
+ * @return EI_IMPULSE_OK if successful
+ */
+__attribute__((unused)) static EI_IMPULSE_ERROR ei_memory_plan_compute(
+    const ei_impulse_t *impulse,
+    uint32_t learn_block_index,
+    size_t patch_budget,
+    ei_memory_plan_storage_t *storage)
+{
+    memset(storage, 0, sizeof(ei_memory_plan_storage_t));
+
+    const ei_config_tflite_eon_graph_t *graph = ei_memory_plan_get_graph(impulse, learn_block_index);
+    if (!graph) {
+        ei_printf("ERR: memory plans require a compiled (EON) graph that exports its layout\n");
+        return EI_IMPULSE_UNSUPPORTED_INFERENCING_ENGINE;
+    }
+    if (graph->model_set_memory_plan(NULL) != kTfLiteOk) {
+        return EI_IMPULSE_TFLITE_ERROR;
+    }
+    storage->default_arena_size = graph->model_arena_size();
+
+    // 1. record the scratch buffers and persistent memory the kernels ask for
+    TfLiteStatus init_status = graph->model_init(ei_aligned_calloc);
+    size_t persistent_bytes = 0;
+    size_t scratch_count = graph->model_scratch_requests(storage->scratch, EI_MEMORY_PLAN_MAX_SCRATCH, &persistent_bytes);
+    graph->model_reset(ei_aligned_free);
+    if (init_status != kTfLiteOk) {
+        ei_printf("ERR: failed to initialize the graph to record scratch buffers (%d)\n", init_status);
+        return EI_IMPULSE_TFLITE_ERROR;
+    }
+    if (scratch_count > EI_MEMORY_PLAN_MAX_SCRATCH) {
+        ei_printf("ERR: graph requests %d scratch buffers, increase EI_MEMORY_PLAN_MAX_SCRATCH\n", (int)scratch_count);
+        return EI_IMPULSE_OUT_OF_MEMORY;
+    }
+
+    size_t tensors_count = graph->model_tensor_lifetimes(NULL, 0);
+    if (tensors_count > EI_MEMORY_PLAN_MAX_TENSORS) {
+        ei_printf("ERR: graph has %d tensors, increase EI_MEMORY_PLAN_MAX_TENSORS\n", (int)tensors_count);
+        return EI_IMPULSE_OUT_OF_MEMORY;
+    }
+
+    ei_tensor_lifetime_t *lifetimes = (ei_tensor_lifetime_t *)ei_malloc(tensors_count * sizeof(ei_tensor_lifetime_t));
+    int *buffer_index = (int *)ei_malloc(tensors_count * sizeof(int));
+    size_t planner_bytes = tflite::GreedyMemoryPlanner::per_buffer_size() * (tensors_count + scratch_count);
+    unsigned char *planner_buffer = (unsigned char *)ei_malloc(planner_bytes);
+    if (!lifetimes || !buffer_index || !planner_buffer) {
+        ei_free(lifetimes);
+        ei_free(buffer_index);
+        ei_free(planner_buffer);
+        return EI_IMPULSE_OUT_OF_MEMORY;
+    }
+    graph->model_tensor_lifetimes(lifetimes, tensors_count);
+
+    // the tiles of a stage are interleaved, so everything in the stage is live while it runs
+    storage->patch.first_node = -1;
+    if (patch_budget > 0 && graph->model_patch_stage &&
+            graph->model_patch_stage(patch_budget, &storage->patch) == kTfLiteOk &&
+            storage->patch.tile_rows > 0) {
+        ei_patch_stage_t *stage = &storage->patch;
+        if (stage->tiled_bytes > patch_budget) {
+            ei_printf("WARN: patch stage needs %u bytes even with one row tiles, budget is %u\n",
+                (unsigned)stage->tiled_bytes, (unsigned)patch_budget);
+        }
+        int count = stage->last_node - stage->first_node + 1;
+        for (int k = -1; k < count; k++) {
+            ei_tensor_lifetime_t *l = &lifetimes[k < 0 ? stage->input_tensor : stage->tensors[k]];
+            if (l->first_node < 0 || l->first_node > stage->first_node) {
+                l->first_node = stage->first_node;
+            }
+            if (l->last_node < stage->last_node) {
+                l->last_node = stage->last_node;
+            }
+            if (k >= 0 && k < count - 1) {
+                l->bytes = stage->tile_bytes[k];
+            }
+        }
+    }
+    else {
+        storage->patch.tile_rows = 0;
+    }
+
+    // 2. activations live from the node that writes them until the last node that reads them,
+    //    scratch buffers only while their own node runs
+    EI_IMPULSE_ERROR res = EI_IMPULSE_OK;
+    tflite::GreedyMemoryPlanner planner;
+    planner.Init(planner_buffer, (int)planner_bytes);
+
+    for (size_t ix = 0; ix < tensors_count && res == EI_IMPULSE_OK; ix++) {
+        const ei_tensor_lifetime_t *l = &lifetimes[ix];
+        buffer_index[ix] = -1;
+        if (!l->in_arena || l->bytes == 0) {
+            continue;
+        }
+        int first_node = l->first_node < 0 ? 0 : l->first_node;
+        int last_node = l->last_node < 0 ? 0 : l->last_node;
+        buffer_index[ix] = planner.GetBufferCount();
+        if (planner.AddBuffer(ei_memory_plan_align(l->bytes), first_node, last_node) != kTfLiteOk) {
+            res = EI_IMPULSE_OUT_OF_MEMORY;
+        }
+    }
+    for (size_t ix = 0; ix < scratch_count && res == EI_IMPULSE_OK; ix++) {
+        int node = storage->scratch[ix].node < 0 ? 0 : storage->scratch[ix].node;
+        if (planner.AddBuffer(ei_memory_plan_align(storage->scratch[ix].bytes), node, node) != kTfLiteOk) {
+            res = EI_IMPULSE_OUT_OF_MEMORY;
+        }
+    }
+
+    // 3. read back the offsets
+    int scratch_base = planner.GetBufferCount() - (int)scratch_count;
+    for (size_t ix = 0; ix < tensors_count && res == EI_IMPULSE_OK; ix++) {
+        int offset = 0;
+        if (buffer_index[ix] >= 0 && planner.GetOffsetForBuffer(buffer_index[ix], &offset) != kTfLiteOk) {
+            res = EI_IMPULSE_TFLITE_ERROR;
+        }
+        storage->tensor_offsets[ix] = (uint32_t)offset;
+    }
+    for (size_t ix = 0; ix < scratch_count && res == EI_IMPULSE_OK; ix++) {
+        int offset = 0;
+        if (planner.GetOffsetForBuffer(scratch_base + (int)ix, &offset) != kTfLiteOk) {
+            res = EI_IMPULSE_TFLITE_ERROR;
+        }
+        storage->scratch[ix].offset = (uint32_t)offset;
+    }
+
+    if (res == EI_IMPULSE_OK) {
+        storage->plan.tensor_offsets = storage->tensor_offsets;
+        storage->plan.tensors_count = tensors_count;
+        storage->plan.scratch = storage->scratch;
+        storage->plan.scratch_count = scratch_count;
+        storage->plan.planned_bytes = planner.GetMaximumMemorySize();
+        storage->plan.persistent_bytes = persistent_bytes;
+        storage->plan.patch_tile_rows = storage->patch.tile_rows;
+    }
+    else {
+        ei_printf("ERR: failed to compute memory plan (%d)\n", res);
+    }
+
+    ei_free(lifetimes);
+    ei_free(buffer_index);
+    ei_free(planner_buffer);
+    return res;
+}
+
+/**
+ * Make the graph use a plan from the next inference on. Apply before ei_memory_placement_apply.
+ * @param plan The plan, or NULL to go back to the built-in layout
+ */
+__attribute__((unused)) static EI_IMPULSE_ERROR ei_memory_plan_apply(
+    const ei_impulse_t *impulse,
+    uint32_t learn_block_index,
+    const ei_memory_plan_t *plan)
+{
+    const ei_config_tflite_eon_graph_t *graph = ei_memory_plan_get_graph(impulse, learn_block_index);
+    if (!graph) {
+        return EI_IMPULSE_UNSUPPORTED_INFERENCING_ENGINE;
+    }
+    if (graph->model_set_memory_plan(plan) != kTfLiteOk) {
+        return EI_IMPULSE_TFLITE_ARENA_ALLOC_FAILED;
+    }
+    return EI_IMPULSE_OK;
+}
+
+/**
+ * The plan compiled into the graph with EI_CLASSIFIER_TFLITE_MEMORY_PLAN=1, or NULL
+ */
+__attribute__((unused)) static const ei_memory_plan_t *ei_memory_plan_compiled(
+    const ei_impulse_t *impulse,
+    uint32_t learn_block_index)
+{
+    const ei_config_tflite_eon_graph_t *graph = ei_memory_plan_get_graph(impulse, learn_block_index);
+    if (!graph || !graph->model_compiled_memory_plan) {
+        return NULL;
+    }
+    return graph->model_compiled_memory_plan();
+}
+
+/**
+ * Check that a plan computed elsewhere (e.g. offline, see ei_memory_plan_compiled()) fits the
+ * kernels of this build, and apply it if it does. Runs init on the graph once without a plan,
+ * like ei_memory_plan_compute(), and compares the scratch buffers and persistent memory the
+ * kernels ask for with the room the plan has for them. If the plan does not fit, the graph
+ * is left on its built-in layout.
+ */
+__attribute__((unused)) static EI_IMPULSE_ERROR ei_memory_plan_check(
+    const ei_impulse_t *impulse,
+    uint32_t learn_block_index,
+    const ei_memory_plan_t *plan)
+{
+    const ei_config_tflite_eon_graph_t *graph = ei_memory_plan_get_graph(impulse, learn_block_index);
+    if (!graph || !plan) {
+        return EI_IMPULSE_UNSUPPORTED_INFERENCING_ENGINE;
+    }
+    if (graph->model_set_memory_plan(NULL) != kTfLiteOk) {
+        return EI_IMPULSE_TFLITE_ERROR;
+    }
+
+    ei_scratch_buffer_plan_t requests[EI_MEMORY_PLAN_MAX_SCRATCH];
+    TfLiteStatus init_status = graph->model_init(ei_aligned_calloc);
+    size_t persistent_bytes = 0;
+    size_t scratch_count = graph->model_scratch_requests(requests, EI_MEMORY_PLAN_MAX_SCRATCH, &persistent_bytes);
+    graph->model_reset(ei_aligned_free);
+    if (init_status != kTfLiteOk) {
+        ei_printf("ERR: failed to initialize the graph to record scratch buffers (%d)\n", init_status);
+        return EI_IMPULSE_TFLITE_ERROR;
+    }
+
+    if (scratch_count != plan->scratch_count || scratch_count > EI_MEMORY_PLAN_MAX_SCRATCH) {
+        ei_printf("WARN: kernels request %d scratch buffers, memory plan has %d\n",
+            (int)scratch_count, (int)plan->scratch_count);
+        return EI_IMPULSE_TFLITE_ARENA_ALLOC_FAILED;
+    }
+    for (size_t ix = 0; ix < scratch_count; ix++) {
+        if (requests[ix].node != plan->scratch[ix].node || requests[ix].bytes > plan->scratch[ix].bytes) {
+            ei_printf("WARN: scratch buffer %d (node %d, %u bytes) does not fit memory plan (node %d, %u bytes)\n",
+                (int)ix, (int)requests[ix].node, (unsigned)requests[ix].bytes,
+                (int)plan->scratch[ix].node, (unsigned)plan->scratch[ix].bytes);
+            return EI_IMPULSE_TFLITE_ARENA_ALLOC_FAILED;
+        }
+    }
+    if (persistent_bytes > plan->persistent_bytes) {
+        ei_printf("WARN: kernels need %u bytes persistent memory, memory plan has %u\n",
+            (unsigned)persistent_bytes, (unsigned)plan->persistent_bytes);
+        return EI_IMPULSE_TFLITE_ARENA_ALLOC_FAILED;
+    }
+
+    return ei_memory_plan_apply(impulse, learn_block_index, plan);
+}
+
+__attribute__((unused)) static void ei_memory_plan_print(const ei_memory_plan_storage_t *storage) {
+    const ei_memory_plan_t *plan = &storage->plan;
+    size_t arena_size = plan->planned_bytes + plan->persistent_bytes;
+    ei_printf("Memory plan: %u bytes activations + scratch, %u bytes persistent, arena %u bytes (was %u)\n",
+        (unsigned)plan->planned_bytes, (unsigned)plan->persistent_bytes,
+        (unsigned)arena_size, (unsigned)storage->default_arena_size);
+    if (plan->patch_tile_rows > 0) {
+        const ei_patch_stage_t *stage = &storage->patch;
+        ei_printf("    patch stage: nodes %d-%d, %d tiles of %u rows, %u bytes (was %u)\n",
+            (int)stage->first_node, (int)stage->last_node,
+            (int)((stage->out_height + stage->tile_rows - 1) / stage->tile_rows), (unsigned)stage->tile_rows,
+            (unsigned)stage->tiled_bytes, (unsigned)stage->untiled_bytes);
+    }
+    for (size_t ix = 0; ix < plan->scratch_count; ix++) {
+        ei_printf("    scratch %d: node %d, %u bytes at offset %u\n", (int)ix, (int)plan->scratch[ix].node,
+            (unsigned)plan->scratch[ix].bytes, (unsigned)plan->scratch[ix].offset);
+    }
+}
+
+/**
+ * Print the plan as C source, save it as tflite-model/<model_name>_memory_plan.h and
+ * build with EI_CLASSIFIER_TFLITE_MEMORY_PLAN=1 to have the model use it from the start
+ * @param model_name Prefix of the compiled model, e.g. "tflite_learn_891896_6"
+ */
+__attribute__((unused)) static void ei_memory_plan_print_source(const ei_memory_plan_t *plan, const char *model_name) {
+    ei_printf("// Memory plan for %s, generated by ei_memory_plan_print_source()\n", model_name);
+    ei_printf("// activations + scratch: %u bytes, persistent: %u bytes\n",
+        (unsigned)plan->planned_bytes, (unsigned)plan->persistent_bytes);
+    ei_printf("#pragma once\n\n");
+    ei_printf("#include \"edge-impulse-sdk/classifier/ei_arena_types.h\"\n\n");
+
+    ei_printf("static const uint32_t %s_plan_tensor_offsets[%u] = {", model_name, (unsigned)plan->tensors_count);
+    for (size_t ix = 0; ix < plan->tensors_count; ix++) {
+        ei_printf("%s%u,", (ix % 12 == 0) ? "\n  " : " ", (unsigned)plan->tensor_offsets[ix]);
+    }
+    ei_printf("\n};\n\n");
+
+    // zero-length arrays are not portable, always emit at least one entry
+    ei_printf("static const ei_scratch_buffer_plan_t %s_plan_scratch[%u] = {\n", model_name,
+        (unsigned)(plan->scratch_count > 0 ? plan->scratch_count : 1));
+    for (size_t ix = 0; ix < plan->scratch_count; ix++) {
+        ei_printf("  { %d, %u, %u },\n", (int)plan->scratch[ix].node,
+            (unsigned)plan->scratch[ix].bytes, (unsigned)plan->scratch[ix].offset);
+    }
+    if (plan->scratch_count == 0) {
+        ei_printf("  { -1, 0, 0 },\n");
+    }
+    ei_printf("};\n\n");
+
+    ei_printf("static const ei_memory_plan_t %s_memory_plan = {\n", model_name);
+    ei_printf("  %s_plan_tensor_offsets, %u,\n", model_name, (unsigned)plan->tensors_count);
+    ei_printf("  %s_plan_scratch, %u,\n", model_name, (unsigned)plan->scratch_count);
+    ei_printf("  %u, %u,\n", (unsigned)plan->planned_bytes, (unsigned)plan->persistent_bytes);
+    ei_printf("  %u\n", (unsigned)plan->patch_tile_rows);
+    ei_printf("};\n");
+}
+
+#endif // _EI_CLASSIFIER_MEMORY_PLAN_H_
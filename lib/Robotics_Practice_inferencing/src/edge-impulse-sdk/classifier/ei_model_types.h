@@ -40,6 +40,7 @@
 #include "edge-impulse-sdk/classifier/ei_classifier_types.h"
 #include "edge-impulse-sdk/dsp/ei_dsp_handle.h"
 #include "edge-impulse-sdk/dsp/numpy.hpp"
+#include "edge-impulse-sdk/classifier/ei_arena_types.h"
 #if EI_CLASSIFIER_USE_FULL_TFLITE || (EI_CLASSIFIER_INFERENCING_ENGINE == EI_CLASSIFIER_AKIDA) || (EI_CLASSIFIER_INFERENCING_ENGINE == EI_CLASSIFIER_MEMRYX)
 #include "tensorflow-lite/tensorflow/lite/c/common.h"
 #else
@@ -305,6 +306,23 @@ typedef struct {
     TfLiteStatus (*model_reset)(void (*free)(void* ptr));
     TfLiteStatus (*model_input)(int, TfLiteTensor*);
     TfLiteStatus (*model_output)(int, TfLiteTensor*);
+    // optional, NULL on graphs that don't expose their memory layout
+    size_t (*model_tensor_lifetimes)(ei_tensor_lifetime_t *lifetimes, size_t max_count);
+    TfLiteStatus (*model_set_arena_regions)(const ei_arena_region_t *regions, size_t regions_count,
+        uint8_t *persistent, size_t persistent_bytes);
+    size_t (*model_scratch_requests)(ei_scratch_buffer_plan_t *requests, size_t max_count, size_t *persistent_bytes);
+    TfLiteStatus (*model_set_memory_plan)(const ei_memory_plan_t *plan);
+    size_t (*model_arena_size)();
+    TfLiteStatus (*model_patch_stage)(size_t budget_bytes, ei_patch_stage_t *stage);
+    // optional, NULL on graphs that don't end in a softmax the post-processing can take over
+    TfLiteStatus (*model_skip_final_softmax)(bool skip);
+    // optional, NULL on graphs that can't read their constant tensors from a weights blob
+    size_t (*model_weights)(ei_weights_tensor_t *tensors, size_t max_count);
+    TfLiteStatus (*model_set_weights)(const ei_weights_tensor_t *tensors, size_t count);
+    // optional, NULL on graphs that can't hand out intermediate activations
+    TfLiteStatus (*model_set_tap)(int node, ei_tensor_tap_fn fn, void *ctx);
+    // optional, returns NULL on graphs built without a compiled-in memory plan
+    const ei_memory_plan_t *(*model_compiled_memory_plan)();
 } ei_config_tflite_eon_graph_t;
 
 typedef struct {
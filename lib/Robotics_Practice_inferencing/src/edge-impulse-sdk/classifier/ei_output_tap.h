@@ -0,0 +1,58 @@
+/* The Clear BSD License
+ *
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _EI_CLASSIFIER_OUTPUT_TAP_H_
+#define _EI_CLASSIFIER_OUTPUT_TAP_H_
+
+#include <stdint.h>
+#include "edge-impulse-sdk/classifier/ei_arena_types.h"
+
+/**
+ * Observer of the output tensors of every run, e.g. to check them byte for byte against stored
+ * goldens before an optimised kernel ships. Called after invoke with each output as the graph
+ * produced it (the bytes result->_raw_outputs gets, unless the block dequantizes them); the data
+ * is valid only during the call. `node` of the tap is -1, `tensor` the output index.
+ */
+typedef void (*ei_output_tap_fn)(uint32_t learn_block_index, const ei_tensor_tap_t *output, void *ctx);
+
+// one observer for the whole program, defined in ei_output_tap.cpp
+extern ei_output_tap_fn ei_output_tap;
+extern void *ei_output_tap_ctx;
+
+/**
+ * Set (or with NULL clear) the output tensor observer, see ei_output_tap_fn
+ */
+void ei_set_output_tap(ei_output_tap_fn fn, void *ctx);
+
+#endif // _EI_CLASSIFIER_OUTPUT_TAP_H_
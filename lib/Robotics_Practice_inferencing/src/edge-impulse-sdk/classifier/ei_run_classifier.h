@@ -103,6 +103,10 @@ namespace {
 /* Function prototypes ----------------------------------------------------- */
 extern "C" EI_IMPULSE_ERROR run_inference(ei_impulse_handle_t *handle, ei_feature_t *fmatrix, ei_impulse_result_t *result, bool debug);
 extern "C" EI_IMPULSE_ERROR run_classifier_image_quantized(const ei_impulse_t *impulse, signal_t *signal, ei_impulse_result_t *result, bool debug);
+#if EIDSP_SIGNAL_C_FN_POINTER == 0 && !defined(__MBED__)
+template<typename Source>
+EI_IMPULSE_ERROR run_classifier_image_quantized(const ei_impulse_t *impulse, const ei::signal_view<Source> *signal, ei_impulse_result_t *result, bool debug);
+#endif // EIDSP_SIGNAL_C_FN_POINTER == 0 && !defined(__MBED__)
 static EI_IMPULSE_ERROR can_run_classifier_image_quantized(const ei_impulse_t *impulse, ei_learning_block_t block_ptr);
 static void ei_result_struct_timing_us_to_ms(ei_impulse_result_t *result);
 
@@ -196,21 +200,25 @@ extern "C" EI_IMPULSE_ERROR run_inference(
     return EI_IMPULSE_OK;
 }
 
-/**
- * @brief      Process a complete impulse
- *
- * @param      impulse  struct with information about model and DSP
- * @param      signal   Sample data
- * @param      result   Output classifier results
- * @param      handle   Handle from open_impulse. nullptr for backward compatibility
- * @param[in]  debug    Debug output enable
- *
- * @return     The ei impulse error.
- */
-extern "C" EI_IMPULSE_ERROR process_impulse(ei_impulse_handle_t *handle,
-                                            signal_t *signal,
-                                            ei_impulse_result_t *result,
-                                            bool debug = false)
+// The DSP blocks (other than the quantized image shortcut) read their input through signal_t
+static inline signal_t *process_impulse_dsp_signal(signal_t *signal, signal_t *storage) {
+    return signal;
+}
+
+#if EIDSP_SIGNAL_C_FN_POINTER == 0 && !defined(__MBED__)
+template<typename Source>
+static inline signal_t *process_impulse_dsp_signal(const ei::signal_view<Source> *signal, signal_t *storage) {
+    *storage = signal->to_signal();
+    return storage;
+}
+#endif // EIDSP_SIGNAL_C_FN_POINTER == 0 && !defined(__MBED__)
+
+// Body of process_impulse, for signal_t and for signal_view
+template<typename Signal>
+static EI_IMPULSE_ERROR process_impulse_impl(ei_impulse_handle_t *handle,
+                                             Signal *signal,
+                                             ei_impulse_result_t *result,
+                                             bool debug)
 {
     if ((handle == nullptr) || (handle->impulse  == nullptr) || (result  == nullptr) || (signal  == nullptr)) {
         return EI_IMPULSE_INFERENCE_ERROR;
@@ -305,6 +313,9 @@ extern "C" EI_IMPULSE_ERROR process_impulse(ei_impulse_handle_t *handle,
 
     size_t out_features_index = 0;
 
+    signal_t dsp_signal_storage;
+    signal_t *dsp_signal = process_impulse_dsp_signal(signal, &dsp_signal_storage);
+
     for (size_t ix = 0; ix < handle->impulse->dsp_blocks_size; ix++) {
         ei_model_dsp_t block = handle->impulse->dsp_blocks[ix];
 
@@ -333,9 +344,9 @@ extern "C" EI_IMPULSE_ERROR process_impulse(ei_impulse_handle_t *handle,
             ei_printf("ERR: EIDSP_SIGNAL_C_FN_POINTER can only be used when all axes are selected for DSP blocks\n");
             return EI_IMPULSE_DSP_ERROR;
         }
-        auto internal_signal = signal;
+        auto internal_signal = dsp_signal;
 #else
-        SignalWithAxes swa(signal, block.axes, block.axes_size, handle->impulse);
+        SignalWithAxes swa(dsp_signal, block.axes, block.axes_size, handle->impulse);
         auto internal_signal = swa.get_signal();
 #endif
 
@@ -426,6 +437,25 @@ extern "C" EI_IMPULSE_ERROR process_impulse(ei_impulse_handle_t *handle,
 #endif
 }
 
+/**
+ * @brief      Process a complete impulse
+ *
+ * @param      impulse  struct with information about model and DSP
+ * @param      signal   Sample data
+ * @param      result   Output classifier results
+ * @param      handle   Handle from open_impulse. nullptr for backward compatibility
+ * @param[in]  debug    Debug output enable
+ *
+ * @return     The ei impulse error.
+ */
+extern "C" EI_IMPULSE_ERROR process_impulse(ei_impulse_handle_t *handle,
+                                            signal_t *signal,
+                                            ei_impulse_result_t *result,
+                                            bool debug = false)
+{
+    return process_impulse_impl(handle, signal, result, debug);
+}
+
 /**
  * @brief      Opens an impulse
  *
@@ -689,7 +719,7 @@ __attribute__((unused)) static EI_IMPULSE_ERROR can_run_classifier_image_quantiz
     }
 
     // And if we have one DSP block which operates on images...
-    if (impulse->dsp_blocks_size != 1 || impulse->dsp_blocks[0].extract_fn != extract_image_features) {
+    if (impulse->dsp_blocks_size != 1 || impulse->dsp_blocks[0].extract_fn != (extract_fn_t)extract_image_features) {
         return EI_IMPULSE_ONLY_SUPPORTED_FOR_IMAGES;
     }
 
@@ -712,6 +742,27 @@ extern "C" EI_IMPULSE_ERROR run_classifier_image_quantized(
     return run_nn_inference_image_quantized(impulse, signal, 0, result, impulse->learning_blocks[0].config, debug);
 }
 
+#if EIDSP_SIGNAL_C_FN_POINTER == 0 && !defined(__MBED__)
+/**
+ * run_classifier_image_quantized over a signal_view. The EON engine reads the source
+ * straight into the input tensor, other engines go through a signal_t.
+ */
+template<typename Source>
+EI_IMPULSE_ERROR run_classifier_image_quantized(
+    const ei_impulse_t *impulse,
+    const ei::signal_view<Source> *signal,
+    ei_impulse_result_t *result,
+    bool debug)
+{
+#if (EI_CLASSIFIER_INFERENCING_ENGINE == EI_CLASSIFIER_TFLITE) && (EI_CLASSIFIER_COMPILED == 1)
+    return run_nn_inference_image_quantized(impulse, signal, 0, result, impulse->learning_blocks[0].config, debug);
+#else
+    signal_t legacy_signal = signal->to_signal();
+    return run_classifier_image_quantized(impulse, &legacy_signal, result, debug);
+#endif
+}
+#endif // EIDSP_SIGNAL_C_FN_POINTER == 0 && !defined(__MBED__)
+
 #endif // #if EI_CLASSIFIER_QUANTIZATION_ENABLED == 1 && (EI_CLASSIFIER_INFERENCING_ENGINE == EI_CLASSIFIER_TFLITE || EI_CLASSIFIER_INFERENCING_ENGINE == EI_CLASSIFIER_TENSAIFLOW || EI_CLASSIFIER_INFERENCING_ENGINE == EI_CLASSIFIER_DRPAI)
 
 #if EI_CLASSIFIER_LOAD_IMAGE_SCALING
@@ -1100,6 +1151,48 @@ __attribute__((unused)) EI_IMPULSE_ERROR run_classifier(
     return process_impulse(impulse, signal, result, debug);
 }
 
+#if EIDSP_SIGNAL_C_FN_POINTER == 0 && !defined(__MBED__)
+/**
+ * @brief Run the classifier over a typed signal view.
+ *
+ * Same as `run_classifier()`, but the source type is known at compile time (see
+ * `ei::signal_view` in dsp/ei_signal_view.h). For quantized image models on the EON engine the
+ * pixels are read straight from the source into the input tensor, without get_data calls.
+ * Every other impulse runs as with a `signal_t`.
+ *
+ * @param[in] impulse Pointer to an `ei_impulse_handle_t` struct that contains the model and
+ *  preprocessing information.
+ * @param[in] signal Pointer to a `signal_view` over the raw features.
+ * @param[out] result  Pointer to an ei_impulse_result_t struct that will contain the various output
+ *  results from inference after `run_classifier()` returns.
+ * @param[in] debug Print internal preprocessing and inference debugging information via `ei_printf()`.
+ *
+ * @return Error code as defined by `EI_IMPULSE_ERROR` enum. Will be `EI_IMPULSE_OK` if inference
+ *  completed successfully.
+ */
+template<typename Source>
+__attribute__((unused)) EI_IMPULSE_ERROR run_classifier(
+    ei_impulse_handle_t *impulse,
+    const ei::signal_view<Source> *signal,
+    ei_impulse_result_t *result,
+    bool debug = false)
+{
+    return process_impulse_impl(impulse, signal, result, debug);
+}
+
+/**
+ * @brief Run the default impulse over a typed signal view, see the overload above.
+ */
+template<typename Source>
+__attribute__((unused)) EI_IMPULSE_ERROR run_classifier(
+    const ei::signal_view<Source> *signal,
+    ei_impulse_result_t *result,
+    bool debug = false)
+{
+    return process_impulse_impl(&ei_default_impulse, signal, result, debug);
+}
+#endif // EIDSP_SIGNAL_C_FN_POINTER == 0 && !defined(__MBED__)
+
 #if EI_CLASSIFIER_FREEFORM_OUTPUT
 /**
  * Set the location for freeform outputs. For impulses with freeform output the application needs to allocate
@@ -39,6 +39,7 @@
 #include "edge-impulse-sdk/dsp/spectral/spectral.hpp"
 #include "edge-impulse-sdk/dsp/speechpy/speechpy.hpp"
 #include "edge-impulse-sdk/classifier/ei_signal_with_range.h"
+#include "edge-impulse-sdk/dsp/ei_signal_view.h"
 #include "edge-impulse-sdk/dsp/ei_flatten.h"
 #include "model-parameters/model_metadata.h"
 
@@ -1141,6 +1142,34 @@ __attribute__((unused)) int extract_mfe_per_slice_features(signal_t *signal, mat
 #endif
 }
 
+// Image features for `count` pixels of a source, shared by the signal_t and signal_view entry points
+template<typename Source>
+static void image_features_from_source(const Source &source, size_t count, float *out, int16_t channel_count) {
+    if (channel_count == 3) {
+        for (size_t ix = 0; ix < count; ix++) {
+            uint32_t pixel = source.pixel(ix);
+
+            // rgb to 0..1
+            *out++ = static_cast<float>(pixel >> 16 & 0xff) / 255.0f;
+            *out++ = static_cast<float>(pixel >> 8 & 0xff) / 255.0f;
+            *out++ = static_cast<float>(pixel & 0xff) / 255.0f;
+        }
+    }
+    else {
+        for (size_t ix = 0; ix < count; ix++) {
+            uint32_t pixel = source.pixel(ix);
+
+            float r = static_cast<float>(pixel >> 16 & 0xff) / 255.0f;
+            float g = static_cast<float>(pixel >> 8 & 0xff) / 255.0f;
+            float b = static_cast<float>(pixel & 0xff) / 255.0f;
+
+            // ITU-R 601-2 luma transform
+            // see: https://pillow.readthedocs.io/en/stable/reference/Image.html#PIL.Image.Image.convert
+            *out++ = (0.299f * r) + (0.587f * g) + (0.114f * b);
+        }
+    }
+}
+
 __attribute__((unused)) int extract_image_features(signal_t *signal, matrix_t *output_matrix, void *config_ptr, const float frequency) {
     ei_dsp_config_image_t config = *((ei_dsp_config_image_t*)config_ptr);
 
@@ -1169,26 +1198,9 @@ __attribute__((unused)) int extract_image_features(signal_t *signal, matrix_t *o
         }
         signal->get_data(ix, elements_to_read, input_matrix.buffer);
 
-        for (size_t jx = 0; jx < elements_to_read; jx++) {
-            uint32_t pixel = static_cast<uint32_t>(input_matrix.buffer[jx]);
-
-            // rgb to 0..1
-            float r = static_cast<float>(pixel >> 16 & 0xff) / 255.0f;
-            float g = static_cast<float>(pixel >> 8 & 0xff) / 255.0f;
-            float b = static_cast<float>(pixel & 0xff) / 255.0f;
-
-            if (channel_count == 3) {
-                output_matrix->buffer[output_ix++] = r;
-                output_matrix->buffer[output_ix++] = g;
-                output_matrix->buffer[output_ix++] = b;
-            }
-            else {
-                // ITU-R 601-2 luma transform
-                // see: https://pillow.readthedocs.io/en/stable/reference/Image.html#PIL.Image.Image.convert
-                float v = (0.299f * r) + (0.587f * g) + (0.114f * b);
-                output_matrix->buffer[output_ix++] = v;
-            }
-        }
+        image_features_from_source(signal_source_float{ input_matrix.buffer }, elements_to_read,
+            output_matrix->buffer + output_ix, channel_count);
+        output_ix += elements_to_read * channel_count;
 
         bytes_left -= elements_to_read;
     }
@@ -1196,6 +1208,21 @@ __attribute__((unused)) int extract_image_features(signal_t *signal, matrix_t *o
     return EIDSP_OK;
 }
 
+/**
+ * extract_image_features over a signal_view, the source is read in place (no pages, no
+ * get_data calls).
+ */
+template<typename Source>
+__attribute__((unused)) int extract_image_features(const signal_view<Source> *signal, matrix_t *output_matrix, void *config_ptr, const float frequency) {
+    ei_dsp_config_image_t config = *((ei_dsp_config_image_t*)config_ptr);
+
+    int16_t channel_count = strcmp(config.channels, "Grayscale") == 0 ? 1 : 3;
+
+    image_features_from_source(signal->source, signal->total_length, output_matrix->buffer, channel_count);
+
+    return EIDSP_OK;
+}
+
 #if (EI_CLASSIFIER_QUANTIZATION_ENABLED == 1) && (EI_CLASSIFIER_INFERENCING_ENGINE == EI_CLASSIFIER_DRPAI)
 
 /*
@@ -1262,6 +1289,95 @@ __attribute__((unused)) int extract_drpai_features_quantized(signal_t *signal, m
 
 #if (EI_CLASSIFIER_QUANTIZATION_ENABLED == 1) && (EI_CLASSIFIER_INFERENCING_ENGINE != EI_CLASSIFIER_DRPAI)
 
+// Quantized image features for `count` pixels of a source, shared by the signal_t and signal_view
+// entry points. The choice of code path is made once, so each loop runs without branches.
+template<typename Source>
+static void image_features_quantized_from_source(const Source &source, size_t count, int8_t *out, int16_t channel_count,
+                                                 float scale, float zero_point, int image_scaling) {
+    const int32_t iRedToGray = (int32_t)(0.299f * 65536.0f);
+    const int32_t iGreenToGray = (int32_t)(0.587f * 65536.0f);
+    const int32_t iBlueToGray = (int32_t)(0.114f * 65536.0f);
+
+    static const float torch_mean[] = { 0.485, 0.456, 0.406 };
+    static const float torch_std[] = { 0.229, 0.224, 0.225 };
+
+    // fast code path
+    if (scale == 0.003921568859368563f && zero_point == -128 && image_scaling == EI_CLASSIFIER_IMAGE_SCALING_NONE) {
+        const int32_t zp = static_cast<int32_t>(zero_point);
+
+        if (channel_count == 3) {
+            for (size_t ix = 0; ix < count; ix++) {
+                uint32_t pixel = source.pixel(ix);
+                int32_t r = static_cast<int32_t>(pixel >> 16 & 0xff);
+                int32_t g = static_cast<int32_t>(pixel >> 8 & 0xff);
+                int32_t b = static_cast<int32_t>(pixel & 0xff);
+
+                *out++ = static_cast<int8_t>(r + zp);
+                *out++ = static_cast<int8_t>(g + zp);
+                *out++ = static_cast<int8_t>(b + zp);
+            }
+        }
+        else {
+            for (size_t ix = 0; ix < count; ix++) {
+                uint32_t pixel = source.pixel(ix);
+                int32_t r = static_cast<int32_t>(pixel >> 16 & 0xff);
+                int32_t g = static_cast<int32_t>(pixel >> 8 & 0xff);
+                int32_t b = static_cast<int32_t>(pixel & 0xff);
+
+                // ITU-R 601-2 luma transform
+                // see: https://pillow.readthedocs.io/en/stable/reference/Image.html#PIL.Image.Image.convert
+                int32_t gray = (iRedToGray * r) + (iGreenToGray * g) + (iBlueToGray * b);
+                gray >>= 16; // scale down to int8_t
+                gray += zp;
+                if (gray < - 128) gray = -128;
+                else if (gray > 127) gray = 127;
+                *out++ = static_cast<int8_t>(gray);
+            }
+        }
+        return;
+    }
+
+    // slow code path
+    for (size_t ix = 0; ix < count; ix++) {
+        uint32_t pixel = source.pixel(ix);
+        float r = static_cast<float>(pixel >> 16 & 0xff);
+        float g = static_cast<float>(pixel >> 8 & 0xff);
+        float b = static_cast<float>(pixel & 0xff);
+
+        if (image_scaling == EI_CLASSIFIER_IMAGE_SCALING_NONE) {
+            r /= 255.0f;
+            g /= 255.0f;
+            b /= 255.0f;
+        }
+        else if (image_scaling == EI_CLASSIFIER_IMAGE_SCALING_TORCH) {
+            r /= 255.0f;
+            g /= 255.0f;
+            b /= 255.0f;
+
+            r = (r - torch_mean[0]) / torch_std[0];
+            g = (g - torch_mean[1]) / torch_std[1];
+            b = (b - torch_mean[2]) / torch_std[2];
+        }
+        else if (image_scaling == EI_CLASSIFIER_IMAGE_SCALING_MIN128_127) {
+            r -= 128.0f;
+            g -= 128.0f;
+            b -= 128.0f;
+        }
+
+        if (channel_count == 3) {
+            *out++ = static_cast<int8_t>(round(r / scale) + zero_point);
+            *out++ = static_cast<int8_t>(round(g / scale) + zero_point);
+            *out++ = static_cast<int8_t>(round(b / scale) + zero_point);
+        }
+        else {
+            // ITU-R 601-2 luma transform
+            // see: https://pillow.readthedocs.io/en/stable/reference/Image.html#PIL.Image.Image.convert
+            float v = (0.299f * r) + (0.587f * g) + (0.114f * b);
+            *out++ = static_cast<int8_t>(round(v / scale) + zero_point);
+        }
+    }
+}
+
 __attribute__((unused)) int extract_image_features_quantized(signal_t *signal, matrix_i8_t *output_matrix, void *config_ptr, float scale, float zero_point, const float frequency,
                                                              int image_scaling) {
     ei_dsp_config_image_t config = *((ei_dsp_config_image_t*)config_ptr);
@@ -1270,13 +1386,6 @@ __attribute__((unused)) int extract_image_features_quantized(signal_t *signal, m
 
     size_t output_ix = 0;
 
-    const int32_t iRedToGray = (int32_t)(0.299f * 65536.0f);
-    const int32_t iGreenToGray = (int32_t)(0.587f * 65536.0f);
-    const int32_t iBlueToGray = (int32_t)(0.114f * 65536.0f);
-
-    static const float torch_mean[] = { 0.485, 0.456, 0.406 };
-    static const float torch_std[] = { 0.229, 0.224, 0.225 };
-
 #if defined(EI_DSP_IMAGE_BUFFER_STATIC_SIZE)
     const size_t page_size = EI_DSP_IMAGE_BUFFER_STATIC_SIZE;
 #else
@@ -1298,106 +1407,55 @@ __attribute__((unused)) int extract_image_features_quantized(signal_t *signal, m
         }
         signal->get_data(ix, elements_to_read, input_matrix.buffer);
 
-        for (size_t jx = 0; jx < elements_to_read; jx++) {
-            uint32_t pixel = static_cast<uint32_t>(input_matrix.buffer[jx]);
-
-            if (channel_count == 3) {
-                // fast code path
-                if (scale == 0.003921568859368563f && zero_point == -128 && image_scaling == EI_CLASSIFIER_IMAGE_SCALING_NONE) {
-                    int32_t r = static_cast<int32_t>(pixel >> 16 & 0xff);
-                    int32_t g = static_cast<int32_t>(pixel >> 8 & 0xff);
-                    int32_t b = static_cast<int32_t>(pixel & 0xff);
-
-                    output_matrix->buffer[output_ix++] = static_cast<int8_t>(r + zero_point);
-                    output_matrix->buffer[output_ix++] = static_cast<int8_t>(g + zero_point);
-                    output_matrix->buffer[output_ix++] = static_cast<int8_t>(b + zero_point);
-                }
-                // slow code path
-                else {
-                    float r = static_cast<float>(pixel >> 16 & 0xff);
-                    float g = static_cast<float>(pixel >> 8 & 0xff);
-                    float b = static_cast<float>(pixel & 0xff);
-
-                    if (image_scaling == EI_CLASSIFIER_IMAGE_SCALING_NONE) {
-                        r /= 255.0f;
-                        g /= 255.0f;
-                        b /= 255.0f;
-                    }
-                    else if (image_scaling == EI_CLASSIFIER_IMAGE_SCALING_TORCH) {
-                        r /= 255.0f;
-                        g /= 255.0f;
-                        b /= 255.0f;
-
-                        r = (r - torch_mean[0]) / torch_std[0];
-                        g = (g - torch_mean[1]) / torch_std[1];
-                        b = (b - torch_mean[2]) / torch_std[2];
-                    }
-                    else if (image_scaling == EI_CLASSIFIER_IMAGE_SCALING_MIN128_127) {
-                        r -= 128.0f;
-                        g -= 128.0f;
-                        b -= 128.0f;
-                    }
-
-                    output_matrix->buffer[output_ix++] = static_cast<int8_t>(round(r / scale) + zero_point);
-                    output_matrix->buffer[output_ix++] = static_cast<int8_t>(round(g / scale) + zero_point);
-                    output_matrix->buffer[output_ix++] = static_cast<int8_t>(round(b / scale) + zero_point);
-                }
-            }
-            else {
-                // fast code path
-                if (scale == 0.003921568859368563f && zero_point == -128 && image_scaling == EI_CLASSIFIER_IMAGE_SCALING_NONE) {
-                    int32_t r = static_cast<int32_t>(pixel >> 16 & 0xff);
-                    int32_t g = static_cast<int32_t>(pixel >> 8 & 0xff);
-                    int32_t b = static_cast<int32_t>(pixel & 0xff);
-
-                    // ITU-R 601-2 luma transform
-                    // see: https://pillow.readthedocs.io/en/stable/reference/Image.html#PIL.Image.Image.convert
-                    int32_t gray = (iRedToGray * r) + (iGreenToGray * g) + (iBlueToGray * b);
-                    gray >>= 16; // scale down to int8_t
-                    gray += zero_point;
-                    if (gray < - 128) gray = -128;
-                    else if (gray > 127) gray = 127;
-                    output_matrix->buffer[output_ix++] = static_cast<int8_t>(gray);
-                }
-                // slow code path
-                else {
-                    float r = static_cast<float>(pixel >> 16 & 0xff);
-                    float g = static_cast<float>(pixel >> 8 & 0xff);
-                    float b = static_cast<float>(pixel & 0xff);
-
-                    if (image_scaling == EI_CLASSIFIER_IMAGE_SCALING_NONE) {
-                        r /= 255.0f;
-                        g /= 255.0f;
-                        b /= 255.0f;
-                    }
-                    else if (image_scaling == EI_CLASSIFIER_IMAGE_SCALING_TORCH) {
-                        r /= 255.0f;
-                        g /= 255.0f;
-                        b /= 255.0f;
-
-                        r = (r - torch_mean[0]) / torch_std[0];
-                        g = (g - torch_mean[1]) / torch_std[1];
-                        b = (b - torch_mean[2]) / torch_std[2];
-                    }
-                    else if (image_scaling == EI_CLASSIFIER_IMAGE_SCALING_MIN128_127) {
-                        r -= 128.0f;
-                        g -= 128.0f;
-                        b -= 128.0f;
-                    }
-
-                    // ITU-R 601-2 luma transform
-                    // see: https://pillow.readthedocs.io/en/stable/reference/Image.html#PIL.Image.Image.convert
-                    float v = (0.299f * r) + (0.587f * g) + (0.114f * b);
-                    output_matrix->buffer[output_ix++] = static_cast<int8_t>(round(v / scale) + zero_point);
-                }
-            }
-        }
+        image_features_quantized_from_source(signal_source_float{ input_matrix.buffer }, elements_to_read,
+            output_matrix->buffer + output_ix, channel_count, scale, zero_point, image_scaling);
+        output_ix += elements_to_read * channel_count;
 
         bytes_left -= elements_to_read;
 
     }
     return EIDSP_OK;
 }
+
+/**
+ * extract_image_features_quantized over a signal_view, the source is read in place (no pages,
+ * no get_data calls). With a u8 source and the default quantization this is one straight loop.
+ */
+template<typename Source>
+__attribute__((unused)) int extract_image_features_quantized(const signal_view<Source> *signal, matrix_i8_t *output_matrix, void *config_ptr, float scale, float zero_point, const float frequency,
+                                                             int image_scaling) {
+    ei_dsp_config_image_t config = *((ei_dsp_config_image_t*)config_ptr);
+
+    int16_t channel_count = strcmp(config.channels, "Grayscale") == 0 ? 1 : 3;
+
+    image_features_quantized_from_source(signal->source, signal->total_length, output_matrix->buffer,
+        channel_count, scale, zero_point, image_scaling);
+
+    return EIDSP_OK;
+}
+
+/**
+ * extract_image_features_quantized over a crop of a larger frame: cropped, resized and quantized
+ * in one pass straight into the output (the input tensor), no resized copy of the frame.
+ * That is the fast code path above; other quantizations and scalings sample the crop pixel by pixel.
+ */
+__attribute__((unused)) int extract_image_features_quantized(const signal_view<signal_source_crop_resize> *signal, matrix_i8_t *output_matrix, void *config_ptr, float scale, float zero_point, const float frequency,
+                                                             int image_scaling) {
+    ei_dsp_config_image_t config = *((ei_dsp_config_image_t*)config_ptr);
+
+    int16_t channel_count = strcmp(config.channels, "Grayscale") == 0 ? 1 : 3;
+
+    const bool fast_path = scale == 0.003921568859368563f && zero_point == -128 &&
+        image_scaling == EI_CLASSIFIER_IMAGE_SCALING_NONE;
+    if (!fast_path || (channel_count == 3 && signal->source.crop.pixel_size_B == 1)) {
+        image_features_quantized_from_source(signal->source, signal->total_length, output_matrix->buffer,
+            channel_count, scale, zero_point, image_scaling);
+        return EIDSP_OK;
+    }
+
+    return ei::image::processing::crop_resize_quantize_image(&signal->source.crop, output_matrix->buffer,
+        channel_count, scale, static_cast<int>(zero_point));
+}
 #endif // (EI_CLASSIFIER_QUANTIZATION_ENABLED == 1) && (EI_CLASSIFIER_INFERENCING_ENGINE != EI_CLASSIFIER_DRPAI)
 
 /**
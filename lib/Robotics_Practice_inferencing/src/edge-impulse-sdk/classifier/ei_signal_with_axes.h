@@ -36,6 +36,7 @@
 #define _EI_CLASSIFIER_SIGNAL_WITH_AXES_H_
 
 #include "edge-impulse-sdk/dsp/numpy_types.h"
+#include "edge-impulse-sdk/dsp/numpy.hpp"
 #include "edge-impulse-sdk/dsp/returntypes.hpp"
 #include "edge-impulse-sdk/classifier/ei_model_types.h"
 
@@ -69,20 +70,9 @@ public:
 
     int get_data(size_t offset, size_t length, float *out_ptr) {
         size_t offset_on_original_signal = offset / _axes_count * _impulse->raw_samples_per_frame;
-        size_t length_on_original_signal = length / _axes_count * _impulse->raw_samples_per_frame;
 
-        size_t out_ptr_ix = 0;
-
-        for (size_t ix = offset_on_original_signal; ix < offset_on_original_signal + length_on_original_signal; ix += _impulse->raw_samples_per_frame) {
-            for (size_t axis_ix = 0; axis_ix < this->_axes_count; axis_ix++) {
-                int r = _original_signal->get_data(ix + _axes[axis_ix], 1, &out_ptr[out_ptr_ix++]);
-                if (r != 0) {
-                    return r;
-                }
-            }
-        }
-
-        return 0;
+        return numpy::signal_get_data_strided(_original_signal, offset_on_original_signal,
+            _impulse->raw_samples_per_frame, length / _axes_count, _axes, _axes_count, out_ptr);
     }
 
 private:
@@ -63,6 +63,7 @@ public:
             return this->get_data(offset, length, out_ptr);
         };
 #endif
+        wrapped_signal.buffer = _original_signal->buffer ? _original_signal->buffer + _range_start : nullptr;
         return &wrapped_signal;
     }
 
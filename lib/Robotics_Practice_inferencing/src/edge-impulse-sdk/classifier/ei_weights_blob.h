@@ -0,0 +1,324 @@
+/* The Clear BSD License
+ *
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _EI_CLASSIFIER_WEIGHTS_BLOB_H_
+#define _EI_CLASSIFIER_WEIGHTS_BLOB_H_
+
+#include <string.h>
+#include "edge-impulse-sdk/classifier/ei_model_types.h"
+#include "edge-impulse-sdk/porting/ei_classifier_porting.h"
+
+/**
+ * Weights blob for compiled (EON) graphs.
+ *
+ * The constant tensors of a compiled graph (filters, biases, paddings) are normally arrays in
+ * .rodata, so every change of the weights means reflashing the application. A graph built with
+ * EI_CLASSIFIER_WEIGHTS_BLOB=1 leaves them out, and ei_weights_blob_apply() points them at a
+ * blob in memory-mapped storage instead (a data partition through esp_partition_mmap, a file
+ * through mmap). The kernels read the weights in place, nothing is copied.
+ *
+ * Layout, all fields little endian:
+ *
+ *   ei_weights_blob_header_t
+ *   ei_weights_blob_entry_t[tensors_count]   in the order the graph lists its constant tensors
+ *   tensor data                              every tensor at a multiple of alignment from the start
+ *
+ * The blob itself has to be mapped at an address aligned to header.alignment (flash mappings and
+ * mmap are page aligned). The fingerprint covers index, type and size of every constant tensor,
+ * so a blob packed for another model (or another export of the same one) is rejected. Blobs are
+ * packed on the host with ei_weights_blob_pack(), from a build that has the weights compiled in.
+ */
+
+#define EI_WEIGHTS_BLOB_MAGIC               0x54574945  // "EIWT"
+#define EI_WEIGHTS_BLOB_VERSION             1
+#define EI_WEIGHTS_BLOB_ALIGNMENT           16
+
+// check the data checksum in ei_weights_blob_apply (reads the whole blob once)
+#ifndef EI_WEIGHTS_BLOB_VERIFY_DATA
+#define EI_WEIGHTS_BLOB_VERIFY_DATA         1
+#endif // EI_WEIGHTS_BLOB_VERIFY_DATA
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t header_bytes;      // sizeof(ei_weights_blob_header_t)
+    uint32_t alignment;         // of the tensor data offsets, and of the address the blob is mapped at
+    uint32_t tensors_count;
+    uint32_t total_bytes;       // header, entries and data, padded to the alignment
+    uint32_t fingerprint;       // of the constant tensors of the graph, see ei_weights_blob_fingerprint
+    uint32_t data_checksum;     // FNV-1a of everything after the entries
+    uint32_t reserved;
+} ei_weights_blob_header_t;
+
+typedef struct {
+    int16_t index;              // tensor index in the graph
+    uint8_t type;               // TfLiteType
+    uint8_t reserved;
+    uint32_t offset;            // from the start of the blob
+    uint32_t bytes;
+} ei_weights_blob_entry_t;
+
+static inline uint32_t ei_weights_blob_fnv1a(uint32_t hash, const void *data, size_t bytes) {
+    const uint8_t *p = (const uint8_t *)data;
+    for (size_t ix = 0; ix < bytes; ix++) {
+        hash = (hash ^ p[ix]) * 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * Fingerprint of the constant tensors of a graph (index, type and size, not the data)
+ */
+static inline uint32_t ei_weights_blob_fingerprint(const ei_weights_tensor_t *tensors, size_t count) {
+    uint32_t hash = 2166136261u;
+    for (size_t ix = 0; ix < count; ix++) {
+        const uint8_t fields[7] = {
+            (uint8_t)tensors[ix].index, (uint8_t)((uint16_t)tensors[ix].index >> 8), tensors[ix].type,
+            (uint8_t)tensors[ix].bytes, (uint8_t)(tensors[ix].bytes >> 8),
+            (uint8_t)(tensors[ix].bytes >> 16), (uint8_t)(tensors[ix].bytes >> 24)
+        };
+        hash = ei_weights_blob_fnv1a(hash, fields, sizeof(fields));
+    }
+    return hash;
+}
+
+static inline size_t ei_weights_blob_align(size_t bytes) {
+    return (bytes + EI_WEIGHTS_BLOB_ALIGNMENT - 1) & ~(size_t)(EI_WEIGHTS_BLOB_ALIGNMENT - 1);
+}
+
+/**
+ * Find the compiled graph of a learning block, or NULL if it can't take its weights from a blob
+ */
+__attribute__((unused)) static const ei_config_tflite_eon_graph_t *ei_weights_blob_get_graph(
+    const ei_impulse_t *impulse,
+    uint32_t learn_block_index)
+{
+    if (learn_block_index >= impulse->learning_blocks_size) {
+        return NULL;
+    }
+    const ei_learning_block_config_tflite_graph_t *block_config =
+        (const ei_learning_block_config_tflite_graph_t *)impulse->learning_blocks[learn_block_index].config;
+    if (!block_config || !block_config->compiled) {
+        return NULL;
+    }
+    const ei_config_tflite_eon_graph_t *graph = (const ei_config_tflite_eon_graph_t *)block_config->graph_config;
+    if (!graph->model_weights || !graph->model_set_weights) {
+        return NULL;
+    }
+    return graph;
+}
+
+/**
+ * List the constant tensors of a graph into a buffer from ei_malloc (free with ei_free)
+ */
+__attribute__((unused)) static ei_weights_tensor_t *ei_weights_blob_list(
+    const ei_config_tflite_eon_graph_t *graph,
+    size_t *count)
+{
+    *count = graph->model_weights(NULL, 0);
+    ei_weights_tensor_t *tensors = (ei_weights_tensor_t *)ei_malloc((*count > 0 ? *count : 1) * sizeof(ei_weights_tensor_t));
+    if (tensors) {
+        graph->model_weights(tensors, *count);
+    }
+    return tensors;
+}
+
+/**
+ * Pack the compiled in weights of a graph into a blob. Needs a build without
+ * EI_CLASSIFIER_WEIGHTS_BLOB (or a graph whose weights are set).
+ *
+ * @param impulse The impulse (e.g. ei_default_impulse.impulse)
+ * @param learn_block_index Index of the EON learning block
+ * @param blob Output, NULL to only get the size
+ * @param blob_size Size of blob
+ * @param blob_bytes Output, bytes of the packed blob
+ * @return EI_IMPULSE_OK if successful
+ */
+__attribute__((unused)) static EI_IMPULSE_ERROR ei_weights_blob_pack(
+    const ei_impulse_t *impulse,
+    uint32_t learn_block_index,
+    uint8_t *blob,
+    size_t blob_size,
+    size_t *blob_bytes)
+{
+    const ei_config_tflite_eon_graph_t *graph = ei_weights_blob_get_graph(impulse, learn_block_index);
+    if (!graph) {
+        ei_printf("ERR: weights blobs require a compiled (EON) graph that exports its constant tensors\n");
+        return EI_IMPULSE_UNSUPPORTED_INFERENCING_ENGINE;
+    }
+    size_t count;
+    ei_weights_tensor_t *tensors = ei_weights_blob_list(graph, &count);
+    if (!tensors) {
+        return EI_IMPULSE_ALLOC_FAILED;
+    }
+
+    const size_t data_start = ei_weights_blob_align(sizeof(ei_weights_blob_header_t) +
+        count * sizeof(ei_weights_blob_entry_t));
+    size_t total = data_start;
+    for (size_t ix = 0; ix < count; ix++) {
+        total = ei_weights_blob_align(total + tensors[ix].bytes);
+    }
+    *blob_bytes = total;
+    if (!blob) {
+        ei_free(tensors);
+        return EI_IMPULSE_OK;
+    }
+    if (blob_size < total) {
+        ei_free(tensors);
+        return EI_IMPULSE_INVALID_SIZE;
+    }
+
+    memset(blob, 0, total);
+    ei_weights_blob_entry_t *entries = (ei_weights_blob_entry_t *)(blob + sizeof(ei_weights_blob_header_t));
+    size_t offset = data_start;
+    for (size_t ix = 0; ix < count; ix++) {
+        if (!tensors[ix].data) {
+            ei_printf("ERR: constant tensor %d has no data to pack\n", (int)tensors[ix].index);
+            ei_free(tensors);
+            return EI_IMPULSE_TFLITE_ERROR;
+        }
+        entries[ix].index = tensors[ix].index;
+        entries[ix].type = tensors[ix].type;
+        entries[ix].offset = (uint32_t)offset;
+        entries[ix].bytes = tensors[ix].bytes;
+        memcpy(blob + offset, tensors[ix].data, tensors[ix].bytes);
+        offset = ei_weights_blob_align(offset + tensors[ix].bytes);
+    }
+
+    ei_weights_blob_header_t *header = (ei_weights_blob_header_t *)blob;
+    header->magic = EI_WEIGHTS_BLOB_MAGIC;
+    header->version = EI_WEIGHTS_BLOB_VERSION;
+    header->header_bytes = sizeof(ei_weights_blob_header_t);
+    header->alignment = EI_WEIGHTS_BLOB_ALIGNMENT;
+    header->tensors_count = (uint32_t)count;
+    header->total_bytes = (uint32_t)total;
+    header->fingerprint = ei_weights_blob_fingerprint(tensors, count);
+    header->data_checksum = ei_weights_blob_fnv1a(2166136261u, blob + data_start, total - data_start);
+    ei_free(tensors);
+    return EI_IMPULSE_OK;
+}
+
+/**
+ * Point the constant tensors of a graph at a mapped weights blob, before the first inference
+ * (the memory plan and placement run init, so before those as well). The blob has to stay
+ * mapped for as long as the classifier runs. Pass NULL to go back to the compiled in weights.
+ *
+ * @param impulse The impulse (e.g. ei_default_impulse.impulse)
+ * @param learn_block_index Index of the EON learning block
+ * @param blob Mapped blob, aligned to its header.alignment
+ * @param blob_size Bytes mapped (e.g. the partition size), at least header.total_bytes
+ * @return EI_IMPULSE_OK if successful
+ */
+__attribute__((unused)) static EI_IMPULSE_ERROR ei_weights_blob_apply(
+    const ei_impulse_t *impulse,
+    uint32_t learn_block_index,
+    const void *blob,
+    size_t blob_size)
+{
+    const ei_config_tflite_eon_graph_t *graph = ei_weights_blob_get_graph(impulse, learn_block_index);
+    if (!graph) {
+        ei_printf("ERR: weights blobs require a compiled (EON) graph that exports its constant tensors\n");
+        return EI_IMPULSE_UNSUPPORTED_INFERENCING_ENGINE;
+    }
+    if (!blob) {
+        return graph->model_set_weights(NULL, 0) == kTfLiteOk ? EI_IMPULSE_OK : EI_IMPULSE_TFLITE_ERROR;
+    }
+
+    const uint8_t *base = (const uint8_t *)blob;
+    const ei_weights_blob_header_t *header = (const ei_weights_blob_header_t *)blob;
+    if (blob_size < sizeof(ei_weights_blob_header_t) || header->magic != EI_WEIGHTS_BLOB_MAGIC) {
+        ei_printf("ERR: not a weights blob\n");
+        return EI_IMPULSE_INVALID_SIZE;
+    }
+    if (header->version != EI_WEIGHTS_BLOB_VERSION || header->header_bytes != sizeof(ei_weights_blob_header_t)) {
+        ei_printf("ERR: weights blob version %d is not supported (expected %d)\n",
+            (int)header->version, EI_WEIGHTS_BLOB_VERSION);
+        return EI_IMPULSE_UNSUPPORTED_INFERENCING_ENGINE;
+    }
+    const uint32_t alignment = header->alignment;
+    if (alignment < EI_WEIGHTS_BLOB_ALIGNMENT || (alignment & (alignment - 1)) != 0 ||
+        ((uintptr_t)base & (alignment - 1)) != 0) {
+        ei_printf("ERR: weights blob is not mapped at a %d byte aligned address\n", (int)alignment);
+        return EI_IMPULSE_INVALID_SIZE;
+    }
+    const size_t entries_end = sizeof(ei_weights_blob_header_t) +
+        (size_t)header->tensors_count * sizeof(ei_weights_blob_entry_t);
+    if (header->total_bytes > blob_size || entries_end > header->total_bytes) {
+        ei_printf("ERR: weights blob is truncated (%d of %d bytes)\n", (int)blob_size, (int)header->total_bytes);
+        return EI_IMPULSE_INVALID_SIZE;
+    }
+
+    size_t count;
+    ei_weights_tensor_t *tensors = ei_weights_blob_list(graph, &count);
+    if (!tensors) {
+        return EI_IMPULSE_ALLOC_FAILED;
+    }
+    EI_IMPULSE_ERROR res = EI_IMPULSE_OK;
+    if (header->tensors_count != count || header->fingerprint != ei_weights_blob_fingerprint(tensors, count)) {
+        ei_printf("ERR: weights blob was packed for another model\n");
+        res = EI_IMPULSE_ERROR_SHAPES_DONT_MATCH;
+    }
+
+    const ei_weights_blob_entry_t *entries = (const ei_weights_blob_entry_t *)(base + sizeof(ei_weights_blob_header_t));
+    for (size_t ix = 0; res == EI_IMPULSE_OK && ix < count; ix++) {
+        const ei_weights_blob_entry_t *entry = &entries[ix];
+        if (entry->index != tensors[ix].index || entry->type != tensors[ix].type ||
+            entry->bytes != tensors[ix].bytes || entry->offset < entries_end ||
+            (entry->offset & (alignment - 1)) != 0 || (size_t)entry->offset + entry->bytes > header->total_bytes) {
+            ei_printf("ERR: weights blob entry %d is invalid\n", (int)ix);
+            res = EI_IMPULSE_INVALID_SIZE;
+            break;
+        }
+        tensors[ix].data = base + entry->offset;
+    }
+
+#if EI_WEIGHTS_BLOB_VERIFY_DATA == 1
+    if (res == EI_IMPULSE_OK) {
+        const size_t data_start = ei_weights_blob_align(entries_end);
+        if (ei_weights_blob_fnv1a(2166136261u, base + data_start, header->total_bytes - data_start) !=
+            header->data_checksum) {
+            ei_printf("ERR: weights blob checksum mismatch\n");
+            res = EI_IMPULSE_INVALID_SIZE;
+        }
+    }
+#endif // EI_WEIGHTS_BLOB_VERIFY_DATA
+
+    if (res == EI_IMPULSE_OK && graph->model_set_weights(tensors, count) != kTfLiteOk) {
+        res = EI_IMPULSE_TFLITE_ERROR;
+    }
+    ei_free(tensors);
+    return res;
+}
+
+#endif // _EI_CLASSIFIER_WEIGHTS_BLOB_H_
@@ -58,7 +58,7 @@ extern "C" void get_data(const void *impulse_arg, int8_t *in_buf_0, uint16_t in_
 
     if ((impulse->sensor == EI_CLASSIFIER_SENSOR_CAMERA) &&
         ((impulse->dsp_blocks_size == 1) ||
-        (impulse->dsp_blocks[0].extract_fn == extract_image_features))) {
+        (impulse->dsp_blocks[0].extract_fn == (extract_fn_t)extract_image_features))) {
 
         memcpy(in_buf_0, processed_features, impulse->nn_input_frame_size);
     }
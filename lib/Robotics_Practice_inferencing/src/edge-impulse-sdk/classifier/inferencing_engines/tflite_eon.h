@@ -41,9 +41,30 @@
 #include "edge-impulse-sdk/tensorflow/lite/kernels/internal/tensor_ctypes.h"
 #include "edge-impulse-sdk/classifier/ei_aligned_malloc.h"
 #include "edge-impulse-sdk/classifier/ei_model_types.h"
+#include "edge-impulse-sdk/classifier/ei_output_tap.h"
 #include "edge-impulse-sdk/classifier/inferencing_engines/tflite_helper.h"
 #include "edge-impulse-sdk/classifier/ei_run_dsp.h"
 
+static void ei_output_tap_notify(uint32_t learn_block_index, uint32_t output_ix, const TfLiteTensor *output) {
+    if (ei_output_tap == NULL) {
+        return;
+    }
+    // NHWC with a batch of 1, lower ranks keep their trailing dimensions
+    const int rank = output->dims->size;
+    ei_tensor_tap_t tap;
+    tap.node = -1;
+    tap.tensor = (int16_t)output_ix;
+    tap.type = (uint8_t)output->type;
+    tap.height = (uint16_t)(rank >= 3 ? output->dims->data[rank - 3] : 1);
+    tap.width = (uint16_t)(rank >= 2 ? output->dims->data[rank - 2] : 1);
+    tap.channels = (uint16_t)(rank >= 1 ? output->dims->data[rank - 1] : 1);
+    tap.scale = output->params.scale;
+    tap.zero_point = output->params.zero_point;
+    tap.data = output->data.data;
+    tap.bytes = output->bytes;
+    ei_output_tap(learn_block_index, &tap, ei_output_tap_ctx);
+}
+
 /**
  * Setup the TFLite runtime
  *
@@ -292,6 +313,9 @@ EI_IMPULSE_ERROR run_nn_inference(
         }
 
         result->_raw_outputs[learn_block_index + output_ix].blockId = block_config->block_id + output_ix;
+        if (run_res == EI_IMPULSE_OK) {
+            ei_output_tap_notify(learn_block_index, output_ix, output);
+        }
     }
 
     graph_config->model_reset(ei_aligned_free);
@@ -310,9 +334,10 @@ EI_IMPULSE_ERROR run_nn_inference(
  * that allocates a lot less memory by quantizing in place. This only works if 'can_run_classifier_image_quantized'
  * returns EI_IMPULSE_OK.
  */
+template<typename Signal>
 EI_IMPULSE_ERROR run_nn_inference_image_quantized(
     const ei_impulse_t *impulse,
-    signal_t *signal,
+    Signal *signal,
     uint32_t learn_block_index,
     ei_impulse_result_t *result,
     void *config_ptr,
@@ -428,6 +453,9 @@ EI_IMPULSE_ERROR run_nn_inference_image_quantized(
         }
 
         result->_raw_outputs[learn_block_index + output_ix].blockId = block_config->block_id + output_ix;
+        if (run_res == EI_IMPULSE_OK) {
+            ei_output_tap_notify(learn_block_index, output_ix, output);
+        }
     }
 
     graph_config->model_reset(ei_aligned_free);
@@ -0,0 +1,363 @@
+/* The Clear BSD License
+ *
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EI_DETECTION_TRIGGER_H
+#define EI_DETECTION_TRIGGER_H
+
+/**
+ * Calibrated, suppression-aware event trigger for object detection, the counterpart of
+ * PerfCal (ei_performance_calibration.h) for classification.
+ *
+ * Every frame the detections are rasterised onto the output grid as one confidence per
+ * (cell, label), quantized to 0..255, and averaged over the frames of the last
+ * average_window_duration_ms: a ring of timestamped uint8 frames and a uint16 running sum per
+ * element, so every frame is added once and subtracted once however long the window is, with no
+ * floats. The window is measured on the frame timestamps, so it keeps its duration when the
+ * capture rate changes; frame_interval_ms is the shortest expected interval and only sizes the
+ * ring. Every label whose best averaged cell reaches the detection threshold fires an event,
+ * unless it's suppressed. A label that fired is suppressed for suppression_ms, and the
+ * suppression is extended for as long as that label stays above the threshold, so a note held
+ * in view for many frames fires exactly one event.
+ */
+
+#include <string.h>
+#include "edge-impulse-sdk/classifier/postprocessing/ei_postprocessing_common.h"
+
+extern ei_impulse_handle_t & ei_default_impulse;
+
+// Longest averaging window in frames
+#ifndef EI_DETECTION_TRIGGER_MAX_WINDOW
+#define EI_DETECTION_TRIGGER_MAX_WINDOW 16
+#endif // EI_DETECTION_TRIGGER_MAX_WINDOW
+
+// Most labels the trigger follows
+#ifndef EI_DETECTION_TRIGGER_MAX_LABELS
+#if EI_CLASSIFIER_LABEL_COUNT > 0
+#define EI_DETECTION_TRIGGER_MAX_LABELS EI_CLASSIFIER_LABEL_COUNT
+#else
+#define EI_DETECTION_TRIGGER_MAX_LABELS 1
+#endif
+#endif // EI_DETECTION_TRIGGER_MAX_LABELS
+
+// fired_labels and the suppression are bit masks per label
+static_assert(EI_DETECTION_TRIGGER_MAX_LABELS <= 32, "detection trigger supports up to 32 labels");
+
+typedef struct {
+    int16_t label_ix;       // best label that fired in the last frame, -1 if none
+    uint16_t x;             // centre of its cell, in input pixels
+    uint16_t y;
+    float confidence;       // averaged confidence of that cell
+    uint32_t fired_labels;  // every label that fired in the last frame, bit per label
+    uint32_t events;        // events fired since the last reset, one per label that fired
+    uint32_t frames;        // frames since the last reset
+    uint32_t window_frames; // frames averaged in the last frame
+} ei_detection_trigger_t;
+
+typedef struct {
+    ei_detection_trigger_t trigger;
+    uint32_t elements;      // cells * labels
+    uint32_t capacity;      // frames the ring holds
+    uint32_t oldest_ix;     // ring slot of the oldest frame in the window
+    uint32_t filled;        // frames in the window, up to capacity
+    uint64_t frame_ms[EI_DETECTION_TRIGGER_MAX_WINDOW];
+    uint64_t suppressed_until_ms[EI_DETECTION_TRIGGER_MAX_LABELS];
+    uint8_t *current;       // [cells][labels] of the frame being added
+    uint8_t *ring;          // [capacity][cells][labels]
+    uint16_t *sum;          // [cells][labels]
+} ei_detection_trigger_state_t;
+
+static void ei_detection_trigger_reset(ei_detection_trigger_state_t *state) {
+    memset(&state->trigger, 0, sizeof(state->trigger));
+    state->trigger.label_ix = -1;
+    state->oldest_ix = 0;
+    state->filled = 0;
+    memset(state->frame_ms, 0, sizeof(state->frame_ms));
+    memset(state->suppressed_until_ms, 0, sizeof(state->suppressed_until_ms));
+    memset(state->ring, 0, (size_t)state->capacity * state->elements);
+    memset(state->sum, 0, state->elements * sizeof(uint16_t));
+}
+
+EI_IMPULSE_ERROR init_detection_trigger(ei_impulse_handle_t *handle, void **state, void *config)
+{
+    const ei_impulse_t *impulse = handle->impulse;
+    const ei_detection_trigger_config_t *trigger_config = (ei_detection_trigger_config_t*)config;
+
+    if (impulse->label_count > EI_DETECTION_TRIGGER_MAX_LABELS) {
+        ei_printf("ERR: detection trigger supports up to %d labels (increase EI_DETECTION_TRIGGER_MAX_LABELS)\n",
+            EI_DETECTION_TRIGGER_MAX_LABELS);
+        return EI_IMPULSE_POSTPROCESSING_ERROR;
+    }
+    if (trigger_config->grid_width == 0 || trigger_config->grid_height == 0 || trigger_config->frame_interval_ms == 0) {
+        ei_printf("ERR: detection trigger needs a grid and a frame interval\n");
+        return EI_IMPULSE_POSTPROCESSING_ERROR;
+    }
+    if (trigger_config->detection_threshold <= 0.0f || trigger_config->detection_threshold > 1.0f) {
+        ei_printf("ERR: detection trigger threshold %f is out of range (0..1]\n", trigger_config->detection_threshold);
+        return EI_IMPULSE_POSTPROCESSING_ERROR;
+    }
+
+    // most frames the window can hold, at the shortest interval between frames
+    uint32_t capacity = trigger_config->average_window_duration_ms / trigger_config->frame_interval_ms;
+    capacity = capacity < 1 ? 1 : capacity > EI_DETECTION_TRIGGER_MAX_WINDOW
+        ? EI_DETECTION_TRIGGER_MAX_WINDOW : capacity;
+    const uint32_t elements = (uint32_t)trigger_config->grid_width * trigger_config->grid_height * impulse->label_count;
+
+    ei_detection_trigger_state_t *trigger_state =
+        (ei_detection_trigger_state_t*)ei_calloc(1, sizeof(ei_detection_trigger_state_t));
+    if (!trigger_state) {
+        return EI_IMPULSE_OUT_OF_MEMORY;
+    }
+    trigger_state->current = (uint8_t*)ei_calloc(elements, 1);
+    trigger_state->ring = (uint8_t*)ei_calloc((size_t)capacity * elements, 1);
+    trigger_state->sum = (uint16_t*)ei_calloc(elements, sizeof(uint16_t));
+    if (!trigger_state->current || !trigger_state->ring || !trigger_state->sum) {
+        ei_free(trigger_state->current);
+        ei_free(trigger_state->ring);
+        ei_free(trigger_state->sum);
+        ei_free(trigger_state);
+        return EI_IMPULSE_OUT_OF_MEMORY;
+    }
+    trigger_state->elements = elements;
+    trigger_state->capacity = capacity;
+    ei_detection_trigger_reset(trigger_state);
+
+    *state = (void*)trigger_state;
+
+    return EI_IMPULSE_OK;
+}
+
+EI_IMPULSE_ERROR deinit_detection_trigger(void *state, void *config)
+{
+    ei_detection_trigger_state_t *trigger_state = (ei_detection_trigger_state_t*)state;
+    if (trigger_state) {
+        ei_free(trigger_state->current);
+        ei_free(trigger_state->ring);
+        ei_free(trigger_state->sum);
+        ei_free(trigger_state);
+    }
+
+    return EI_IMPULSE_OK;
+}
+
+/**
+ * sum += current, slot = current
+ */
+static inline void ei_detection_trigger_add(uint16_t *__restrict sum, uint8_t *__restrict slot,
+                                            const uint8_t *__restrict current, size_t size) {
+    for (size_t ix = 0; ix < size; ix++) {
+        sum[ix] = (uint16_t)(sum[ix] + current[ix]);
+        slot[ix] = current[ix];
+    }
+}
+
+/**
+ * Drop the oldest frame of the window, sum -= oldest
+ */
+static inline void ei_detection_trigger_drop_oldest(ei_detection_trigger_state_t *state) {
+    uint16_t *__restrict sum = state->sum;
+    const uint8_t *__restrict oldest = state->ring + (size_t)state->oldest_ix * state->elements;
+    for (size_t ix = 0; ix < state->elements; ix++) {
+        sum[ix] = (uint16_t)(sum[ix] - oldest[ix]);
+    }
+    if (++state->oldest_ix >= state->capacity) {
+        state->oldest_ix = 0;
+    }
+    state->filled--;
+}
+
+__attribute__((unused)) static EI_IMPULSE_ERROR process_detection_trigger(ei_impulse_handle_t *handle,
+                                                                       uint32_t block_index,
+                                                                       uint32_t input_block_id,
+                                                                       ei_impulse_result_t *result,
+                                                                       void *config_ptr,
+                                                                       void *state) {
+    const ei_impulse_t *impulse = handle->impulse;
+    const ei_detection_trigger_config_t *config = (ei_detection_trigger_config_t*)config_ptr;
+    ei_detection_trigger_state_t *trigger_state = (ei_detection_trigger_state_t*)state;
+
+    if (!trigger_state) {
+        ei_printf("ERR: detection trigger needs run_classifier_init() to be called first\n");
+        return EI_IMPULSE_POSTPROCESSING_ERROR;
+    }
+
+    const uint32_t labels = impulse->label_count;
+    const uint32_t grid_width = config->grid_width;
+    const uint32_t grid_height = config->grid_height;
+
+    // 1. rasterise the detections of this frame, the highest confidence wins a cell
+    uint8_t *current = trigger_state->current;
+    memset(current, 0, trigger_state->elements);
+    for (size_t ix = 0; ix < result->bounding_boxes_count; ix++) {
+        const ei_impulse_result_bounding_box_t *bb = &result->bounding_boxes[ix];
+        if (!bb->label || bb->value <= 0.0f || bb->width == 0 || bb->height == 0) {
+            continue;
+        }
+        int label_ix = -1;
+        for (uint32_t lx = 0; lx < labels; lx++) {
+            if (impulse->categories[lx] == bb->label || strcmp(impulse->categories[lx], bb->label) == 0) {
+                label_ix = (int)lx;
+                break;
+            }
+        }
+        if (label_ix < 0) {
+            continue;
+        }
+        const uint8_t q = (uint8_t)(bb->value >= 1.0f ? 255 : bb->value * 255.0f + 0.5f);
+        const uint32_t x0 = bb->x * grid_width / impulse->input_width;
+        const uint32_t y0 = bb->y * grid_height / impulse->input_height;
+        uint32_t x1 = (bb->x + bb->width - 1) * grid_width / impulse->input_width;
+        uint32_t y1 = (bb->y + bb->height - 1) * grid_height / impulse->input_height;
+        x1 = x1 >= grid_width ? grid_width - 1 : x1;
+        y1 = y1 >= grid_height ? grid_height - 1 : y1;
+        for (uint32_t cy = y0; cy <= y1; cy++) {
+            for (uint32_t cx = x0; cx <= x1; cx++) {
+                uint8_t *cell = &current[(cy * grid_width + cx) * labels + label_ix];
+                if (q > *cell) {
+                    *cell = q;
+                }
+            }
+        }
+    }
+
+    // 2. running sums over the frames of the last average_window_duration_ms; a full ring
+    // drops its oldest frame early (frames came faster than frame_interval_ms)
+    ei_detection_trigger_t *trigger = &trigger_state->trigger;
+    const uint64_t now_ms = ei_read_timer_ms();
+    if (trigger_state->filled >= trigger_state->capacity) {
+        ei_detection_trigger_drop_oldest(trigger_state);
+    }
+    uint32_t slot_ix = trigger_state->oldest_ix + trigger_state->filled;
+    if (slot_ix >= trigger_state->capacity) {
+        slot_ix -= trigger_state->capacity;
+    }
+    ei_detection_trigger_add(trigger_state->sum, trigger_state->ring + (size_t)slot_ix * trigger_state->elements,
+                             current, trigger_state->elements);
+    trigger_state->frame_ms[slot_ix] = now_ms;
+    trigger_state->filled++;
+    while (trigger_state->filled > 1 &&
+           now_ms - trigger_state->frame_ms[trigger_state->oldest_ix] >= config->average_window_duration_ms) {
+        ei_detection_trigger_drop_oldest(trigger_state);
+    }
+    trigger->window_frames = trigger_state->filled;
+
+    // 3. best averaged cell of every label that can fire; compared as sums, threshold * 255 * frames
+    const uint32_t threshold_sum = (uint32_t)(config->detection_threshold * 255.0f * trigger_state->filled + 0.5f);
+    uint16_t best_sum[EI_DETECTION_TRIGGER_MAX_LABELS] = { 0 };
+    uint32_t best_cell[EI_DETECTION_TRIGGER_MAX_LABELS] = { 0 };
+    const uint16_t *sum = trigger_state->sum;
+    for (uint32_t ix = 0; ix < trigger_state->elements; ix++) {
+        const uint32_t label_ix = ix % labels;
+        if (sum[ix] > best_sum[label_ix]) {
+            best_sum[label_ix] = sum[ix];
+            best_cell[label_ix] = ix / labels;
+        }
+    }
+
+    // 4. every label above the threshold fires once; while it stays above, the suppression of a
+    // label that already fired is extended, and the best of the labels that fired is reported
+    trigger->label_ix = -1;
+    trigger->fired_labels = 0;
+    uint32_t fired_sum = 0;
+    for (uint32_t label_ix = 0; label_ix < labels; label_ix++) {
+        if (best_sum[label_ix] < threshold_sum) {
+            continue;
+        }
+        if (config->suppression_flags != 0 && !(config->suppression_flags & (1u << label_ix))) {
+            continue;
+        }
+        const bool suppressed = now_ms < trigger_state->suppressed_until_ms[label_ix];
+        trigger_state->suppressed_until_ms[label_ix] = now_ms + config->suppression_ms;
+        if (suppressed) {
+            continue;
+        }
+        trigger->fired_labels |= 1u << label_ix;
+        trigger->events++;
+        if (best_sum[label_ix] > fired_sum) {
+            const uint32_t cell = best_cell[label_ix];
+            fired_sum = best_sum[label_ix];
+            trigger->label_ix = (int16_t)label_ix;
+            trigger->x = (uint16_t)(((cell % grid_width) * 2 + 1) * impulse->input_width / (2 * grid_width));
+            trigger->y = (uint16_t)(((cell / grid_width) * 2 + 1) * impulse->input_height / (2 * grid_height));
+            trigger->confidence = (float)fired_sum / (255.0f * trigger_state->filled);
+        }
+    }
+    trigger->frames++;
+
+    return EI_IMPULSE_OK;
+}
+
+static ei_detection_trigger_state_t *ei_detection_trigger_get_state(ei_impulse_handle_t *handle) {
+    int16_t block_number = get_block_number(handle, (void*)init_detection_trigger);
+    if (block_number == -1 || handle->post_processing_state == NULL) {
+        return NULL;
+    }
+    return (ei_detection_trigger_state_t*)handle->post_processing_state[block_number];
+}
+
+/**
+ * The event of the last frame (label_ix -1 if nothing fired) and the event count
+ */
+EI_IMPULSE_ERROR get_detection_trigger(ei_impulse_handle_t *handle, ei_detection_trigger_t *trigger) {
+    ei_detection_trigger_state_t *trigger_state = ei_detection_trigger_get_state(handle);
+    if (!trigger_state) {
+        return EI_IMPULSE_POSTPROCESSING_ERROR;
+    }
+
+    memcpy(trigger, &trigger_state->trigger, sizeof(ei_detection_trigger_t));
+    return EI_IMPULSE_OK;
+}
+
+/**
+ * Forget the window and the suppression, e.g. after inference paused
+ */
+EI_IMPULSE_ERROR reset_detection_trigger(ei_impulse_handle_t *handle) {
+    ei_detection_trigger_state_t *trigger_state = ei_detection_trigger_get_state(handle);
+    if (!trigger_state) {
+        return EI_IMPULSE_POSTPROCESSING_ERROR;
+    }
+
+    ei_detection_trigger_reset(trigger_state);
+    return EI_IMPULSE_OK;
+}
+
+// versions that operate on the default impulse
+EI_IMPULSE_ERROR get_detection_trigger(ei_detection_trigger_t *trigger) {
+    return get_detection_trigger(&ei_default_impulse, trigger);
+}
+
+EI_IMPULSE_ERROR reset_detection_trigger() {
+    return reset_detection_trigger(&ei_default_impulse);
+}
+
+#endif // EI_DETECTION_TRIGGER_H
@@ -0,0 +1,215 @@
+/* The Clear BSD License
+ *
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EI_FOMO_FUSION_H
+#define EI_FOMO_FUSION_H
+
+/**
+ * Temporal fusion of FOMO heatmaps. The int8 output tensor of the learning block is folded
+ * into an exponentially weighted average over the previous frames, and the average is written
+ * back into the tensor, so the FOMO block that runs next extracts its cubes from the fused map.
+ *
+ * The average is kept in int16 with 8 fractional bits: the newest frame weighs 1 / 2^shift,
+ * so about 2^shift frames contribute. A cell at the edge of a note that flickers across the
+ * threshold from frame to frame settles, without running the model more often. The update is
+ * one shift and two adds per element, with no branches, and vectorises.
+ */
+
+#include <string.h>
+#include "edge-impulse-sdk/classifier/postprocessing/ei_postprocessing_common.h"
+
+extern ei_impulse_handle_t & ei_default_impulse;
+
+// Largest output tensor that can be fused, in elements (12x12 grid with 7 classes is 1008)
+#ifndef EI_FOMO_FUSION_MAX_OUTPUTS
+#define EI_FOMO_FUSION_MAX_OUTPUTS 1024
+#endif // EI_FOMO_FUSION_MAX_OUTPUTS
+
+typedef struct {
+    uint32_t frames;        // frames fused since the last reset
+    uint32_t last_us;       // time the last fusion took
+    uint32_t max_us;
+} ei_fomo_fusion_stats_t;
+
+typedef struct {
+    ei_fomo_fusion_stats_t stats;
+    uint32_t size;          // elements in the accumulator, 0 until the first frame
+    int16_t acc[EI_FOMO_FUSION_MAX_OUTPUTS];
+} ei_fomo_fusion_state_t;
+
+/**
+ * acc += (out * 256 - acc) / 2^shift, then out = round(acc / 256)
+ */
+static inline void ei_fomo_fusion_update(int16_t *__restrict acc, int8_t *__restrict out,
+                                         size_t size, int shift) {
+    for (size_t ix = 0; ix < size; ix++) {
+        int32_t a = acc[ix];
+        a += (((int32_t)out[ix] << 8) - a) >> shift;
+        acc[ix] = (int16_t)a;
+        out[ix] = (int8_t)((a + 128) >> 8);
+    }
+}
+
+static void ei_fomo_fusion_reset(ei_fomo_fusion_state_t *state) {
+    memset(&state->stats, 0, sizeof(state->stats));
+    state->size = 0;
+}
+
+EI_IMPULSE_ERROR init_fomo_fusion(ei_impulse_handle_t *handle, void **state, void *config)
+{
+    const ei_fomo_fusion_config_t *fusion_config = (ei_fomo_fusion_config_t*)config;
+
+    if (fusion_config->shift > 7) {
+        ei_printf("ERR: FOMO fusion shift %u is out of range (0..7)\n", (unsigned)fusion_config->shift);
+        return EI_IMPULSE_POSTPROCESSING_ERROR;
+    }
+
+    ei_fomo_fusion_state_t *fusion_state = (ei_fomo_fusion_state_t*)ei_calloc(1, sizeof(ei_fomo_fusion_state_t));
+    if (!fusion_state) {
+        return EI_IMPULSE_OUT_OF_MEMORY;
+    }
+    ei_fomo_fusion_reset(fusion_state);
+
+    *state = (void*)fusion_state;
+
+    return EI_IMPULSE_OK;
+}
+
+EI_IMPULSE_ERROR deinit_fomo_fusion(void *state, void *config)
+{
+    if (state) {
+        ei_free(state);
+    }
+
+    return EI_IMPULSE_OK;
+}
+
+__attribute__((unused)) static EI_IMPULSE_ERROR process_fomo_fusion(ei_impulse_handle_t *handle,
+                                                                 uint32_t block_index,
+                                                                 uint32_t input_block_id,
+                                                                 ei_impulse_result_t *result,
+                                                                 void *config_ptr,
+                                                                 void *state) {
+    const ei_impulse_t *impulse = handle->impulse;
+    const ei_fomo_fusion_config_t *config = (ei_fomo_fusion_config_t*)config_ptr;
+    ei_fomo_fusion_state_t *fusion_state = (ei_fomo_fusion_state_t*)state;
+
+    if (!fusion_state) {
+        ei_printf("ERR: FOMO fusion needs run_classifier_init() to be called first\n");
+        return EI_IMPULSE_POSTPROCESSING_ERROR;
+    }
+
+    ei::matrix_i8_t* raw_output_mtx = NULL;
+    bool find_mtx_res = find_mtx_by_idx(result->_raw_outputs, &raw_output_mtx, input_block_id, impulse->output_tensors_size);
+    if (!find_mtx_res) {
+        // only quantized outputs are fused
+        return EI_IMPULSE_OUTPUT_TENSOR_NULL;
+    }
+
+    const uint32_t size = raw_output_mtx->rows * raw_output_mtx->cols;
+    if (size > EI_FOMO_FUSION_MAX_OUTPUTS) {
+        ei_printf("ERR: FOMO fusion supports up to %d outputs (increase EI_FOMO_FUSION_MAX_OUTPUTS)\n",
+            EI_FOMO_FUSION_MAX_OUTPUTS);
+        return EI_IMPULSE_POSTPROCESSING_ERROR;
+    }
+
+    const uint64_t start_us = ei_read_timer_us();
+
+    int8_t *out = raw_output_mtx->buffer;
+    if (fusion_state->size != size) {
+        // first frame: the average starts at the frame itself
+        for (uint32_t ix = 0; ix < size; ix++) {
+            fusion_state->acc[ix] = (int16_t)((int32_t)out[ix] << 8);
+        }
+        fusion_state->size = size;
+    }
+    else {
+        ei_fomo_fusion_update(fusion_state->acc, out, size, config->shift);
+    }
+
+    ei_fomo_fusion_stats_t *stats = &fusion_state->stats;
+    stats->last_us = (uint32_t)(ei_read_timer_us() - start_us);
+    if (stats->last_us > stats->max_us) {
+        stats->max_us = stats->last_us;
+    }
+    stats->frames++;
+
+    return EI_IMPULSE_OK;
+}
+
+static ei_fomo_fusion_state_t *ei_fomo_fusion_get_state(ei_impulse_handle_t *handle) {
+    int16_t block_number = get_block_number(handle, (void*)init_fomo_fusion);
+    if (block_number == -1 || handle->post_processing_state == NULL) {
+        return NULL;
+    }
+    return (ei_fomo_fusion_state_t*)handle->post_processing_state[block_number];
+}
+
+/**
+ * Frames fused so far and the cost of the fusion per frame
+ */
+EI_IMPULSE_ERROR get_fomo_fusion_stats(ei_impulse_handle_t *handle, ei_fomo_fusion_stats_t *stats) {
+    ei_fomo_fusion_state_t *fusion_state = ei_fomo_fusion_get_state(handle);
+    if (!fusion_state) {
+        return EI_IMPULSE_POSTPROCESSING_ERROR;
+    }
+
+    memcpy(stats, &fusion_state->stats, sizeof(ei_fomo_fusion_stats_t));
+    return EI_IMPULSE_OK;
+}
+
+/**
+ * Forget the previous frames, e.g. after the scene changed or inference paused;
+ * the next frame starts a new average
+ */
+EI_IMPULSE_ERROR reset_fomo_fusion(ei_impulse_handle_t *handle) {
+    ei_fomo_fusion_state_t *fusion_state = ei_fomo_fusion_get_state(handle);
+    if (!fusion_state) {
+        return EI_IMPULSE_POSTPROCESSING_ERROR;
+    }
+
+    ei_fomo_fusion_reset(fusion_state);
+    return EI_IMPULSE_OK;
+}
+
+// versions that operate on the default impulse
+EI_IMPULSE_ERROR get_fomo_fusion_stats(ei_fomo_fusion_stats_t *stats) {
+    return get_fomo_fusion_stats(&ei_default_impulse, stats);
+}
+
+EI_IMPULSE_ERROR reset_fomo_fusion() {
+    return reset_fomo_fusion(&ei_default_impulse);
+}
+
+#endif // EI_FOMO_FUSION_H
@@ -0,0 +1,244 @@
+/* The Clear BSD License
+ *
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EI_FOMO_LOGITS_H
+#define EI_FOMO_LOGITS_H
+
+/**
+ * FOMO with the final softmax of the graph left to the post-processing.
+ *
+ * Softmax is monotonic within a cell, and the confidence of a class can never exceed its
+ * two-way softmax against background:
+ *
+ *     p_c <= 1 / (1 + exp(beta * scale * (q_bg - q_c)))
+ *
+ * so a cell can only reach the threshold t when q_c - q_bg >= ln(t / (1 - t)) / (beta * scale).
+ * That bound is computed once as an integer, which rejects almost every cell with one
+ * subtraction per class and no float maths. Cells that pass go through the same int8 softmax
+ * the graph would have run, so the boxes are the ones process_fomo_i8 finds on the softmax output.
+ */
+
+#include <cmath>
+#include <limits>
+#include "edge-impulse-sdk/classifier/postprocessing/ei_postprocessing_common.h"
+#include "edge-impulse-sdk/tensorflow/lite/kernels/internal/quantization_util.h"
+#include "edge-impulse-sdk/tensorflow/lite/kernels/internal/reference/softmax.h"
+
+#if EI_HAS_FOMO
+
+// Longest cell (background + classes) the exact softmax handles on the stack
+#ifndef EI_FOMO_LOGITS_MAX_DEPTH
+#define EI_FOMO_LOGITS_MAX_DEPTH 32
+#endif // EI_FOMO_LOGITS_MAX_DEPTH
+
+typedef struct {
+    float threshold;          // threshold min_logit_delta was computed for
+    int32_t min_logit_delta;  // q_c - q_bg below this can't reach the threshold
+    float logits_scale;       // quantization scale of the logits tensor of the graph
+    tflite::SoftmaxParams softmax;
+    const ei_config_tflite_eon_graph_t *graph_config;  // to put the softmax back on deinit
+} ei_fomo_logits_state_t;
+
+static void ei_fomo_logits_update_threshold(ei_fomo_logits_state_t *state,
+                                            const ei_fill_result_fomo_i8_logits_config_t *config) {
+    // the int8 softmax rounds, and approximates exp, so keep two output steps of margin
+    const double t = (double)config->threshold - 2.0 * (double)config->scale;
+    const double logit_step = (double)config->beta * (double)state->logits_scale;
+
+    state->threshold = config->threshold;
+    if (t <= 0.0) {
+        // every cell may pass (two int8 logits are at most 255 apart)
+        state->min_logit_delta = -256;
+    }
+    else if (t >= 1.0) {
+        state->min_logit_delta = 256;
+    }
+    else {
+        const double delta = std::floor(std::log(t / (1.0 - t)) / logit_step);
+        state->min_logit_delta = (int32_t)std::max(-256.0, std::min(256.0, delta));
+    }
+}
+
+EI_IMPULSE_ERROR init_fomo_i8_logits(ei_impulse_handle_t *handle, void **state, void *config)
+{
+    const ei_impulse_t *impulse = handle->impulse;
+    const ei_fill_result_fomo_i8_logits_config_t *fomo_config = (ei_fill_result_fomo_i8_logits_config_t*)config;
+
+    if (impulse->label_count + 1 > EI_FOMO_LOGITS_MAX_DEPTH) {
+        ei_printf("ERR: FOMO on logits supports up to %d classes\n", EI_FOMO_LOGITS_MAX_DEPTH - 1);
+        return EI_IMPULSE_POSTPROCESSING_ERROR;
+    }
+
+    // ask the learning block that feeds us to stop before its softmax
+    int16_t block_number = get_block_number(handle, (void*)init_fomo_i8_logits);
+    if (block_number == -1) {
+        return EI_IMPULSE_POSTPROCESSING_ERROR;
+    }
+    const uint32_t input_block_id = impulse->postprocessing_blocks[block_number].input_block_id;
+
+    const ei_learning_block_config_tflite_graph_t *block_config = NULL;
+    const ei_config_tflite_eon_graph_t *graph_config = NULL;
+    for (size_t ix = 0; ix < impulse->learning_blocks_size; ix++) {
+        if (impulse->learning_blocks[ix].blockId != input_block_id) {
+            continue;
+        }
+        const ei_learning_block_config_tflite_graph_t *config =
+            (ei_learning_block_config_tflite_graph_t*)impulse->learning_blocks[ix].config;
+        if (config->compiled && !config->dequantize_output) {
+            block_config = config;
+            graph_config = (ei_config_tflite_eon_graph_t*)config->graph_config;
+        }
+    }
+    if (!graph_config || !graph_config->model_skip_final_softmax ||
+        graph_config->model_skip_final_softmax(true) != kTfLiteOk) {
+        ei_printf("ERR: learning block %u can't skip its final softmax\n", (unsigned)input_block_id);
+        return EI_IMPULSE_POSTPROCESSING_ERROR;
+    }
+
+    // with the softmax skipped the output is the logits tensor, with its own quantization; the
+    // zero point cancels out in q_c - q_bg and in the softmax, only the scale matters
+    TfLiteTensor logits;
+    if (graph_config->model_output(block_config->output_tensors_indices[0], &logits) != kTfLiteOk ||
+        logits.type != kTfLiteInt8 || logits.quantization.type != kTfLiteAffineQuantization ||
+        !(logits.params.scale > 0.0f)) {
+        ei_printf("ERR: logits of learning block %u are not int8 with a per-tensor scale\n", (unsigned)input_block_id);
+        graph_config->model_skip_final_softmax(false);
+        return EI_IMPULSE_POSTPROCESSING_ERROR;
+    }
+
+    ei_fomo_logits_state_t *fomo_state = (ei_fomo_logits_state_t*)ei_calloc(1, sizeof(ei_fomo_logits_state_t));
+    if (!fomo_state) {
+        graph_config->model_skip_final_softmax(false);
+        return EI_IMPULSE_OUT_OF_MEMORY;
+    }
+
+    // same parameters as CalculateSoftmaxParams derives for an int8 -> int8 softmax
+    static const int kScaledDiffIntegerBits = 5;
+    int input_left_shift;
+    tflite::PreprocessSoftmaxScaling(
+        static_cast<double>(fomo_config->beta),
+        static_cast<double>(logits.params.scale), kScaledDiffIntegerBits,
+        &fomo_state->softmax.input_multiplier, &input_left_shift);
+    fomo_state->softmax.input_left_shift = input_left_shift;
+    fomo_state->softmax.diff_min =
+        -1.0 * tflite::CalculateInputRadius(kScaledDiffIntegerBits, input_left_shift);
+
+    fomo_state->logits_scale = logits.params.scale;
+    ei_fomo_logits_update_threshold(fomo_state, fomo_config);
+    fomo_state->graph_config = graph_config;
+
+    *state = (void*)fomo_state;
+
+    return EI_IMPULSE_OK;
+}
+
+EI_IMPULSE_ERROR deinit_fomo_i8_logits(void *state, void *config)
+{
+    ei_fomo_logits_state_t *fomo_state = (ei_fomo_logits_state_t*)state;
+
+    if (fomo_state) {
+        fomo_state->graph_config->model_skip_final_softmax(false);
+        ei_free(fomo_state);
+    }
+
+    return EI_IMPULSE_OK;
+}
+
+__attribute__((unused)) static EI_IMPULSE_ERROR process_fomo_i8_logits(ei_impulse_handle_t *handle,
+                                                                    uint32_t block_index,
+                                                                    uint32_t input_block_id,
+                                                                    ei_impulse_result_t *result,
+                                                                    void *config_ptr,
+                                                                    void *state) {
+    const ei_impulse_t *impulse = handle->impulse;
+    const ei_fill_result_fomo_i8_logits_config_t *config = (ei_fill_result_fomo_i8_logits_config_t*)config_ptr;
+    ei_fomo_logits_state_t *fomo_state = (ei_fomo_logits_state_t*)state;
+
+    if (!fomo_state) {
+        ei_printf("ERR: FOMO on logits needs run_classifier_init() to be called first\n");
+        return EI_IMPULSE_POSTPROCESSING_ERROR;
+    }
+    // set_threshold_postprocessing writes into the config
+    if (fomo_state->threshold != config->threshold) {
+        ei_fomo_logits_update_threshold(fomo_state, config);
+    }
+
+    std::vector<ei_classifier_cube_t*> cubes;
+
+    int out_width_factor = impulse->input_width / config->out_width;
+
+    ei::matrix_i8_t* raw_output_mtx = NULL;
+    bool find_mtx_res = find_mtx_by_idx(result->_raw_outputs, &raw_output_mtx, input_block_id, impulse->output_tensors_size);
+    if (!find_mtx_res) {
+        return EI_IMPULSE_OUTPUT_TENSOR_NULL;
+    }
+
+    const int depth = impulse->label_count + 1;
+    const int32_t min_logit_delta = fomo_state->min_logit_delta;
+    const tflite::RuntimeShape cell_shape({ 1, depth });
+    int8_t probs[EI_FOMO_LOGITS_MAX_DEPTH];
+
+    for (size_t y = 0; y < config->out_width; y++) {
+        for (size_t x = 0; x < config->out_height; x++) {
+            size_t loc = ((y * config->out_height) + x) * depth;
+            const int8_t *logits = &raw_output_mtx->buffer[loc];
+
+            bool candidate = false;
+            for (int ix = 1; ix < depth; ix++) {
+                if ((int32_t)logits[ix] - (int32_t)logits[0] >= min_logit_delta) {
+                    candidate = true;
+                    break;
+                }
+            }
+            if (!candidate) {
+                continue;
+            }
+
+            tflite::reference_ops::Softmax(fomo_state->softmax, cell_shape, logits, cell_shape, probs);
+
+            for (int ix = 1; ix < depth; ix++) {
+                float vf = static_cast<float>(probs[ix] - config->zero_point) * config->scale;
+
+                ei_handle_cube(&cubes, x, y, vf, impulse->categories[ix - 1], config->threshold);
+            }
+        }
+    }
+
+    process_cubes(result, &cubes, out_width_factor, config->object_detection_count);
+
+    return EI_IMPULSE_OK;
+}
+
+#endif // EI_HAS_FOMO
+#endif // EI_FOMO_LOGITS_H
@@ -0,0 +1,298 @@
+/* The Clear BSD License
+ *
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EI_LABEL_TOTALS_H
+#define EI_LABEL_TOTALS_H
+
+/**
+ * Running totals of the values of detected objects, e.g. the sum of the banknotes that
+ * went past the camera.
+ *
+ * Each label has an integer value. An object is followed from frame to frame by its label
+ * and centroid, and its value is added once, after it was seen in confirm_frames frames,
+ * so an object that stays in view isn't counted again on every inference. The totals are
+ * kept in a fixed struct that can be copied out at any time.
+ */
+
+#include <string.h>
+#include "edge-impulse-sdk/classifier/postprocessing/ei_postprocessing_common.h"
+
+extern ei_impulse_handle_t & ei_default_impulse;
+
+// Most labels that are totalled separately
+#ifndef EI_LABEL_TOTALS_MAX_LABELS
+#if EI_CLASSIFIER_LABEL_COUNT > 0
+#define EI_LABEL_TOTALS_MAX_LABELS EI_CLASSIFIER_LABEL_COUNT
+#else
+#define EI_LABEL_TOTALS_MAX_LABELS 1
+#endif
+#endif // EI_LABEL_TOTALS_MAX_LABELS
+
+// Most objects followed between frames
+#ifndef EI_LABEL_TOTALS_MAX_OBJECTS
+#define EI_LABEL_TOTALS_MAX_OBJECTS 16
+#endif // EI_LABEL_TOTALS_MAX_OBJECTS
+
+typedef struct {
+    uint32_t total;                                 // sum of the values of all counted objects
+    uint32_t objects;                               // number of counted objects
+    uint32_t frames;                                // inferences since the last reset
+    uint16_t label_count;                           // entries used in counts
+    uint16_t in_view;                               // objects followed right now
+    uint32_t counts[EI_LABEL_TOTALS_MAX_LABELS];    // counted objects per label
+} ei_label_totals_t;
+
+typedef struct {
+    uint16_t cx;
+    uint16_t cy;
+    int16_t label_ix;       // -1 for a free slot
+    uint8_t seen;
+    uint8_t missed;
+    bool counted;
+    bool matched;
+} ei_label_totals_object_t;
+
+typedef struct {
+    ei_label_totals_t totals;
+    ei_label_totals_object_t objects[EI_LABEL_TOTALS_MAX_OBJECTS];
+} ei_label_totals_state_t;
+
+static void ei_label_totals_reset(ei_label_totals_state_t *state) {
+    uint16_t label_count = state->totals.label_count;
+    memset(state, 0, sizeof(ei_label_totals_state_t));
+    state->totals.label_count = label_count;
+    for (size_t ix = 0; ix < EI_LABEL_TOTALS_MAX_OBJECTS; ix++) {
+        state->objects[ix].label_ix = -1;
+    }
+}
+
+EI_IMPULSE_ERROR init_label_totals(ei_impulse_handle_t *handle, void **state, void *config)
+{
+    const ei_impulse_t *impulse = handle->impulse;
+    const ei_label_totals_config_t *totals_config = (ei_label_totals_config_t*)config;
+
+    if (impulse->label_count > EI_LABEL_TOTALS_MAX_LABELS) {
+        ei_printf("ERR: label totals support up to %d labels (increase EI_LABEL_TOTALS_MAX_LABELS)\n",
+            EI_LABEL_TOTALS_MAX_LABELS);
+        return EI_IMPULSE_POSTPROCESSING_ERROR;
+    }
+    if (totals_config->label_values_size != impulse->label_count) {
+        ei_printf("ERR: label totals have %u values for %u labels\n",
+            (unsigned)totals_config->label_values_size, (unsigned)impulse->label_count);
+        return EI_IMPULSE_POSTPROCESSING_ERROR;
+    }
+
+    ei_label_totals_state_t *totals_state = (ei_label_totals_state_t*)ei_calloc(1, sizeof(ei_label_totals_state_t));
+    if (!totals_state) {
+        return EI_IMPULSE_OUT_OF_MEMORY;
+    }
+    totals_state->totals.label_count = impulse->label_count;
+    ei_label_totals_reset(totals_state);
+
+    *state = (void*)totals_state;
+
+    return EI_IMPULSE_OK;
+}
+
+EI_IMPULSE_ERROR deinit_label_totals(void *state, void *config)
+{
+    if (state) {
+        ei_free(state);
+    }
+
+    return EI_IMPULSE_OK;
+}
+
+static int ei_label_totals_label_index(const ei_impulse_t *impulse, const char *label) {
+    // boxes point at the categories, so comparing pointers is enough
+    for (size_t ix = 0; ix < impulse->label_count; ix++) {
+        if (impulse->categories[ix] == label) {
+            return (int)ix;
+        }
+    }
+    for (size_t ix = 0; ix < impulse->label_count; ix++) {
+        if (strcmp(impulse->categories[ix], label) == 0) {
+            return (int)ix;
+        }
+    }
+    return -1;
+}
+
+__attribute__((unused)) static EI_IMPULSE_ERROR process_label_totals(ei_impulse_handle_t *handle,
+                                                                  uint32_t block_index,
+                                                                  uint32_t input_block_id,
+                                                                  ei_impulse_result_t *result,
+                                                                  void *config_ptr,
+                                                                  void *state) {
+    const ei_impulse_t *impulse = handle->impulse;
+    const ei_label_totals_config_t *config = (ei_label_totals_config_t*)config_ptr;
+    ei_label_totals_state_t *totals_state = (ei_label_totals_state_t*)state;
+
+    if (!totals_state) {
+        ei_printf("ERR: label totals need run_classifier_init() to be called first\n");
+        return EI_IMPULSE_POSTPROCESSING_ERROR;
+    }
+
+    ei_label_totals_object_t *objects = totals_state->objects;
+    for (size_t ox = 0; ox < EI_LABEL_TOTALS_MAX_OBJECTS; ox++) {
+        objects[ox].matched = false;
+    }
+
+    for (size_t ix = 0; ix < result->bounding_boxes_count; ix++) {
+        const ei_impulse_result_bounding_box_t *bb = &result->bounding_boxes[ix];
+        if (bb->value < config->threshold || !bb->label) {
+            continue;
+        }
+        int label_ix = ei_label_totals_label_index(impulse, bb->label);
+        if (label_ix < 0 || config->label_values[label_ix] == 0) {
+            continue;
+        }
+        const int32_t cx = (int32_t)(bb->x + bb->width / 2);
+        const int32_t cy = (int32_t)(bb->y + bb->height / 2);
+
+        // closest object of the same label that hasn't been matched in this frame yet
+        int best_ox = -1;
+        int32_t best_distance = (int32_t)config->match_distance + 1;
+        int free_ox = -1;
+        for (size_t ox = 0; ox < EI_LABEL_TOTALS_MAX_OBJECTS; ox++) {
+            const ei_label_totals_object_t *obj = &objects[ox];
+            if (obj->label_ix < 0) {
+                if (free_ox < 0) {
+                    free_ox = (int)ox;
+                }
+                continue;
+            }
+            if (obj->label_ix != label_ix || obj->matched) {
+                continue;
+            }
+            const int32_t dx = obj->cx > cx ? obj->cx - cx : cx - obj->cx;
+            const int32_t dy = obj->cy > cy ? obj->cy - cy : cy - obj->cy;
+            const int32_t distance = dx > dy ? dx : dy;
+            if (distance < best_distance) {
+                best_distance = distance;
+                best_ox = (int)ox;
+            }
+        }
+
+        if (best_ox < 0) {
+            if (free_ox < 0) {
+                // every slot is taken, it's picked up once one frees
+                continue;
+            }
+            best_ox = free_ox;
+            objects[best_ox].label_ix = (int16_t)label_ix;
+            objects[best_ox].seen = 0;
+            objects[best_ox].counted = false;
+        }
+
+        ei_label_totals_object_t *obj = &objects[best_ox];
+        obj->cx = (uint16_t)cx;
+        obj->cy = (uint16_t)cy;
+        obj->missed = 0;
+        obj->matched = true;
+        if (obj->seen < UINT8_MAX) {
+            obj->seen++;
+        }
+    }
+
+    uint16_t in_view = 0;
+    for (size_t ox = 0; ox < EI_LABEL_TOTALS_MAX_OBJECTS; ox++) {
+        ei_label_totals_object_t *obj = &objects[ox];
+        if (obj->label_ix < 0) {
+            continue;
+        }
+        if (!obj->matched) {
+            if (++obj->missed > config->hold_frames) {
+                obj->label_ix = -1;
+            }
+            continue;
+        }
+        in_view++;
+        if (!obj->counted && obj->seen >= config->confirm_frames) {
+            obj->counted = true;
+            totals_state->totals.total += (uint32_t)config->label_values[obj->label_ix];
+            totals_state->totals.objects++;
+            totals_state->totals.counts[obj->label_ix]++;
+        }
+    }
+    totals_state->totals.in_view = in_view;
+    totals_state->totals.frames++;
+
+    return EI_IMPULSE_OK;
+}
+
+/**
+ * Copy the running totals out of the label totals block
+ */
+EI_IMPULSE_ERROR get_label_totals(ei_impulse_handle_t *handle, ei_label_totals_t *totals) {
+    int16_t block_number = get_block_number(handle, (void*)init_label_totals);
+    if (block_number == -1 || handle->post_processing_state == NULL) {
+        return EI_IMPULSE_POSTPROCESSING_ERROR;
+    }
+    ei_label_totals_state_t *totals_state = (ei_label_totals_state_t*)handle->post_processing_state[block_number];
+    if (!totals_state) {
+        return EI_IMPULSE_POSTPROCESSING_ERROR;
+    }
+
+    memcpy(totals, &totals_state->totals, sizeof(ei_label_totals_t));
+    return EI_IMPULSE_OK;
+}
+
+/**
+ * Start a new session: clear the totals and forget the objects in view
+ */
+EI_IMPULSE_ERROR reset_label_totals(ei_impulse_handle_t *handle) {
+    int16_t block_number = get_block_number(handle, (void*)init_label_totals);
+    if (block_number == -1 || handle->post_processing_state == NULL) {
+        return EI_IMPULSE_POSTPROCESSING_ERROR;
+    }
+    ei_label_totals_state_t *totals_state = (ei_label_totals_state_t*)handle->post_processing_state[block_number];
+    if (!totals_state) {
+        return EI_IMPULSE_POSTPROCESSING_ERROR;
+    }
+
+    ei_label_totals_reset(totals_state);
+    return EI_IMPULSE_OK;
+}
+
+// versions that operate on the default impulse
+EI_IMPULSE_ERROR get_label_totals(ei_label_totals_t *totals) {
+    return get_label_totals(&ei_default_impulse, totals);
+}
+
+EI_IMPULSE_ERROR reset_label_totals() {
+    return reset_label_totals(&ei_default_impulse);
+}
+
+#endif // EI_LABEL_TOTALS_H
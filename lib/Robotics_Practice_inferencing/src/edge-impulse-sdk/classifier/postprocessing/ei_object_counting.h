@@ -36,6 +36,7 @@
 #define EI_OBJECT_COUNTING_H
 
 /* Includes ---------------------------------------------------------------- */
+#include <cstring>
 #include "edge-impulse-sdk/dsp/numpy_types.h"
 #include "edge-impulse-sdk/dsp/returntypes.hpp"
 #include "edge-impulse-sdk/classifier/ei_model_types.h"
@@ -43,52 +44,204 @@
 
 extern ei_impulse_handle_t & ei_default_impulse;
 
-#if EI_CLASSIFIER_OBJECT_COUNTING_ENABLED == 1
+// Most counting lines the counter holds
+#ifndef EI_OBJECT_COUNTING_MAX_SEGMENTS
+#define EI_OBJECT_COUNTING_MAX_SEGMENTS         8
+#endif
+
+// Most labels counted separately, objects with any other label only add to the line totals
+#ifndef EI_OBJECT_COUNTING_MAX_LABELS
+#if EI_CLASSIFIER_LABEL_COUNT > 0
+#define EI_OBJECT_COUNTING_MAX_LABELS           EI_CLASSIFIER_LABEL_COUNT
+#else
+#define EI_OBJECT_COUNTING_MAX_LABELS           1
+#endif
+#endif
+
+// Coordinates are clamped to +/- this, which keeps every orientation test exact in int32
+#define EI_OBJECT_COUNTING_COORD_LIMIT          8191
 
+/**
+ * Counts tracked objects whose centroid crosses one of a fixed set of lines.
+ *
+ * The segments are copied into fixed arrays at init, together with their line equation
+ * (dx, dy, k), so the side of a point P is the sign of dx * P.y - dy * P.x - k. Every
+ * test is integer and exact, and a movement is only tested against the lines whose
+ * bounding box it overlaps. Crossings are counted per line and per label, so the
+ * totals per class are ready without a pass over the traces afterwards.
+ */
 class CrossingCounter {
 public:
-    CrossingCounter(std::vector<std::tuple<int, int, int, int>> segments) : segments(segments) {
-        counts.resize(segments.size(), 0);
+    CrossingCounter(const std::vector<std::tuple<int, int, int, int>> &segments,
+                    const char * const *labels, size_t labels_count) {
+        this->labels = labels;
+        this->labels_count = labels_count < EI_OBJECT_COUNTING_MAX_LABELS ?
+            labels_count : EI_OBJECT_COUNTING_MAX_LABELS;
+        this->segments_count = 0;
+        set_segments(segments);
+    }
+
+    /**
+     * Replace the counting lines. The counts are kept when the number of lines
+     * stays the same, and cleared otherwise.
+     * @returns false if there are more segments than EI_OBJECT_COUNTING_MAX_SEGMENTS
+     */
+    bool set_segments(const std::vector<std::tuple<int, int, int, int>> &new_segments) {
+        if (new_segments.size() > EI_OBJECT_COUNTING_MAX_SEGMENTS) {
+            EI_LOGE("Object counting supports %d segments, got %d (increase EI_OBJECT_COUNTING_MAX_SEGMENTS)\n",
+                (int)EI_OBJECT_COUNTING_MAX_SEGMENTS, (int)new_segments.size());
+            return false;
+        }
+
+        if (new_segments.size() != segments_count) {
+            segments_count = new_segments.size();
+            reset();
+        }
+
+        for (size_t ix = 0; ix < segments_count; ix++) {
+            segment_t &s = segments[ix];
+            s.ax = clamp(std::get<0>(new_segments[ix]));
+            s.ay = clamp(std::get<1>(new_segments[ix]));
+            s.bx = clamp(std::get<2>(new_segments[ix]));
+            s.by = clamp(std::get<3>(new_segments[ix]));
+            s.dx = s.bx - s.ax;
+            s.dy = s.by - s.ay;
+            s.k = s.dx * s.ay - s.dy * s.ax;
+            s.min_x = s.ax < s.bx ? s.ax : s.bx;
+            s.max_x = s.ax < s.bx ? s.bx : s.ax;
+            s.min_y = s.ay < s.by ? s.ay : s.by;
+            s.max_y = s.ay < s.by ? s.by : s.ay;
+        }
+        return true;
+    }
+
+    void get_segments(std::vector<std::tuple<int, int, int, int>> &out) const {
+        out.clear();
+        for (size_t ix = 0; ix < segments_count; ix++) {
+            out.emplace_back(segments[ix].ax, segments[ix].ay, segments[ix].bx, segments[ix].by);
+        }
+    }
+
+    void reset() {
+        memset(counts, 0, sizeof(counts));
+        memset(label_counts, 0, sizeof(label_counts));
+    }
+
+    /**
+     * Count the crossings of all open traces of one frame.
+     */
+    template<typename Trace>
+    void update(const Trace *traces, size_t traces_count) {
+        for (size_t ix = 0; ix < traces_count; ix++) {
+            const auto &movement = traces[ix].last_centroid_segment;
+            update(std::get<0>(movement), std::get<1>(movement),
+                   std::get<2>(movement), std::get<3>(movement),
+                   label_index(traces[ix].label));
+        }
+    }
+
+    /**
+     * Count the crossings of one centroid moving from (x0, y0) to (x1, y1).
+     * @param label_ix Index of the object's label, or -1 to only add to the line totals
+     */
+    void update(int x0, int y0, int x1, int y1, int label_ix) {
+        int32_t cx = clamp(x0), cy = clamp(y0);
+        int32_t dx = clamp(x1), dy = clamp(y1);
+        if (cx == dx && cy == dy) {
+            return;
+        }
+
+        int32_t min_x = cx < dx ? cx : dx, max_x = cx < dx ? dx : cx;
+        int32_t min_y = cy < dy ? cy : dy, max_y = cy < dy ? dy : cy;
+        // the movement as a line, same form as the segments
+        int32_t mdx = dx - cx, mdy = dy - cy;
+        int32_t mk = mdx * cy - mdy * cx;
+
+        for (size_t ix = 0; ix < segments_count; ix++) {
+            const segment_t &s = segments[ix];
+            // segments can't intersect if their bounding boxes don't
+            if (max_x < s.min_x || min_x > s.max_x || max_y < s.min_y || min_y > s.max_y) {
+                continue;
+            }
+            // C and D on opposite sides of AB, and A and B on opposite sides of CD
+            bool c_side = s.dx * cy - s.dy * cx > s.k;
+            bool d_side = s.dx * dy - s.dy * dx > s.k;
+            if (c_side == d_side) {
+                continue;
+            }
+            bool a_side = mdx * s.ay - mdy * s.ax > mk;
+            bool b_side = mdx * s.by - mdy * s.bx > mk;
+            if (a_side == b_side) {
+                continue;
+            }
+
+            counts[ix]++;
+            if (label_ix >= 0) {
+                label_counts[ix][label_ix]++;
+            }
+        }
     }
 
-    void update(std::tuple<int, int, int, int> other_segment) {
-        for (size_t segment_idx = 0; segment_idx < segments.size(); segment_idx++) {
-            if (_line_intersects(segments[segment_idx], other_segment)) {
-                counts[segment_idx] += 1;
+    /**
+     * @returns Index of label in the impulse categories, or -1 if it's not counted per label
+     */
+    int label_index(const char *label) const {
+        if (!label) {
+            return -1;
+        }
+        // trace labels point into the categories array, so the pointers usually match
+        for (size_t ix = 0; ix < labels_count; ix++) {
+            if (labels[ix] == label) {
+                return (int)ix;
+            }
+        }
+        for (size_t ix = 0; ix < labels_count; ix++) {
+            if (strcmp(labels[ix], label) == 0) {
+                return (int)ix;
             }
         }
+        return -1;
     }
 
-    std::vector<uint32_t> counts;
-    std::vector<std::tuple<int, int, int, int>> segments;
+    size_t segments_count;
+    size_t labels_count;
+    uint32_t counts[EI_OBJECT_COUNTING_MAX_SEGMENTS];
+    uint32_t label_counts[EI_OBJECT_COUNTING_MAX_SEGMENTS][EI_OBJECT_COUNTING_MAX_LABELS];
+
 private:
-    bool ccw(int A[2], int B[2], int C[2]) {
-        return (C[1] - A[1]) * (B[0] - A[0]) > (B[1] - A[1]) * (C[0] - A[0]);
-    }
-
-    bool _line_intersects(std::tuple<int, int, int, int> L1, std::tuple<int, int, int, int> L2) {
-        int A[2] = { std::get<0>(L1), std::get<1>(L1) };
-        int B[2] = { std::get<2>(L1), std::get<3>(L1) };
-        int C[2] = { std::get<0>(L2), std::get<1>(L2) };
-        int D[2] = { std::get<2>(L2), std::get<3>(L2) };
-// verbose debug
-#if EI_LOG_LEVEL == 5
-        ei_printf("A[0] = %d A[1] = %d\n", A[0], A[1]);
-        ei_printf("B[0] = %d B[1] = %d\n", B[0], B[1]);
-        ei_printf("C[0] = %d C[1] = %d\n", C[0], C[1]);
-        ei_printf("D[0] = %d D[1] = %d\n", D[0], D[1]);
-#endif
-        return ccw(A, C, D) != ccw(B, C, D) && ccw(A, B, C) != ccw(A, B, D);
+    typedef struct {
+        int32_t ax, ay, bx, by;
+        int32_t dx, dy, k;
+        int32_t min_x, max_x, min_y, max_y;
+    } segment_t;
+
+    static int32_t clamp(int v) {
+        if (v > EI_OBJECT_COUNTING_COORD_LIMIT) return EI_OBJECT_COUNTING_COORD_LIMIT;
+        if (v < -EI_OBJECT_COUNTING_COORD_LIMIT) return -EI_OBJECT_COUNTING_COORD_LIMIT;
+        return v;
     }
+
+    segment_t segments[EI_OBJECT_COUNTING_MAX_SEGMENTS];
+    const char * const *labels;
 };
 
+// The counter itself has no dependency on the tracker, so it builds on its own (tools/crossing_check.cpp)
+#if EI_CLASSIFIER_OBJECT_COUNTING_ENABLED == 1
+
 EI_IMPULSE_ERROR init_object_counting(ei_impulse_handle_t *handle, void **state, void *config)
 {
-    // const ei_impulse_t *impulse = handle->impulse;
+    const ei_impulse_t *impulse = handle->impulse;
     const ei_object_counting_config_t *object_counting_config = (ei_object_counting_config_t*)config;
 
+    if (object_counting_config->segments.size() > EI_OBJECT_COUNTING_MAX_SEGMENTS) {
+        EI_LOGE("Object counting supports %d segments, got %d (increase EI_OBJECT_COUNTING_MAX_SEGMENTS)\n",
+            (int)EI_OBJECT_COUNTING_MAX_SEGMENTS, (int)object_counting_config->segments.size());
+        return EI_IMPULSE_POSTPROCESSING_ERROR;
+    }
+
     // Allocate the object counter
-    CrossingCounter *object_counter = new CrossingCounter(object_counting_config->segments);
+    CrossingCounter *object_counter = new CrossingCounter(object_counting_config->segments,
+        impulse->categories, impulse->label_count);
 
     if (!object_counter) {
         return EI_IMPULSE_POSTPROCESSING_ERROR;
@@ -123,13 +276,14 @@ EI_IMPULSE_ERROR process_object_counting(ei_impulse_handle_t *handle,
 
     if (impulse->sensor == EI_CLASSIFIER_SENSOR_CAMERA) {
         if((void *)object_counter != NULL) {
-            for (size_t i = 0; i < result->postprocessed_output.object_tracking_output.open_traces_count; i++) {
-                ei_object_tracking_trace_t trace = result->postprocessed_output.object_tracking_output.open_traces[i];
-                object_counter->update(trace.last_centroid_segment);
-            }
+            object_counter->update(result->postprocessed_output.object_tracking_output.open_traces,
+                                   result->postprocessed_output.object_tracking_output.open_traces_count);
 
-            result->postprocessed_output.object_counting_output.counts = object_counter->counts.data();
-            result->postprocessed_output.object_counting_output.counter_num = object_counter->counts.size();
+            result->postprocessed_output.object_counting_output.counts = object_counter->counts;
+            result->postprocessed_output.object_counting_output.counter_num = object_counter->segments_count;
+        }
+        else {
+            EI_LOGW("process_object_counting: object_counter is NULL, did you forget to call run_classifier_init()?\n");
         }
     }
 
@@ -155,7 +309,9 @@ EI_IMPULSE_ERROR set_post_process_params(ei_impulse_handle_t* handle, ei_object_
     }
     CrossingCounter *object_counter = (CrossingCounter*)handle->post_processing_state[block_number];
 
-    object_counter->segments = params->segments;
+    if (!object_counter->set_segments(params->segments)) {
+        return EI_IMPULSE_POSTPROCESSING_ERROR;
+    }
     return EI_IMPULSE_OK;
 }
 
@@ -166,7 +322,42 @@ EI_IMPULSE_ERROR get_post_process_params(ei_impulse_handle_t* handle, ei_object_
     }
     CrossingCounter *object_counter = (CrossingCounter*)handle->post_processing_state[block_number];
 
-    params->segments = object_counter->segments;
+    object_counter->get_segments(params->segments);
+    return EI_IMPULSE_OK;
+}
+
+/**
+ * Get the crossings of one line, per label.
+ * @param segment_ix Index of the line
+ * @param label_counts Set to an array with one count per label, in the order of the impulse categories
+ * @param label_counts_size Set to the number of labels in label_counts
+ */
+EI_IMPULSE_ERROR get_object_counts(ei_impulse_handle_t* handle, size_t segment_ix,
+                                   const uint32_t **label_counts, size_t *label_counts_size) {
+    int16_t block_number = get_block_number(handle, (void*)init_object_counting);
+    if (block_number == -1) {
+        return EI_IMPULSE_POSTPROCESSING_ERROR;
+    }
+    CrossingCounter *object_counter = (CrossingCounter*)handle->post_processing_state[block_number];
+
+    if (!object_counter || segment_ix >= object_counter->segments_count) {
+        return EI_IMPULSE_POSTPROCESSING_ERROR;
+    }
+    *label_counts = object_counter->label_counts[segment_ix];
+    *label_counts_size = object_counter->labels_count;
+    return EI_IMPULSE_OK;
+}
+
+EI_IMPULSE_ERROR reset_object_counts(ei_impulse_handle_t* handle) {
+    int16_t block_number = get_block_number(handle, (void*)init_object_counting);
+    if (block_number == -1) {
+        return EI_IMPULSE_POSTPROCESSING_ERROR;
+    }
+    CrossingCounter *object_counter = (CrossingCounter*)handle->post_processing_state[block_number];
+
+    if (object_counter) {
+        object_counter->reset();
+    }
     return EI_IMPULSE_OK;
 }
 
@@ -189,5 +380,23 @@ EI_IMPULSE_ERROR get_post_process_params(ei_object_counting_config_t *params) {
     return EI_IMPULSE_OK;
 }
 
+EI_IMPULSE_ERROR get_object_counts(size_t segment_ix, const uint32_t **label_counts, size_t *label_counts_size) {
+    ei_impulse_handle_t* handle = &ei_default_impulse;
+
+    if(handle->post_processing_state == NULL) {
+        return EI_IMPULSE_POSTPROCESSING_ERROR;
+    }
+    return get_object_counts(handle, segment_ix, label_counts, label_counts_size);
+}
+
+EI_IMPULSE_ERROR reset_object_counts() {
+    ei_impulse_handle_t* handle = &ei_default_impulse;
+
+    if(handle->post_processing_state != NULL) {
+        reset_object_counts(handle);
+    }
+    return EI_IMPULSE_OK;
+}
+
 #endif // EI_CLASSIFIER_OBJECT_COUNTING_ENABLED
 #endif // EI_OBJECT_COUNTING_H
\ No newline at end of file
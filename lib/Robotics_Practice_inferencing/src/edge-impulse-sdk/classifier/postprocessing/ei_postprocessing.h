@@ -50,6 +50,13 @@
 #include "edge-impulse-sdk/classifier/postprocessing/ei_object_counting.h"
 #endif
 
+#if (EI_CLASSIFIER_INFERENCING_ENGINE == EI_CLASSIFIER_TFLITE) && (EI_CLASSIFIER_COMPILED == 1)
+#include "edge-impulse-sdk/classifier/postprocessing/ei_fomo_logits.h"
+#endif
+
+#include "edge-impulse-sdk/classifier/postprocessing/ei_fomo_fusion.h"
+#include "edge-impulse-sdk/classifier/postprocessing/ei_label_totals.h"
+#include "edge-impulse-sdk/classifier/postprocessing/ei_detection_trigger.h"
 #include "edge-impulse-sdk/classifier/postprocessing/ei_postprocessing_thresholds.h"
 
 extern "C" EI_IMPULSE_ERROR init_postprocessing(ei_impulse_handle_t *handle) {
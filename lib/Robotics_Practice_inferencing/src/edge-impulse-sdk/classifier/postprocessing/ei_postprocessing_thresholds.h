@@ -47,6 +47,8 @@
 #if EI_CLASSIFIER_OBJECT_TRACKING_ENABLED == 1
 #include "edge-impulse-sdk/classifier/postprocessing/ei_object_tracking.h"
 #endif // EI_CLASSIFIER_OBJECT_TRACKING_ENABLED == 1
+#include "edge-impulse-sdk/classifier/postprocessing/ei_fomo_fusion.h"
+#include "edge-impulse-sdk/classifier/postprocessing/ei_label_totals.h"
 
 /**
  * @brief Get all configurable thresholds for a postprocessing block
@@ -175,6 +177,61 @@ EI_IMPULSE_ERROR get_thresholds_postprocessing(const ei_postprocessing_block_t *
     }
 #endif // EI_CLASSIFIER_OBJECT_TRACKING_ENABLED == 1
 
+    if (pp_block->init_fn == init_fomo_fusion) {
+        ei_fomo_fusion_config_t *config = (ei_fomo_fusion_config_t*)pp_block->config;
+
+        out_thresholds.push_back({
+            "fomo_fusion", /* type */
+            "shift", /* name */
+            static_cast<float>(config->shift), /* value */
+            [config](float v) {
+                config->shift = static_cast<uint8_t>(v < 0 ? 0 : v > 7 ? 7 : v);
+            }
+        });
+    }
+
+    if (pp_block->init_fn == init_label_totals) {
+        ei_label_totals_config_t *config = (ei_label_totals_config_t*)pp_block->config;
+
+        out_thresholds.push_back({
+            "label_totals", /* type */
+            "min_score", /* name */
+            config->threshold, /* value */
+            [config](float v) {
+                config->threshold = v;
+            }
+        });
+        out_thresholds.push_back({
+            "label_totals", /* type */
+            "match_distance", /* name */
+            static_cast<float>(config->match_distance), /* value */
+            [config](float v) {
+                config->match_distance = static_cast<uint16_t>(v);
+            }
+        });
+    }
+
+    if (pp_block->init_fn == init_detection_trigger) {
+        ei_detection_trigger_config_t *config = (ei_detection_trigger_config_t*)pp_block->config;
+
+        out_thresholds.push_back({
+            "detection_trigger", /* type */
+            "detection_threshold", /* name */
+            config->detection_threshold, /* value */
+            [config](float v) {
+                config->detection_threshold = v;
+            }
+        });
+        out_thresholds.push_back({
+            "detection_trigger", /* type */
+            "suppression_ms", /* name */
+            static_cast<float>(config->suppression_ms), /* value */
+            [config](float v) {
+                config->suppression_ms = static_cast<uint32_t>(v < 0 ? 0 : v);
+            }
+        });
+    }
+
     return EI_IMPULSE_OK;
 }
 
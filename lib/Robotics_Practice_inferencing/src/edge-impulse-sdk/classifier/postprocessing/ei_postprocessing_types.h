@@ -144,6 +144,39 @@ typedef struct {
     float scale;
 } ei_fill_result_fomo_i8_config_t;
 
+typedef struct {
+    float threshold;
+    uint16_t out_width;
+    uint16_t out_height;
+    uint32_t object_detection_count;
+    float zero_point;       // quantization of the softmax output
+    float scale;
+    float beta;
+} ei_fill_result_fomo_i8_logits_config_t;
+
+typedef struct {
+    float threshold;                // boxes below this confidence are ignored
+    const int32_t *label_values;    // value of each label, in the order of the categories (0 = not counted)
+    uint16_t label_values_size;
+    uint16_t match_distance;        // furthest a centroid moves between frames and is still the same object, in pixels
+    uint8_t confirm_frames;         // frames an object is seen before it's counted
+    uint8_t hold_frames;            // frames an object can go unseen before it's forgotten
+} ei_label_totals_config_t;
+
+typedef struct {
+    uint8_t shift;                  // the newest frame weighs 1 / 2^shift (0 = no fusion, up to 7)
+} ei_fomo_fusion_config_t;
+
+typedef struct {
+    float detection_threshold;              // averaged confidence that fires an event
+    uint32_t average_window_duration_ms;    // frames of the last this many ms are averaged (frame timestamps)
+    uint32_t suppression_ms;                // a label that fired stays quiet this long after it was last seen
+    uint32_t frame_interval_ms;             // shortest expected time between inferences, sizes the ring of frames
+    uint32_t suppression_flags;             // labels that can fire (bit per label), 0 = all
+    uint16_t grid_width;                    // output grid the detections are averaged on
+    uint16_t grid_height;
+} ei_detection_trigger_config_t;
+
 typedef struct {
     float threshold;
     uint16_t grid_size_x;
@@ -77,6 +77,22 @@
     #endif
 #endif // EIDSP_USE_NEON
 
+#ifndef EIDSP_USE_SSE2
+    #if defined(__SSE2__) || defined(_M_X64)
+        #define EIDSP_USE_SSE2      1
+    #else
+        #define EIDSP_USE_SSE2      0
+    #endif
+#endif // EIDSP_USE_SSE2
+
+#ifndef EIDSP_USE_AVX2
+    #if defined(__AVX2__)
+        #define EIDSP_USE_AVX2      1
+    #else
+        #define EIDSP_USE_AVX2      0
+    #endif
+#endif // EIDSP_USE_AVX2
+
 #ifndef EIDSP_USE_ASSERTS
 #define EIDSP_USE_ASSERTS        0
 #endif // EIDSP_USE_ASSERTS
@@ -110,6 +126,11 @@
 #define EIDSP_SIGNAL_C_FN_POINTER    0
 #endif // EIDSP_SIGNAL_C_FN_POINTER
 
+// floats read per get_data call (on the stack) by numpy::signal_get_data_strided
+#ifndef EIDSP_SIGNAL_PAGE_SIZE
+#define EIDSP_SIGNAL_PAGE_SIZE       128
+#endif // EIDSP_SIGNAL_PAGE_SIZE
+
 #ifndef EIDSP_USE_ESP_DSP
 #if defined(ESP32) || defined(CONFIG_IDF_TARGET_ESP32) || defined(CONFIG_IDF_TARGET_ESP32S3) || defined(CONFIG_IDF_TARGET_ESP32P4) || defined(CONFIG_IDF_TARGET_ESP32C3)
 #define EIDSP_USE_ESP_DSP 1
@@ -117,5 +138,15 @@
 #define EIDSP_USE_ESP_DSP 0
 #endif
 #endif
+
+// SSE2 / AVX2 numpy matrix primitives (dsp_engines/ei_x86_numpy.hpp) on x86 hosts without
+// another math engine. Set to 0 to run the scalar loops, e.g. to compare against them.
+#ifndef EIDSP_USE_X86_SIMD
+#if EIDSP_USE_SSE2 && !EIDSP_USE_CMSIS_DSP && !EIDSP_USE_ESP_DSP
+#define EIDSP_USE_X86_SIMD 1
+#else
+#define EIDSP_USE_X86_SIMD 0
+#endif
+#endif // EIDSP_USE_X86_SIMD
 // clang-format on
 #endif // _EIDSP_CPP_CONFIG_H_
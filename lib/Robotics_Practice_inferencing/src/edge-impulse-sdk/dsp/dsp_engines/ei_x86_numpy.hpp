@@ -0,0 +1,382 @@
+/*
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ *
+ * Generated by Edge Impulse and licensed under the applicable Edge Impulse
+ * Terms of Service. Community and Professional Terms of Service
+ * (https://edgeimpulse.com/legal/terms-of-service) or Enterprise Terms of
+ * Service (https://edgeimpulse.com/legal/enterprise-terms-of-service),
+ * according to your product plan subscription (the “License”).
+ *
+ * This software, documentation and other associated files (collectively referred
+ * to as the “Software”) is a single SDK variation generated by the Edge Impulse
+ * platform and requires an active paid Edge Impulse subscription to use this
+ * Software for any purpose.
+ *
+ * You may NOT use this Software unless you have an active Edge Impulse subscription
+ * that meets the eligibility requirements for the applicable License, subject to
+ * your full and continued compliance with the terms and conditions of the License,
+ * including without limitation any usage restrictions under the applicable License.
+ *
+ * If you do not have an active Edge Impulse product plan subscription, or if use
+ * of this Software exceeds the usage limitations of your Edge Impulse product plan
+ * subscription, you are not permitted to use this Software and must immediately
+ * delete and erase all copies of this Software within your control or possession.
+ * Edge Impulse reserves all rights and remedies available to enforce its rights.
+ *
+ * Unless required by applicable law or agreed to in writing, the Software is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language governing
+ * permissions, disclaimers and limitations under the License.
+ */
+#ifndef _EIDSP_X86_NUMPY_H_
+#define _EIDSP_X86_NUMPY_H_
+
+/**
+ * SSE2 / AVX2 kernels for the numpy matrix primitives on x86 hosts (EIDSP_USE_X86_SIMD).
+ * Vectors run across output values, so dot products, the elementwise ops and the axis 0
+ * reductions add in the same order as the scalar loops and give the same floats
+ * (unless the compiler contracts the scalar loops into FMA). Only rms reduces along a
+ * row in vector lanes, and differs from the scalar sum in the last bits.
+ */
+
+#include "edge-impulse-sdk/dsp/numpy_types.h"
+#include "edge-impulse-sdk/dsp/returntypes.hpp"
+#include <stdint.h>
+#include <stddef.h>
+#include <math.h>
+
+#if EIDSP_USE_AVX2
+#include <immintrin.h>
+#else
+#include <emmintrin.h>
+#endif
+
+// Transpose tile edge in floats, two 32x32 tiles (8 KiB) stay in L1
+#ifndef EIDSP_X86_TRANSPOSE_TILE
+#define EIDSP_X86_TRANSPOSE_TILE 32
+#endif
+
+namespace ei {
+
+#if EIDSP_USE_AVX2
+typedef __m256 x86_f32_t;
+static constexpr size_t X86_F32_LANES = 8;
+static inline x86_f32_t x86_load(const float *p) { return _mm256_loadu_ps(p); }
+static inline void x86_store(float *p, x86_f32_t v) { _mm256_storeu_ps(p, v); }
+static inline x86_f32_t x86_set1(float v) { return _mm256_set1_ps(v); }
+static inline x86_f32_t x86_zero() { return _mm256_setzero_ps(); }
+static inline x86_f32_t x86_add(x86_f32_t a, x86_f32_t b) { return _mm256_add_ps(a, b); }
+static inline x86_f32_t x86_sub(x86_f32_t a, x86_f32_t b) { return _mm256_sub_ps(a, b); }
+static inline x86_f32_t x86_mul(x86_f32_t a, x86_f32_t b) { return _mm256_mul_ps(a, b); }
+static inline x86_f32_t x86_div(x86_f32_t a, x86_f32_t b) { return _mm256_div_ps(a, b); }
+static inline x86_f32_t x86_sqrt(x86_f32_t a) { return _mm256_sqrt_ps(a); }
+static inline float x86_hsum(x86_f32_t v)
+{
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    return _mm_cvtss_f32(_mm_add_ss(s, _mm_shuffle_ps(s, s, 1)));
+}
+#else
+typedef __m128 x86_f32_t;
+static constexpr size_t X86_F32_LANES = 4;
+static inline x86_f32_t x86_load(const float *p) { return _mm_loadu_ps(p); }
+static inline void x86_store(float *p, x86_f32_t v) { _mm_storeu_ps(p, v); }
+static inline x86_f32_t x86_set1(float v) { return _mm_set1_ps(v); }
+static inline x86_f32_t x86_zero() { return _mm_setzero_ps(); }
+static inline x86_f32_t x86_add(x86_f32_t a, x86_f32_t b) { return _mm_add_ps(a, b); }
+static inline x86_f32_t x86_sub(x86_f32_t a, x86_f32_t b) { return _mm_sub_ps(a, b); }
+static inline x86_f32_t x86_mul(x86_f32_t a, x86_f32_t b) { return _mm_mul_ps(a, b); }
+static inline x86_f32_t x86_div(x86_f32_t a, x86_f32_t b) { return _mm_div_ps(a, b); }
+static inline x86_f32_t x86_sqrt(x86_f32_t a) { return _mm_sqrt_ps(a); }
+static inline float x86_hsum(x86_f32_t v)
+{
+    __m128 s = _mm_add_ps(v, _mm_movehl_ps(v, v));
+    return _mm_cvtss_f32(_mm_add_ss(s, _mm_shuffle_ps(s, s, 1)));
+}
+#endif
+
+/**
+ * Accumulate row (1xN) * matrix2 (NxK) onto out_row (1xK).
+ * Four vectors of output columns are kept in registers over the whole of N.
+ */
+static inline void hw_dot_row(const float *row, size_t n, const float *matrix2, size_t k_cols, float *out_row)
+{
+    const size_t L = X86_F32_LANES;
+    size_t j = 0;
+    for (; j + 4 * L <= k_cols; j += 4 * L) {
+        x86_f32_t acc0 = x86_zero(), acc1 = x86_zero(), acc2 = x86_zero(), acc3 = x86_zero();
+        const float *b = matrix2 + j;
+        for (size_t k = 0; k < n; k++, b += k_cols) {
+            const x86_f32_t a = x86_set1(row[k]);
+            acc0 = x86_add(acc0, x86_mul(a, x86_load(b)));
+            acc1 = x86_add(acc1, x86_mul(a, x86_load(b + L)));
+            acc2 = x86_add(acc2, x86_mul(a, x86_load(b + 2 * L)));
+            acc3 = x86_add(acc3, x86_mul(a, x86_load(b + 3 * L)));
+        }
+        x86_store(out_row + j, x86_add(x86_load(out_row + j), acc0));
+        x86_store(out_row + j + L, x86_add(x86_load(out_row + j + L), acc1));
+        x86_store(out_row + j + 2 * L, x86_add(x86_load(out_row + j + 2 * L), acc2));
+        x86_store(out_row + j + 3 * L, x86_add(x86_load(out_row + j + 3 * L), acc3));
+    }
+    for (; j + L <= k_cols; j += L) {
+        x86_f32_t acc = x86_zero();
+        const float *b = matrix2 + j;
+        for (size_t k = 0; k < n; k++, b += k_cols) {
+            acc = x86_add(acc, x86_mul(x86_set1(row[k]), x86_load(b)));
+        }
+        x86_store(out_row + j, x86_add(x86_load(out_row + j), acc));
+    }
+    for (; j < k_cols; j++) {
+        float tmp = 0.0f;
+        for (size_t k = 0; k < n; k++) {
+            tmp += row[k] * matrix2[k * k_cols + j];
+        }
+        out_row[j] += tmp;
+    }
+}
+
+/**
+ * Accumulate matrix1 (MxN) * matrix2 (NxK) onto out_matrix (MxK)
+ */
+static inline void hw_dot(const matrix_t *matrix1, const matrix_t *matrix2, matrix_t *out_matrix)
+{
+    for (size_t i = 0; i < matrix1->rows; i++) {
+        hw_dot_row(matrix1->buffer + i * matrix1->cols, matrix1->cols, matrix2->buffer, matrix2->cols,
+            out_matrix->buffer + i * out_matrix->cols);
+    }
+}
+
+/**
+ * data = data * scale + add, in place
+ */
+static inline void hw_scale_and_add(float *data, size_t length, float scale, float add)
+{
+    const size_t L = X86_F32_LANES;
+    const x86_f32_t vscale = x86_set1(scale);
+    const x86_f32_t vadd = x86_set1(add);
+    size_t ix = 0;
+    for (; ix + 4 * L <= length; ix += 4 * L) {
+        x86_store(data + ix, x86_add(x86_mul(x86_load(data + ix), vscale), vadd));
+        x86_store(data + ix + L, x86_add(x86_mul(x86_load(data + ix + L), vscale), vadd));
+        x86_store(data + ix + 2 * L, x86_add(x86_mul(x86_load(data + ix + 2 * L), vscale), vadd));
+        x86_store(data + ix + 3 * L, x86_add(x86_mul(x86_load(data + ix + 3 * L), vscale), vadd));
+    }
+    for (; ix + L <= length; ix += L) {
+        x86_store(data + ix, x86_add(x86_mul(x86_load(data + ix), vscale), vadd));
+    }
+    for (; ix < length; ix++) {
+        data[ix] = (data[ix] * scale) + add;
+    }
+}
+
+/**
+ * Root mean square of an array
+ */
+static inline float hw_rms_array(const float *array, size_t length)
+{
+    const size_t L = X86_F32_LANES;
+    x86_f32_t acc0 = x86_zero(), acc1 = x86_zero();
+    size_t ix = 0;
+    for (; ix + 2 * L <= length; ix += 2 * L) {
+        const x86_f32_t v0 = x86_load(array + ix);
+        const x86_f32_t v1 = x86_load(array + ix + L);
+        acc0 = x86_add(acc0, x86_mul(v0, v0));
+        acc1 = x86_add(acc1, x86_mul(v1, v1));
+    }
+    float sum = x86_hsum(x86_add(acc0, acc1));
+    for (; ix < length; ix++) {
+        sum += array[ix] * array[ix];
+    }
+    return sqrtf(sum / static_cast<float>(length));
+}
+
+/**
+ * Column sums of columns [col, col + lanes) into sum, rows added top to bottom like the scalar loop
+ */
+static inline x86_f32_t x86_column_sum(const float *input, size_t rows, size_t cols, size_t col)
+{
+    x86_f32_t sum = x86_zero();
+    for (size_t row = 0; row < rows; row++) {
+        sum = x86_add(sum, x86_load(input + row * cols + col));
+    }
+    return sum;
+}
+
+/**
+ * Mean of every column of input (rows x cols) into output (cols)
+ */
+static inline void hw_mean_axis0(const float *input, size_t rows, size_t cols, float *output)
+{
+    const size_t L = X86_F32_LANES;
+    const x86_f32_t vrows = x86_set1(static_cast<float>(rows));
+    size_t col = 0;
+    for (; col + L <= cols; col += L) {
+        x86_store(output + col, x86_div(x86_column_sum(input, rows, cols, col), vrows));
+    }
+    for (; col < cols; col++) {
+        float sum = 0.0f;
+        for (size_t row = 0; row < rows; row++) {
+            sum += input[row * cols + col];
+        }
+        output[col] = sum / rows;
+    }
+}
+
+/**
+ * Population standard deviation of every column of input (rows x cols) into output (cols)
+ */
+static inline void hw_std_axis0(const float *input, size_t rows, size_t cols, float *output)
+{
+    const size_t L = X86_F32_LANES;
+    const x86_f32_t vrows = x86_set1(static_cast<float>(rows));
+    size_t col = 0;
+    for (; col + L <= cols; col += L) {
+        const x86_f32_t mean = x86_div(x86_column_sum(input, rows, cols, col), vrows);
+        x86_f32_t std = x86_zero();
+        for (size_t row = 0; row < rows; row++) {
+            const x86_f32_t tmp = x86_sub(x86_load(input + row * cols + col), mean);
+            std = x86_add(std, x86_mul(tmp, tmp));
+        }
+        x86_store(output + col, x86_sqrt(x86_div(std, vrows)));
+    }
+    for (; col < cols; col++) {
+        float sum = 0.0f;
+        for (size_t row = 0; row < rows; row++) {
+            sum += input[row * cols + col];
+        }
+        const float mean = sum / rows;
+        float std = 0.0f;
+        for (size_t row = 0; row < rows; row++) {
+            const float tmp = input[row * cols + col] - mean;
+            std += tmp * tmp;
+        }
+        output[col] = sqrtf(std / rows);
+    }
+}
+
+/**
+ * Sign-extend int8 values to float
+ */
+static inline void hw_int8_to_float(const int8_t *input, float *output, size_t length)
+{
+    size_t ix = 0;
+#if EIDSP_USE_AVX2
+    for (; ix + 8 <= length; ix += 8) {
+        const __m256i v = _mm256_cvtepi8_epi32(_mm_loadl_epi64((const __m128i *)(input + ix)));
+        _mm256_storeu_ps(output + ix, _mm256_cvtepi32_ps(v));
+    }
+#else
+    for (; ix + 16 <= length; ix += 16) {
+        const __m128i v = _mm_loadu_si128((const __m128i *)(input + ix));
+        // each byte duplicated into a 16-bit lane, arithmetic shift leaves it sign-extended
+        const __m128i lo = _mm_srai_epi16(_mm_unpacklo_epi8(v, v), 8);
+        const __m128i hi = _mm_srai_epi16(_mm_unpackhi_epi8(v, v), 8);
+        _mm_storeu_ps(output + ix, _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(lo, lo), 16)));
+        _mm_storeu_ps(output + ix + 4, _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(lo, lo), 16)));
+        _mm_storeu_ps(output + ix + 8, _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(hi, hi), 16)));
+        _mm_storeu_ps(output + ix + 12, _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(hi, hi), 16)));
+    }
+#endif
+    for (; ix < length; ix++) {
+        output[ix] = static_cast<float>(input[ix]);
+    }
+}
+
+/**
+ * 4x4 block from src to dst, transposed. All loads happen before the stores, so src may be dst.
+ */
+static inline void x86_transpose_4x4(const float *src, size_t src_stride, float *dst, size_t dst_stride)
+{
+    __m128 r0 = _mm_loadu_ps(src);
+    __m128 r1 = _mm_loadu_ps(src + src_stride);
+    __m128 r2 = _mm_loadu_ps(src + 2 * src_stride);
+    __m128 r3 = _mm_loadu_ps(src + 3 * src_stride);
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    _mm_storeu_ps(dst, r0);
+    _mm_storeu_ps(dst + dst_stride, r1);
+    _mm_storeu_ps(dst + 2 * dst_stride, r2);
+    _mm_storeu_ps(dst + 3 * dst_stride, r3);
+}
+
+/**
+ * Transpose input (rows x cols) into output (cols x rows), tile by tile in 4x4 blocks
+ */
+static inline void hw_transpose(const float *input, float *output, size_t rows, size_t cols)
+{
+    const size_t tile = EIDSP_X86_TRANSPOSE_TILE;
+    for (size_t r0 = 0; r0 < rows; r0 += tile) {
+        const size_t r1 = r0 + tile < rows ? r0 + tile : rows;
+        for (size_t c0 = 0; c0 < cols; c0 += tile) {
+            const size_t c1 = c0 + tile < cols ? c0 + tile : cols;
+            size_t r = r0;
+            for (; r + 4 <= r1; r += 4) {
+                size_t c = c0;
+                for (; c + 4 <= c1; c += 4) {
+                    x86_transpose_4x4(input + r * cols + c, cols, output + c * rows + r, rows);
+                }
+                for (; c < c1; c++) {
+                    for (size_t rr = r; rr < r + 4; rr++) {
+                        output[c * rows + rr] = input[rr * cols + c];
+                    }
+                }
+            }
+            for (; r < r1; r++) {
+                for (size_t c = c0; c < c1; c++) {
+                    output[c * rows + r] = input[r * cols + c];
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Transpose a square matrix (n x n) in place, without a copy. Blocks on the diagonal are
+ * transposed in registers, the block pairs mirrored across it are transposed and swapped.
+ */
+static inline void hw_transpose_square_in_place(float *matrix, size_t n)
+{
+    const size_t tile = EIDSP_X86_TRANSPOSE_TILE;
+    const size_t n4 = n & ~static_cast<size_t>(3);
+    for (size_t r0 = 0; r0 < n4; r0 += tile) {
+        const size_t r1 = r0 + tile < n4 ? r0 + tile : n4;
+        for (size_t c0 = r0; c0 < n4; c0 += tile) {
+            const size_t c1 = c0 + tile < n4 ? c0 + tile : n4;
+            for (size_t r = r0; r < r1; r += 4) {
+                for (size_t c = (c0 == r0 ? r : c0); c < c1; c += 4) {
+                    float *upper = matrix + r * n + c;
+                    if (c == r) {
+                        x86_transpose_4x4(upper, n, upper, n);
+                        continue;
+                    }
+                    float *lower = matrix + c * n + r;
+                    __m128 a0 = _mm_loadu_ps(upper), a1 = _mm_loadu_ps(upper + n);
+                    __m128 a2 = _mm_loadu_ps(upper + 2 * n), a3 = _mm_loadu_ps(upper + 3 * n);
+                    __m128 b0 = _mm_loadu_ps(lower), b1 = _mm_loadu_ps(lower + n);
+                    __m128 b2 = _mm_loadu_ps(lower + 2 * n), b3 = _mm_loadu_ps(lower + 3 * n);
+                    _MM_TRANSPOSE4_PS(a0, a1, a2, a3);
+                    _MM_TRANSPOSE4_PS(b0, b1, b2, b3);
+                    _mm_storeu_ps(lower, a0);
+                    _mm_storeu_ps(lower + n, a1);
+                    _mm_storeu_ps(lower + 2 * n, a2);
+                    _mm_storeu_ps(lower + 3 * n, a3);
+                    _mm_storeu_ps(upper, b0);
+                    _mm_storeu_ps(upper + n, b1);
+                    _mm_storeu_ps(upper + 2 * n, b2);
+                    _mm_storeu_ps(upper + 3 * n, b3);
+                }
+            }
+        }
+    }
+    // last n % 4 rows and columns
+    for (size_t r = 0; r < n; r++) {
+        for (size_t c = (r < n4 ? n4 : r + 1); c < n; c++) {
+            float tmp = matrix[r * n + c];
+            matrix[r * n + c] = matrix[c * n + r];
+            matrix[c * n + r] = tmp;
+        }
+    }
+}
+
+} // namespace ei
+
+#endif // _EIDSP_X86_NUMPY_H_
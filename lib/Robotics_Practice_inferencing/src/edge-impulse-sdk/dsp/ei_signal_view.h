@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2024 EdgeImpulse Inc.
+ *
+ * Generated by Edge Impulse and licensed under the applicable Edge Impulse
+ * Terms of Service. Community and Professional Terms of Service
+ * (https://edgeimpulse.com/legal/terms-of-service) or Enterprise Terms of
+ * Service (https://edgeimpulse.com/legal/enterprise-terms-of-service),
+ * according to your product plan subscription (the “License”).
+ *
+ * This software, documentation and other associated files (collectively referred
+ * to as the “Software”) is a single SDK variation generated by the Edge Impulse
+ * platform and requires an active paid Edge Impulse subscription to use this
+ * Software for any purpose.
+ *
+ * You may NOT use this Software unless you have an active Edge Impulse subscription
+ * that meets the eligibility requirements for the applicable License, subject to
+ * your full and continued compliance with the terms and conditions of the License,
+ * including without limitation any usage restrictions under the applicable License.
+ *
+ * If you do not have an active Edge Impulse product plan subscription, or if use
+ * of this Software exceeds the usage limitations of your Edge Impulse product plan
+ * subscription, you are not permitted to use this Software and must immediately
+ * delete and erase all copies of this Software within your control or possession.
+ * Edge Impulse reserves all rights and remedies available to enforce its rights.
+ *
+ * Unless required by applicable law or agreed to in writing, the Software is
+ * distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language governing
+ * permissions, disclaimers and limitations under the License.
+ */
+
+#ifndef _EIDSP_SIGNAL_VIEW_H_
+#define _EIDSP_SIGNAL_VIEW_H_
+
+/**
+ * Compile-time alternative to signal_t. A signal_view carries the type of its source, so
+ * DSP code templated on it reads samples through inline calls instead of a std::function,
+ * and a loop over a raw buffer compiles down to a plain loop over that buffer.
+ *
+ * Samples follow the signal_t conventions: images are one float per pixel holding the packed
+ * 0xRRGGBB value. Sources also hand out that pixel as an integer, which is what the image
+ * DSP works on.
+ *
+ *     ei::signal_view<ei::signal_source_gray8> signal = ei::signal_view_from_gray8(buf, 96 * 96);
+ *     run_classifier(&signal, &result);
+ *
+ * A frame larger than the model input can be cropped and resized on the way in:
+ *
+ *     ei::image::processing::crop_resize_t crop;
+ *     crop_resize_init(&crop, fb, 320, 240, 1, 0, 0, 320, 240, 96, 96,
+ *                      EI_CLASSIFIER_RESIZE_MODE, EI_CLASSIFIER_RESIZE_FILTER_AREA);
+ *     ei::signal_view<ei::signal_source_crop_resize> signal = ei::signal_view_from_crop(crop);
+ */
+
+#include "edge-impulse-sdk/dsp/numpy_types.h"
+#include "edge-impulse-sdk/dsp/image/processing.hpp"
+
+#ifdef __cplusplus
+namespace ei {
+
+/** 8-bit grayscale buffer, one byte per pixel */
+struct signal_source_gray8 {
+    const uint8_t *data;
+
+    inline uint32_t pixel(size_t ix) const {
+        uint32_t v = data[ix];
+        return (v << 16) | (v << 8) | v;
+    }
+    inline float sample(size_t ix) const {
+        return static_cast<float>(pixel(ix));
+    }
+};
+
+/** RGB888 buffer, three bytes per pixel */
+struct signal_source_rgb888 {
+    const uint8_t *data;
+
+    inline uint32_t pixel(size_t ix) const {
+        const uint8_t *p = data + ix * 3;
+        return (static_cast<uint32_t>(p[0]) << 16) | (static_cast<uint32_t>(p[1]) << 8) | p[2];
+    }
+    inline float sample(size_t ix) const {
+        return static_cast<float>(pixel(ix));
+    }
+};
+
+/** Float buffer in signal_t layout (packed pixels for images, raw values otherwise) */
+struct signal_source_float {
+    const float *data;
+
+    inline uint32_t pixel(size_t ix) const {
+        return static_cast<uint32_t>(data[ix]);
+    }
+    inline float sample(size_t ix) const {
+        return data[ix];
+    }
+};
+
+/**
+ * Crop of a larger frame, resized on the fly (image::processing::crop_resize_t). Quantized image
+ * models fill the input tensor from it in one pass, see crop_resize_quantize_image.
+ */
+struct signal_source_crop_resize {
+    image::processing::crop_resize_t crop;
+
+    inline uint32_t pixel(size_t ix) const {
+        return image::processing::crop_resize_pixel(&crop, (int)(ix % crop.dst_width), (int)(ix / crop.dst_width));
+    }
+    inline float sample(size_t ix) const {
+        return static_cast<float>(pixel(ix));
+    }
+};
+
+template<typename Source>
+struct signal_view {
+    Source source;
+    /** Total number of samples, as signal_t::total_length */
+    size_t total_length;
+
+    inline int get_data(size_t offset, size_t length, float *out_ptr) const {
+        for (size_t ix = 0; ix < length; ix++) {
+            out_ptr[ix] = source.sample(offset + ix);
+        }
+        return 0;
+    }
+
+#if EIDSP_SIGNAL_C_FN_POINTER == 0 && !defined(__MBED__)
+    /**
+     * Legacy signal_t over this view, for code paths that only take signal_t.
+     * The view has to outlive the returned signal.
+     */
+    signal_t to_signal() const {
+        signal_t signal;
+        signal.total_length = total_length;
+        signal.get_data = [this](size_t offset, size_t length, float *out_ptr) {
+            return this->get_data(offset, length, out_ptr);
+        };
+        return signal;
+    }
+#endif // EIDSP_SIGNAL_C_FN_POINTER == 0 && !defined(__MBED__)
+};
+
+inline signal_view<signal_source_gray8> signal_view_from_gray8(const uint8_t *data, size_t pixels) {
+    return signal_view<signal_source_gray8>{ { data }, pixels };
+}
+
+inline signal_view<signal_source_rgb888> signal_view_from_rgb888(const uint8_t *data, size_t pixels) {
+    return signal_view<signal_source_rgb888>{ { data }, pixels };
+}
+
+inline signal_view<signal_source_float> signal_view_from_float(const float *data, size_t length) {
+    return signal_view<signal_source_float>{ { data }, length };
+}
+
+/** Output of a crop_resize_t (crop_resize_init), dst_width x dst_height pixels */
+inline signal_view<signal_source_crop_resize> signal_view_from_crop(const image::processing::crop_resize_t &crop) {
+    return signal_view<signal_source_crop_resize>{ { crop }, (size_t)crop.dst_width * crop.dst_height };
+}
+
+} // namespace ei
+#endif // __cplusplus
+
+#endif // _EIDSP_SIGNAL_VIEW_H_
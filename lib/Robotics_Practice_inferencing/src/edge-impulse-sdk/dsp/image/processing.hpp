@@ -34,6 +34,7 @@
 #include "edge-impulse-sdk/dsp/ei_utils.h"
 #include "edge-impulse-sdk/porting/ei_classifier_porting.h"
 #include "edge-impulse-sdk/dsp/returntypes.hpp"
+#include "edge-impulse-sdk/classifier/ei_constants.h"
 
 namespace ei { namespace image { namespace processing {
 
@@ -41,21 +42,93 @@ enum YUV_OPTIONS
 {
     BIG_ENDIAN_ORDER = 1, //RGB reading from low to high memory.  Otherwise, uses native encoding
     PAD_4B = 2, // pad 0x00 on the high B. ie 0x00RRGGBB
+    YUYV_ORDER = 4, // YUV422 input as Y0 U Y1 V (esp32-camera).  Otherwise U Y0 V Y1
+    RGB565_BIG_ENDIAN = 8, // RGB565 input high byte first (esp32-camera).  Otherwise little endian
 };
 
+/**
+ * Implementation used by the colour converters and the area downscaler. CONVERT_AUTO picks
+ * the fastest one compiled in; the others are there to check the fast paths against the scalar reference.
+ * All of them give bit-exact results.
+ */
+enum CONVERT_BACKEND
+{
+    CONVERT_AUTO = 0,
+    CONVERT_SCALAR = 1,
+    CONVERT_SWAR = 2, // 32-bit words, for cores without SIMD (ESP32)
+    CONVERT_SSE2 = 3,
+    CONVERT_AVX2 = 4,
+};
+
+/**
+ * @brief Whether a backend is compiled in (CONVERT_AUTO always is)
+ */
+bool convert_backend_available(CONVERT_BACKEND backend);
+
 /**
  * @brief Convert YUV to RGB
  *
  * @param rgb_out Output buffer (can be the same as yuv_in if big enough)
  * @param yuv_in Input buffer
  * @param in_size_B Size of input image in B
- * @param opts Note, only BIG_ENDIAN_ORDER supported presently
+ * @param opts BIG_ENDIAN_ORDER, PAD_4B and YUYV_ORDER
+ * @param backend Implementation to use
  */
 int yuv422_to_rgb888(
     unsigned char *rgb_out,
     unsigned const char *yuv_in,
     unsigned int in_size_B,
-    YUV_OPTIONS opts);
+    YUV_OPTIONS opts,
+    CONVERT_BACKEND backend = CONVERT_AUTO);
+
+/**
+ * @brief Extract the Y plane of a YUV422 image as 8-bit grayscale (no colour math)
+ *
+ * @param gray_out Output buffer, in_size_B / 2 bytes (can be the same as yuv_in)
+ * @param yuv_in Input buffer
+ * @param in_size_B Size of input image in B
+ * @param opts YUYV_ORDER
+ * @param backend Implementation to use
+ */
+int yuv422_to_gray(
+    uint8_t *gray_out,
+    const uint8_t *yuv_in,
+    unsigned int in_size_B,
+    YUV_OPTIONS opts,
+    CONVERT_BACKEND backend = CONVERT_AUTO);
+
+/**
+ * @brief Convert RGB565 to RGB888. 5 and 6 bit channels are widened by bit replication
+ *
+ * @param rgb_out Output buffer (can be the same as rgb565_in if big enough)
+ * @param rgb565_in Input buffer
+ * @param in_size_B Size of input image in B
+ * @param opts BIG_ENDIAN_ORDER, PAD_4B and RGB565_BIG_ENDIAN
+ * @param backend Implementation to use
+ */
+int rgb565_to_rgb888(
+    uint8_t *rgb_out,
+    const uint8_t *rgb565_in,
+    unsigned int in_size_B,
+    YUV_OPTIONS opts,
+    CONVERT_BACKEND backend = CONVERT_AUTO);
+
+/**
+ * @brief Convert RGB565 to 8-bit grayscale, (77 * R + 150 * G + 29 * B + 128) >> 8
+ * on the widened channels (BT.601 luma in 8.8 fixed point)
+ *
+ * @param gray_out Output buffer, in_size_B / 2 bytes (can be the same as rgb565_in)
+ * @param rgb565_in Input buffer
+ * @param in_size_B Size of input image in B
+ * @param opts RGB565_BIG_ENDIAN
+ * @param backend Implementation to use
+ */
+int rgb565_to_gray(
+    uint8_t *gray_out,
+    const uint8_t *rgb565_in,
+    unsigned int in_size_B,
+    YUV_OPTIONS opts,
+    CONVERT_BACKEND backend = CONVERT_AUTO);
 
 /**
  * @brief Crops an image. Can be in-place. 4B alignment for best performance
@@ -130,6 +203,49 @@ int resize_image(
     int dstHeight,
     int pixel_size_B);
 
+/**
+ * @brief Area (box) downscale by integer factors. Every output pixel is the rounded mean of a
+ * (srcWidth / dstWidth) x (srcHeight / dstHeight) block of source pixels, so nothing is skipped
+ * and fine detail doesn't alias. Separable: source rows are summed into a row accumulator,
+ * then groups of columns. Can be done in place (set srcImage == dstImage)
+ *
+ * @param srcImage Input buffer
+ * @param srcWidth Input width in pixels, a multiple of dstWidth (at most 256x)
+ * @param srcHeight Input height in pixels, a multiple of dstHeight (at most 256x)
+ * @param dstImage Output buffer, can be same as input buffer
+ * @param dstWidth Output width in pixels
+ * @param dstHeight Output height in pixels
+ * @param pixel_size_B Size of pixels in Bytes.  3 for RGB, 1 for mono
+ * @param backend Implementation to use
+ */
+int resize_image_area(
+    const uint8_t *srcImage,
+    int srcWidth,
+    int srcHeight,
+    uint8_t *dstImage,
+    int dstWidth,
+    int dstHeight,
+    int pixel_size_B,
+    CONVERT_BACKEND backend = CONVERT_AUTO);
+
+/**
+ * @brief resize_image_area with int8 output, quantized as round(value / 255 / scale) + zero_point
+ *
+ * @param scale Quantization scale of the output
+ * @param zero_point Quantization zero point of the output
+ */
+int resize_image_area_quantized(
+    const uint8_t *srcImage,
+    int srcWidth,
+    int srcHeight,
+    int8_t *dstImage,
+    int dstWidth,
+    int dstHeight,
+    int pixel_size_B,
+    float scale,
+    int zero_point,
+    CONVERT_BACKEND backend = CONVERT_AUTO);
+
 /**
  * @brief Calculate new dims that match the aspect ratio of destination
  * This prevents a squashed look
@@ -205,6 +321,12 @@ int crop_and_interpolate_image(
  * @param dstHeight Desired new height in pixels
  * @param pixel_size_B Size of pixels in Bytes. 3 for RGB, 1 for mono
  * @param mode Resizing mode (FIT_SHORTEST=1, FIT_LONGEST=2, SQUASH=3)
+ * @param filter EI_CLASSIFIER_RESIZE_FILTER_BILINEAR, or EI_CLASSIFIER_RESIZE_FILTER_AREA to average
+ * all source pixels when downscaling 2x or more (integer part of the ratio boxed, the rest bilinear).
+ * The area filter is for quality: at a fractional ratio such as 320x240 -> 96x96 it is slower than
+ * bilinear, and only at whole ratios is it faster as well.
+ * When the area filter applies, the crop of FIT_SHORTEST is read in place, so dstImage only needs
+ * dstWidth x dstHeight pixels
  * @return int Status code (0 for success, non-zero for failure)
  */
 int resize_image_using_mode(
@@ -215,6 +337,111 @@ int resize_image_using_mode(
     int dstWidth,
     int dstHeight,
     int pixel_size_B,
-    int mode);
+    int mode,
+    int filter = EI_CLASSIFIER_RESIZE_FILTER_BILINEAR);
+
+/**
+ * A crop of a source frame mapped onto a dst_width x dst_height image by one of the resize modes,
+ * sampled on demand instead of being resized into a buffer. Fill it with crop_resize_init.
+ */
+typedef struct {
+    const uint8_t *image;
+    int width; // frame width in pixels
+    int pixel_size_B;
+    int dst_width;
+    int dst_height;
+    bool area; // box average (area filter applies), else bilinear
+    // part of the frame that is sampled
+    int win_x;
+    int win_y;
+    int win_width;
+    int win_height;
+    // where it lands in the output, FIT_LONGEST pads around it with 0
+    int out_x;
+    int out_y;
+    int out_width;
+    int out_height;
+} crop_resize_t;
+
+/**
+ * @brief Set up a crop_resize_t. The mode is applied to the crop rectangle as resize_image_using_mode
+ * applies it to a whole image (FIT_SHORTEST takes the centre of the crop, SQUASH stretches it,
+ * FIT_LONGEST letterboxes it, NONE needs a crop of the output size). Samples match
+ * resize_image_using_mode on the cropped image; with the area filter a ratio that isn't a whole
+ * number averages whole-pixel blocks of varying size instead of boxing and then interpolating.
+ *
+ * @param srcImage Frame, kept by pointer
+ * @param srcWidth Frame width in pixels
+ * @param srcHeight Frame height in pixels
+ * @param pixel_size_B 1 for mono, 3 for RGB
+ * @param cropX Left of the crop rectangle, in pixels
+ * @param cropY Top of the crop rectangle, in pixels
+ * @param cropWidth Crop width in pixels (the whole frame: srcWidth)
+ * @param cropHeight Crop height in pixels (the whole frame: srcHeight)
+ * @param dstWidth Output width in pixels
+ * @param dstHeight Output height in pixels
+ * @param mode EI_CLASSIFIER_RESIZE_*
+ * @param filter EI_CLASSIFIER_RESIZE_FILTER_BILINEAR or EI_CLASSIFIER_RESIZE_FILTER_AREA
+ * @return int EIDSP_OK, or EIDSP_PARAMETER_INVALID if the crop isn't inside the frame
+ */
+int crop_resize_init(
+    crop_resize_t *cr,
+    const uint8_t *srcImage,
+    int srcWidth,
+    int srcHeight,
+    int pixel_size_B,
+    int cropX,
+    int cropY,
+    int cropWidth,
+    int cropHeight,
+    int dstWidth,
+    int dstHeight,
+    int mode,
+    int filter);
+
+/**
+ * @brief One output pixel of a crop_resize_t, packed as 0xRRGGBB (mono replicated to all three)
+ */
+uint32_t crop_resize_pixel(const crop_resize_t *cr, int x, int y);
+
+/**
+ * @brief Crop, resize and quantize in one pass, e.g. from the camera frame straight into an int8
+ * input tensor. Output rows are produced one at a time, nothing frame sized is allocated.
+ * Values are quantized as round(value / 255 / scale) + zero_point. A single output channel is
+ * luma (ITU-R 601-2 in 16-bit fixed point, mono pixels replicated to RGB), which matches the
+ * quantized image features of the classifier for crop_resize_pixel values.
+ *
+ * @param dstImage Output, dst_width x dst_height x dst_channels values
+ * @param dst_channels 1, or pixel_size_B of the source
+ * @param scale Quantization scale of the output
+ * @param zero_point Quantization zero point of the output
+ */
+int crop_resize_quantize_image(
+    const crop_resize_t *cr,
+    int8_t *dstImage,
+    int dst_channels,
+    float scale,
+    int zero_point);
+
+/**
+ * @brief crop_resize_init followed by crop_resize_quantize_image
+ */
+int crop_resize_quantize_image(
+    const uint8_t *srcImage,
+    int srcWidth,
+    int srcHeight,
+    int pixel_size_B,
+    int cropX,
+    int cropY,
+    int cropWidth,
+    int cropHeight,
+    int8_t *dstImage,
+    int dstWidth,
+    int dstHeight,
+    int dst_channels,
+    int mode,
+    int filter,
+    float scale,
+    int zero_point);
 }}} //namespaces
 #endif //!__EI_IMAGE_PROCESSING__H__
\ No newline at end of file
@@ -82,6 +82,9 @@
 #else
 #define EIDSP_INCLUDE_KISSFFT 1
 #include "edge-impulse-sdk/dsp/dsp_engines/ei_no_hw_dsp.h"
+#if EIDSP_USE_X86_SIMD
+#include "edge-impulse-sdk/dsp/dsp_engines/ei_x86_numpy.hpp"
+#endif
 
 #endif // dsp / math hw
 
@@ -270,6 +273,9 @@ public:
         {
             EI_RETURN_IF_ERROR(hw_dot(matrix1, matrix2, out_matrix));
         }
+#elif EIDSP_USE_X86_SIMD
+        memset(out_matrix->buffer, 0, out_matrix->rows * out_matrix->cols * sizeof(float));
+        hw_dot(matrix1, matrix2, out_matrix);
 #else
         memset(out_matrix->buffer, 0, out_matrix->rows * out_matrix->cols * sizeof(float));
 
@@ -334,6 +340,8 @@ public:
 
 #if EIDSP_USE_HW_MATH
         EI_RETURN_IF_ERROR(hw_dot_by_row(i, row, matrix1_cols, matrix2, out_matrix));
+#elif EIDSP_USE_X86_SIMD
+        hw_dot_row(row, matrix1_cols, matrix2->buffer, matrix2->cols, out_matrix->buffer + (i * matrix2->cols));
 #else
         for (size_t j = 0; j < matrix2->cols; j++) {
             float tmp = 0.0f;
@@ -378,6 +386,12 @@ public:
     }
 
     static void transpose_in_place(matrix_t *matrix) {
+#if EIDSP_USE_X86_SIMD
+        if (matrix->rows == matrix->cols) {
+            hw_transpose_square_in_place(matrix->buffer, matrix->rows);
+            return;
+        }
+#endif
         // Don't bother if either dim is one, just need to swap the dimension sizes
         if( matrix->rows != 1 && matrix->cols != 1) {
             size_t size = matrix->cols * matrix->rows - 1;
@@ -452,6 +466,13 @@ public:
      * @returns EIDSP_OK if OK
      */
     static int transpose(float *matrix, int rows, int columns) {
+#if EIDSP_USE_X86_SIMD
+        // square needs no copy
+        if (rows == columns) {
+            hw_transpose_square_in_place(matrix, rows);
+            return EIDSP_OK;
+        }
+#endif
         EI_DSP_MATRIX(temp_matrix, rows, columns);
         if (!temp_matrix.buffer) {
             EIDSP_ERR(EIDSP_OUT_OF_MEM);
@@ -460,6 +481,8 @@ public:
 #if EIDSP_USE_HW_MATH
         EI_RETURN_IF_ERROR(hw_mat_transpose(matrix, temp_matrix.buffer,
             static_cast<uint16_t>(rows), static_cast<uint16_t>(columns)));
+#elif EIDSP_USE_X86_SIMD
+        hw_transpose(matrix, temp_matrix.buffer, columns, rows);
 #else
         for (int j = 0; j < rows; j++){
             for (int i = 0; i < columns; i++){
@@ -939,6 +962,8 @@ public:
             ++ptr;
             --remaining;
         }
+#elif EIDSP_USE_X86_SIMD
+        hw_scale_and_add(matrix->buffer, matrix->rows * matrix->cols, scale, add);
 #else
         for (uint32_t ix = 0; ix < matrix->rows * matrix->cols; ix++) {
             matrix->buffer[ix] = (matrix->buffer[ix] * scale) + add;
@@ -968,6 +993,8 @@ public:
             float rms_result;
             hw_rms_array(matrix->buffer + (row * matrix->cols), matrix->cols, &rms_result);
             output_matrix->buffer[row] = rms_result;
+#elif EIDSP_USE_X86_SIMD
+            output_matrix->buffer[row] = hw_rms_array(matrix->buffer + (row * matrix->cols), matrix->cols);
 #else
             float sum = 0.0;
             for(size_t ix = 0; ix < matrix->cols; ix++) {
@@ -1028,6 +1055,10 @@ public:
             EIDSP_ERR(EIDSP_MATRIX_SIZE_MISMATCH);
         }
 
+#if EIDSP_USE_X86_SIMD
+        // on x86 the columns are summed side by side in vector lanes instead
+        hw_mean_axis0(input_matrix->buffer, input_matrix->rows, input_matrix->cols, output_matrix->buffer);
+#else
         for (size_t col = 0; col < input_matrix->cols; col++) {
             // Note - not using CMSIS-DSP here
             // gathering up the current columnand moving it into sequential memory to use
@@ -1043,6 +1074,7 @@ public:
 
             output_matrix->buffer[col] = sum / input_matrix->rows;
         }
+#endif
 
         return EIDSP_OK;
     }
@@ -1064,6 +1096,9 @@ public:
 
 #if EIDSP_USE_HW_MATH
         return hw_std_axis0(input_matrix, output_matrix);
+#elif EIDSP_USE_X86_SIMD
+        hw_std_axis0(input_matrix->buffer, input_matrix->rows, input_matrix->cols, output_matrix->buffer);
+        return EIDSP_OK;
 #else
 
         for (size_t col = 0; col < input_matrix->cols; col++) {
@@ -1491,9 +1526,13 @@ public:
      * @returns 0 if OK
      */
     static int int8_to_float(const EIDSP_i8 *input, float *output, size_t length) {
+#if EIDSP_USE_X86_SIMD
+        hw_int8_to_float(input, output, length);
+#else
         for (size_t ix = 0; ix < length; ix++) {
             output[ix] = static_cast<float>((input[ix]));
         }
+#endif
         return EIDSP_OK;
     }
 
@@ -1517,9 +1556,80 @@ public:
             return numpy::signal_get_data(data, offset, length, out_ptr);
         };
 #endif
+        signal->buffer = data;
         return EIDSP_OK;
     }
 
+    /**
+     * Read samples that are interleaved in a signal, e.g. a subset of the axes of a sensor.
+     * The signal is seen as `count` frames of `stride` samples starting at `offset`, and
+     * the samples at `picks[0..picks_count)` within every frame are written to `out_ptr`
+     * one after the other (`count * picks_count` floats).
+     * Signals from signal_from_buffer are read directly, any other signal is read in pages
+     * of whole frames (EIDSP_SIGNAL_PAGE_SIZE floats) rather than one get_data per sample.
+     * @param signal Input signal
+     * @param offset Offset of the first frame in the signal
+     * @param stride Number of samples per frame
+     * @param count Number of frames
+     * @param picks Index of every sample to keep within a frame
+     * @param picks_count Number of picks
+     * @param out_ptr Output buffer
+     * @returns 0 if OK, otherwise the error returned by get_data
+     */
+    template<typename IndexT>
+    static int signal_get_data_strided(signal_t *signal, size_t offset, size_t stride, size_t count,
+                                       const IndexT *picks, size_t picks_count, float *out_ptr)
+    {
+        if (signal->buffer) {
+            const float *frame = signal->buffer + offset;
+            for (size_t ix = 0; ix < count; ix++) {
+                for (size_t pick_ix = 0; pick_ix < picks_count; pick_ix++) {
+                    *out_ptr++ = frame[picks[pick_ix]];
+                }
+                frame += stride;
+            }
+            return 0;
+        }
+
+        const size_t frames_per_page = EIDSP_SIGNAL_PAGE_SIZE / stride;
+        if (frames_per_page == 0) {
+            // frames larger than a page, only fetch the samples we keep
+            for (size_t ix = 0; ix < count; ix++) {
+                for (size_t pick_ix = 0; pick_ix < picks_count; pick_ix++) {
+                    int r = signal->get_data(offset + ix * stride + picks[pick_ix], 1, out_ptr++);
+                    if (r != 0) {
+                        return r;
+                    }
+                }
+            }
+            return 0;
+        }
+
+        // the last frame of a page doesn't have to be read past its last pick
+        size_t last_pick = 0;
+        for (size_t pick_ix = 0; pick_ix < picks_count; pick_ix++) {
+            last_pick = std::max(last_pick, (size_t)picks[pick_ix]);
+        }
+
+        float page[EIDSP_SIGNAL_PAGE_SIZE];
+        for (size_t ix = 0; ix < count; ix += frames_per_page) {
+            const size_t frames = std::min(frames_per_page, count - ix);
+            int r = signal->get_data(offset + ix * stride, (frames - 1) * stride + last_pick + 1, page);
+            if (r != 0) {
+                return r;
+            }
+
+            const float *frame = page;
+            for (size_t frame_ix = 0; frame_ix < frames; frame_ix++) {
+                for (size_t pick_ix = 0; pick_ix < picks_count; pick_ix++) {
+                    *out_ptr++ = frame[picks[pick_ix]];
+                }
+                frame += stride;
+            }
+        }
+        return 0;
+    }
+
 #endif
 
 #if defined ( __GNUC__ )
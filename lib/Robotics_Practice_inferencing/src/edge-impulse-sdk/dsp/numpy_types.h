@@ -699,6 +699,15 @@ typedef struct ei_signal_t {
      *  preprocessing and inference.
     */
     size_t total_length;
+
+#if EIDSP_SIGNAL_C_FN_POINTER == 0
+    /**
+     * Optional, set by `numpy::signal_from_buffer()`. When the samples sit in one contiguous
+     * float buffer, readers such as `numpy::signal_get_data_strided()` copy from it directly
+     * instead of going through `get_data`. Leave NULL for any other source.
+    */
+    const float *buffer = nullptr;
+#endif // EIDSP_SIGNAL_C_FN_POINTER == 0
 } signal_t;
 
 /** @} */
@@ -38,6 +38,7 @@
 #include <Arduino.h>
 #include <stdarg.h>
 #include <stdlib.h>
+#include "../ei_pool_allocator.h"
 
 #define EI_WEAK_FN __attribute__((weak))
 
@@ -98,15 +99,27 @@ __attribute__((weak)) void ei_printf_float(float f) {
 }
 
 __attribute__((weak)) void *ei_malloc(size_t size) {
+#if EI_CLASSIFIER_USE_POOL_ALLOCATOR == 1
+    return ei_pool_malloc(size);
+#else
     return malloc(size);
+#endif
 }
 
 __attribute__((weak)) void *ei_calloc(size_t nitems, size_t size) {
+#if EI_CLASSIFIER_USE_POOL_ALLOCATOR == 1
+    return ei_pool_calloc(nitems, size);
+#else
     return calloc(nitems, size);
+#endif
 }
 
 __attribute__((weak)) void ei_free(void *ptr) {
+#if EI_CLASSIFIER_USE_POOL_ALLOCATOR == 1
+    ei_pool_free(ptr);
+#else
     free(ptr);
+#endif
 }
 
 #if defined(__cplusplus) && EI_C_LINKAGE == 1
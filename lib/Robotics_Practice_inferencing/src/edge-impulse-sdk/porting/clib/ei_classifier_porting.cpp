@@ -36,6 +36,8 @@
 #if EI_PORTING_CLIB == 1
 #include <stdarg.h>
 #include <stdio.h>
+#include <chrono>
+#include "edge-impulse-sdk/porting/ei_pool_allocator.h"
 
 __attribute__((weak)) EI_IMPULSE_ERROR ei_run_impulse_check_canceled() {
     return EI_IMPULSE_OK;
@@ -52,8 +54,13 @@ uint64_t ei_read_timer_ms() {
     return ei_read_timer_us() / 1000;
 }
 
-uint64_t ei_read_timer_us() {
-    return 0;
+/**
+ * Monotonic time from the C++ standard library, so DSP / inference / post-processing
+ * timings are real on a host. Weak, for targets without a steady clock
+ */
+__attribute__((weak)) uint64_t ei_read_timer_us() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
 }
 
 __attribute__((weak)) void ei_printf(const char *format, ...) {
@@ -78,15 +85,27 @@ __attribute__((weak)) char ei_getchar(void)
 }
 
 __attribute__((weak)) void *ei_malloc(size_t size) {
+#if EI_CLASSIFIER_USE_POOL_ALLOCATOR == 1
+    return ei_pool_malloc(size);
+#else
     return malloc(size);
+#endif
 }
 
 __attribute__((weak)) void *ei_calloc(size_t nitems, size_t size) {
+#if EI_CLASSIFIER_USE_POOL_ALLOCATOR == 1
+    return ei_pool_calloc(nitems, size);
+#else
     return calloc(nitems, size);
+#endif
 }
 
 __attribute__((weak)) void ei_free(void *ptr) {
+#if EI_CLASSIFIER_USE_POOL_ALLOCATOR == 1
+    ei_pool_free(ptr);
+#else
     free(ptr);
+#endif
 }
 
 #if defined(__cplusplus) && EI_C_LINKAGE == 1
@@ -0,0 +1,454 @@
+/* The Clear BSD License
+ *
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "ei_pool_allocator.h"
+#if EI_CLASSIFIER_USE_POOL_ALLOCATOR == 1
+
+#include "ei_classifier_porting.h"
+#include "edge-impulse-sdk/dsp/config.hpp"
+#include <string.h>
+
+#if defined(ESP32) || EI_PORTING_ESPRESSIF == 1
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+static portMUX_TYPE ei_pool_mux = portMUX_INITIALIZER_UNLOCKED;
+#define EI_POOL_LOCK()      portENTER_CRITICAL(&ei_pool_mux)
+#define EI_POOL_UNLOCK()    portEXIT_CRITICAL(&ei_pool_mux)
+#else
+#include <atomic>
+static std::atomic_flag ei_pool_flag = ATOMIC_FLAG_INIT;
+#define EI_POOL_LOCK()      while (ei_pool_flag.test_and_set(std::memory_order_acquire)) { }
+#define EI_POOL_UNLOCK()    ei_pool_flag.clear(std::memory_order_release)
+#endif
+
+// only the pool knows the real in-use numbers when it is active, so report them
+// through the DSP counters unless those are already maintained by EIDSP_TRACK_ALLOCATIONS
+#if EIDSP_TRACK_ALLOCATIONS == 0
+extern size_t ei_memory_in_use;
+extern size_t ei_memory_peak_use;
+#define EI_POOL_REPORT_USAGE    1
+#else
+#define EI_POOL_REPORT_USAGE    0
+#endif
+
+#define EI_POOL_MAGIC           0xE1B0
+#define EI_POOL_CLASS_LARGE     0xFFFF
+
+// Every block is preceded by this header, its size keeps the user pointer at the block alignment
+typedef struct {
+    uint16_t magic;
+    uint16_t class_ix;
+    uint32_t size;      // requested size
+    uint32_t capacity;  // usable size of the block
+    uint32_t offset;    // from the start of the fallback allocation to the header, 0 in the arena
+} ei_pool_header_t;
+
+static_assert(sizeof(ei_pool_header_t) == EI_POOL_MIN_BLOCK_SIZE, "pool header must keep blocks aligned");
+
+typedef struct ei_pool_free_node {
+    struct ei_pool_free_node *next;
+} ei_pool_free_node_t;
+
+static struct {
+    bool active;
+    ei_pool_config_t config;
+    uint8_t *arena_start;
+    uint8_t *arena_end;
+    uint8_t *arena_next;
+    ei_pool_free_node_t *free_lists[EI_POOL_CLASS_COUNT];
+    ei_pool_header_t *large_cache[EI_POOL_LARGE_CACHE_SLOTS];
+    ei_pool_stats_t stats;
+} pool;
+
+static inline void *header_to_user(ei_pool_header_t *hdr) {
+    return (void *)(hdr + 1);
+}
+
+static inline ei_pool_header_t *user_to_header(void *ptr) {
+    return ((ei_pool_header_t *)ptr) - 1;
+}
+
+// Fallback blocks are over-allocated so the header, and with it the user pointer, lands on the
+// block alignment whatever alignment the fallback allocator gives (ESP-NN wants 16 bytes)
+static ei_pool_header_t *fallback_block(void *(*alloc_fn)(size_t), size_t capacity) {
+    uint8_t *raw = (uint8_t *)alloc_fn(sizeof(ei_pool_header_t) + capacity + EI_POOL_MIN_BLOCK_SIZE - 1);
+    if (!raw) {
+        return NULL;
+    }
+    uintptr_t aligned = ((uintptr_t)raw + (EI_POOL_MIN_BLOCK_SIZE - 1)) & ~((uintptr_t)EI_POOL_MIN_BLOCK_SIZE - 1);
+    ei_pool_header_t *hdr = (ei_pool_header_t *)aligned;
+    hdr->offset = (uint32_t)(aligned - (uintptr_t)raw);
+    return hdr;
+}
+
+static inline void *fallback_start(ei_pool_header_t *hdr) {
+    return (uint8_t *)hdr - hdr->offset;
+}
+
+static int size_to_class(size_t size) {
+    size_t block_size = EI_POOL_MIN_BLOCK_SIZE;
+    for (int ix = 0; ix < EI_POOL_CLASS_COUNT; ix++) {
+        if (size <= block_size) {
+            return ix;
+        }
+        block_size <<= 1;
+    }
+    return -1;
+}
+
+static void register_alloc(size_t size) {
+    pool.stats.bytes_in_use += size;
+    if (pool.stats.bytes_in_use > pool.stats.peak_bytes_in_use) {
+        pool.stats.peak_bytes_in_use = pool.stats.bytes_in_use;
+    }
+#if EI_POOL_REPORT_USAGE == 1
+    ei_memory_in_use = pool.stats.bytes_in_use;
+    ei_memory_peak_use = pool.stats.peak_bytes_in_use;
+#endif
+}
+
+static void register_free(size_t size) {
+    pool.stats.bytes_in_use -= size;
+#if EI_POOL_REPORT_USAGE == 1
+    ei_memory_in_use = pool.stats.bytes_in_use;
+#endif
+}
+
+static void update_largest_free_block(void) {
+    // a small request takes a whole block of its class, from the free list or carved from the arena
+    const size_t arena_left = (size_t)(pool.arena_end - pool.arena_next);
+    size_t largest = 0;
+    for (int ix = EI_POOL_CLASS_COUNT - 1; ix >= 0; ix--) {
+        const size_t block_size = pool.stats.classes[ix].block_size;
+        if (pool.free_lists[ix] || arena_left >= sizeof(ei_pool_header_t) + block_size) {
+            largest = block_size;
+            break;
+        }
+    }
+    for (int ix = 0; ix < EI_POOL_LARGE_CACHE_SLOTS; ix++) {
+        if (pool.large_cache[ix] && pool.large_cache[ix]->capacity > largest) {
+            largest = pool.large_cache[ix]->capacity;
+        }
+    }
+    pool.stats.largest_free_block = largest;
+}
+
+bool ei_pool_init(const ei_pool_config_t *config) {
+    if (!config || !config->fallback_malloc || !config->fallback_free) {
+        return false;
+    }
+
+    EI_POOL_LOCK();
+    memset(&pool, 0, sizeof(pool));
+    pool.config = *config;
+
+    uintptr_t start = ((uintptr_t)config->arena + (EI_POOL_MIN_BLOCK_SIZE - 1)) & ~((uintptr_t)EI_POOL_MIN_BLOCK_SIZE - 1);
+    uintptr_t end = (uintptr_t)config->arena + config->arena_size;
+    if (!config->arena || end < start) {
+        start = end = 0;
+    }
+    pool.arena_start = (uint8_t *)start;
+    pool.arena_end = (uint8_t *)end;
+    pool.arena_next = pool.arena_start;
+
+    size_t block_size = EI_POOL_MIN_BLOCK_SIZE;
+    for (int ix = 0; ix < EI_POOL_CLASS_COUNT; ix++) {
+        pool.stats.classes[ix].block_size = block_size;
+        block_size <<= 1;
+    }
+    pool.stats.arena_size = (size_t)(end - start);
+    update_largest_free_block();
+    pool.active = true;
+    EI_POOL_UNLOCK();
+
+    return true;
+}
+
+bool ei_pool_is_active(void) {
+    return pool.active;
+}
+
+static void *pool_malloc_small(int class_ix, size_t size) {
+    ei_pool_class_stats_t *cls = &pool.stats.classes[class_ix];
+    ei_pool_header_t *hdr = NULL;
+
+    EI_POOL_LOCK();
+    if (pool.free_lists[class_ix]) {
+        ei_pool_free_node_t *node = pool.free_lists[class_ix];
+        pool.free_lists[class_ix] = node->next;
+        cls->free_blocks--;
+        hdr = user_to_header(node);
+    }
+    else if ((size_t)(pool.arena_end - pool.arena_next) >= sizeof(ei_pool_header_t) + cls->block_size) {
+        hdr = (ei_pool_header_t *)pool.arena_next;
+        hdr->offset = 0;
+        pool.arena_next += sizeof(ei_pool_header_t) + cls->block_size;
+        pool.stats.arena_carved = (size_t)(pool.arena_next - pool.arena_start);
+    }
+    EI_POOL_UNLOCK();
+
+    // arena exhausted, grow this class from the fallback allocator
+    bool from_fallback = false;
+    if (!hdr) {
+        hdr = fallback_block(pool.config.fallback_malloc, cls->block_size);
+        from_fallback = true;
+    }
+
+    EI_POOL_LOCK();
+    if (!hdr) {
+        pool.stats.failed_allocs++;
+        EI_POOL_UNLOCK();
+        return NULL;
+    }
+    if (from_fallback) {
+        pool.stats.small_fallback_blocks++;
+    }
+    hdr->magic = EI_POOL_MAGIC;
+    hdr->class_ix = (uint16_t)class_ix;
+    hdr->size = (uint32_t)size;
+    hdr->capacity = (uint32_t)cls->block_size;
+
+    cls->allocs++;
+    cls->in_use++;
+    if (cls->in_use > cls->peak_in_use) {
+        cls->peak_in_use = cls->in_use;
+    }
+    register_alloc(size);
+    update_largest_free_block();
+    EI_POOL_UNLOCK();
+
+    return header_to_user(hdr);
+}
+
+static void *pool_malloc_large(size_t size) {
+    ei_pool_header_t *hdr = NULL;
+
+    // best fit from the cache, but don't hand out blocks more than twice the size we need
+    EI_POOL_LOCK();
+    int best_ix = -1;
+    for (int ix = 0; ix < EI_POOL_LARGE_CACHE_SLOTS; ix++) {
+        ei_pool_header_t *c = pool.large_cache[ix];
+        if (!c || c->capacity < size || c->capacity / 2 > size) {
+            continue;
+        }
+        if (best_ix == -1 || c->capacity < pool.large_cache[best_ix]->capacity) {
+            best_ix = ix;
+        }
+    }
+    if (best_ix != -1) {
+        hdr = pool.large_cache[best_ix];
+        pool.large_cache[best_ix] = NULL;
+        pool.stats.large_cached--;
+        pool.stats.large_cache_hits++;
+    }
+    EI_POOL_UNLOCK();
+
+    if (!hdr) {
+        hdr = fallback_block(pool.config.fallback_malloc, size);
+        if (hdr) {
+            hdr->capacity = (uint32_t)size;
+        }
+    }
+
+    EI_POOL_LOCK();
+    if (!hdr) {
+        pool.stats.failed_allocs++;
+        EI_POOL_UNLOCK();
+        return NULL;
+    }
+    hdr->magic = EI_POOL_MAGIC;
+    hdr->class_ix = EI_POOL_CLASS_LARGE;
+    hdr->size = (uint32_t)size;
+
+    pool.stats.large_allocs++;
+    pool.stats.large_in_use++;
+    if (pool.stats.large_in_use > pool.stats.large_peak_in_use) {
+        pool.stats.large_peak_in_use = pool.stats.large_in_use;
+    }
+    register_alloc(size);
+    update_largest_free_block();
+    EI_POOL_UNLOCK();
+
+    return header_to_user(hdr);
+}
+
+void *ei_pool_malloc(size_t size) {
+    if (size == 0) {
+        return NULL;
+    }
+
+    if (!pool.active) {
+        // not initialized yet, still tag the block so it can be free'd later on
+        ei_pool_header_t *hdr = fallback_block(malloc, size);
+        if (!hdr) {
+            return NULL;
+        }
+        hdr->magic = 0;
+        return header_to_user(hdr);
+    }
+
+    int class_ix = size_to_class(size);
+    if (class_ix >= 0) {
+        return pool_malloc_small(class_ix, size);
+    }
+    return pool_malloc_large(size);
+}
+
+void *ei_pool_calloc(size_t nitems, size_t size) {
+    size_t bytes = nitems * size;
+    if (size != 0 && bytes / size != nitems) {
+        return NULL;
+    }
+
+    void *ptr = ei_pool_malloc(bytes);
+    if (ptr) {
+        memset(ptr, 0, bytes);
+    }
+    return ptr;
+}
+
+void ei_pool_free(void *ptr) {
+    if (!ptr) {
+        return;
+    }
+
+    ei_pool_header_t *hdr = user_to_header(ptr);
+
+    // allocated before the pool was initialized
+    if (hdr->magic != EI_POOL_MAGIC) {
+        free(fallback_start(hdr));
+        return;
+    }
+
+    EI_POOL_LOCK();
+    register_free(hdr->size);
+
+    if (hdr->class_ix != EI_POOL_CLASS_LARGE) {
+        ei_pool_class_stats_t *cls = &pool.stats.classes[hdr->class_ix];
+        ei_pool_free_node_t *node = (ei_pool_free_node_t *)ptr;
+        node->next = pool.free_lists[hdr->class_ix];
+        pool.free_lists[hdr->class_ix] = node;
+        cls->in_use--;
+        cls->free_blocks++;
+        update_largest_free_block();
+        EI_POOL_UNLOCK();
+        return;
+    }
+
+    pool.stats.large_in_use--;
+
+    // keep the block for the next frame; if the cache is full evict the smallest block
+    int slot = -1;
+    for (int ix = 0; ix < EI_POOL_LARGE_CACHE_SLOTS; ix++) {
+        if (!pool.large_cache[ix]) {
+            slot = ix;
+            break;
+        }
+        if (slot == -1 || pool.large_cache[ix]->capacity < pool.large_cache[slot]->capacity) {
+            slot = ix;
+        }
+    }
+
+    ei_pool_header_t *evict = NULL;
+    if (pool.large_cache[slot] && pool.large_cache[slot]->capacity >= hdr->capacity) {
+        evict = hdr;
+    }
+    else {
+        if (pool.large_cache[slot]) {
+            evict = pool.large_cache[slot];
+        }
+        else {
+            pool.stats.large_cached++;
+        }
+        pool.large_cache[slot] = hdr;
+    }
+    update_largest_free_block();
+    EI_POOL_UNLOCK();
+
+    if (evict) {
+        pool.config.fallback_free(fallback_start(evict));
+    }
+}
+
+void ei_pool_trim(void) {
+    ei_pool_header_t *release[EI_POOL_LARGE_CACHE_SLOTS];
+
+    EI_POOL_LOCK();
+    for (int ix = 0; ix < EI_POOL_LARGE_CACHE_SLOTS; ix++) {
+        release[ix] = pool.large_cache[ix];
+        pool.large_cache[ix] = NULL;
+    }
+    pool.stats.large_cached = 0;
+    update_largest_free_block();
+    EI_POOL_UNLOCK();
+
+    for (int ix = 0; ix < EI_POOL_LARGE_CACHE_SLOTS; ix++) {
+        if (release[ix]) {
+            pool.config.fallback_free(fallback_start(release[ix]));
+        }
+    }
+}
+
+void ei_pool_get_stats(ei_pool_stats_t *stats) {
+    EI_POOL_LOCK();
+    *stats = pool.stats;
+    EI_POOL_UNLOCK();
+}
+
+void ei_pool_print_stats(void) {
+    ei_pool_stats_t s;
+    ei_pool_get_stats(&s);
+
+    ei_printf("Pool: in use %u bytes (peak %u), arena %u/%u bytes carved, largest free block %u bytes\n",
+        (unsigned)s.bytes_in_use, (unsigned)s.peak_bytes_in_use,
+        (unsigned)s.arena_carved, (unsigned)s.arena_size, (unsigned)s.largest_free_block);
+    for (int ix = 0; ix < EI_POOL_CLASS_COUNT; ix++) {
+        const ei_pool_class_stats_t *c = &s.classes[ix];
+        if (c->allocs == 0) {
+            continue;
+        }
+        ei_printf("    %5u bytes: in use %u (peak %u), free %u, allocs %u\n",
+            (unsigned)c->block_size, (unsigned)c->in_use, (unsigned)c->peak_in_use,
+            (unsigned)c->free_blocks, (unsigned)c->allocs);
+    }
+    ei_printf("    large: in use %u (peak %u), cached %u, allocs %u (cache hits %u)\n",
+        (unsigned)s.large_in_use, (unsigned)s.large_peak_in_use, (unsigned)s.large_cached,
+        (unsigned)s.large_allocs, (unsigned)s.large_cache_hits);
+    if (s.small_fallback_blocks || s.failed_allocs) {
+        ei_printf("    arena overflow blocks %u, failed allocs %u\n",
+            (unsigned)s.small_fallback_blocks, (unsigned)s.failed_allocs);
+    }
+}
+
+#endif // EI_CLASSIFIER_USE_POOL_ALLOCATOR == 1
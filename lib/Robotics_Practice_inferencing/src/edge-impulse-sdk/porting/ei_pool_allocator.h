@@ -0,0 +1,158 @@
+/* The Clear BSD License
+ *
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _EI_POOL_ALLOCATOR_H_
+#define _EI_POOL_ALLOCATOR_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * Size-class pool allocator that can sit behind the ei_malloc / ei_calloc / ei_free hooks.
+ *
+ * Small requests (up to EI_POOL_MAX_BLOCK_SIZE bytes) are served from segregated free lists
+ * carved out of a user supplied arena; freed blocks go back onto the list of their class and
+ * are never returned to the system heap. Large requests (tensor arena, DSP matrices) go to the
+ * fallback allocator, but freed large blocks are kept in a small cache and handed out again on
+ * the next request that fits. Per-frame allocation patterns therefore reuse the same memory
+ * every frame instead of fragmenting the system heap.
+ *
+ * Enable with EI_CLASSIFIER_USE_POOL_ALLOCATOR=1 and call ei_pool_init() before the first
+ * call to run_classifier(). Until ei_pool_init() is called all requests go to the fallback.
+ */
+
+#ifndef EI_CLASSIFIER_USE_POOL_ALLOCATOR
+#define EI_CLASSIFIER_USE_POOL_ALLOCATOR        0
+#endif // EI_CLASSIFIER_USE_POOL_ALLOCATOR
+
+// smallest size class, in bytes (also the alignment of every returned pointer, blocks from the
+// fallback allocator are over-allocated to keep it)
+#define EI_POOL_MIN_BLOCK_SIZE                  16
+// number of power-of-two size classes (16, 32, ..., 2048 bytes by default)
+#ifndef EI_POOL_CLASS_COUNT
+#define EI_POOL_CLASS_COUNT                     8
+#endif // EI_POOL_CLASS_COUNT
+#define EI_POOL_MAX_BLOCK_SIZE                  (EI_POOL_MIN_BLOCK_SIZE << (EI_POOL_CLASS_COUNT - 1))
+// number of freed large blocks that are kept around for reuse
+#ifndef EI_POOL_LARGE_CACHE_SLOTS
+#define EI_POOL_LARGE_CACHE_SLOTS               4
+#endif // EI_POOL_LARGE_CACHE_SLOTS
+
+typedef struct {
+    /** Arena that small blocks are carved from (may be NULL, then small blocks also use the fallback) */
+    void *arena;
+    /** Size of the arena in bytes */
+    size_t arena_size;
+    /** Allocator for large blocks and for small blocks once the arena is exhausted */
+    void *(*fallback_malloc)(size_t size);
+    /** Release function matching fallback_malloc */
+    void (*fallback_free)(void *ptr);
+} ei_pool_config_t;
+
+typedef struct {
+    /** Usable size of a block in this class */
+    size_t block_size;
+    /** Blocks currently handed out */
+    uint32_t in_use;
+    /** Highest value of in_use seen */
+    uint32_t peak_in_use;
+    /** Blocks sitting on the free list */
+    uint32_t free_blocks;
+    /** Total number of allocations served by this class */
+    uint32_t allocs;
+} ei_pool_class_stats_t;
+
+typedef struct {
+    ei_pool_class_stats_t classes[EI_POOL_CLASS_COUNT];
+    /** Large blocks currently handed out */
+    uint32_t large_in_use;
+    /** Highest value of large_in_use seen */
+    uint32_t large_peak_in_use;
+    /** Total number of large allocations */
+    uint32_t large_allocs;
+    /** Large allocations served from the cache instead of the fallback allocator */
+    uint32_t large_cache_hits;
+    /** Freed large blocks currently kept in the cache */
+    uint32_t large_cached;
+    /** Small blocks that had to come from the fallback because the arena was exhausted */
+    uint32_t small_fallback_blocks;
+    /** Allocations that failed */
+    uint32_t failed_allocs;
+    /** Requested bytes currently in use */
+    size_t bytes_in_use;
+    /** Highest value of bytes_in_use seen */
+    size_t peak_bytes_in_use;
+    /** Size of the arena */
+    size_t arena_size;
+    /** Bytes of the arena that have been carved into blocks */
+    size_t arena_carved;
+    /** Largest single request that can be served without touching the fallback allocator */
+    size_t largest_free_block;
+} ei_pool_stats_t;
+
+/**
+ * Initialize the pool. Any allocations made before this call keep going to
+ * the fallback allocator and are released correctly by ei_pool_free().
+ * @param config Arena and fallback allocator
+ * @return true if the pool is active
+ */
+bool ei_pool_init(const ei_pool_config_t *config);
+
+/**
+ * @return true once ei_pool_init() succeeded
+ */
+bool ei_pool_is_active(void);
+
+void *ei_pool_malloc(size_t size);
+void *ei_pool_calloc(size_t nitems, size_t size);
+void ei_pool_free(void *ptr);
+
+/**
+ * Return all cached large blocks to the fallback allocator,
+ * e.g. before starting a WiFi stack that needs contiguous heap.
+ */
+void ei_pool_trim(void);
+
+/**
+ * Copy the current statistics
+ * @param stats Output
+ */
+void ei_pool_get_stats(ei_pool_stats_t *stats);
+
+/**
+ * Print the statistics through ei_printf
+ */
+void ei_pool_print_stats(void);
+
+#endif // _EI_POOL_ALLOCATOR_H_
@@ -49,6 +49,7 @@
 
 // memory handling
 #include "esp_heap_caps.h"
+#include "../ei_pool_allocator.h"
 
 #define EI_WEAK_FN __attribute__((weak))
 
@@ -98,6 +99,9 @@ __attribute__((weak)) void ei_printf_float(float f) {
 // we use alligned alloc instead of regular malloc
 // due to https://github.com/espressif/esp-nn/issues/7
 __attribute__((weak)) void *ei_malloc(size_t size) {
+#if EI_CLASSIFIER_USE_POOL_ALLOCATOR == 1
+    return ei_pool_malloc(size);
+#else
 #if defined(CONFIG_IDF_TARGET_ESP32S3)
 #if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
     return heap_caps_aligned_alloc(16, size, MALLOC_CAP_DEFAULT);
@@ -106,9 +110,13 @@ __attribute__((weak)) void *ei_malloc(size_t size) {
 #endif
 #endif
     return malloc(size);
+#endif
 }
 
 __attribute__((weak)) void *ei_calloc(size_t nitems, size_t size) {
+#if EI_CLASSIFIER_USE_POOL_ALLOCATOR == 1
+    return ei_pool_calloc(nitems, size);
+#else
 #if defined(CONFIG_IDF_TARGET_ESP32S3)
 #if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
     return heap_caps_calloc(nitems, size, MALLOC_CAP_DEFAULT);
@@ -123,10 +131,15 @@ __attribute__((weak)) void *ei_calloc(size_t nitems, size_t size) {
 #endif
 #endif
     return calloc(nitems, size);
+#endif
 }
 
 __attribute__((weak)) void ei_free(void *ptr) {
+#if EI_CLASSIFIER_USE_POOL_ALLOCATOR == 1
+    ei_pool_free(ptr);
+#else
     free(ptr);
+#endif
 }
 
 #if defined(__cplusplus) && EI_C_LINKAGE == 1
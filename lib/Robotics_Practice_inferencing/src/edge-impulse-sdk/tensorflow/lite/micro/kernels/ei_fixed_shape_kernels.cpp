@@ -0,0 +1,139 @@
+/* The Clear BSD License
+ *
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "edge-impulse-sdk/tensorflow/lite/micro/kernels/ei_fixed_shape_kernels.h"
+
+namespace tflite {
+namespace ei_fixed {
+
+namespace {
+
+// The same quantization parameters the generic conv and depthwise kernels compute in prepare
+OpDataConv* AllocateConvData(TfLiteContext* context, TfLiteNode* node, int quantized_dimension) {
+  MicroContext* micro_context = GetMicroContext(context);
+  TfLiteTensor* filter = micro_context->AllocateTempInputTensor(node, kConvWeightsTensor);
+  if (filter == nullptr) {
+    return nullptr;
+  }
+  const int num_channels = filter->dims->data[quantized_dimension];
+  micro_context->DeallocateTempTfLiteTensor(filter);
+
+  OpDataConv* data = static_cast<OpDataConv*>(
+    context->AllocatePersistentBuffer(context, sizeof(OpDataConv)));
+  if (data == nullptr) {
+    return nullptr;
+  }
+  data->per_channel_output_multiplier = static_cast<int32_t*>(
+    context->AllocatePersistentBuffer(context, num_channels * sizeof(int32_t)));
+  data->per_channel_output_shift = static_cast<int32_t*>(
+    context->AllocatePersistentBuffer(context, num_channels * sizeof(int32_t)));
+  if (data->per_channel_output_multiplier == nullptr || data->per_channel_output_shift == nullptr) {
+    return nullptr;
+  }
+  return data;
+}
+
+}  // namespace
+
+void* SetupConv(TfLiteContext* context, TfLiteNode* node) {
+  const TfLiteConvParams& params = *static_cast<const TfLiteConvParams*>(node->builtin_data);
+  MicroContext* micro_context = GetMicroContext(context);
+  TfLiteTensor* input = micro_context->AllocateTempInputTensor(node, kConvInputTensor);
+  TfLiteTensor* filter = micro_context->AllocateTempInputTensor(node, kConvWeightsTensor);
+  TfLiteTensor* output = micro_context->AllocateTempOutputTensor(node, kConvOutputTensor);
+  OpDataConv* data = nullptr;
+
+  if (input && filter && output && input->type == kTfLiteInt8 && filter->type == kTfLiteInt8 &&
+      filter->quantization.type == kTfLiteAffineQuantization) {
+    data = AllocateConvData(context, node, kConvQuantizedDimension);
+    if (data && CalculateOpDataConv(context, node, params, input->dims->data[2], input->dims->data[1],
+          filter->dims->data[2], filter->dims->data[1], output->dims->data[2], output->dims->data[1],
+          input->type, data) != kTfLiteOk) {
+      data = nullptr;
+    }
+  }
+
+  micro_context->DeallocateTempTfLiteTensor(input);
+  micro_context->DeallocateTempTfLiteTensor(filter);
+  micro_context->DeallocateTempTfLiteTensor(output);
+  return data;
+}
+
+void* SetupDepthwiseConv(TfLiteContext* context, TfLiteNode* node) {
+  const TfLiteDepthwiseConvParams& params = *static_cast<const TfLiteDepthwiseConvParams*>(node->builtin_data);
+  MicroContext* micro_context = GetMicroContext(context);
+  TfLiteTensor* input = micro_context->AllocateTempInputTensor(node, kDepthwiseConvInputTensor);
+  TfLiteTensor* filter = micro_context->AllocateTempInputTensor(node, kDepthwiseConvWeightsTensor);
+  TfLiteTensor* output = micro_context->AllocateTempOutputTensor(node, kDepthwiseConvOutputTensor);
+  OpDataConv* data = nullptr;
+
+  if (input && filter && output && input->type == kTfLiteInt8 && filter->type == kTfLiteInt8 &&
+      filter->quantization.type == kTfLiteAffineQuantization && params.depth_multiplier == 1) {
+    data = AllocateConvData(context, node, kDepthwiseConvQuantizedDimension);
+    if (data && CalculateOpDataDepthwiseConv(context, node, params, input->dims->data[2], input->dims->data[1],
+          filter->dims->data[2], filter->dims->data[1], output->dims->data[2], output->dims->data[1],
+          input->type, data) != kTfLiteOk) {
+      data = nullptr;
+    }
+  }
+
+  micro_context->DeallocateTempTfLiteTensor(input);
+  micro_context->DeallocateTempTfLiteTensor(filter);
+  micro_context->DeallocateTempTfLiteTensor(output);
+  return data;
+}
+
+void* SetupAdd(TfLiteContext* context, TfLiteNode* node) {
+  TfLiteAddParams* params = static_cast<TfLiteAddParams*>(node->builtin_data);
+  MicroContext* micro_context = GetMicroContext(context);
+  TfLiteTensor* input1 = micro_context->AllocateTempInputTensor(node, kAddInputTensor1);
+  TfLiteTensor* input2 = micro_context->AllocateTempInputTensor(node, kAddInputTensor2);
+  TfLiteTensor* output = micro_context->AllocateTempOutputTensor(node, kAddOutputTensor);
+  OpDataAdd* data = nullptr;
+
+  if (input1 && input2 && output && output->type == kTfLiteInt8) {
+    data = static_cast<OpDataAdd*>(context->AllocatePersistentBuffer(context, sizeof(OpDataAdd)));
+    if (data && CalculateOpDataAdd(context, params, input1, input2, output, data) != kTfLiteOk) {
+      data = nullptr;
+    }
+  }
+
+  micro_context->DeallocateTempTfLiteTensor(input1);
+  micro_context->DeallocateTempTfLiteTensor(input2);
+  micro_context->DeallocateTempTfLiteTensor(output);
+  return data;
+}
+
+}  // namespace ei_fixed
+}  // namespace tflite
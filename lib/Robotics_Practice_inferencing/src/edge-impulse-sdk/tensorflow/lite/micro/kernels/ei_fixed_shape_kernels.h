@@ -0,0 +1,371 @@
+/* The Clear BSD License
+ *
+ * Copyright (c) 2025 EdgeImpulse Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   * Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _EI_FIXED_SHAPE_KERNELS_H_
+#define _EI_FIXED_SHAPE_KERNELS_H_
+
+#include "edge-impulse-sdk/tensorflow/lite/c/builtin_op_data.h"
+#include "edge-impulse-sdk/tensorflow/lite/c/common.h"
+#include "edge-impulse-sdk/tensorflow/lite/kernels/internal/common.h"
+#include "edge-impulse-sdk/tensorflow/lite/micro/kernels/add.h"
+#include "edge-impulse-sdk/tensorflow/lite/micro/kernels/conv.h"
+#include "edge-impulse-sdk/tensorflow/lite/micro/kernels/depthwise_conv.h"
+#include "edge-impulse-sdk/tensorflow/lite/micro/kernels/kernel_util.h"
+
+/**
+ * Int8 conv, depthwise conv and add kernels with the shape of a node fixed at compile time.
+ *
+ * A compiled (EON) graph knows the shape of every node, so it can instantiate these templates
+ * per node: kernel size, channels, stride and row width become constants, the channel loops are
+ * unrolled and there is no dispatch on dims or padding left at runtime. Only the number of rows
+ * is read from the tensors, so the kernels also run on row tiles.
+ *
+ * The quantization parameters are computed once by the setup functions, with the same code the
+ * generic kernels use in prepare, and the arithmetic follows the reference kernels, so the output
+ * is bit-exact with the generic path. The invoke functions return false when the tensors they get
+ * (input, filter, bias and output) do not have the shape they were instantiated for; the caller
+ * then runs the generic kernel.
+ *
+ * The padding checks are hoisted out of the filter loops: output pixels whose window lies inside
+ * the input run with constant loop bounds, only the border pixels clip their window, once.
+ */
+
+#if defined(__clang__)
+#define EI_FIXED_UNROLL _Pragma("unroll")
+#elif defined(__GNUC__) && __GNUC__ >= 8
+#define EI_FIXED_UNROLL _Pragma("GCC unroll 128")
+#else
+#define EI_FIXED_UNROLL
+#endif
+
+namespace tflite {
+namespace ei_fixed {
+
+// Computes the quantization parameters of a node in persistent memory, nullptr on failure
+typedef void* (*SetupFn)(TfLiteContext* context, TfLiteNode* node);
+// Runs the node, false if the tensors do not match the instantiated shape
+typedef bool (*InvokeFn)(TfLiteContext* context, TfLiteNode* node, const void* data);
+
+typedef struct {
+  SetupFn setup;
+  InvokeFn invoke;
+} Kernel;
+
+void* SetupConv(TfLiteContext* context, TfLiteNode* node);
+void* SetupDepthwiseConv(TfLiteContext* context, TfLiteNode* node);
+void* SetupAdd(TfLiteContext* context, TfLiteNode* node);
+
+inline bool HasShape(const TfLiteEvalTensor* tensor, int width, int depth) {
+  return tensor->type == kTfLiteInt8 && tensor->dims->size == 4 && tensor->dims->data[0] == 1 &&
+    tensor->dims->data[2] == width && tensor->dims->data[3] == depth;
+}
+
+inline bool HasFilterShape(const TfLiteEvalTensor* filter, int out_c, int kh, int kw, int in_c) {
+  return filter->type == kTfLiteInt8 && filter->dims->size == 4 && filter->dims->data[0] == out_c &&
+    filter->dims->data[1] == kh && filter->dims->data[2] == kw && filter->dims->data[3] == in_c;
+}
+
+inline bool HasBiasShape(const TfLiteEvalTensor* bias, int channels) {
+  return bias == nullptr || (bias->type == kTfLiteInt32 && bias->dims->size >= 1 &&
+    bias->dims->data[bias->dims->size - 1] == channels);
+}
+
+// First and one past the last output column whose window of kernel_w columns lies inside the input
+inline void InteriorColumns(int in_w, int out_w, int kernel_w, int stride, int padding,
+                            int* begin, int* end) {
+  int first = (padding + stride - 1) / stride;
+  int last = in_w + padding >= kernel_w ? (in_w + padding - kernel_w) / stride + 1 : 0;
+  first = first < out_w ? first : out_w;
+  last = last < first ? first : (last > out_w ? out_w : last);
+  *begin = first;
+  *end = last;
+}
+
+inline int8_t Requantize(int32_t acc, int32_t multiplier, int32_t shift, const OpDataConv& data) {
+  acc = MultiplyByQuantizedMultiplier(acc, multiplier, shift);
+  acc += data.output_zero_point;
+  acc = acc < data.output_activation_min ? data.output_activation_min : acc;
+  acc = acc > data.output_activation_max ? data.output_activation_max : acc;
+  return static_cast<int8_t>(acc);
+}
+
+// One output pixel of a conv, BORDER clips the window to the input
+template <int KH, int KW, int IN_C, int OUT_C, int IN_W, bool BORDER>
+inline void ConvPixel(const OpDataConv& data, const int8_t* input_data, int input_height,
+                      int in_y_origin, int in_x_origin, const int8_t* filter_data,
+                      const int32_t* bias_data, int8_t* output_data) {
+  const int ky_begin = BORDER && in_y_origin < 0 ? -in_y_origin : 0;
+  const int ky_end = BORDER && in_y_origin + KH > input_height ? input_height - in_y_origin : KH;
+  const int kx_begin = BORDER && in_x_origin < 0 ? -in_x_origin : 0;
+  const int kx_end = BORDER && in_x_origin + KW > IN_W ? IN_W - in_x_origin : KW;
+  const int32_t input_offset = -data.input_zero_point;
+
+  for (int out_c = 0; out_c < OUT_C; out_c++) {
+    const int8_t* f = filter_data + out_c * KH * KW * IN_C;
+    int32_t acc = 0;
+    for (int ky = ky_begin; ky < ky_end; ky++) {
+      for (int kx = kx_begin; kx < kx_end; kx++) {
+        const int8_t* in = input_data + ((in_y_origin + ky) * IN_W + in_x_origin + kx) * IN_C;
+        const int8_t* w = f + (ky * KW + kx) * IN_C;
+        EI_FIXED_UNROLL
+        for (int in_c = 0; in_c < IN_C; in_c++) {
+          acc += w[in_c] * (in[in_c] + input_offset);
+        }
+      }
+    }
+    if (bias_data) {
+      acc += bias_data[out_c];
+    }
+    output_data[out_c] = Requantize(acc, data.per_channel_output_multiplier[out_c],
+      data.per_channel_output_shift[out_c], data);
+  }
+}
+
+template <int KH, int KW, int IN_C, int OUT_C, int STRIDE, int IN_W, int OUT_W>
+bool Conv(TfLiteContext* context, TfLiteNode* node, const void* user_data) {
+  const OpDataConv& data = *static_cast<const OpDataConv*>(user_data);
+  const TfLiteConvParams& params = *static_cast<const TfLiteConvParams*>(node->builtin_data);
+  const TfLiteEvalTensor* input = micro::GetEvalInput(context, node, kConvInputTensor);
+  const TfLiteEvalTensor* filter = micro::GetEvalInput(context, node, kConvWeightsTensor);
+  const TfLiteEvalTensor* bias = node->inputs->size == 3 ?
+    micro::GetEvalInput(context, node, kConvBiasTensor) : nullptr;
+  TfLiteEvalTensor* output = micro::GetEvalOutput(context, node, kConvOutputTensor);
+  if (!HasShape(input, IN_W, IN_C) || !HasShape(output, OUT_W, OUT_C) ||
+      !HasFilterShape(filter, OUT_C, KH, KW, IN_C) || !HasBiasShape(bias, OUT_C) ||
+      params.stride_height != STRIDE || params.stride_width != STRIDE ||
+      params.dilation_height_factor != 1 || params.dilation_width_factor != 1) {
+    return false;
+  }
+
+  const int input_height = input->dims->data[1];
+  const int output_height = output->dims->data[1];
+  const int8_t* input_data = micro::GetTensorData<int8_t>(input);
+  const int8_t* filter_data = micro::GetTensorData<int8_t>(filter);
+  const int32_t* bias_data = bias ? micro::GetTensorData<int32_t>(bias) : nullptr;
+  int8_t* output_data = micro::GetTensorData<int8_t>(output);
+
+  int x_begin, x_end;
+  InteriorColumns(IN_W, OUT_W, KW, STRIDE, data.padding.width, &x_begin, &x_end);
+
+  for (int out_y = 0; out_y < output_height; out_y++) {
+    const int in_y_origin = out_y * STRIDE - data.padding.height;
+    int8_t* out_row = output_data + out_y * OUT_W * OUT_C;
+    const bool border_row = in_y_origin < 0 || in_y_origin + KH > input_height;
+    const int interior_begin = border_row ? OUT_W : x_begin;
+    const int interior_end = border_row ? OUT_W : x_end;
+    for (int out_x = 0; out_x < interior_begin; out_x++) {
+      ConvPixel<KH, KW, IN_C, OUT_C, IN_W, true>(data, input_data, input_height, in_y_origin,
+        out_x * STRIDE - data.padding.width, filter_data, bias_data, out_row + out_x * OUT_C);
+    }
+    for (int out_x = interior_begin; out_x < interior_end; out_x++) {
+      ConvPixel<KH, KW, IN_C, OUT_C, IN_W, false>(data, input_data, input_height, in_y_origin,
+        out_x * STRIDE - data.padding.width, filter_data, bias_data, out_row + out_x * OUT_C);
+    }
+    for (int out_x = interior_end; out_x < OUT_W; out_x++) {
+      ConvPixel<KH, KW, IN_C, OUT_C, IN_W, true>(data, input_data, input_height, in_y_origin,
+        out_x * STRIDE - data.padding.width, filter_data, bias_data, out_row + out_x * OUT_C);
+    }
+  }
+  return true;
+}
+
+// 1x1 conv with stride 1: a matrix multiply over all pixels, so the width does not matter
+template <int IN_C, int OUT_C>
+bool PointwiseConv(TfLiteContext* context, TfLiteNode* node, const void* user_data) {
+  const OpDataConv& data = *static_cast<const OpDataConv*>(user_data);
+  const TfLiteConvParams& params = *static_cast<const TfLiteConvParams*>(node->builtin_data);
+  const TfLiteEvalTensor* input = micro::GetEvalInput(context, node, kConvInputTensor);
+  const TfLiteEvalTensor* filter = micro::GetEvalInput(context, node, kConvWeightsTensor);
+  const TfLiteEvalTensor* bias = node->inputs->size == 3 ?
+    micro::GetEvalInput(context, node, kConvBiasTensor) : nullptr;
+  TfLiteEvalTensor* output = micro::GetEvalOutput(context, node, kConvOutputTensor);
+  const int width = input->dims->data[2];
+  if (!HasShape(input, width, IN_C) || !HasShape(output, width, OUT_C) ||
+      input->dims->data[1] != output->dims->data[1] ||
+      !HasFilterShape(filter, OUT_C, 1, 1, IN_C) || !HasBiasShape(bias, OUT_C) ||
+      params.stride_height != 1 || params.stride_width != 1 ||
+      data.padding.height != 0 || data.padding.width != 0) {
+    return false;
+  }
+
+  const int pixels = input->dims->data[1] * width;
+  const int32_t input_offset = -data.input_zero_point;
+  const int8_t* input_data = micro::GetTensorData<int8_t>(input);
+  const int8_t* filter_data = micro::GetTensorData<int8_t>(filter);
+  const int32_t* bias_data = bias ? micro::GetTensorData<int32_t>(bias) : nullptr;
+  int8_t* output_data = micro::GetTensorData<int8_t>(output);
+
+  for (int p = 0; p < pixels; p++) {
+    const int8_t* in = input_data + p * IN_C;
+    for (int out_c = 0; out_c < OUT_C; out_c++) {
+      const int8_t* w = filter_data + out_c * IN_C;
+      int32_t acc = 0;
+      EI_FIXED_UNROLL
+      for (int in_c = 0; in_c < IN_C; in_c++) {
+        acc += w[in_c] * (in[in_c] + input_offset);
+      }
+      if (bias_data) {
+        acc += bias_data[out_c];
+      }
+      *output_data++ = Requantize(acc, data.per_channel_output_multiplier[out_c],
+        data.per_channel_output_shift[out_c], data);
+    }
+  }
+  return true;
+}
+
+// One output pixel of a depthwise conv, BORDER clips the window to the input
+template <int KH, int KW, int C, int IN_W, bool BORDER>
+inline void DepthwiseConvPixel(const OpDataConv& data, const int8_t* input_data, int input_height,
+                               int in_y_origin, int in_x_origin, const int8_t* filter_data,
+                               const int32_t* bias_data, int8_t* output_data) {
+  const int ky_begin = BORDER && in_y_origin < 0 ? -in_y_origin : 0;
+  const int ky_end = BORDER && in_y_origin + KH > input_height ? input_height - in_y_origin : KH;
+  const int kx_begin = BORDER && in_x_origin < 0 ? -in_x_origin : 0;
+  const int kx_end = BORDER && in_x_origin + KW > IN_W ? IN_W - in_x_origin : KW;
+  const int32_t input_offset = -data.input_zero_point;
+
+  int32_t acc[C];
+  for (int c = 0; c < C; c++) {
+    acc[c] = 0;
+  }
+  for (int ky = ky_begin; ky < ky_end; ky++) {
+    for (int kx = kx_begin; kx < kx_end; kx++) {
+      const int8_t* in = input_data + ((in_y_origin + ky) * IN_W + in_x_origin + kx) * C;
+      const int8_t* w = filter_data + (ky * KW + kx) * C;
+      EI_FIXED_UNROLL
+      for (int c = 0; c < C; c++) {
+        acc[c] += w[c] * (in[c] + input_offset);
+      }
+    }
+  }
+  for (int c = 0; c < C; c++) {
+    int32_t value = bias_data ? acc[c] + bias_data[c] : acc[c];
+    output_data[c] = Requantize(value, data.per_channel_output_multiplier[c],
+      data.per_channel_output_shift[c], data);
+  }
+}
+
+// Depthwise conv with a depth multiplier of 1
+template <int KH, int KW, int C, int STRIDE, int IN_W, int OUT_W>
+bool DepthwiseConv(TfLiteContext* context, TfLiteNode* node, const void* user_data) {
+  const OpDataConv& data = *static_cast<const OpDataConv*>(user_data);
+  const TfLiteDepthwiseConvParams& params = *static_cast<const TfLiteDepthwiseConvParams*>(node->builtin_data);
+  const TfLiteEvalTensor* input = micro::GetEvalInput(context, node, kDepthwiseConvInputTensor);
+  const TfLiteEvalTensor* filter = micro::GetEvalInput(context, node, kDepthwiseConvWeightsTensor);
+  const TfLiteEvalTensor* bias = node->inputs->size == 3 ?
+    micro::GetEvalInput(context, node, kDepthwiseConvBiasTensor) : nullptr;
+  TfLiteEvalTensor* output = micro::GetEvalOutput(context, node, kDepthwiseConvOutputTensor);
+  if (!HasShape(input, IN_W, C) || !HasShape(output, OUT_W, C) ||
+      !HasFilterShape(filter, 1, KH, KW, C) || !HasBiasShape(bias, C) ||
+      params.stride_height != STRIDE || params.stride_width != STRIDE ||
+      params.dilation_height_factor != 1 || params.dilation_width_factor != 1) {
+    return false;
+  }
+
+  const int input_height = input->dims->data[1];
+  const int output_height = output->dims->data[1];
+  const int8_t* input_data = micro::GetTensorData<int8_t>(input);
+  const int8_t* filter_data = micro::GetTensorData<int8_t>(filter);
+  const int32_t* bias_data = bias ? micro::GetTensorData<int32_t>(bias) : nullptr;
+  int8_t* output_data = micro::GetTensorData<int8_t>(output);
+
+  int x_begin, x_end;
+  InteriorColumns(IN_W, OUT_W, KW, STRIDE, data.padding.width, &x_begin, &x_end);
+
+  for (int out_y = 0; out_y < output_height; out_y++) {
+    const int in_y_origin = out_y * STRIDE - data.padding.height;
+    int8_t* out_row = output_data + out_y * OUT_W * C;
+    const bool border_row = in_y_origin < 0 || in_y_origin + KH > input_height;
+    const int interior_begin = border_row ? OUT_W : x_begin;
+    const int interior_end = border_row ? OUT_W : x_end;
+    for (int out_x = 0; out_x < interior_begin; out_x++) {
+      DepthwiseConvPixel<KH, KW, C, IN_W, true>(data, input_data, input_height, in_y_origin,
+        out_x * STRIDE - data.padding.width, filter_data, bias_data, out_row + out_x * C);
+    }
+    for (int out_x = interior_begin; out_x < interior_end; out_x++) {
+      DepthwiseConvPixel<KH, KW, C, IN_W, false>(data, input_data, input_height, in_y_origin,
+        out_x * STRIDE - data.padding.width, filter_data, bias_data, out_row + out_x * C);
+    }
+    for (int out_x = interior_end; out_x < OUT_W; out_x++) {
+      DepthwiseConvPixel<KH, KW, C, IN_W, true>(data, input_data, input_height, in_y_origin,
+        out_x * STRIDE - data.padding.width, filter_data, bias_data, out_row + out_x * C);
+    }
+  }
+  return true;
+}
+
+inline int FlatSize(const TfLiteEvalTensor* tensor) {
+  int size = 1;
+  for (int ix = 0; ix < tensor->dims->size; ix++) {
+    size *= tensor->dims->data[ix];
+  }
+  return size;
+}
+
+// Element-wise add of two tensors with the same shape
+template <int N>
+bool Add(TfLiteContext* context, TfLiteNode* node, const void* user_data) {
+  const OpDataAdd& data = *static_cast<const OpDataAdd*>(user_data);
+  const TfLiteEvalTensor* input1 = micro::GetEvalInput(context, node, kAddInputTensor1);
+  const TfLiteEvalTensor* input2 = micro::GetEvalInput(context, node, kAddInputTensor2);
+  TfLiteEvalTensor* output = micro::GetEvalOutput(context, node, kAddOutputTensor);
+  if (data.requires_broadcast || output->type != kTfLiteInt8 ||
+      FlatSize(input1) != N || FlatSize(input2) != N || FlatSize(output) != N) {
+    return false;
+  }
+
+  const int8_t* input1_data = micro::GetTensorData<int8_t>(input1);
+  const int8_t* input2_data = micro::GetTensorData<int8_t>(input2);
+  int8_t* output_data = micro::GetTensorData<int8_t>(output);
+  for (int i = 0; i < N; i++) {
+    const int32_t shifted_input1 = (data.input1_offset + input1_data[i]) * (1 << data.left_shift);
+    const int32_t shifted_input2 = (data.input2_offset + input2_data[i]) * (1 << data.left_shift);
+    const int32_t scaled_input1 = MultiplyByQuantizedMultiplierSmallerThanOneExp(
+      shifted_input1, data.input1_multiplier, data.input1_shift);
+    const int32_t scaled_input2 = MultiplyByQuantizedMultiplierSmallerThanOneExp(
+      shifted_input2, data.input2_multiplier, data.input2_shift);
+    int32_t value = MultiplyByQuantizedMultiplierSmallerThanOneExp(
+      scaled_input1 + scaled_input2, data.output_multiplier, data.output_shift) + data.output_offset;
+    value = value < data.output_activation_min ? data.output_activation_min : value;
+    value = value > data.output_activation_max ? data.output_activation_max : value;
+    output_data[i] = static_cast<int8_t>(value);
+  }
+  return true;
+}
+
+}  // namespace ei_fixed
+}  // namespace tflite
+
+#endif // _EI_FIXED_SHAPE_KERNELS_H_
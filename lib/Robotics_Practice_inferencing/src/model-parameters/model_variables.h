@@ -84,6 +84,17 @@ const ei_config_tflite_eon_graph_t ei_config_graph_891896_6 = {
     .model_reset = &tflite_learn_891896_6_reset,
     .model_input = &tflite_learn_891896_6_input,
     .model_output = &tflite_learn_891896_6_output,
+    .model_tensor_lifetimes = &tflite_learn_891896_6_tensor_lifetimes,
+    .model_set_arena_regions = &tflite_learn_891896_6_set_arena_regions,
+    .model_scratch_requests = &tflite_learn_891896_6_scratch_requests,
+    .model_set_memory_plan = &tflite_learn_891896_6_set_memory_plan,
+    .model_arena_size = &tflite_learn_891896_6_arena_size,
+    .model_patch_stage = &tflite_learn_891896_6_patch_stage,
+    .model_skip_final_softmax = &tflite_learn_891896_6_skip_final_softmax,
+    .model_weights = &tflite_learn_891896_6_weights,
+    .model_set_weights = &tflite_learn_891896_6_set_weights,
+    .model_set_tap = &tflite_learn_891896_6_set_tap,
+    .model_compiled_memory_plan = &tflite_learn_891896_6_compiled_memory_plan,
 };
 
 const uint8_t ei_output_tensors_indices_891896_6[1] = { 0 };
@@ -113,25 +124,80 @@ const ei_learning_block_t ei_learning_blocks_891896_1[ei_learning_blocks_891896_
     },
 };
 
-ei_fill_result_fomo_i8_config_t ei_fill_result_fomo_i8_config_891896_6 = {
+ei_fill_result_fomo_i8_logits_config_t ei_fill_result_fomo_i8_logits_config_891896_6 = {
     .threshold = 0.5,
     .out_width = 12,
     .out_height = 12,
     .object_detection_count = 10,
     .zero_point = -128,
-    .scale = 0.00390625
+    .scale = 0.00390625,
+    .beta = 1
 };
 
-const size_t ei_postprocessing_blocks_891896_1_size = 1;
+ei_fomo_fusion_config_t ei_fomo_fusion_config_891896_1 = {
+    .shift = 1
+};
+
+const int32_t ei_label_values_891896_1[] = { 1000, 100, 200, 20, 500, 50 };
+ei_label_totals_config_t ei_label_totals_config_891896_1 = {
+    .threshold = 0.5,
+    .label_values = ei_label_values_891896_1,
+    .label_values_size = 6,
+    .match_distance = 24,
+    .confirm_frames = 1,
+    .hold_frames = 1
+};
+
+ei_detection_trigger_config_t ei_detection_trigger_config_891896_1 = {
+    .detection_threshold = 0.6,
+    .average_window_duration_ms = 1500,
+    .suppression_ms = 3000,
+    .frame_interval_ms = 500, // active_interval_ms of the capture scheduler, the shortest
+    .suppression_flags = 0,
+    .grid_width = 12,
+    .grid_height = 12
+};
+
+const size_t ei_postprocessing_blocks_891896_1_size = 4;
 const ei_postprocessing_block_t ei_postprocessing_blocks_891896_1[ei_postprocessing_blocks_891896_1_size] = {
+    {
+        .block_id = 8,
+        .type = EI_CLASSIFIER_MODE_OTHER,
+        .init_fn = &init_fomo_fusion,
+        .deinit_fn = &deinit_fomo_fusion,
+        .postprocess_fn = &process_fomo_fusion,
+        .display_fn = NULL,
+        .config = (void*)&ei_fomo_fusion_config_891896_1,
+        .input_block_id = 6
+    },
     {
         .block_id = 6,
         .type = EI_CLASSIFIER_MODE_OBJECT_DETECTION,
-        .init_fn = NULL,
-        .deinit_fn = NULL,
-        .postprocess_fn = &process_fomo_i8,
+        .init_fn = &init_fomo_i8_logits,
+        .deinit_fn = &deinit_fomo_i8_logits,
+        .postprocess_fn = &process_fomo_i8_logits,
+        .display_fn = NULL,
+        .config = (void*)&ei_fill_result_fomo_i8_logits_config_891896_6,
+        .input_block_id = 6
+    },
+    {
+        .block_id = 7,
+        .type = EI_CLASSIFIER_MODE_OTHER,
+        .init_fn = &init_label_totals,
+        .deinit_fn = &deinit_label_totals,
+        .postprocess_fn = &process_label_totals,
+        .display_fn = NULL,
+        .config = (void*)&ei_label_totals_config_891896_1,
+        .input_block_id = 6
+    },
+    {
+        .block_id = 9,
+        .type = EI_CLASSIFIER_MODE_OTHER,
+        .init_fn = &init_detection_trigger,
+        .deinit_fn = &deinit_detection_trigger,
+        .postprocess_fn = &process_detection_trigger,
         .display_fn = NULL,
-        .config = (void*)&ei_fill_result_fomo_i8_config_891896_6,
+        .config = (void*)&ei_detection_trigger_config_891896_1,
         .input_block_id = 6
     },
 };
@@ -36,6 +36,18 @@
 #include "edge-impulse-sdk/tensorflow/lite/c/common.h"
 #include "edge-impulse-sdk/tensorflow/lite/micro/micro_mutable_op_resolver.h"
 #include "edge-impulse-sdk/porting/ei_classifier_porting.h"
+#include "edge-impulse-sdk/classifier/ei_arena_types.h"
+#include "edge-impulse-sdk/classifier/ei_classifier_config.h"
+#include "tflite-model/tflite_learn_891896_6_compiled.h"
+
+#if EI_CLASSIFIER_TFLITE_FIXED_SHAPE_KERNELS == 1
+#include "edge-impulse-sdk/tensorflow/lite/micro/kernels/ei_fixed_shape_kernels.h"
+#endif
+
+#if defined(EI_CLASSIFIER_TFLITE_MEMORY_PLAN)
+// generated with ei_memory_plan_print_source(), on the target or on a host build with the same kernels
+#include "tflite-model/tflite_learn_891896_6_memory_plan.h"
+#endif
 
 #if EI_CLASSIFIER_PRINT_STATE
 #if defined(__cplusplus) && EI_C_LINKAGE == 1
@@ -75,6 +87,13 @@ extern void ei_printf(const char *format, ...);
 #define MODEL_SECTION(X)
 #endif
 
+// constant tensor data is compiled in, or supplied at runtime (see tflite_learn_891896_6_set_weights)
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 1
+#define WEIGHTS_DATA(X) nullptr
+#else
+#define WEIGHTS_DATA(X) X
+#endif
+
 #ifndef EI_MAX_SCRATCH_BUFFER_COUNT
 #ifndef CONFIG_IDF_TARGET_ESP32S3
 #define EI_MAX_SCRATCH_BUFFER_COUNT 14
@@ -93,10 +112,17 @@ using namespace tflite::ops::micro;
 
 namespace {
 
+#if EI_CLASSIFIER_TFLITE_FIXED_SHAPE_KERNELS == 1
+// persistent quantization parameters of the fixed shape kernels (see fixed_kernels)
+constexpr int kFixedKernelsArenaSize = 9216;
+#else
+constexpr int kFixedKernelsArenaSize = 0;
+#endif
+
 #if defined(EI_CLASSIFIER_ALLOCATION_STATIC_HIMAX) || defined(EI_CLASSIFIER_ALLOCATION_STATIC_HIMAX_GNU)
-constexpr int kTensorArenaSize = 242624;
+constexpr int kTensorArenaSize = 242624 + kFixedKernelsArenaSize;
 #else
-constexpr int kTensorArenaSize = 241600;
+constexpr int kTensorArenaSize = 241600 + kFixedKernelsArenaSize;
 #endif
 
 #if defined(EI_CLASSIFIER_ALLOCATION_STATIC)
@@ -119,6 +145,44 @@ uint8_t* tensor_arena = NULL;
 static uint8_t* tensor_boundary;
 static uint8_t* current_location;
 
+// Set by tflite_learn_891896_6_skip_final_softmax, invoke then stops before the last node
+static bool skip_final_softmax = false;
+
+// Set by tflite_learn_891896_6_set_weights, whether every constant tensor has its data
+static bool weights_set = EI_CLASSIFIER_WEIGHTS_BLOB == 0;
+
+// Set by tflite_learn_891896_6_set_tap, invoke hands the output of this node to tap_fn
+static int tap_node = -1;
+static ei_tensor_tap_fn tap_fn = NULL;
+static void* tap_ctx = NULL;
+
+#if defined(EI_CLASSIFIER_ALLOCATION_HEAP)
+// Optional split of the arena layout over separately placed regions (see tflite_learn_891896_6_set_arena_regions)
+#ifndef EI_MAX_ARENA_REGION_COUNT
+#define EI_MAX_ARENA_REGION_COUNT 8
+#endif // EI_MAX_ARENA_REGION_COUNT
+static ei_arena_region_t arena_regions[EI_MAX_ARENA_REGION_COUNT];
+static size_t arena_regions_count = 0;
+static uint8_t* persistent_area = NULL;
+static size_t persistent_area_bytes = 0;
+
+// Optional joint layout of activations and scratch buffers (see tflite_learn_891896_6_set_memory_plan)
+#if defined(EI_CLASSIFIER_TFLITE_MEMORY_PLAN)
+static const ei_memory_plan_t* memory_plan = &tflite_learn_891896_6_memory_plan;
+#else
+static const ei_memory_plan_t* memory_plan = NULL;
+#endif
+
+static uint8_t* arena_ptr(uintptr_t offset) {
+  for (size_t ix = 0; ix < arena_regions_count; ix++) {
+    if (offset >= arena_regions[ix].offset && offset < arena_regions[ix].offset + arena_regions[ix].bytes) {
+      return arena_regions[ix].ptr + (offset - arena_regions[ix].offset);
+    }
+  }
+  return tensor_arena + offset;
+}
+#endif // EI_CLASSIFIER_ALLOCATION_HEAP
+
 template <int SZ, class T> struct TfArray {
   int sz; T elem[SZ];
 };
@@ -158,18 +222,23 @@ const TfArray<4, int> tensor_dimension0 = { 4, { 1,96,96,1 } };
 const TfArray<1, float> quant0_scale = { 1, { 0.0039215688593685627, } };
 const TfArray<1, int> quant0_zero = { 1, { -128 } };
 const TfLiteAffineQuantization quant0 = { (TfLiteFloatArray*)&quant0_scale, (TfLiteIntArray*)&quant0_zero, 0 };
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 0
 const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int32_t tensor_data1[4*2] = { 
   0, 0, 
   0, 1, 
   0, 1, 
   0, 0, 
 };
+#endif // EI_CLASSIFIER_WEIGHTS_BLOB
 const TfArray<2, int> tensor_dimension1 = { 2, { 4,2 } };
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 0
 const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int32_t tensor_data2[7] = { 20659, -34721, -31351, -28611, -29492, -40023, -22290, };
+#endif // EI_CLASSIFIER_WEIGHTS_BLOB
 const TfArray<1, int> tensor_dimension2 = { 1, { 7 } };
 const TfArray<7, float> quant2_scale = { 7, { 0.00022956756583880633, 0.00019246689043939114, 0.00019561732187867165, 0.00022347501362673938, 0.00019472278654575348, 0.00016299288836307824, 0.00025596845080144703, } };
 const TfArray<7, int> quant2_zero = { 7, { 0,0,0,0,0,0,0 } };
 const TfLiteAffineQuantization quant2 = { (TfLiteFloatArray*)&quant2_scale, (TfLiteIntArray*)&quant2_zero, 0 };
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 0
 const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int8_t tensor_data3[7*1*1*32] = { 
   /* [0][0][][] */ 15,-74,30,-2,-58,-37,4,47,-34,-61,5,68,88,-41,-23,27,11,58,4,-127,30,-62,-49,-57,49,35,-27,109,28,-102,115,-59, 
   /* [1][0][][] */ 46,-80,24,-7,32,-26,42,-88,58,30,-83,-49,-127,107,86,88,-37,38,52,-56,56,61,-9,16,-32,84,103,8,1,-29,-49,-3, 
@@ -179,14 +248,18 @@ const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int8_t tensor_data3[7*1*1*32] =
   /* [5][0][][] */ 67,-39,-43,92,-30,100,110,79,-123,-49,127,-11,-99,-10,7,-100,-89,3,27,-19,127,101,-111,42,56,-91,109,91,-69,-41,-99,5, 
   /* [6][0][][] */ 72,-11,-10,32,-49,-53,-35,1,58,-60,18,-62,-8,-22,13,61,20,-10,46,-60,-61,75,29,54,17,-36,-54,-77,-127,6,-73,37, 
 };
+#endif // EI_CLASSIFIER_WEIGHTS_BLOB
 const TfArray<4, int> tensor_dimension3 = { 4, { 7,1,1,32 } };
 const TfArray<7, float> quant3_scale = { 7, { 0.0050036460161209106, 0.0041950009763240814, 0.004263667855411768, 0.0048708529211580753, 0.0042441706173121929, 0.0035525867715477943, 0.0055790785700082779, } };
 const TfLiteAffineQuantization quant3 = { (TfLiteFloatArray*)&quant3_scale, (TfLiteIntArray*)&g0::quant2_zero, 0 };
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 0
 const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int32_t tensor_data4[32] = { 746, -727, 104, 400, -94, 69, 492, 129, -206, -175, 182, 418, 1516, 326, 431, 465, -19, 577, 509, -248, -264, 392, -403, 267, 26, 322, -132, 2010, 1443, -351, 1951, -22, };
+#endif // EI_CLASSIFIER_WEIGHTS_BLOB
 const TfArray<1, int> tensor_dimension4 = { 1, { 32 } };
 const TfArray<32, float> quant4_scale = { 32, { 5.9330923249945045e-05, 8.5309628047980368e-05, 7.5183343142271042e-05, 6.2170074670575559e-05, 6.4085106714628637e-05, 7.9150471719913185e-05, 6.7195935116615146e-05, 6.3478117226622999e-05, 7.8979428508318961e-05, 7.9805584391579032e-05, 6.6966764279641211e-05, 6.7751578171737492e-05, 7.7597280323971063e-05, 9.0566660219337791e-05, 6.2351798987947404e-05, 6.2638842791784555e-05, 7.1199581725522876e-05, 7.5259238656144589e-05, 6.1386293964460492e-05, 8.3248793089296669e-05, 5.0377391744405031e-05, 5.7801957154879346e-05, 7.1972332079894841e-05, 6.323793058982119e-05, 4.6262019168352708e-05, 8.2057340478058904e-05, 6.4293300965800881e-05, 6.4316118368878961e-05, 9.4161099696066231e-05, 6.3735860749147832e-05, 9.2399866844061762e-05, 7.8393524745479226e-05, } };
 const TfArray<32, int> quant4_zero = { 32, { 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0 } };
 const TfLiteAffineQuantization quant4 = { (TfLiteFloatArray*)&quant4_scale, (TfLiteIntArray*)&quant4_zero, 0 };
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 0
 const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int8_t tensor_data5[32*1*1*96] = { 
   /* [0][0][][] */ -28,-18,104,19,76,-24,-103,-81,71,-124,-72,-68,61,30,-32,42,-95,-36,-61,-19,-25,-75,27,77,-56,-29,79,-8,96,17,-2,-96,38,-25,-50,1,-46,-54,-51,31,5,-78,-54,100,38,-71,98,-3,8,-35,-7,72,-32,-66,-121,88,4,53,116,-127,-53,62,-16,47,18,40,31,41,63,76,92,-65,101,-86,43,83,-75,34,-17,53,64,-48,98,-5,-44,-47,-39,12,46,117,18,-89,-13,72,30,48, 
   /* [1][0][][] */ -15,35,-52,-33,-23,50,-3,10,56,-54,-61,127,27,-27,8,32,48,18,-18,53,-23,12,23,13,21,-9,-30,48,-3,13,56,-16,41,72,1,6,7,3,-12,5,-2,15,-38,-48,15,34,-22,-61,-6,-41,31,-37,2,85,-9,-16,18,48,31,47,-48,92,-18,-42,-48,30,34,16,57,0,-6,11,-63,27,-40,28,39,-6,-13,16,-74,24,-30,-6,0,98,-30,-23,40,43,40,-5,73,78,19,-12, 
@@ -221,14 +294,18 @@ const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int8_t tensor_data5[32*1*1*96] =
   /* [30][0][][] */ 50,-19,-14,43,-8,25,85,35,51,-2,52,-35,-21,31,51,54,17,19,48,-29,31,-46,-37,38,-58,63,-24,67,16,-39,0,47,-10,-1,-34,65,-8,15,46,-31,119,26,-5,48,75,22,66,38,-78,46,11,-40,69,-13,14,73,13,-20,-37,22,-8,7,-27,31,-32,-14,3,127,-12,53,34,2,-19,66,44,10,1,-56,-31,-30,38,69,-46,30,-31,46,-32,123,-4,-62,59,69,-18,58,18,-51, 
   /* [31][0][][] */ 44,-66,50,86,17,24,-87,-73,-36,-32,-67,-127,78,-60,-42,63,-56,-60,21,55,36,-1,-4,62,19,-95,52,34,-38,-34,37,34,-16,17,-37,-47,104,-6,-14,-57,-3,-61,-6,39,29,-42,4,35,50,-36,65,-5,-44,-66,-114,46,-101,50,39,-2,-9,7,71,-28,59,76,-57,-65,67,-29,-46,24,-14,-26,16,12,-52,27,39,72,-17,-42,62,30,30,24,-29,-31,10,-4,-28,-6,-35,49,13,-13, 
 };
+#endif // EI_CLASSIFIER_WEIGHTS_BLOB
 const TfArray<4, int> tensor_dimension5 = { 4, { 32,1,1,96 } };
 const TfArray<32, float> quant5_scale = { 32, { 0.0025215642526745796, 0.0036256590392440557, 0.0031952920835465193, 0.0026422282680869102, 0.0027236170135438442, 0.003363894997164607, 0.0028558271005749702, 0.0026978200767189264, 0.0033566257916390896, 0.0033917373511940241, 0.0028460873290896416, 0.002879441948607564, 0.0032978844828903675, 0.0038490828592330217, 0.0026499514933675528, 0.0026621508877724409, 0.0030259822960942984, 0.0031985174864530563, 0.0026089174207299948, 0.0035380737390369177, 0.0021410391200333834, 0.0024565830826759338, 0.0030588239897042513, 0.0026876118499785662, 0.0019661358091980219, 0.0034874370321631432, 0.0027324652764946222, 0.0027334350161254406, 0.0040018465369939804, 0.00270877406001091, 0.0039269942790269852, 0.0033317247871309519, } };
 const TfLiteAffineQuantization quant5 = { (TfLiteFloatArray*)&quant5_scale, (TfLiteIntArray*)&g0::quant4_zero, 0 };
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 0
 const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int32_t tensor_data6[96] = { 1823, -116, 3292, 6312, 3559, -2442, 5366, -1176, -2278, 92, 3980, -1178, 4024, 4578, 2462, 2675, -243, -115, -534, 4947, 2890, -586, 3071, -179, -1258, 5275, 1591, 1877, 6692, 2208, 4597, 2392, 1268, 4514, 5868, 5546, -679, 3604, 2033, -3713, 799, 1333, -46, 2203, -1381, 139, -2053, 1002, -6987, 2432, 1002, -2384, 9468, -571, 3144, 1381, 2203, 1970, -1867, -1531, 530, 1579, 522, 6421, 6580, 3246, 2539, 8777, 3386, -603, 4065, 5219, 3638, -768, 3605, 8336, -63, -2821, 634, 1184, 6501, 3536, -257, -1643, 1198, 400, 1929, -2752, 3779, -345, 3174, 864, 5, -1776, -147, 1201, };
+#endif // EI_CLASSIFIER_WEIGHTS_BLOB
 const TfArray<1, int> tensor_dimension6 = { 1, { 96 } };
 const TfArray<96, float> quant6_scale = { 96, { 0.00012780482938978821, 0.00020090256293769926, 0.00018360411922913045, 0.00013010059774387628, 0.00018925726180896163, 0.00015712942695245147, 0.00014802672376390547, 0.00020487152505666018, 0.00016593249165453017, 0.00022774323588237166, 0.00018073484534397721, 0.00024807907175272703, 0.0001422324130544439, 0.00014137245307210833, 0.00014348006516229361, 0.00014275875582825392, 0.00023496791254729033, 0.00028976768953725696, 0.00024881368153728545, 0.00011716348672052845, 0.0001560389791848138, 0.00017687148647382855, 0.00011589371570153162, 0.00019021086336579174, 0.00019281650020275265, 0.00014113639190327376, 0.00017154669330921024, 0.00019828137010335922, 0.00011423358955653384, 0.00016385652997996658, 0.00011298073513898998, 0.0001505921536590904, 0.0002512820647098124, 0.00012872350635007024, 0.00010019715409725904, 0.00012822798453271389, 0.00019456073641777039, 0.0001282944722333923, 0.00016959322965703905, 0.00014651185483671725, 0.00021505812765099108, 0.00015053435345180333, 0.0001853492867667228, 0.00012451241491362453, 0.00016968869022093713, 0.00012347733718343079, 0.00012260455696377903, 0.00017478119116276503, 9.6368370577692986e-05, 0.00015820223779883236, 0.00025971443392336369, 0.00014139924314804375, 7.8135788498912007e-05, 0.00016856873116921633, 0.00016528635751456022, 0.0002071816852549091, 0.0001572368637425825, 0.00019536004401743412, 0.00011874570191139355, 0.00017710070824250579, 0.00017286888032685965, 0.00017243396723642945, 0.00024449580814689398, 0.0001130872406065464, 0.00010975135228363797, 0.00013550932635553181, 0.00016297839465551078, 9.6189083706121892e-05, 0.00018080305017065257, 0.00014477841614279896, 0.00012038855493301526, 0.00013439962640404701, 0.00013844098430126905, 0.00018883806478697807, 0.00020079399109818041, 0.00010053673759102821, 0.00011665656347759068, 0.00019039938342757523, 0.0001721397420624271, 0.00014920425019226968, 0.00013146735727787018, 0.00016719357518013567, 0.00014335448213387281, 0.00020036945352330804, 0.00017730359104461968, 0.00017816448234952986, 0.00014901914983056486, 0.00014146602188702673, 0.00015862612053751945, 0.00015112607798073441, 0.00019061515922658145, 0.00026111333863809705, 0.00012449528730940074, 0.00017381832003593445, 0.00020065029093530029, 0.00023753578716423362, } };
 const TfArray<96, int> quant6_zero = { 96, { 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0 } };
 const TfLiteAffineQuantization quant6 = { (TfLiteFloatArray*)&quant6_scale, (TfLiteIntArray*)&quant6_zero, 0 };
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 0
 const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int8_t tensor_data7[96*1*1*16] = { 
   /* [0][0][][] */ -34,48,-81,69,48,-48,72,102,-42,-15,10,-127,115,116,-91,46, 
   /* [1][0][][] */ -29,0,-55,-29,-5,23,21,-127,30,-37,-56,-83,7,-53,-70,-4, 
@@ -327,14 +404,18 @@ const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int8_t tensor_data7[96*1*1*16] =
   /* [94][0][][] */ 38,68,102,31,-127,-59,4,-7,30,-42,39,-13,-71,-50,4,-51, 
   /* [95][0][][] */ 8,47,50,103,127,-8,-105,36,59,7,-40,41,-20,37,74,-87, 
 };
+#endif // EI_CLASSIFIER_WEIGHTS_BLOB
 const TfArray<4, int> tensor_dimension7 = { 4, { 96,1,1,16 } };
 const TfArray<96, float> quant7_scale = { 96, { 0.0020088367164134979, 0.0031577872578054667, 0.0028858901932835579, 0.0020449217408895493, 0.0029747462831437588, 0.0024697608314454556, 0.0023266845382750034, 0.0032201712019741535, 0.0026081274263560772, 0.0035796689335256815, 0.0028407908976078033, 0.0038993076886981726, 0.0022356095723807812, 0.0022220925893634558, 0.0022552201990038157, 0.0022438825108110905, 0.0036932264920324087, 0.0045545697212219238, 0.0039108544588088989, 0.0018415760714560747, 0.0024526212364435196, 0.0027800665702670813, 0.001821617828682065, 0.0029897349886596203, 0.0030306903645396233, 0.0022183822002261877, 0.0026963714044541121, 0.0031165871769189835, 0.0017955239163711667, 0.0025754973758012056, 0.0017758315661922097, 0.0023670080117881298, 0.0039496524259448051, 0.0020232764072716236, 0.0015748991863802075, 0.002015487989410758, 0.0030581064056605101, 0.0020165329333394766, 0.002665666863322258, 0.0023028738796710968, 0.0033802844118326902, 0.0023660995066165924, 0.0029133206699043512, 0.0019570866134017706, 0.0026671674568206072, 0.001940817222930491, 0.0019270987249910831, 0.0027472113724797964, 0.0015147184021770954, 0.0024866233579814434, 0.004082192201167345, 0.0022225137799978256, 0.0012281385716050863, 0.0026495638303458691, 0.0025979715865105391, 0.0032564823050051928, 0.0024714495521038771, 0.0030706697143614292, 0.0018664452945813537, 0.0027836696244776249, 0.0027171536348760128, 0.0027103177271783352, 0.0038429857231676579, 0.001777505618520081, 0.0017250721575692296, 0.0021299361251294613, 0.0025616949424147606, 0.0015119003364816308, 0.0028418628498911858, 0.0022756275720894337, 0.0018922677263617516, 0.0021124938502907753, 0.0021760158706456423, 0.0029681574087589979, 0.0031560806091874838, 0.0015802368288859725, 0.0018336082575842738, 0.0029926982242614031, 0.0027056930121034384, 0.0023451929446309805, 0.0020664043258875608, 0.0026279492303729057, 0.0022532462608069181, 0.0031494076829403639, 0.0027868584729731083, 0.0028003898914903402, 0.0023422834929078817, 0.0022235633805394173, 0.0024932858068495989, 0.0023754001595079899, 0.0029960896354168653, 0.0041041802614927292, 0.0019568172283470631, 0.0027320769149810076, 0.0031538219191133976, 0.003733588382601738, } };
 const TfLiteAffineQuantization quant7 = { (TfLiteFloatArray*)&quant7_scale, (TfLiteIntArray*)&g0::quant6_zero, 0 };
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 0
 const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int32_t tensor_data8[16] = { 1991, 7971, 906, 14307, -10951, -3938, 102, -1067, 14384, 5496, -11945, 2000, -16727, 13732, 2808, 25217, };
+#endif // EI_CLASSIFIER_WEIGHTS_BLOB
 const TfArray<1, int> tensor_dimension8 = { 1, { 16 } };
 const TfArray<16, float> quant8_scale = { 16, { 9.5338000392075628e-05, 9.5764837169554085e-05, 9.2627968115266412e-05, 0.00012735450582113117, 6.2176222854759544e-05, 9.7805561381392181e-05, 6.5589083533268422e-05, 0.00010591903264867142, 0.00010436579759698361, 0.00010330809891456738, 6.7863613367080688e-05, 9.421367576578632e-05, 9.2906680947635323e-05, 8.2751081208698452e-05, 0.00013921159552410245, 7.5142379500903189e-05, } };
 const TfArray<16, int> quant8_zero = { 16, { 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0 } };
 const TfLiteAffineQuantization quant8 = { (TfLiteFloatArray*)&quant8_scale, (TfLiteIntArray*)&quant8_zero, 0 };
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 0
 const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int8_t tensor_data9[16*1*1*96] = { 
   /* [0][0][][] */ -88,37,67,-32,-55,-19,-10,-30,-7,9,4,-8,65,23,1,-34,22,2,58,18,-4,-12,127,72,61,34,6,49,-15,-87,-69,15,-18,-45,-7,13,-15,39,7,32,-7,8,-41,13,-56,-21,27,35,17,-10,-56,-14,-15,-10,-10,-37,-26,20,-10,55,50,25,-9,3,-27,-42,-21,10,-45,-33,4,19,-14,23,-39,-27,-15,16,-51,-12,-39,45,47,-31,17,49,-8,58,29,-16,-4,-36,-17,-15,-38,-21, 
   /* [1][0][][] */ 12,60,58,-78,-74,-20,39,-28,-31,43,127,-52,41,-11,-85,-43,-64,24,-87,33,-13,-88,58,74,-5,-53,-36,-38,109,-105,114,-67,63,15,-15,83,79,112,7,-52,63,50,36,26,5,34,-105,-90,9,-108,-28,-25,23,-21,-60,33,91,27,-41,0,40,38,-6,-66,-13,-37,-69,14,21,31,-99,-11,-68,3,20,-94,10,50,-28,-73,-15,-29,-61,-28,51,-28,-17,93,-71,-33,-58,13,72,76,-31,52, 
@@ -353,23 +434,31 @@ const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int8_t tensor_data9[16*1*1*96] =
   /* [14][0][][] */ -27,19,-59,-39,68,64,-79,-9,61,-42,79,7,33,-47,-55,-49,-44,13,50,127,-4,-37,-12,23,1,24,-18,72,41,-16,-40,31,85,7,-40,5,-38,51,71,44,20,33,12,29,-27,-50,75,-62,36,-37,-41,-2,44,-9,-52,20,59,87,-79,5,-1,-54,-19,-97,-28,-65,-35,-3,-84,66,-34,39,3,-47,11,-35,47,11,-95,-44,40,23,-20,1,27,62,-17,-11,-36,77,59,8,6,-30,-47,-89, 
   /* [15][0][][] */ -103,-28,-27,-25,38,-45,-82,-92,-39,20,25,51,-17,-6,38,57,-77,-3,-10,-58,32,-66,-92,-103,34,-28,45,-124,-43,-123,-9,15,7,51,78,-96,5,-34,5,-40,-41,31,-19,-44,-67,17,44,84,-73,-71,-64,-42,-43,59,-3,-55,-82,-26,73,2,-62,24,-49,-50,-88,-27,1,21,86,-59,126,-65,51,-18,-20,-28,-28,-22,-6,17,-4,67,37,5,-17,-34,-127,-54,-12,-15,-27,79,31,-28,-6,30, 
 };
+#endif // EI_CLASSIFIER_WEIGHTS_BLOB
 const TfArray<4, int> tensor_dimension9 = { 4, { 16,1,1,96 } };
 const TfArray<16, float> quant9_scale = { 16, { 0.0040518650785088539, 0.0040700053796172142, 0.0039366884157061577, 0.0054125664755702019, 0.0026424892712384462, 0.0041567361913621426, 0.0027875360101461411, 0.0045015588402748108, 0.0044355462305247784, 0.0043905940838158131, 0.0028842035681009293, 0.0040040812455117702, 0.003948533907532692, 0.00351692084223032, 0.00591649254783988, 0.0031935509759932756, } };
 const TfLiteAffineQuantization quant9 = { (TfLiteFloatArray*)&quant9_scale, (TfLiteIntArray*)&g0::quant8_zero, 0 };
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 0
 const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int32_t tensor_data10[96] = { -10603, 1222, -5567, -7033, -3706, 3725, 793, -1854, 131, -7348, 10536, -4059, -2073, 20486, 17530, -2012, 28308, -3900, -8412, -808, -6566, -4752, -2194, -200, 729, -1801, -7600, -9070, 871, -6337, 2303, 4325, 16135, 1343, 1241, -305, -2483, -4092, -758, 8986, 3275, 130, -3055, -2210, 21522, 14749, 2117, 12188, -1194, 16123, 17007, -4780, -1119, 3018, 3779, 12275, -3740, -3596, 25280, 7601, 10764, 13026, 15390, -8507, 766, -524, -2510, 583, -8833, -4289, 5267, -2263, 13231, 188, -1301, 12144, -1485, 1071, 13795, 3775, -6321, 11035, -8374, 4062, 14925, -2186, 57, -2688, -8611, -4264, 15623, -1111, 4745, -707, -4628, -1980, };
+#endif // EI_CLASSIFIER_WEIGHTS_BLOB
 const TfArray<96, float> quant10_scale = { 96, { 0.00016540342767257243, 0.00016291490464936942, 0.00011482548870844766, 0.00011033639748347923, 0.00016876107838470489, 0.0001442971988581121, 0.00030772516038268805, 0.00018677898333407938, 0.00013957393821328878, 0.00014131456555332989, 0.00010115095938090235, 0.00016576058987993747, 0.0001854488073149696, 7.9402328992728144e-05, 8.0860598245635629e-05, 0.00014979297702666372, 6.1010854551568627e-05, 0.00020760702318511903, 0.00010644012218108401, 5.0798829761333764e-05, 0.00020839778881054372, 0.00030244546360336244, 0.00022144384274724871, 0.0001538447686471045, 0.00046060048043727875, 0.00021732880850322545, 0.00018982680921908468, 9.6674739324953407e-05, 0.00013219477841630578, 0.00010933015437331051, 0.00035173169453628361, 0.00014334423758555204, 0.0001216474556713365, 0.00017929465684574097, 0.00014850871230009943, 0.00021050649229437113, 0.00012562602933030576, 0.00015756345237605274, 0.00021761927928309888, 0.00012723810505121946, 0.00013133733591530472, 0.00018076958076562732, 0.00013188974116928875, 0.00023107365996111184, 6.5710977651178837e-05, 0.00010210774053120986, 0.00018977053696289659, 0.00012285712000448257, 0.00013678737741429359, 8.6800806457176805e-05, 0.00010238619142910466, 8.7773696577642113e-05, 0.00020394059538375586, 0.0001320041628787294, 0.00018487477791495621, 0.0001248569751624018, 0.00011472855840111151, 0.00011910193279618397, 7.6825912401545793e-05, 9.6778545412234962e-05, 0.00012545376375783235, 0.00011906638974323869, 0.00010473040310898796, 0.00011632250971160829, 0.00017110211774706841, 0.00033827434526756406, 0.00019972329027950764, 0.00023769686231389642, 0.00016143848188221455, 0.00013556757767219096, 0.00017566283349879086, 0.00013246458547655493, 9.8712618637364358e-05, 0.00015998017624951899, 0.00030046410392969847, 8.1361358752474189e-05, 0.00018363921844866127, 0.00018487183842808008, 0.00013824447523802519, 0.00018690717115532607, 0.00021524517796933651, 0.00012686391710303724, 0.0001519732759334147, 0.00015313760377466679, 9.4160139269661158e-05, 0.00014314900909084827, 0.00026470771990716457, 0.00026257481658831239, 0.00030194284045137465, 0.00018872007785830647, 7.6200354669708759e-05, 0.00025492621352896094, 0.000153969886014238, 0.00019004983187187463, 9.9445256637409329e-05, 0.00024045964528340846, } };
 const TfLiteAffineQuantization quant10 = { (TfLiteFloatArray*)&quant10_scale, (TfLiteIntArray*)&g0::quant6_zero, 0 };
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 0
 const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int8_t tensor_data11[1*3*3*96] = { 
   /* [0][0][][] */ 35,98,38,16,-44,-2,30,16,111,-57,-94,69,-53,-12,-64,12,-63,19,45,18,5,49,77,127,29,-23,-48,43,-36,36,11,-35,-52,-1,-71,126,4,94,-24,-13,51,-59,53,53,-95,-36,9,4,-45,-61,-74,12,22,18,-38,-5,-109,-87,-99,-127,-122,20,-127,20,-23,24,113,-5,-1,33,15,9,-36,47,55,27,9,-37,-118,25,32,-50,87,-13,-61,-50,-34,12,-71,-17,-38,59,72,-28,116,-11, -4,-44,30,51,10,127,-14,14,39,49,-127,64,-48,-88,-89,68,-99,33,101,127,127,22,100,113,23,58,38,3,39,127,-5,-81,95,87,-24,11,89,127,-57,-107,127,-13,105,127,-127,-76,127,-30,-27,5,-26,-2,16,127,2,-96,31,67,-89,-52,-100,-42,-94,72,-23,84,94,-24,79,127,113,-7,-35,78,-36,-41,-9,-71,14,127,-33,-70,127,-102,-127,-29,13,17,127,35,-63,-1,127,-20,127,23, 53,-60,21,31,-41,-3,-33,35,114,127,-84,68,-35,31,-27,-125,-127,-4,53,8,7,49,46,111,16,-20,41,56,26,47,0,-46,-49,-116,-117,35,34,67,-15,8,4,80,-5,58,-46,-35,-12,4,43,-64,-2,-16,11,10,-52,-35,76,-127,-37,-86,-127,43,-71,-1,8,21,-59,24,2,2,8,24,-25,-74,4,9,9,7,-118,5,48,-14,49,-29,-28,-45,-52,-6,-42,-18,-4,63,-10,55,97,-32, 
   /* [0][1][][] */ 119,-27,63,127,18,-87,127,23,-69,-123,-30,127,-7,-127,-115,44,-35,15,121,64,-92,8,-127,-48,-25,30,-84,127,-105,45,61,26,-45,35,36,127,-109,68,-1,-50,50,-127,101,49,-90,-127,-10,-98,-113,-100,-111,42,59,-122,16,27,-126,33,-73,-7,-70,-127,-54,53,-127,-51,127,-46,-82,46,-64,-86,-127,50,127,-111,93,35,-70,-70,127,-74,2,127,-22,-8,26,85,20,3,-127,39,-1,-77,113,10, -122,-9,14,51,-66,-124,-114,-127,54,20,-110,62,-40,-49,-91,127,-120,-127,127,117,85,-127,-81,4,-127,127,50,70,-70,34,-127,28,-127,95,127,-34,-27,123,127,-56,-83,21,42,65,-19,-79,-59,-127,24,-65,-127,127,53,38,82,-51,1,65,24,16,-69,-46,-83,127,31,-127,51,127,74,43,-127,-58,-30,80,-118,-123,127,127,127,-62,-94,28,-59,108,-52,-74,127,127,120,127,-95,-127,-120,-38,9,127, 127,14,127,119,1,-45,-19,19,-104,124,-18,105,-3,-78,-127,-21,-74,7,51,87,-77,36,-91,-61,7,0,127,82,127,60,28,-127,-50,-127,-39,61,-127,29,-40,-63,-2,99,61,34,-63,-70,-20,-35,127,-123,-87,-54,53,-109,-127,41,127,17,-127,35,-77,-105,-19,45,122,-45,-73,-7,-85,45,-61,-31,-79,-127,-9,-127,50,-10,-93,-52,-18,-88,4,119,-63,21,9,45,-3,18,-25,43,-45,127,93,-31, 
   /* [0][2][][] */ 58,-127,50,19,50,-2,45,57,-60,-22,62,-11,60,-84,-13,35,-92,54,4,97,35,50,30,-79,26,-12,-15,61,-90,-7,-5,-18,-73,-3,-23,33,62,30,39,-50,-44,-11,-26,11,-54,-15,-39,-17,-45,-43,-12,30,9,-19,-47,-19,-56,40,9,17,-16,-18,-3,9,-71,51,20,-24,56,25,11,118,-23,-19,23,7,29,-57,-57,-36,32,-10,-15,-75,-31,76,-56,-19,-47,7,7,24,-46,-30,38,-78, -38,-36,57,61,127,84,-30,61,-127,27,-77,-12,127,-110,-56,-15,-101,86,-64,-15,61,19,74,-25,49,-93,15,68,-16,62,-9,-36,-38,16,47,-24,92,34,24,-127,-72,-25,-127,3,-2,-2,-25,-26,-16,-71,-3,97,127,-42,-69,-127,-10,122,-45,32,115,-66,57,36,-25,51,-46,5,127,57,22,99,1,14,-20,-70,21,-55,28,-42,37,-127,-25,-118,-56,127,13,1,98,38,25,2,-26,-20,65,-17, 69,71,59,29,40,-9,-22,51,-50,35,53,-14,37,-107,-31,17,-60,49,12,115,16,57,28,-95,53,-23,54,34,2,13,-8,-84,-54,-10,-50,-47,88,12,31,-35,-35,12,1,-2,-45,17,-58,-10,53,-127,-74,31,-45,-6,-22,-19,109,34,17,33,17,-2,-31,4,81,37,-127,-5,47,43,-21,127,-16,-63,-11,14,25,-47,-92,-26,65,35,-5,-69,-6,49,-46,-15,-47,15,44,59,-71,10,0,-56, 
 };
+#endif // EI_CLASSIFIER_WEIGHTS_BLOB
 const TfArray<4, int> tensor_dimension11 = { 4, { 1,3,3,96 } };
 const TfArray<96, float> quant11_scale = { 96, { 0.0082456031814217567, 0.0081215463578701019, 0.0057242186740040779, 0.0055004311725497246, 0.0084129869937896729, 0.007193426601588726, 0.015340549871325493, 0.0093112057074904442, 0.006957965437322855, 0.0070447381585836411, 0.0050425236113369465, 0.0082634082064032555, 0.0092448946088552475, 0.0039583225734531879, 0.0040310192853212357, 0.0074673993512988091, 0.0030414804350584745, 0.010349513962864876, 0.0053061959333717823, 0.0025323959998786449, 0.0103889349848032, 0.015077349729835987, 0.011039299890398979, 0.0076693873852491379, 0.022961609065532684, 0.010834159329533577, 0.0094631444662809372, 0.0048193773254752159, 0.0065901032648980618, 0.0054502682760357857, 0.017534339800477028, 0.0071459198370575905, 0.0060643036849796772, 0.0089381011202931404, 0.0074033765122294426, 0.010494057089090347, 0.0062626414000988007, 0.0078547690063714981, 0.010848639532923698, 0.0063430056907236576, 0.0065473588183522224, 0.0090116281062364578, 0.0065748970955610275, 0.011519360356032848, 0.0032757886219769716, 0.0050902203656733036, 0.0094603393226861954, 0.0061246072873473167, 0.0068190507590770721, 0.0043271472677588463, 0.0051041017286479473, 0.0043756472878158092, 0.010166737250983715, 0.0065806005150079727, 0.0092162787914276123, 0.0062243030406534672, 0.0057193865068256855, 0.0059374058619141579, 0.003829884110018611, 0.0048245522193610668, 0.0062540536746382713, 0.0059356340207159519, 0.0052209640853106976, 0.0057988474145531654, 0.0085296910256147385, 0.016863470897078514, 0.0099564986303448677, 0.011849536560475826, 0.0080479448661208153, 0.006758242379873991, 0.0087570492178201675, 0.0066035534255206585, 0.0049209687858819962, 0.007975245825946331, 0.014978575520217419, 0.0040559829212725163, 0.0091546839103102684, 0.0092161316424608231, 0.0068916897289454937, 0.0093175964429974556, 0.010730287060141563, 0.0063243517652153969, 0.0075760907493531704, 0.0076341335661709309, 0.0046940208412706852, 0.0071361875161528587, 0.013196066953241825, 0.013089739717543125, 0.015052292495965958, 0.0094079719856381416, 0.003798699239268899, 0.012708445079624653, 0.0076756239868700504, 0.0094742625951766968, 0.0049574915319681168, 0.011987265199422836, } };
 const TfLiteAffineQuantization quant11 = { (TfLiteFloatArray*)&quant11_scale, (TfLiteIntArray*)&g0::quant6_zero, 3 };
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 0
 const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int32_t tensor_data12[96] = { 4593, 2211, 379, -1077, 4600, 5364, 10269, 1633, -283, 6914, 1664, -4130, 3330, 4078, 231, -804, 4099, 9637, -261, 860, 8266, 10567, 11923, -1163, -3777, -798, 6955, 604, 3340, 291, 8816, -1590, 7582, 2850, 6003, -3398, 1532, -3689, 1352, 2326, 1907, 2187, 1357, -2332, 1554, 2081, 4630, 5135, 3091, 3303, 6471, 2648, -3588, 1738, 1448, 2831, 1267, 2324, 11820, 515, -1209, 7648, 4753, 2702, 6756, 9497, -4218, 3718, 6526, -1046, 3831, 957, 4225, 2978, 3948, 2372, -1448, 2770, 5136, 9517, 4067, 1600, 7531, 734, 3668, 3604, 974, -1816, 14550, -599, 963, -1896, 8176, 3137, -743, -536, };
+#endif // EI_CLASSIFIER_WEIGHTS_BLOB
 const TfArray<96, float> quant12_scale = { 96, { 0.00014953153731767088, 0.00012436789984349161, 0.00017204741016030312, 0.00018730241572484374, 0.00015035188698675483, 0.0001222422142745927, 8.3301805716473609e-05, 0.00015957470168359578, 0.00011462756810942665, 0.00011218172585358843, 0.00015588989481329918, 0.00011070512846345082, 0.00012512372632045299, 0.00012664799578487873, 0.0002637362340465188, 0.00015596493904013187, 0.00014788453700020909, 8.802521915640682e-05, 0.00012477851123549044, 0.0001405339571647346, 8.8656415755394846e-05, 7.8384451626334339e-05, 7.4072253482881933e-05, 0.00013176379434298724, 0.0001234490773640573, 0.00019046389206778258, 0.00012139088357798755, 0.00015418676775880158, 0.0001104496986954473, 0.00015450007049366832, 9.5715200586710125e-05, 0.00013442135241348296, 0.00010471120913280174, 0.00015956637798808515, 0.00014000419469084591, 0.00014418869977816939, 0.00015343731502071023, 0.00015141612675506622, 0.00015776568034198135, 0.00013639417011290789, 0.00021317723440006375, 0.00013011942792218179, 0.00021667621331289411, 0.00014223491598386317, 0.00016188935842365026, 0.00016850163228809834, 0.00012906947813462466, 0.00012508025974966586, 0.00016296737885568291, 0.00017336757446173579, 0.0001216498130816035, 0.00013622391270473599, 0.00013183942064642906, 0.00020248843065928668, 0.00019282440189272165, 0.00015687383711338043, 0.00018161418847739697, 0.00012470775982365012, 6.8848661612719297e-05, 0.00015160991461016238, 0.00019586604321375489, 9.6573785413056612e-05, 0.00014057320368010551, 0.00018704784451983869, 9.3499358627013862e-05, 7.3199880716856569e-05, 0.00013383032637648284, 0.00013218134699855, 0.00011063057172577828, 0.00015779134992044419, 0.00016383473121095449, 0.00017699890304356813, 0.00012496426643338054, 0.0001252376678166911, 0.00014849216677248478, 0.0001182748019346036, 0.00016630531172268093, 0.00012483869795687497, 9.1615889687091112e-05, 7.4412550020497292e-05, 0.00015571193944197148, 0.00021949103393126279, 0.00010605584247969091, 0.00014959400868974626, 0.00011089868348790333, 0.00015272310702130198, 0.00012805921141989529, 0.00019759188580792397, 6.4748797740321606e-05, 0.00018500455189496279, 0.00017379577911924571, 0.00016332443919964135, 0.00010113961616298184, 0.00010151269088964909, 0.00017540683620609343, 0.00016753081581555307, } };
 const TfLiteAffineQuantization quant12 = { (TfLiteFloatArray*)&quant12_scale, (TfLiteIntArray*)&g0::quant6_zero, 0 };
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 0
 const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int8_t tensor_data13[96*1*1*16] = { 
   /* [0][0][][] */ -30,-10,20,-36,-3,-54,-53,-28,46,-43,16,-48,53,-127,-20,-53, 
   /* [1][0][][] */ -127,36,-89,-107,-118,32,4,47,-38,92,50,-70,65,86,53,87, 
@@ -468,11 +557,15 @@ const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int8_t tensor_data13[96*1*1*16]
   /* [94][0][][] */ -26,-122,57,-127,-5,14,-33,-19,107,-43,-21,41,-4,15,-50,37, 
   /* [95][0][][] */ -29,-40,-29,-24,127,52,-4,52,83,47,-55,48,-11,72,-61,58, 
 };
+#endif // EI_CLASSIFIER_WEIGHTS_BLOB
 const TfArray<96, float> quant13_scale = { 96, { 0.0024543190374970436, 0.0020412986632436514, 0.0028238808736205101, 0.0030742671806365252, 0.0024677838664501905, 0.0020064087584614754, 0.0013672647764906287, 0.0026191615033894777, 0.0018814266659319401, 0.0018412821227684617, 0.0025586811825633049, 0.0018170461989939213, 0.0020537041127681732, 0.0020787226967513561, 0.0043288050219416618, 0.0025599130894988775, 0.0024272862356156111, 0.0014447920257225633, 0.0020480381790548563, 0.0023066382855176926, 0.0014551520580425858, 0.0012865543831139803, 0.0012157766614109278, 0.0021626902744174004, 0.0020262175239622593, 0.0031261576805263758, 0.001992435660213232, 0.0025307273026555777, 0.0018128537340089679, 0.002535869600251317, 0.0015710106818005443, 0.0022063096985220909, 0.0017186657059937716, 0.0026190248318016529, 0.0022979432251304388, 0.0023666250053793192, 0.0025184261612594128, 0.0024852515198290348, 0.0025894693098962307, 0.0022386903874576092, 0.0034989605192095041, 0.0021357005462050438, 0.0035563907586038113, 0.0023345567751675844, 0.0026571527123451233, 0.0027656825259327888, 0.002118467353284359, 0.0020529907196760178, 0.0026748466771095991, 0.0028455492574721575, 0.0019966855179518461, 0.0022358959540724754, 0.0021639314945787191, 0.0033235209994018078, 0.0031649016309529543, 0.0025748310144990683, 0.0029809039551764727, 0.0020468768198043108, 0.0011300398036837578, 0.0024884322192519903, 0.003214825177565217, 0.0015851029893383384, 0.0023072825279086828, 0.0030700888019055128, 0.0015346412546932697, 0.0012014580424875021, 0.0021966090425848961, 0.002169543644413352, 0.0018158224411308765, 0.0025898905005306005, 0.0026890828739851713, 0.0029051515739411116, 0.0020510868635028601, 0.0020555744413286448, 0.0024372595362365246, 0.0019412902183830738, 0.0027296335902065039, 0.002049025846645236, 0.0015037271659821272, 0.0012213620357215405, 0.0025557603221386671, 0.0036025913432240486, 0.0017407356062904, 0.0024553444236516953, 0.0018202230567112565, 0.0025067036040127277, 0.002101885387673974, 0.0032431522849947214, 0.0010627470910549164, 0.0030365514103323221, 0.0028525774832814932, 0.0026807072572410107, 0.0016600437229499221, 0.0016661671688780189, 0.0028790202923119068, 0.002749748295173049, } };
 const TfLiteAffineQuantization quant13 = { (TfLiteFloatArray*)&quant13_scale, (TfLiteIntArray*)&g0::quant6_zero, 0 };
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 0
 const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int32_t tensor_data14[16] = { -22689, -6255, 15846, -5393, 10064, -13384, 4309, -8542, 14806, -8371, 4984, 8801, -2164, -40742, -8796, 4143, };
+#endif // EI_CLASSIFIER_WEIGHTS_BLOB
 const TfArray<16, float> quant14_scale = { 16, { 7.9612393165007234e-05, 7.1143280365504324e-05, 7.5359908805694431e-05, 8.2658101746346802e-05, 9.6662290161475539e-05, 0.00014087923045735806, 7.9326346167363226e-05, 7.2663395258132368e-05, 0.00011041430843761191, 0.00010301168367732316, 0.00011393108434276655, 9.6970943559426814e-05, 9.8132790299132466e-05, 9.0060952061321586e-05, 6.5963577071670443e-05, 8.8444438006263226e-05, } };
 const TfLiteAffineQuantization quant14 = { (TfLiteFloatArray*)&quant14_scale, (TfLiteIntArray*)&g0::quant8_zero, 0 };
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 0
 const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int8_t tensor_data15[16*1*1*96] = { 
   /* [0][0][][] */ -7,27,29,1,-19,-101,-39,-1,-23,-70,8,-10,66,-74,51,43,-73,-30,10,22,86,7,-95,-18,18,67,123,70,12,89,72,-10,18,-1,45,-26,35,51,-40,14,127,3,19,-24,-28,2,7,-50,23,-27,98,12,-64,14,38,-3,2,-34,-3,32,-5,61,-33,11,33,18,29,6,7,-32,31,39,19,17,-13,8,74,-40,22,46,1,42,51,28,-88,-6,18,72,36,7,-92,6,18,-16,90,103, 
   /* [1][0][][] */ 39,33,-36,-21,10,-42,115,-12,-63,-40,-73,-20,15,-32,9,-34,-37,-26,-68,25,-1,-116,97,-59,35,-2,1,85,-22,45,-38,56,-61,52,25,33,-77,61,-81,67,17,-19,-25,-78,72,-57,15,26,-111,3,47,-120,-31,48,103,24,20,20,-81,23,-69,21,14,12,56,34,102,-4,-53,-127,-3,62,51,34,-14,12,-72,-5,87,-10,5,-23,54,-75,-34,-52,1,9,1,-32,44,14,76,-47,-40,73, 
@@ -491,21 +584,29 @@ const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int8_t tensor_data15[16*1*1*96]
   /* [14][0][][] */ -32,88,55,42,-75,-64,27,47,-53,-19,73,3,-68,7,65,-26,-41,65,-63,46,-24,12,-94,-10,-26,-8,-49,-120,21,-1,25,106,-33,39,26,-27,-11,-88,-17,-44,61,-36,55,-20,-25,57,-62,54,-40,-33,84,36,-19,37,16,42,-58,38,-6,75,41,89,2,62,50,-12,0,-83,26,62,94,40,-36,13,11,7,53,7,43,41,-64,119,-1,-121,99,-23,14,8,-127,3,-25,23,-19,-8,27,73, 
   /* [15][0][][] */ 90,-20,28,-2,21,-6,-12,-10,19,33,-38,-33,64,55,10,1,-3,21,-75,45,-19,-10,2,39,72,-34,68,20,30,-20,-35,37,63,26,-18,-30,37,48,48,63,49,10,11,26,-34,-102,59,7,-40,-53,-7,7,-12,-32,-28,27,-30,13,-10,28,-5,-50,-22,45,41,35,-51,40,-20,-73,28,10,-22,-127,-45,-75,-22,45,-117,47,52,-64,17,17,-29,-10,2,-27,26,66,25,-57,-27,-2,18,-21, 
 };
+#endif // EI_CLASSIFIER_WEIGHTS_BLOB
 const TfArray<16, float> quant15_scale = { 16, { 0.0033835265785455704, 0.0030235894955694675, 0.0032027959823608398, 0.0035129692405462265, 0.0041081472299993038, 0.0059873671270906925, 0.0033713697921484709, 0.003088194178417325, 0.0046926080249249935, 0.0043779965490102768, 0.0048420708626508713, 0.0041212649084627628, 0.0041706436313688755, 0.0038275904953479767, 0.0028034518472850323, 0.0037588886916637421, } };
 const TfLiteAffineQuantization quant15 = { (TfLiteFloatArray*)&quant15_scale, (TfLiteIntArray*)&g0::quant8_zero, 0 };
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 0
 const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int32_t tensor_data16[96] = { 4994, 436, -9888, 2914, -3152, -55, -2317, -2857, 5958, -8675, 1157, -3413, 11613, -3848, -387, -5315, 106, 97, -5723, -5061, -57, 1035, -2552, 409, 78, 5108, -12187, -6804, -3866, -6893, -350, 1492, 11124, 464, -7818, -1901, 870, 13011, 3983, 9525, 3239, 7159, -348, 3172, -4948, -426, 10854, -377, -13704, -245, -7589, 4764, 895, -9300, 1064, 5146, -7606, 8001, -67, 4337, -2498, 262, 262, 5403, 12826, -329, 13871, 14788, -2115, -449, 10839, -1524, -382, -1159, -3156, -2519, 18062, 935, 10525, 10896, 13242, -1607, 6376, 10921, -945, -1513, 10726, -6531, 14368, 1002, -10844, -285, -820, 3628, 16756, -1162, };
+#endif // EI_CLASSIFIER_WEIGHTS_BLOB
 const TfArray<96, float> quant16_scale = { 96, { 0.00015575464931316674, 0.00024151554680429399, 0.000105564649857115, 0.00024441824643872678, 0.00033218934549950063, 0.00041254234383814037, 0.00014365778770297766, 0.00017213939281646162, 0.00020727736409753561, 0.00014590402133762836, 0.00029964992427267134, 0.00020272708206903189, 7.4110314017161727e-05, 0.0001408904354320839, 0.00016614554624538869, 0.00019957385666202754, 0.00025631129392422736, 0.00033498267293907702, 0.00016301152936648577, 0.00035411835415288806, 0.00035895907785743475, 0.00024871798814274371, 0.00022309247287921607, 0.00018264113168697804, 0.0013792546233162284, 0.00019770141807384789, 0.00018022953008767217, 0.00013094101450406015, 0.00034543205401860178, 0.00010480380296939984, 0.00018480503058526665, 0.00045273685827851295, 0.00011192996316822246, 0.00095853710081428289, 0.00011163089948240668, 0.00020281129400245845, 0.00038468142156489193, 0.00010144695261260495, 0.00029633994563482702, 0.00013212210615165532, 0.0003741067775990814, 0.00017216945707332343, 0.00027664098888635635, 0.00026562082348391414, 0.00013291373034007847, 0.00032443692907691002, 8.0861740570981055e-05, 0.00028066668892279267, 8.710147812962532e-05, 0.00041833778959698975, 0.00016183458501473069, 0.00014653676771558821, 0.00014754597214050591, 0.00011451110913185403, 0.00034931677510030568, 0.00018218184413854033, 0.00011248218652326614, 0.00024242883955594152, 0.00045285790110938251, 0.00026638756389729679, 0.000250585115281865, 0.00027839950053021312, 0.00016488728579133749, 0.00010276778630213812, 0.00023970197071321309, 0.00049565266817808151, 0.0001173991768155247, 9.3667003966402262e-05, 0.00025105776148848236, 0.00030905051971785724, 0.00015034175885375589, 0.00025314060621894896, 0.00057557079708203673, 0.00017918065714184195, 0.00013502185174729675, 0.00017987245519179851, 8.3030856330879033e-05, 0.00020257373398635536, 0.00011587367043830454, 0.00018474116222932935, 9.9956858321093023e-05, 0.00024412923085037619, 0.00013524394307751209, 0.00030492176301777363, 0.00010686906171031296, 0.00030026413151063025, 0.00012054462422383949, 0.00019380332378204912, 0.00010870112600969151, 0.00017545785522088408, 8.020647510420531e-05, 0.00023431623412761837, 0.00028199006919749081, 0.00016827808576636016, 8.2446211308706552e-05, 0.0002445136196911335, } };
 const TfLiteAffineQuantization quant16 = { (TfLiteFloatArray*)&quant16_scale, (TfLiteIntArray*)&g0::quant6_zero, 0 };
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 0
 const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int8_t tensor_data17[1*3*3*96] = { 
   /* [0][0][][] */ 38,6,101,-16,77,18,69,12,-4,23,-15,15,-43,-21,-34,-4,-15,19,-104,-12,-19,21,-25,53,-7,4,24,29,39,17,41,-1,18,-9,38,-30,-6,-58,-34,-12,8,11,30,12,-16,46,-73,-49,85,3,27,42,-105,40,9,-35,14,-23,20,-46,2,-26,-24,-70,-33,-43,-31,-12,-20,13,-33,17,42,8,-39,-7,-22,76,127,-61,-53,8,-97,-48,-11,-40,17,-13,-51,-5,55,-37,1,9,-6,-18, 66,45,127,15,-24,16,127,-68,1,3,-42,2,-29,44,-127,127,-12,72,-10,-29,-16,127,52,117,15,-2,68,107,127,78,127,-44,-52,-10,-60,-7,-37,-100,127,10,-50,-125,-30,-35,58,-37,-19,39,127,-23,46,127,-124,23,-82,-6,-98,-11,-15,7,-2,-127,-127,-111,-39,6,1,-96,-21,0,-60,108,-127,-22,-29,-22,-80,-57,-5,-127,-127,15,21,-77,127,68,-56,32,-127,0,60,-27,15,127,-43,-95, 48,29,5,29,73,27,74,7,-14,30,-19,59,8,15,-3,-32,-21,0,-84,-23,-16,27,12,41,0,4,-56,-34,10,49,26,4,4,-7,33,72,-1,-127,-41,-9,-2,-30,15,12,5,-23,-66,-20,80,-14,30,10,4,86,12,-40,110,-45,7,-50,8,-22,-40,-71,-55,-41,127,3,-22,8,-26,16,38,-8,-25,-2,-12,61,-37,-42,-41,2,-127,-22,19,-39,-1,2,-89,-58,24,65,-29,-18,2,-15, 
   /* [0][1][][] */ -99,-5,127,-58,44,69,10,-18,-14,22,-24,-35,-125,6,12,68,-12,42,76,45,24,-16,50,-26,39,42,119,47,-5,-2,-22,-23,-127,-20,99,-6,3,-73,-52,-127,-3,-18,82,-19,-29,127,-70,-112,87,111,54,-63,-127,123,66,-52,82,-39,54,-18,2,-6,55,-127,-81,6,-19,-69,16,-4,-88,-1,45,122,-1,-70,-127,-10,-50,-65,-121,0,-25,-75,65,27,-120,60,-63,127,68,-65,127,-27,-46,-7, 43,127,94,127,-127,-127,87,-74,127,127,-80,-95,-83,127,-47,30,127,-127,127,127,127,-73,127,-127,-127,-127,127,127,-120,127,-30,127,-28,127,118,-63,127,16,5,50,127,8,-127,-127,127,-24,113,127,126,-127,127,-126,108,107,-127,127,-89,127,-127,127,-81,95,57,-77,127,127,-23,127,-79,-127,-11,-127,-11,127,127,118,8,-127,106,-18,-1,127,119,127,44,85,-127,127,-71,56,-29,-31,-57,-9,-127,-27, -127,-32,59,-24,24,51,5,8,-39,20,-9,127,-127,10,24,26,-23,55,78,27,13,-21,61,-22,43,49,20,-7,4,11,-3,-21,-122,-33,127,127,2,-107,-63,-96,-33,-17,37,-31,-17,-59,-120,-107,75,115,22,-49,96,127,99,-86,127,-35,58,-43,7,-32,-80,15,-108,-6,-51,-65,0,8,-127,-15,35,-82,47,127,-46,11,-43,14,-109,-10,-37,-91,20,34,-107,69,-42,-89,127,127,-45,-47,-89,-3, 
   /* [0][2][][] */ -20,-68,17,-57,50,4,1,57,-39,27,45,-39,11,3,6,-24,2,-10,-2,-3,-23,-20,-4,-39,26,-7,-13,19,31,10,-35,-11,15,-11,26,-47,-13,-39,-49,-74,-38,-37,23,10,55,27,-81,18,-39,-2,-18,-41,8,-39,27,-38,107,-40,1,-29,4,46,3,120,-52,-24,99,-59,19,27,-50,-26,12,-2,19,-15,-103,40,-16,-12,-78,6,-64,-20,10,5,12,-23,-16,15,22,-46,2,-35,-1,18, 1,-84,50,-43,-45,-7,34,127,-94,70,127,-1,-54,39,121,111,-4,-52,123,-24,-46,-50,61,7,20,-43,51,-9,5,44,-60,-61,-1,-25,-120,-8,-104,-65,28,-33,-59,-127,-23,112,82,-32,-113,29,68,-6,-9,-45,67,2,-79,-65,-34,-69,44,-62,127,40,73,45,-62,-41,-18,-107,127,66,-28,35,32,1,18,13,-36,-50,24,55,-49,-11,-76,-64,19,-127,-14,-7,-30,-2,44,-20,13,-96,-80,127, -38,-12,27,-17,50,-4,6,43,-44,2,7,67,-27,-3,5,-31,-6,6,32,-4,-29,-28,-3,-39,17,-11,-18,-12,8,36,-28,-13,-8,-10,38,-12,-14,-9,-40,-63,-71,-20,4,4,27,-19,-127,36,-21,8,-7,-32,22,-60,30,-43,126,-27,3,-21,25,33,42,116,-27,-12,-15,-47,18,32,16,-11,10,-38,19,-13,-33,50,88,-32,13,10,-71,4,-3,15,29,-8,-29,-21,25,36,-26,-41,-11,15, 
 };
+#endif // EI_CLASSIFIER_WEIGHTS_BLOB
 const TfArray<96, float> quant17_scale = { 96, { 0.0066195721738040447, 0.010264410637319088, 0.0044864974915981293, 0.010387775488197803, 0.014118046499788761, 0.017533048987388611, 0.0061054560355842113, 0.0073159239254891872, 0.0088092880323529243, 0.0062009207904338837, 0.012735121883451939, 0.0086159007623791695, 0.0031496882438659668, 0.0059878434985876083, 0.0070611857809126377, 0.0084818890318274498, 0.010893230326473713, 0.014236763119697571, 0.0069279898889362812, 0.015050029382109642, 0.01525576040148735, 0.010570514015853405, 0.0094814300537109375, 0.007762247696518898, 0.058618318289518356, 0.008402310311794281, 0.0076597551815211773, 0.0055649927817285061, 0.014680861495435238, 0.0044541615061461926, 0.0078542139381170273, 0.019241316244006157, 0.0047570234164595604, 0.040737826377153397, 0.0047443131916224957, 0.0086194798350334167, 0.016348959878087044, 0.0043114954605698586, 0.01259444747120142, 0.0056151892058551311, 0.0158995371311903, 0.0073172017000615597, 0.011757241562008858, 0.011288885027170181, 0.0056488336995244026, 0.013788569718599319, 0.003436623839661479, 0.011928333900868893, 0.0037018128205090761, 0.017779355868697166, 0.0068779694847762585, 0.0062278127297759056, 0.0062707038596272469, 0.0048667220398783684, 0.014845962636172771, 0.0077427281066775322, 0.0047804927453398705, 0.010303225368261337, 0.019246460869908333, 0.011321471072733402, 0.010649867355823517, 0.011831978335976601, 0.0070077092386782169, 0.0043676309287548065, 0.010187333449721336, 0.021065237000584602, 0.0049894647672772408, 0.0039808475412428379, 0.010669955052435398, 0.013134646229445934, 0.0063895247876644135, 0.01075847540050745, 0.024461759254336357, 0.0076151778921484947, 0.0057384283281862736, 0.0076445792801678181, 0.0035288112703710794, 0.0086093833670020103, 0.0049246307462453842, 0.0078514991328120232, 0.0042481664568185806, 0.0103754922747612, 0.0057478677481412888, 0.012959174811840057, 0.0045419349335134029, 0.012761224992573261, 0.0051231463439762592, 0.008236641064286232, 0.0046197976917028427, 0.0074569587595760822, 0.0034087751992046833, 0.0099584395065903664, 0.011984577402472496, 0.0071518183685839176, 0.0035039638169109821, 0.01039182860404253, } };
 const TfLiteAffineQuantization quant17 = { (TfLiteFloatArray*)&quant17_scale, (TfLiteIntArray*)&g0::quant6_zero, 3 };
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 0
 const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int32_t tensor_data18[96] = { 1903, 6201, -311, 2002, 16648, 8643, -529, 2692, 9521, -165, 10481, 5222, 671, 1233, 3741, -568, 2940, 6768, -3246, 10616, 3065, 5611, -2964, 1683, -7931, 3081, 2726, 2675, 7883, 947, 3082, 11805, 1779, 29045, 3719, 2676, 3592, 1979, 5950, 2276, 20398, 1361, 1842, 4409, 1684, 11967, 4277, 10036, 3451, -2286, 3131, 8021, 2232, -1568, 8088, 731, 1609, 20874, 2625, 2125, 2112, 11552, 2661, -649, 17569, 17066, 1744, 4912, 5711, 4435, 3075, 1376, -3504, 5948, 2188, 3318, 322, 9678, 4889, 9748, 2696, 501, 7072, 14706, 57, 11320, 9825, 1859, 197, 2758, 315, 14052, 4306, 2135, 5068, 8205, };
+#endif // EI_CLASSIFIER_WEIGHTS_BLOB
 const TfArray<96, float> quant18_scale = { 96, { 0.00019597624486777931, 0.00010219860268989578, 0.00037314085057005286, 0.00020938526722602546, 5.0228303734911606e-05, 8.9173998276237398e-05, 0.00022972817532718182, 0.00012416482786647975, 9.703147952677682e-05, 0.00018973770784214139, 9.1601817985065281e-05, 0.00010210700565949082, 0.00020334332657512277, 0.00019626047287601978, 0.00015907222405076027, 0.0001090458026737906, 0.00021833421487826854, 0.00012486752530094236, 7.5683441536966711e-05, 8.7881504441611469e-05, 0.000115324801299721, 0.00013940074131824076, 0.00013991921150591224, 0.00012386511662043631, 9.0058398200199008e-05, 8.6985361122060567e-05, 0.00020709184173028916, 0.00013812691031489521, 0.00011235386045882478, 0.00026733207050710917, 0.0001930493745021522, 6.0047110309824347e-05, 0.00023226415214594454, 3.4204269468318671e-05, 0.00012786420120391995, 0.00025342422304674983, 0.00015818171959836036, 0.00022825936321169138, 9.7103162261191756e-05, 0.00016721505380701274, 4.9299113015877083e-05, 0.00019484992662910372, 0.00016738666454330087, 7.4231218604836613e-05, 0.00024517899146303535, 7.1336973633151501e-05, 0.00011954865476582199, 8.6847423517610878e-05, 0.00011240193271078169, 0.00015717027417849749, 0.00017201509035658091, 9.217637125402689e-05, 0.0001921953953569755, 0.00015903208986856043, 8.7766689830459654e-05, 0.00015180562331806868, 0.0002293095167260617, 4.8397982027381659e-05, 0.00012098569277441129, 0.00015926812193356454, 0.00017376500181853771, 7.5420262874104083e-05, 0.00022350228391587734, 0.00013752632366959006, 5.3574367484543473e-05, 5.3566058340948075e-05, 0.00023125925508793443, 0.00010238899994874373, 0.00013811633107252419, 0.00011710786930052564, 0.00019856040307786316, 0.00011170557991135865, 0.00016276759561151266, 0.00013295015378389508, 0.00016357781714759767, 0.00018818366515915841, 0.00016185251297429204, 7.9074816312640905e-05, 0.00012255414912942797, 9.501961903879419e-05, 0.00013939748168922961, 0.0002158420393243432, 9.126532677328214e-05, 6.7622757342178375e-05, 0.00017774208390619606, 7.1781912993174046e-05, 7.1885100624058396e-05, 0.00021732442837674171, 0.00023863930255174637, 0.00019723409786820412, 0.00021130054665263742, 6.2767401686869562e-05, 0.00013549717550631613, 0.00018656562315300107, 0.00011199199798284099, 7.5736767030321062e-05, } };
 const TfLiteAffineQuantization quant18 = { (TfLiteFloatArray*)&quant18_scale, (TfLiteIntArray*)&g0::quant6_zero, 0 };
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 0
 const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int8_t tensor_data19[96*1*1*16] = { 
   /* [0][0][][] */ 62,-13,63,87,-127,-9,83,77,101,89,-15,66,8,-4,20,54, 
   /* [1][0][][] */ 7,-2,-104,-24,127,104,-26,34,36,36,-86,3,-122,55,-94,-78, 
@@ -604,11 +705,15 @@ const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int8_t tensor_data19[96*1*1*16]
   /* [94][0][][] */ 110,14,91,-39,27,-9,35,14,4,62,-5,45,36,-2,127,-6, 
   /* [95][0][][] */ -34,-95,-41,-3,121,33,35,66,-64,-18,-127,-99,58,14,-89,43, 
 };
+#endif // EI_CLASSIFIER_WEIGHTS_BLOB
 const TfArray<96, float> quant19_scale = { 96, { 0.0042998362332582474, 0.0022422985639423132, 0.0081869335845112801, 0.0045940382406115532, 0.0011020390084013343, 0.0019565308466553688, 0.0050403736531734467, 0.0027242507785558701, 0.002128928666934371, 0.0041629588231444359, 0.0020097987726330757, 0.002240288769826293, 0.0044614742510020733, 0.0043060723692178726, 0.0034901397302746773, 0.002392530208453536, 0.0047903833910822868, 0.0027396681252866983, 0.0016605400014668703, 0.0019281727727502584, 0.0025302951689809561, 0.0030585357453674078, 0.0030699113849550486, 0.0027176749426871538, 0.001975935185328126, 0.0019085108069702983, 0.0045437188819050789, 0.0030305869877338409, 0.0024651109706610441, 0.0058654258027672768, 0.0042356187477707863, 0.0013174695195630193, 0.0050960145890712738, 0.00075046217534691095, 0.0028054171707481146, 0.0055602793581783772, 0.0034706017468124628, 0.0050081470981240273, 0.0021305014379322529, 0.003668798366561532, 0.001081652007997036, 0.004275124054402113, 0.0036725637037307024, 0.0016286773607134819, 0.0053793736733496189, 0.0015651759458705783, 0.0026229689829051495, 0.0019054844742640853, 0.0024661656934767962, 0.0034484099596738815, 0.0037741139531135559, 0.0020224046893417835, 0.0042168819345533848, 0.0034892591647803783, 0.0019256536616012454, 0.0033307063858956099, 0.0050311880186200142, 0.0010618807282298803, 0.0026544984430074692, 0.0034944377839565277, 0.0038125081919133663, 0.0016547656850889325, 0.0049037737771868706, 0.0030174099374562502, 0.0011754536535590887, 0.0011752713471651077, 0.005073966458439827, 0.0022464760113507509, 0.003030354855582118, 0.0025694167707115412, 0.0043565342202782631, 0.0024508873466402292, 0.003571218578144908, 0.0029170059133321047, 0.0035889951977878809, 0.0041288621723651886, 0.0035511411260813475, 0.0017349488334730268, 0.0026889115106314421, 0.0020847872365266085, 0.0030584642663598061, 0.0047357035800814629, 0.0020024159457534552, 0.0014836837071925402, 0.0038997677620500326, 0.0015749380690976977, 0.001577202114276588, 0.0047682281583547592, 0.0052358889952301979, 0.0043274341151118279, 0.0046360604465007782, 0.0013771543744951487, 0.0029728889930993319, 0.0040933615528047085, 0.0024571714457124472, 0.001661709975451231, } };
 const TfLiteAffineQuantization quant19 = { (TfLiteFloatArray*)&quant19_scale, (TfLiteIntArray*)&g0::quant6_zero, 0 };
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 0
 const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int32_t tensor_data20[16] = { -4059, 6817, -14367, 5036, 7621, -14164, -44749, -13805, -2911, 1111, -19356, -15671, 10611, -6500, -6046, -2639, };
+#endif // EI_CLASSIFIER_WEIGHTS_BLOB
 const TfArray<16, float> quant20_scale = { 16, { 0.0001358809822704643, 0.00011700114555424079, 0.00012886026524938643, 0.0001102897003875114, 7.5605181336868554e-05, 0.00010503278463147581, 7.8091332397889346e-05, 0.00013314199168235064, 9.55777577473782e-05, 8.1264704931527376e-05, 0.00013298026169650257, 0.00010935881437035277, 0.00010095465404447168, 7.1934453444555402e-05, 0.00010287285113008693, 0.00013325376494321972, } };
 const TfLiteAffineQuantization quant20 = { (TfLiteFloatArray*)&quant20_scale, (TfLiteIntArray*)&g0::quant8_zero, 0 };
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 0
 const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int8_t tensor_data21[16*1*1*48] = { 
   /* [0][0][][] */ 35,48,25,-35,62,71,-48,54,-7,99,2,55,-35,30,-9,48,25,81,41,-73,-59,86,-17,49,71,45,51,49,-49,-50,1,80,-25,-11,-80,56,61,-127,-35,25,15,-32,76,3,-10,-60,-64,-25, 
   /* [1][0][][] */ -33,1,-57,-42,15,80,-51,6,-18,-38,-29,37,59,-36,-27,-22,-19,-25,4,13,-43,44,-95,-34,-46,-45,49,68,-22,-24,40,-36,9,-40,-22,42,23,-56,127,-14,-17,38,-47,-3,40,58,36,14, 
@@ -627,25 +732,33 @@ const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int8_t tensor_data21[16*1*1*48]
   /* [14][0][][] */ 73,26,-38,-12,-41,10,-82,-16,-7,41,48,31,10,-57,22,-40,44,-96,25,-5,86,-34,21,-6,1,104,-74,4,-51,-19,-76,7,116,18,81,-15,-51,26,-26,69,-6,-45,127,-16,-41,-28,-44,42, 
   /* [15][0][][] */ -51,12,38,6,73,-5,-2,45,41,66,-12,44,38,12,-33,-15,-3,39,-4,-41,31,-40,-45,-43,67,-61,-25,47,-22,15,19,2,-61,8,127,-18,-92,21,48,-14,-36,-32,31,-10,-34,-31,-12,-5, 
 };
+#endif // EI_CLASSIFIER_WEIGHTS_BLOB
 const TfArray<4, int> tensor_dimension21 = { 4, { 16,1,1,48 } };
 const TfArray<16, float> quant21_scale = { 16, { 0.005774941761046648, 0.0049725486896932125, 0.0054765609093010426, 0.0046873120591044426, 0.0032132202759385109, 0.004463893361389637, 0.0033188816159963608, 0.0056585348211228848, 0.0040620546787977219, 0.003453749930486083, 0.0056516607291996479, 0.0046477494761347771, 0.0042905728332698345, 0.0030572141986340284, 0.0043720961548388004, 0.005663285031914711, } };
 const TfLiteAffineQuantization quant21 = { (TfLiteFloatArray*)&quant21_scale, (TfLiteIntArray*)&g0::quant8_zero, 0 };
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 0
 const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int32_t tensor_data22[48] = { 15018, 886, 20184, -624, 13677, -1772, 42243, 516, 12869, 42966, 2844, 28764, 2656, 15860, 39794, 19887, 1252, 994, -63, 62090, -109, 18537, 359, 16747, 19456, 35299, 895, -1199, -550, 13693, 20977, -1071, 13, -612, -2594, 13114, 13376, 39924, -629, 20378, 25393, 2246, 446, 17419, -4015, 63, 46624, 30212, };
+#endif // EI_CLASSIFIER_WEIGHTS_BLOB
 const TfArray<1, int> tensor_dimension22 = { 1, { 48 } };
 const TfArray<48, float> quant22_scale = { 48, { 0.00010324639151804149, 8.0549332778900862e-05, 6.0486374422907829e-05, 0.0001030943967634812, 0.00011185997573193163, 7.0369598688557744e-05, 4.1277158743469045e-05, 0.00030487417825497687, 0.00010455550363985822, 4.5290234993444756e-05, 5.4835098126204684e-05, 6.9027133577037603e-05, 6.8562403612304479e-05, 7.2742252086754888e-05, 4.6664579713251442e-05, 0.00010130285227205604, 6.266935815801844e-05, 6.0748985561076552e-05, 0.00014149909839034081, 3.4585656976560131e-05, 8.4635437815450132e-05, 7.4372845119796693e-05, 8.9651970483828336e-05, 8.0544865340925753e-05, 6.2282277212943882e-05, 6.4625040977261961e-05, 5.0965685659321025e-05, 5.0904403906315565e-05, 0.00028144760290160775, 0.00010062432556878775, 5.9234029322396964e-05, 0.00016412223340012133, 9.2557151219807565e-05, 0.00017374903836753219, 7.1925242082215846e-05, 7.3784773121587932e-05, 9.204293746734038e-05, 5.021664037485607e-05, 0.00010086964175570756, 8.4890918515156955e-05, 5.792183947050944e-05, 0.00018312197062186897, 0.00015130420797504485, 7.4889016104862094e-05, 0.00019453762797638774, 5.7073630159720778e-05, 4.2939322156598791e-05, 6.387141183950007e-05, } };
 const TfArray<48, int> quant22_zero = { 48, { 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0 } };
 const TfLiteAffineQuantization quant22 = { (TfLiteFloatArray*)&quant22_scale, (TfLiteIntArray*)&quant22_zero, 0 };
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 0
 const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int8_t tensor_data23[1*3*3*48] = { 
   /* [0][0][][] */ -72,56,-124,87,-64,123,-79,127,-84,-69,52,-58,62,-124,-14,-21,88,94,89,-109,76,-107,67,-97,-123,-26,108,127,-91,-41,-86,78,113,-107,75,-34,-71,-94,101,-3,-1,-55,99,-68,82,99,-94,-23, -100,51,-65,92,-44,127,-59,107,-113,-99,93,-56,41,-127,-49,-42,122,127,127,-127,96,-57,66,-113,-107,-78,90,114,25,-59,-106,115,127,-127,96,-87,-122,-88,99,-49,-79,104,127,-127,-39,127,-109,-84, -58,76,-10,31,-32,98,-81,79,-74,-51,25,-52,5,-70,-38,-9,44,72,89,-59,60,-36,10,-72,-123,-30,61,57,85,10,-34,35,55,-58,54,-44,-12,-37,45,-23,-127,-47,16,-58,-62,71,-68,-92, 
   /* [0][1][][] */ -65,127,-94,116,-50,127,-127,126,-83,-98,100,-104,91,-103,-117,-116,101,90,-58,-123,103,-127,104,-83,-127,-88,125,121,-127,-83,-127,92,77,17,110,-86,-115,-127,116,-115,-77,-96,95,-67,127,69,-127,-95, -127,90,-127,127,-127,122,-92,60,-127,-127,127,-127,127,-117,-127,-127,127,118,-39,-126,127,-81,127,-127,-94,-127,127,110,-4,-111,-95,127,75,22,127,-127,-127,-91,127,-127,-117,127,102,-92,-45,127,-70,-127, -96,80,-59,78,-68,69,-81,63,-58,-52,75,-68,63,-43,-99,-6,76,52,-25,-49,67,-53,60,-69,-125,-52,71,64,93,-68,-60,63,33,8,72,-18,13,-40,63,-85,-58,-108,31,-27,-38,84,-54,-122, 
   /* [0][2][][] */ -53,46,-16,83,-43,82,-91,72,-47,-34,43,-97,50,-18,-68,-26,22,43,-55,-48,34,-101,33,-66,-81,-63,67,26,-67,-60,-49,50,29,82,52,-76,-85,-108,42,-80,-120,-54,23,-77,85,63,-98,-56, -45,47,-104,67,-93,97,-74,36,-79,-47,54,-92,94,-72,-83,-41,31,44,-71,-48,39,-37,49,-94,-71,-65,48,15,15,-127,-63,72,14,83,66,-77,-87,-94,48,-89,-73,71,20,-124,-2,108,-36,-16, -28,24,-54,18,-28,65,-57,46,-63,-31,41,-74,17,-17,-58,11,37,24,-40,-37,17,-3,-3,-32,-10,-38,35,6,58,-63,-15,52,-7,86,47,14,-34,-32,43,-66,-32,-40,19,-88,-15,88,-10,-88, 
 };
+#endif // EI_CLASSIFIER_WEIGHTS_BLOB
 const TfArray<4, int> tensor_dimension23 = { 4, { 1,3,3,48 } };
 const TfArray<48, float> quant23_scale = { 48, { 0.0043879714794456959, 0.0034233464393764734, 0.0025706707965582609, 0.0043815118260681629, 0.0047540487721562386, 0.0029907079879194498, 0.0017542792484164238, 0.012957151979207993, 0.0044436086900532246, 0.0019248349126428366, 0.0023304915521293879, 0.0029336530715227127, 0.0029139020480215549, 0.0030915455427020788, 0.0019832446705549955, 0.0043053710833191872, 0.002663447754457593, 0.0025818317662924528, 0.0060137114487588406, 0.0014698903542011976, 0.0035970059689134359, 0.0031608457211405039, 0.0038102087564766407, 0.0034231566824018955, 0.0026469966396689415, 0.0027465641032904387, 0.0021660416387021542, 0.002163437195122242, 0.011961523443460464, 0.0042765336111187935, 0.0025174461770802736, 0.0069751949049532413, 0.0039336788468062878, 0.0073843342252075672, 0.0030568225774914026, 0.0031358527485281229, 0.0039118248969316483, 0.0021342071704566479, 0.0042869597673416138, 0.0036078640259802341, 0.0024616781156510115, 0.0077826837077736855, 0.0064304284751415253, 0.0031827830243855715, 0.0082678487524390221, 0.0024256291799247265, 0.0018249211134389043, 0.0027145349886268377, } };
 const TfLiteAffineQuantization quant23 = { (TfLiteFloatArray*)&quant23_scale, (TfLiteIntArray*)&g0::quant22_zero, 3 };
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 0
 const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int32_t tensor_data24[48] = { 2046, -1349, 1288, -2267, 3657, -1025, 4478, -4504, 1862, 608, 2863, 2604, 1225, -19, 1305, 6782, -1502, 3849, 5615, 953, -1474, 2604, -134, 4747, 1444, 2396, 778, -1186, 9145, -913, 2174, -1732, -204, 4492, -189, 2265, 1795, 1886, 1270, 5267, 1801, 9257, -2633, 2222, 7632, 1350, 2711, 6011, };
+#endif // EI_CLASSIFIER_WEIGHTS_BLOB
 const TfArray<48, float> quant24_scale = { 48, { 0.00023409418645314872, 0.00021061798906885087, 0.00026494255871511996, 0.00019665050785988569, 0.0002119679847965017, 0.00019872633856721222, 0.00015175505541265011, 0.00014450908929575235, 0.00024401264090556651, 0.00028082786593586206, 0.00018800482212100178, 0.00021791401377413422, 0.00021605200890917331, 0.00032259081490337849, 0.00018160526815336198, 0.00012179446639493108, 0.00022389166406355798, 0.00021170105901546776, 0.00014054312487132847, 0.00022862323385197669, 0.00020093853527214378, 0.00022251965128816664, 0.00025040775653906167, 0.00016250180487986654, 0.00026344819343648851, 0.00018814328359439969, 0.00028406348428688943, 0.00024618118186481297, 0.00010331855446565896, 0.00023186960606835783, 0.00019995198817923665, 0.00014647982607129961, 0.00023316523584071547, 0.00018642596842255443, 0.0002277866005897522, 0.00020662602037191391, 0.00021533117978833616, 0.00021355792705435306, 0.00017193901294376701, 0.00015576017904095352, 0.00027696506003849208, 0.00010194825881626457, 0.00017095066141337156, 0.00018707568233367056, 0.00011203637404832989, 0.00016660772962495685, 0.0002127097686752677, 0.00012438432895578444, } };
 const TfLiteAffineQuantization quant24 = { (TfLiteFloatArray*)&quant24_scale, (TfLiteIntArray*)&g0::quant22_zero, 0 };
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 0
 const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int8_t tensor_data25[48*1*1*8] = { 
   /* [0][0][][] */ 48,36,127,-57,62,77,-72,-28, 
   /* [1][0][][] */ -3,-98,-127,2,77,24,41,19, 
@@ -696,14 +809,18 @@ const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int8_t tensor_data25[48*1*1*8] =
   /* [46][0][][] */ -37,-30,40,35,-127,-80,-30,-12, 
   /* [47][0][][] */ -23,46,43,-125,-127,33,-5,49, 
 };
+#endif // EI_CLASSIFIER_WEIGHTS_BLOB
 const TfArray<4, int> tensor_dimension25 = { 4, { 48,1,1,8 } };
 const TfArray<48, float> quant25_scale = { 48, { 0.0027750872541218996, 0.0024967868812382221, 0.0031407815404236317, 0.0023312082048505545, 0.0025127904955297709, 0.0023558163084089756, 0.0017989918123930693, 0.0017130939522758126, 0.0028926662635058165, 0.0033290949650108814, 0.0022287173196673393, 0.0025832781102508307, 0.0025612048339098692, 0.003824177198112011, 0.002152853412553668, 0.0014438217040151358, 0.0026541405823081732, 0.0025096260942518711, 0.0016660790424793959, 0.0027102313470095396, 0.0023820409551262856, 0.0026378759648650885, 0.002968477550894022, 0.0019263898720964789, 0.003123066620901227, 0.0022303587757050991, 0.0033674519509077072, 0.0029183733277022839, 0.0012247975682839751, 0.0027487156912684441, 0.0023703458718955517, 0.0017364561790600419, 0.0027640748303383589, 0.0022100007627159357, 0.0027003134600818157, 0.0024494638200849295, 0.0025526597164571285, 0.0025316386017948389, 0.0020382639486342669, 0.0018464707536622882, 0.0032833032310009003, 0.0012085533235222101, 0.0020265474449843168, 0.0022177028004080057, 0.0013281436404213309, 0.0019750639330595732, 0.0025215840432792902, 0.0014745233347639441, } };
 const TfLiteAffineQuantization quant25 = { (TfLiteFloatArray*)&quant25_scale, (TfLiteIntArray*)&g0::quant22_zero, 0 };
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 0
 const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int32_t tensor_data26[8] = { 1309, 1652, 19971, -2340, 4201, -18455, 2979, -9907, };
+#endif // EI_CLASSIFIER_WEIGHTS_BLOB
 const TfArray<1, int> tensor_dimension26 = { 1, { 8 } };
 const TfArray<8, float> quant26_scale = { 8, { 8.4861618233844638e-05, 9.6465060778427869e-05, 0.00018268065468873829, 0.00014419031504075974, 0.00013661655248142779, 0.00014008121797814965, 0.00010431206465000287, 8.8473148935008794e-05, } };
 const TfArray<8, int> quant26_zero = { 8, { 0,0,0,0,0,0,0,0 } };
 const TfLiteAffineQuantization quant26 = { (TfLiteFloatArray*)&quant26_scale, (TfLiteIntArray*)&quant26_zero, 0 };
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 0
 const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int8_t tensor_data27[8*1*1*48] = { 
   /* [0][0][][] */ -47,-31,-8,-103,-4,-8,92,96,-109,-94,-13,17,-43,11,-56,31,-76,18,11,127,73,-50,7,104,82,95,44,5,-69,-61,-73,-69,-50,98,12,-44,53,-20,88,24,10,-16,0,-88,40,-42,-29,-61, 
   /* [1][0][][] */ -7,58,-31,-40,-84,63,-32,-66,-41,90,-21,9,27,15,-65,-5,-15,-125,96,-63,127,4,-45,42,78,-18,-100,62,36,15,54,9,-19,-15,-6,4,-4,113,-24,-20,63,34,-22,-9,104,14,-16,63, 
@@ -714,22 +831,30 @@ const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int8_t tensor_data27[8*1*1*48] =
   /* [6][0][][] */ -42,39,-127,68,30,11,16,19,-1,-15,51,-57,-95,-28,-36,10,-99,27,-2,70,31,39,-65,-76,-33,-20,30,63,-38,-31,-48,7,35,71,-33,-28,-39,-11,68,-23,52,48,-106,-63,-33,122,-25,-29, 
   /* [7][0][][] */ -7,65,-76,35,19,44,106,69,31,55,-100,-11,-32,-1,-59,-66,-5,41,127,77,85,11,96,40,88,77,-65,106,-60,23,15,-66,18,-67,-11,41,12,107,-59,81,-57,62,-3,-115,76,-19,35,-34, 
 };
+#endif // EI_CLASSIFIER_WEIGHTS_BLOB
 const TfArray<4, int> tensor_dimension27 = { 4, { 8,1,1,48 } };
 const TfArray<8, float> quant27_scale = { 8, { 0.0036066188476979733, 0.0040997648611664772, 0.0077639278024435043, 0.0061280885711312294, 0.0058062034659087658, 0.0059534516185522079, 0.0044332626275718212, 0.0037601087242364883, } };
 const TfLiteAffineQuantization quant27 = { (TfLiteFloatArray*)&quant27_scale, (TfLiteIntArray*)&g0::quant26_zero, 0 };
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 0
 const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int32_t tensor_data28[48] = { -615, 14509, -421, -142, 3577, -824, 2169, 1624, -4295, -141, -4899, -45, 92, -2016, -2358, 6022, 5483, 4124, -517, -4721, -8079, -3834, 23550, -2508, -3193, -711, 7794, -4146, 661, -63, -9437, 6983, 5666, 1191, 3834, 375, 181, -634, 17860, -3670, 3859, -4122, 6330, 7118, 3319, 10066, -543, 4592, };
+#endif // EI_CLASSIFIER_WEIGHTS_BLOB
 const TfArray<48, float> quant28_scale = { 48, { 0.00027414265787228942, 0.00011988379992544651, 0.00098334532231092453, 0.00026158979744650424, 0.00020599900744855404, 0.0002487408637534827, 0.00027227739337831736, 0.00032478576758876443, 9.1500674898270518e-05, 0.00024436757666990161, 0.00018925574840977788, 0.0017197298584505916, 0.00036638492019847035, 0.00034183129901066422, 0.00038009497802704573, 0.00062985339900478721, 0.00018897015252150595, 8.3833656390197575e-05, 0.00026163962320424616, 0.00023494115157518536, 0.00026064910343848169, 0.00018946621275972575, 6.4503074099775404e-05, 0.00041221754509024322, 0.00023415555187966675, 0.00032556799123995006, 0.00031649920856580138, 0.00027313921600580215, 0.00024364533601328731, 0.00044886115938425064, 0.00014905691205058247, 0.00013693526852875948, 0.00011602468293858692, 0.00022461003391072154, 0.00016988808056339622, 0.00039015311631374061, 0.001257703872397542, 0.00030671642161905766, 9.3059526989236474e-05, 0.00014299957547336817, 0.00016953129670582712, 0.00011070830805692822, 0.00026515894569456577, 0.00033702183282002807, 0.00031783303711563349, 9.4492497737519443e-05, 5.8132045523962006e-05, 0.00022185962006915361, } };
 const TfLiteAffineQuantization quant28 = { (TfLiteFloatArray*)&quant28_scale, (TfLiteIntArray*)&g0::quant22_zero, 0 };
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 0
 const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int8_t tensor_data29[1*3*3*48] = { 
   /* [0][0][][] */ 4,-66,5,4,-35,-101,-26,67,-25,17,-4,3,59,13,-16,-12,74,-17,51,12,2,36,-60,26,-9,-9,-13,-32,-85,57,10,-127,65,-18,-42,-56,-20,-41,-20,35,-7,127,-7,-15,-32,40,127,-35, -127,-116,-25,127,-79,65,-70,121,21,18,25,-9,53,77,4,-52,-17,61,24,15,8,127,1,127,112,-39,-67,19,74,-121,26,-79,69,-17,-55,-127,15,18,-48,-51,-104,23,-127,-72,16,40,90,80, -35,13,9,8,-37,52,46,23,8,-42,-8,7,-24,-7,-2,-11,-45,18,-78,-21,-17,20,127,27,-44,-4,-23,21,7,21,12,46,3,-27,-64,60,7,20,8,86,34,-37,38,-19,-31,31,-36,-38, 
   /* [0][1][][] */ -20,-43,-30,-1,29,-97,113,-40,-25,23,17,28,127,13,3,-31,-10,-59,43,54,73,-45,50,-5,-52,127,-90,-27,127,-72,37,-125,-27,0,-73,6,-5,-70,-64,61,127,125,-4,-127,-93,-81,-61,76, 119,-127,127,-8,127,32,-62,-46,24,127,127,-127,-102,127,127,127,127,127,122,127,127,76,-6,-4,127,-103,-127,55,35,127,127,64,-127,127,127,127,-127,127,-127,-127,51,35,-107,-11,127,-127,-11,69, 8,55,-41,-1,-49,127,-127,59,81,-89,16,56,-51,-6,12,-61,16,-11,-127,35,21,-72,-21,-2,59,-18,-38,127,-84,-29,23,6,-31,17,98,-5,35,12,-10,-65,110,-6,57,40,-76,92,125,-81, 
   /* [0][2][][] */ -20,-15,4,-32,-6,-104,-18,-12,25,6,-5,14,-7,20,0,-6,-32,-6,56,-62,6,-13,79,-25,-89,11,50,-12,24,7,3,2,-9,-11,-40,35,3,-19,-12,87,-19,14,-41,-24,-36,22,-44,-8, 71,-48,-34,-42,18,1,101,-127,127,-36,-15,12,-72,11,-14,-69,-10,82,-15,10,17,14,-14,-46,-52,62,79,-22,-100,8,-25,-39,-11,-9,-46,-15,57,-21,-24,98,-100,-3,-34,39,38,46,26,-127, 6,20,3,-27,-23,31,-23,-88,25,-25,-26,8,10,-6,-15,11,27,14,-49,-21,0,-8,-26,-22,35,-22,22,6,-34,-2,-8,-3,38,-12,-36,-43,-3,18,8,-6,0,-27,2,12,-23,17,71,-53, 
 };
+#endif // EI_CLASSIFIER_WEIGHTS_BLOB
 const TfArray<48, float> quant29_scale = { 48, { 0.011651062406599522, 0.0050950613804161549, 0.04179217666387558, 0.011117566376924515, 0.0087549574673175812, 0.010571486316621304, 0.011571789160370827, 0.013803394511342049, 0.0038887786213308573, 0.010385621339082718, 0.0080433692783117294, 0.073088519275188446, 0.015571358613669872, 0.014527830295264721, 0.016154035925865173, 0.026768770068883896, 0.0080312313511967659, 0.0035629302728921175, 0.011119683273136616, 0.0099849989637732506, 0.011077586561441422, 0.0080523137003183365, 0.0027413805946707726, 0.01751924492418766, 0.0099516110494732857, 0.013836639001965523, 0.01345121581107378, 0.011608416214585304, 0.010354926809668541, 0.019076598808169365, 0.0063349185511469841, 0.0058197486214339733, 0.0049310489557683468, 0.0095459260046482086, 0.0072202431038022041, 0.01658150739967823, 0.053452413529157639, 0.013035447336733341, 0.0039550298824906349, 0.0060774818994104862, 0.0072050802409648895, 0.0047051031142473221, 0.011269255541265011, 0.014323427341878414, 0.013507903553545475, 0.0040159309282898903, 0.0024706118274480104, 0.0094290338456630707, } };
 const TfLiteAffineQuantization quant29 = { (TfLiteFloatArray*)&quant29_scale, (TfLiteIntArray*)&g0::quant22_zero, 3 };
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 0
 const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int32_t tensor_data30[48] = { 3699, 4789, 19697, 1380, 2343, -1156, 6599, 13555, 3455, -137, 2513, -2472, 11991, -1805, 2784, 26297, -341, 1911, 775, 2835, 4492, 3049, 258, 26112, 6910, 3546, 10153, 1807, 6145, 5388, 665, 1337, 864, 1937, -501, 186, -2270, -294, 2595, 2143, 5288, 2332, 5310, 7723, 7508, 3406, 1907, 10428, };
+#endif // EI_CLASSIFIER_WEIGHTS_BLOB
 const TfArray<48, float> quant30_scale = { 48, { 0.00017968939209822565, 0.00017736632435116917, 5.4046689911046997e-05, 0.00021190206462051719, 0.000192342369700782, 0.00028257863596081734, 0.00012796906230505556, 7.0327470893971622e-05, 0.0001782051840564236, 0.00025501416530460119, 0.00028688009479083121, 0.00021065918554086238, 7.8137789387255907e-05, 0.0002276646118843928, 0.00019876795704476535, 4.3273135815979913e-05, 0.00034194847103208303, 0.00018399913096800447, 0.00021578467567451298, 0.00023145313025452197, 0.00017597590340301394, 0.00020198493439238518, 0.00036176361027173698, 4.2126379412366077e-05, 0.0001188971073133871, 0.00015148923557717353, 9.0686378825921565e-05, 0.00023752645938657224, 0.00012521805183496326, 0.00013640339602716267, 0.00046650684089399874, 0.00036772771272808313, 0.00022750221251044422, 0.0001824043138185516, 0.00025547639233991504, 0.00028967577964067459, 0.00022775011893827468, 0.00031954768928699195, 0.00021809473400935531, 0.00023565338051412255, 0.00015274564793799073, 0.00025529495906084776, 0.00016590522136539221, 0.00013064866652712226, 0.00011475514475023374, 0.00022577919298782945, 0.00029095829813741148, 9.054898691829294e-05, } };
 const TfLiteAffineQuantization quant30 = { (TfLiteFloatArray*)&quant30_scale, (TfLiteIntArray*)&g0::quant22_zero, 0 };
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 0
 const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int8_t tensor_data31[48*1*1*8] = { 
   /* [0][0][][] */ 85,127,-101,-108,11,101,25,100, 
   /* [1][0][][] */ 85,-70,57,-127,-55,61,-101,-44, 
@@ -780,11 +905,15 @@ const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int8_t tensor_data31[48*1*1*8] =
   /* [46][0][][] */ 70,-61,-15,127,54,55,22,76, 
   /* [47][0][][] */ -56,-87,52,94,-78,13,109,-127, 
 };
+#endif // EI_CLASSIFIER_WEIGHTS_BLOB
 const TfArray<48, float> quant31_scale = { 48, { 0.0027173364069312811, 0.0026822059880942106, 0.00081731611862778664, 0.0032044695690274239, 0.0029086798895150423, 0.0042732697911560535, 0.001935200416482985, 0.0010635207872837782, 0.0026948915328830481, 0.0038564284332096577, 0.0043383180163800716, 0.0031856743153184652, 0.0011816315818578005, 0.0034428373910486698, 0.0030058503616601229, 0.00065439403988420963, 0.0051710843108594418, 0.0027825101278722286, 0.0032631841022521257, 0.0035001288633793592, 0.002661179518327117, 0.0030544986948370934, 0.005470737349241972, 0.00063705234788358212, 0.0017980106640607119, 0.0022908821702003479, 0.0013713964726775885, 0.0035919721703976393, 0.0018935985863208771, 0.0020627479534596205, 0.0070547070354223251, 0.0055609289556741714, 0.0034403814934194088, 0.0027583925984799862, 0.0038634182419627905, 0.0043805954046547413, 0.0034441302996128798, 0.0048323306255042553, 0.0032981177791953087, 0.0035636466927826405, 0.0023098820820450783, 0.0038606747984886169, 0.0025088866241276264, 0.00197572261095047, 0.0017353742150589824, 0.0034143251832574606, 0.0043999901972711086, 0.0013693188084289432, } };
 const TfLiteAffineQuantization quant31 = { (TfLiteFloatArray*)&quant31_scale, (TfLiteIntArray*)&g0::quant22_zero, 0 };
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 0
 const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int32_t tensor_data32[8] = { 6283, 15156, -4081, 4160, -3440, 3372, -9636, -18001, };
+#endif // EI_CLASSIFIER_WEIGHTS_BLOB
 const TfArray<8, float> quant32_scale = { 8, { 0.00019827831420116127, 0.0001148433584603481, 0.00013388415391091257, 0.00015009113121777773, 0.00014893185289110988, 0.00011747478856705129, 0.00020024435070808977, 0.00012067377247149125, } };
 const TfLiteAffineQuantization quant32 = { (TfLiteFloatArray*)&quant32_scale, (TfLiteIntArray*)&g0::quant26_zero, 0 };
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 0
 const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int8_t tensor_data33[8*1*1*48] = { 
   /* [0][0][][] */ -42,-11,32,7,-32,-20,16,17,-39,-4,-69,-57,-26,-68,-9,-31,53,-41,41,40,-17,30,-43,11,0,-41,53,-11,-1,-17,14,5,90,44,38,-127,23,3,-16,-36,12,-25,44,53,39,-3,29,1, 
   /* [1][0][][] */ -1,23,53,-27,3,50,-48,-25,0,25,-15,-94,11,121,-16,51,-22,25,-31,-62,16,-89,-33,29,-77,-15,-6,-116,-28,-10,31,-81,30,82,-43,1,117,-22,-1,52,-34,46,-79,-25,127,-9,-34,-18, 
@@ -795,21 +924,29 @@ const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int8_t tensor_data33[8*1*1*48] =
   /* [6][0][][] */ 48,-16,19,-8,-42,-25,-33,10,-42,6,-38,127,-43,-36,-1,53,2,46,17,30,23,-82,-36,9,20,34,-65,-2,9,-38,15,30,-5,10,-22,-2,5,18,-7,1,-10,-14,37,53,0,-30,68,-14, 
   /* [7][0][][] */ -30,6,-5,71,28,28,12,31,17,1,81,-4,120,98,63,41,53,43,-1,0,31,-13,-76,-25,17,1,-27,64,19,-17,-38,-8,39,3,36,-88,-81,29,37,61,-33,25,81,127,-68,-23,-103,60, 
 };
+#endif // EI_CLASSIFIER_WEIGHTS_BLOB
 const TfArray<8, float> quant33_scale = { 8, { 0.0084268283098936081, 0.0048808427527546883, 0.0056900763884186745, 0.0063788727857172489, 0.0063296034932136536, 0.0049926782958209515, 0.0085103847086429596, 0.0051286350935697556, } };
 const TfLiteAffineQuantization quant33 = { (TfLiteFloatArray*)&quant33_scale, (TfLiteIntArray*)&g0::quant26_zero, 0 };
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 0
 const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int32_t tensor_data34[48] = { 10417, 5913, 4707, 478, 5381, -250, 1743, 30969, 1608, 2628, 5068, 64798, 770, 4542, 28, 12375, -2542, 16892, 596, 9079, 8281, -550, 3693, -6924, 16166, 1656, 284, 12568, -1590, -2660, -7854, 10635, 5850, -200, 861, 3726, -10884, 7187, -2030, 23877, -2147, -701, 6125, 624, 829, -1663, 1563, -885, };
+#endif // EI_CLASSIFIER_WEIGHTS_BLOB
 const TfArray<48, float> quant34_scale = { 48, { 8.1022633821703494e-05, 0.00012752637849189341, 0.00013686748570762575, 0.00015705671103205532, 0.00096168811433017254, 0.00013977862545289099, 8.8749424321576953e-05, 8.8823086116462946e-05, 0.00015628276742063463, 7.1262467827182263e-05, 7.5299125455785543e-05, 4.1787254303926602e-05, 9.0323715994600207e-05, 5.9836620494024828e-05, 0.00024960166774690151, 0.00015435864042956382, 0.00011746765085263178, 0.00024827261222526431, 0.00013268974726088345, 0.00010581516107777134, 0.00015992083353921771, 0.00041223946027457714, 0.0001279327116208151, 0.0002201373572461307, 0.00010588842997094616, 6.7458538978826255e-05, 6.1310296587180346e-05, 9.5229283033404499e-05, 0.00015215593157336116, 0.0010139137739315629, 0.00025040342006832361, 8.9788896730169654e-05, 0.00010965187539113685, 0.00015108645311556756, 0.00015041483857203275, 6.8811961682513356e-05, 6.7283814132679254e-05, 5.5498850997537374e-05, 0.00011868245928781107, 4.944756074110046e-05, 0.00014629383804276586, 0.00013748662604484707, 6.9148663897067308e-05, 9.2373680672608316e-05, 7.5772477430291474e-05, 0.00028801104053854942, 7.2038470534607768e-05, 0.00019327260088175535, } };
 const TfLiteAffineQuantization quant34 = { (TfLiteFloatArray*)&quant34_scale, (TfLiteIntArray*)&g0::quant22_zero, 0 };
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 0
 const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int8_t tensor_data35[1*3*3*48] = { 
   /* [0][0][][] */ -25,-49,-50,-21,127,-74,77,-53,-104,-96,-7,-63,127,34,51,-127,58,-42,2,-24,-30,63,-2,-3,-59,75,74,-61,92,-64,23,-51,-127,-65,40,75,45,105,119,-110,-127,-9,3,63,50,-95,76,69, -92,-63,-107,61,-104,122,62,-69,-69,52,65,-120,120,96,91,-79,-64,-116,29,-38,-37,58,-81,94,-121,122,98,-121,100,-39,-10,-127,-60,-57,86,127,102,127,127,-89,-110,-69,53,90,80,110,74,72, -10,-37,-69,108,-94,-31,24,18,62,14,47,-105,12,67,-6,-15,-61,-27,23,-11,3,-27,-55,16,-75,112,33,-96,47,58,127,-65,3,25,-18,43,82,70,46,-53,-18,99,68,33,57,25,21,-127, 
   /* [0][1][][] */ -92,-91,-56,-79,-79,-101,90,-110,-127,-127,101,-74,101,55,-84,-65,127,-127,-61,-91,-77,96,-38,-43,-51,91,105,-74,-107,-72,7,-41,-72,-127,-127,76,69,109,8,-98,62,3,83,127,84,127,127,-107, -127,-127,-100,-111,-30,127,127,-127,84,62,127,-127,84,127,71,-114,52,-102,-127,-127,-127,127,-127,127,-127,127,127,-127,-127,127,-36,-121,-85,-93,71,108,127,113,-16,-127,91,-127,127,123,127,9,103,123, -24,-52,-127,127,49,-42,59,17,53,24,33,-83,7,67,75,-47,-8,-6,-17,-87,-35,38,-92,-44,-115,68,10,-68,-52,37,77,-38,-34,8,83,44,82,62,-21,-47,59,112,83,20,67,-46,28,36, 
   /* [0][2][][] */ -111,-39,-18,-3,-35,-37,31,-55,44,-62,19,-32,26,42,-61,-34,-73,-40,90,-11,-5,75,-72,-28,-23,87,110,-25,48,56,1,-14,-7,-85,-82,39,43,29,-58,-54,21,11,53,32,43,53,20,-86, -80,-51,-45,-89,93,35,78,-68,74,21,-32,-63,3,67,-127,-98,27,3,53,-57,-39,76,-43,84,-49,112,102,-25,36,9,-29,-36,-83,-41,-102,47,68,32,-82,-101,40,-50,79,56,50,-109,33,-3, 13,-37,-62,-34,-47,-10,32,20,-91,27,9,-48,5,31,5,-55,27,23,7,-50,-17,58,-2,-24,-71,29,18,-19,12,-54,55,-22,-105,19,10,15,36,27,-41,-42,26,49,26,15,32,-27,15,44, 
 };
+#endif // EI_CLASSIFIER_WEIGHTS_BLOB
 const TfArray<48, float> quant35_scale = { 48, { 0.0034434618428349495, 0.0054198708385229111, 0.0058168680407106876, 0.0066749099642038345, 0.040871743112802505, 0.0059405914507806301, 0.0037718506064265966, 0.0037749810144305229, 0.0066420175135135651, 0.0030286547262221575, 0.0032002127263695002, 0.0017759582260623574, 0.0038387577515095472, 0.002543056383728981, 0.010608070529997349, 0.0065602422691881657, 0.0049923751503229141, 0.01055158581584692, 0.0056393141858279705, 0.0044971443712711334, 0.0067966352216899395, 0.017520176246762276, 0.0054371398873627186, 0.0093558374792337418, 0.0045002582482993603, 0.0028669878374785185, 0.0026056875940412283, 0.0040472443215548992, 0.0064666271209716797, 0.043091334402561188, 0.010642144829034805, 0.0038160281255841255, 0.0046602045185863972, 0.0064211739227175713, 0.0063926307484507561, 0.0029245084151625633, 0.0028595621697604656, 0.002358701080083847, 0.0050440044142305851, 0.0021015212405472994, 0.0062174880877137184, 0.0058431816287338734, 0.0029388181865215302, 0.0039258813485503197, 0.0032203302253037691, 0.01224046852439642, 0.0030616349540650845, 0.0082140853628516197, } };
 const TfLiteAffineQuantization quant35 = { (TfLiteFloatArray*)&quant35_scale, (TfLiteIntArray*)&g0::quant22_zero, 3 };
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 0
 const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int32_t tensor_data36[48] = { 1194, -394, -648, 1372, 29265, 2276, -463, 3385, 1343, 1076, 365, 2107, 872, 317, -1101, 429, 1720, 7329, 3133, -558, 1407, -982, -94, 3569, -50, -619, 1432, -65, 4544, 18456, 2878, -143, 351, -261, 3306, 217, 212, -356, 1331, 1146, 1217, 2404, 156, -273, 405, 2053, 1245, 68, };
+#endif // EI_CLASSIFIER_WEIGHTS_BLOB
 const TfArray<48, float> quant36_scale = { 48, { 0.00042718552867881954, 0.00037962384521961212, 0.00029102401458658278, 0.00030192040139809251, 3.7860056181671098e-05, 0.00031596783082932234, 0.00061954546254128218, 0.00024847211898304522, 0.00032440532231703401, 0.00062041834462434053, 0.00029965076828375459, 0.00036638209712691605, 0.00024055823450908065, 0.00041528607835061848, 0.00028943244251422584, 0.00035207904875278473, 0.00037086644442752004, 0.00012209999840706587, 0.000250190933002159, 0.0003653443418443203, 0.00035108861629851162, 0.00022449478274211287, 0.00049902714090421796, 0.0002356211916776374, 0.00043934627319686115, 0.00080233736662194133, 0.00035109894815832376, 0.00089026434579864144, 0.00019321765284985304, 5.5610486015211791e-05, 0.00027168748783878982, 0.00068651780020445585, 0.00042008137097582221, 0.00037158062332309783, 0.0002670421963557601, 0.0003263111284468323, 0.0004871637502219528, 0.00054865423589944839, 0.00032003555679693818, 0.0005036852671764791, 0.00047555533819831908, 0.00029147870372980833, 0.00032875698525458574, 0.0004783922340720892, 0.00052093586418777704, 0.00026857882039621472, 0.00031622181995771825, 0.00034743701689876616, } };
 const TfLiteAffineQuantization quant36 = { (TfLiteFloatArray*)&quant36_scale, (TfLiteIntArray*)&g0::quant22_zero, 0 };
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 0
 const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int8_t tensor_data37[48*1*1*8] = { 
   /* [0][0][][] */ -42,20,28,-35,-77,-54,-127,24, 
   /* [1][0][][] */ 79,-77,-54,-40,127,-99,103,7, 
@@ -860,11 +997,15 @@ const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int8_t tensor_data37[48*1*1*8] =
   /* [46][0][][] */ -23,-127,-39,41,11,37,-46,120, 
   /* [47][0][][] */ 48,62,114,0,95,109,127,-11, 
 };
+#endif // EI_CLASSIFIER_WEIGHTS_BLOB
 const TfArray<48, float> quant37_scale = { 48, { 0.0041092699393630028, 0.0036517549306154251, 0.0027994774281978607, 0.002904294291511178, 0.00036419116077013314, 0.0030394219793379307, 0.0059596579521894455, 0.0023901534732431173, 0.0031205855775624514, 0.0059680542908608913, 0.002882461529225111, 0.0035243772435933352, 0.0023140267003327608, 0.0039948043413460255, 0.0027841674163937569, 0.0033867903985083103, 0.0035675140097737312, 0.001174529199488461, 0.0024066874757409096, 0.0035143946297466755, 0.003377262968569994, 0.0021595058497041464, 0.0048003434203565121, 0.0022665353026241064, 0.0042262491770088673, 0.0077180066145956516, 0.0033773623872548342, 0.0085638118907809258, 0.0018586385995149612, 0.00053493969608098269, 0.0026134715881198645, 0.0066038919612765312, 0.0040409322828054428, 0.0035743839107453823, 0.0025687867309898138, 0.0031389184296131134, 0.004686224739998579, 0.0052777263335883617, 0.0030785512644797564, 0.0048451516777276993, 0.0045745586976408958, 0.0028038513846695423, 0.0031624459661543369, 0.0046018478460609913, 0.0050110924057662487, 0.0025835679844021797, 0.0030418653041124344, 0.0033421369735151529, } };
 const TfLiteAffineQuantization quant37 = { (TfLiteFloatArray*)&quant37_scale, (TfLiteIntArray*)&g0::quant22_zero, 0 };
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 0
 const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int32_t tensor_data38[8] = { -8909, -3671, 12405, -9925, 20551, 10221, -6832, 12279, };
+#endif // EI_CLASSIFIER_WEIGHTS_BLOB
 const TfArray<8, float> quant38_scale = { 8, { 0.00019095889001619071, 0.00022798373538535088, 0.00018163131608162075, 0.0002341965155210346, 0.00017697192379273474, 0.00016514601884409785, 0.00017136224778369069, 0.00026188860647380352, } };
 const TfLiteAffineQuantization quant38 = { (TfLiteFloatArray*)&quant38_scale, (TfLiteIntArray*)&g0::quant26_zero, 0 };
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 0
 const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int8_t tensor_data39[8*1*1*16] = { 
   /* [0][0][][] */ -3,-5,-20,-71,-22,-36,22,-30,42,13,-26,3,114,127,-14,-99, 
   /* [1][0][][] */ 127,-51,-48,17,-55,69,-71,-45,-40,81,-40,-45,-6,4,-47,-18, 
@@ -875,23 +1016,31 @@ const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int8_t tensor_data39[8*1*1*16] =
   /* [6][0][][] */ 92,47,-127,-70,38,-67,7,-79,-39,29,-114,84,80,-83,11,73, 
   /* [7][0][][] */ -127,-10,99,-29,-65,-4,-5,-56,-51,68,79,-29,51,-27,17,22, 
 };
+#endif // EI_CLASSIFIER_WEIGHTS_BLOB
 const TfArray<4, int> tensor_dimension39 = { 4, { 8,1,1,16 } };
 const TfArray<8, float> quant39_scale = { 8, { 0.008115752600133419, 0.0096893087029457092, 0.0077193309552967548, 0.009953351691365242, 0.0075213066302239895, 0.0070187053643167019, 0.0072828955017030239, 0.011130264960229397, } };
 const TfLiteAffineQuantization quant39 = { (TfLiteFloatArray*)&quant39_scale, (TfLiteIntArray*)&g0::quant26_zero, 0 };
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 0
 const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int32_t tensor_data40[16] = { 23834, -876, -6, 5344, -225, 603, 8295, 1399, -34, 189, -1963, 2497, 124, -306, -160, -1662, };
+#endif // EI_CLASSIFIER_WEIGHTS_BLOB
 const TfArray<16, float> quant40_scale = { 16, { 9.8023425380233675e-05, 0.00019553479796741158, 0.00014998049300629646, 0.00019359674479346722, 0.0011973384534940124, 0.00086431961972266436, 0.00019214687927160412, 0.00092824938474223018, 0.00029432386509142816, 0.0013371540699154139, 0.00019245823204983026, 0.00017264475172851235, 9.2193302407395095e-05, 0.00024021152057684958, 0.00014438788639381528, 0.00042389810550957918, } };
 const TfLiteAffineQuantization quant40 = { (TfLiteFloatArray*)&quant40_scale, (TfLiteIntArray*)&g0::quant8_zero, 0 };
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 0
 const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int8_t tensor_data41[1*3*3*16] = { 
   /* [0][0][][] */ -9,-7,14,0,-19,10,21,12,-9,-11,-7,-7,8,-5,18,1, 0,-14,12,3,14,-2,24,-26,-9,9,-9,86,-21,23,-15,0, -5,-1,-2,-1,5,-14,0,11,2,2,-9,-12,9,-2,-7,0, 
   /* [0][1][][] */ 2,-12,10,4,127,-25,-127,-24,127,127,5,5,126,-26,-17,-17, -127,127,127,-3,-89,-93,-8,-100,7,-106,127,127,127,127,127,127, 22,-12,0,-3,-9,127,-2,-9,7,-13,-2,0,16,-6,-21,-9, 
   /* [0][2][][] */ -1,8,0,-33,-26,15,63,5,-6,-7,0,8,13,-3,7,-11, 11,-28,-10,-127,0,-16,-4,127,-5,2,-7,-14,-13,-61,-32,-37, 1,6,1,-14,-4,-5,-5,-1,2,2,1,2,0,-8,-4,-14, 
 };
+#endif // EI_CLASSIFIER_WEIGHTS_BLOB
 const TfArray<4, int> tensor_dimension41 = { 4, { 1,3,3,16 } };
 const TfArray<16, float> quant41_scale = { 16, { 0.0041659954003989697, 0.0083102285861968994, 0.0063741705380380154, 0.0082278614863753319, 0.050886884331703186, 0.036733582615852356, 0.008166242390871048, 0.039450597018003464, 0.012508763931691647, 0.056829046458005905, 0.0081794746220111847, 0.0073374016210436821, 0.0039182151667773724, 0.01020898949354887, 0.0061364849098026752, 0.018015669658780098, } };
 const TfLiteAffineQuantization quant41 = { (TfLiteFloatArray*)&quant41_scale, (TfLiteIntArray*)&g0::quant8_zero, 3 };
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 0
 const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int32_t tensor_data42[16] = { 441, 393, -161, 4280, 52203, 50934, 1616, 6720, 4775, 10161, 836, -147, 5463, 580, 332, 41937, };
+#endif // EI_CLASSIFIER_WEIGHTS_BLOB
 const TfArray<16, float> quant42_scale = { 16, { 0.0002413991023786366, 0.0010185989085584879, 0.00034998147748410702, 0.0001210136033478193, 2.8177633794257417e-05, 3.0534592951880768e-05, 0.00013252705684863031, 2.4757373466854915e-05, 0.00016726220201235265, 3.0170876925694756e-05, 0.000516798987518996, 0.00087388342944905162, 0.00029652251396328211, 1.5042301129142288e-05, 0.00087197433458641171, 3.6209628888173029e-05, } };
 const TfLiteAffineQuantization quant42 = { (TfLiteFloatArray*)&quant42_scale, (TfLiteIntArray*)&g0::quant8_zero, 0 };
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 0
 const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int8_t tensor_data43[16*3*3*1] = { 
   /* [0][0][][] */ -86, -110, -29, 
   /* [0][1][][] */ 66, -38, 17, 
@@ -942,6 +1091,7 @@ const MODEL_SECTION(EI_MODEL_SECTION) ALIGN(16) int8_t tensor_data43[16*3*3*1] =
   /* [15][1][][] */ -127, -111, 36, 
   /* [15][2][][] */ -39, -87, -2, 
 };
+#endif // EI_CLASSIFIER_WEIGHTS_BLOB
 const TfArray<4, int> tensor_dimension43 = { 4, { 16,3,3,1 } };
 const TfArray<16, float> quant43_scale = { 16, { 0.061556767672300339, 0.25974270701408386, 0.089245274662971497, 0.030858466401696205, 0.0071852961555123329, 0.0077863205224275589, 0.033794399350881577, 0.0063131297938525677, 0.042651858180761337, 0.0076935733668506145, 0.13178373873233795, 0.22284026443958282, 0.075613237917423248, 0.0038357865996658802, 0.22235344350337982, 0.0092334551736712456, } };
 const TfLiteAffineQuantization quant43 = { (TfLiteFloatArray*)&quant43_scale, (TfLiteIntArray*)&g0::quant8_zero, 0 };
@@ -1077,49 +1227,49 @@ const TfArray<1, int> outputs26 = { 1, { 70 } };
 
 TensorInfo_t tensorData[] = {
 { kTfLiteArenaRw, kTfLiteInt8, (int32_t*)(tensor_arena + 0), (TfLiteIntArray*)&g0::tensor_dimension0, 9216, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant0))}, },
-{ kTfLiteMmapRo, kTfLiteInt32, (int32_t*)g0::tensor_data1, (TfLiteIntArray*)&g0::tensor_dimension1, 32, {kTfLiteNoQuantization, nullptr}, },
-{ kTfLiteMmapRo, kTfLiteInt32, (int32_t*)g0::tensor_data2, (TfLiteIntArray*)&g0::tensor_dimension2, 28, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant2))}, },
-{ kTfLiteMmapRo, kTfLiteInt8, (int32_t*)g0::tensor_data3, (TfLiteIntArray*)&g0::tensor_dimension3, 224, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant3))}, },
-{ kTfLiteMmapRo, kTfLiteInt32, (int32_t*)g0::tensor_data4, (TfLiteIntArray*)&g0::tensor_dimension4, 128, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant4))}, },
-{ kTfLiteMmapRo, kTfLiteInt8, (int32_t*)g0::tensor_data5, (TfLiteIntArray*)&g0::tensor_dimension5, 3072, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant5))}, },
-{ kTfLiteMmapRo, kTfLiteInt32, (int32_t*)g0::tensor_data6, (TfLiteIntArray*)&g0::tensor_dimension6, 384, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant6))}, },
-{ kTfLiteMmapRo, kTfLiteInt8, (int32_t*)g0::tensor_data7, (TfLiteIntArray*)&g0::tensor_dimension7, 1536, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant7))}, },
-{ kTfLiteMmapRo, kTfLiteInt32, (int32_t*)g0::tensor_data8, (TfLiteIntArray*)&g0::tensor_dimension8, 64, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant8))}, },
-{ kTfLiteMmapRo, kTfLiteInt8, (int32_t*)g0::tensor_data9, (TfLiteIntArray*)&g0::tensor_dimension9, 1536, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant9))}, },
-{ kTfLiteMmapRo, kTfLiteInt32, (int32_t*)g0::tensor_data10, (TfLiteIntArray*)&g0::tensor_dimension6, 384, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant10))}, },
-{ kTfLiteMmapRo, kTfLiteInt8, (int32_t*)g0::tensor_data11, (TfLiteIntArray*)&g0::tensor_dimension11, 864, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant11))}, },
-{ kTfLiteMmapRo, kTfLiteInt32, (int32_t*)g0::tensor_data12, (TfLiteIntArray*)&g0::tensor_dimension6, 384, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant12))}, },
-{ kTfLiteMmapRo, kTfLiteInt8, (int32_t*)g0::tensor_data13, (TfLiteIntArray*)&g0::tensor_dimension7, 1536, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant13))}, },
-{ kTfLiteMmapRo, kTfLiteInt32, (int32_t*)g0::tensor_data14, (TfLiteIntArray*)&g0::tensor_dimension8, 64, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant14))}, },
-{ kTfLiteMmapRo, kTfLiteInt8, (int32_t*)g0::tensor_data15, (TfLiteIntArray*)&g0::tensor_dimension9, 1536, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant15))}, },
-{ kTfLiteMmapRo, kTfLiteInt32, (int32_t*)g0::tensor_data16, (TfLiteIntArray*)&g0::tensor_dimension6, 384, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant16))}, },
-{ kTfLiteMmapRo, kTfLiteInt8, (int32_t*)g0::tensor_data17, (TfLiteIntArray*)&g0::tensor_dimension11, 864, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant17))}, },
-{ kTfLiteMmapRo, kTfLiteInt32, (int32_t*)g0::tensor_data18, (TfLiteIntArray*)&g0::tensor_dimension6, 384, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant18))}, },
-{ kTfLiteMmapRo, kTfLiteInt8, (int32_t*)g0::tensor_data19, (TfLiteIntArray*)&g0::tensor_dimension7, 1536, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant19))}, },
-{ kTfLiteMmapRo, kTfLiteInt32, (int32_t*)g0::tensor_data20, (TfLiteIntArray*)&g0::tensor_dimension8, 64, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant20))}, },
-{ kTfLiteMmapRo, kTfLiteInt8, (int32_t*)g0::tensor_data21, (TfLiteIntArray*)&g0::tensor_dimension21, 768, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant21))}, },
-{ kTfLiteMmapRo, kTfLiteInt32, (int32_t*)g0::tensor_data22, (TfLiteIntArray*)&g0::tensor_dimension22, 192, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant22))}, },
-{ kTfLiteMmapRo, kTfLiteInt8, (int32_t*)g0::tensor_data23, (TfLiteIntArray*)&g0::tensor_dimension23, 432, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant23))}, },
-{ kTfLiteMmapRo, kTfLiteInt32, (int32_t*)g0::tensor_data24, (TfLiteIntArray*)&g0::tensor_dimension22, 192, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant24))}, },
-{ kTfLiteMmapRo, kTfLiteInt8, (int32_t*)g0::tensor_data25, (TfLiteIntArray*)&g0::tensor_dimension25, 384, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant25))}, },
-{ kTfLiteMmapRo, kTfLiteInt32, (int32_t*)g0::tensor_data26, (TfLiteIntArray*)&g0::tensor_dimension26, 32, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant26))}, },
-{ kTfLiteMmapRo, kTfLiteInt8, (int32_t*)g0::tensor_data27, (TfLiteIntArray*)&g0::tensor_dimension27, 384, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant27))}, },
-{ kTfLiteMmapRo, kTfLiteInt32, (int32_t*)g0::tensor_data28, (TfLiteIntArray*)&g0::tensor_dimension22, 192, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant28))}, },
-{ kTfLiteMmapRo, kTfLiteInt8, (int32_t*)g0::tensor_data29, (TfLiteIntArray*)&g0::tensor_dimension23, 432, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant29))}, },
-{ kTfLiteMmapRo, kTfLiteInt32, (int32_t*)g0::tensor_data30, (TfLiteIntArray*)&g0::tensor_dimension22, 192, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant30))}, },
-{ kTfLiteMmapRo, kTfLiteInt8, (int32_t*)g0::tensor_data31, (TfLiteIntArray*)&g0::tensor_dimension25, 384, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant31))}, },
-{ kTfLiteMmapRo, kTfLiteInt32, (int32_t*)g0::tensor_data32, (TfLiteIntArray*)&g0::tensor_dimension26, 32, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant32))}, },
-{ kTfLiteMmapRo, kTfLiteInt8, (int32_t*)g0::tensor_data33, (TfLiteIntArray*)&g0::tensor_dimension27, 384, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant33))}, },
-{ kTfLiteMmapRo, kTfLiteInt32, (int32_t*)g0::tensor_data34, (TfLiteIntArray*)&g0::tensor_dimension22, 192, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant34))}, },
-{ kTfLiteMmapRo, kTfLiteInt8, (int32_t*)g0::tensor_data35, (TfLiteIntArray*)&g0::tensor_dimension23, 432, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant35))}, },
-{ kTfLiteMmapRo, kTfLiteInt32, (int32_t*)g0::tensor_data36, (TfLiteIntArray*)&g0::tensor_dimension22, 192, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant36))}, },
-{ kTfLiteMmapRo, kTfLiteInt8, (int32_t*)g0::tensor_data37, (TfLiteIntArray*)&g0::tensor_dimension25, 384, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant37))}, },
-{ kTfLiteMmapRo, kTfLiteInt32, (int32_t*)g0::tensor_data38, (TfLiteIntArray*)&g0::tensor_dimension26, 32, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant38))}, },
-{ kTfLiteMmapRo, kTfLiteInt8, (int32_t*)g0::tensor_data39, (TfLiteIntArray*)&g0::tensor_dimension39, 128, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant39))}, },
-{ kTfLiteMmapRo, kTfLiteInt32, (int32_t*)g0::tensor_data40, (TfLiteIntArray*)&g0::tensor_dimension8, 64, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant40))}, },
-{ kTfLiteMmapRo, kTfLiteInt8, (int32_t*)g0::tensor_data41, (TfLiteIntArray*)&g0::tensor_dimension41, 144, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant41))}, },
-{ kTfLiteMmapRo, kTfLiteInt32, (int32_t*)g0::tensor_data42, (TfLiteIntArray*)&g0::tensor_dimension8, 64, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant42))}, },
-{ kTfLiteMmapRo, kTfLiteInt8, (int32_t*)g0::tensor_data43, (TfLiteIntArray*)&g0::tensor_dimension43, 144, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant43))}, },
+{ kTfLiteMmapRo, kTfLiteInt32, (int32_t*)WEIGHTS_DATA(g0::tensor_data1), (TfLiteIntArray*)&g0::tensor_dimension1, 32, {kTfLiteNoQuantization, nullptr}, },
+{ kTfLiteMmapRo, kTfLiteInt32, (int32_t*)WEIGHTS_DATA(g0::tensor_data2), (TfLiteIntArray*)&g0::tensor_dimension2, 28, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant2))}, },
+{ kTfLiteMmapRo, kTfLiteInt8, (int32_t*)WEIGHTS_DATA(g0::tensor_data3), (TfLiteIntArray*)&g0::tensor_dimension3, 224, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant3))}, },
+{ kTfLiteMmapRo, kTfLiteInt32, (int32_t*)WEIGHTS_DATA(g0::tensor_data4), (TfLiteIntArray*)&g0::tensor_dimension4, 128, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant4))}, },
+{ kTfLiteMmapRo, kTfLiteInt8, (int32_t*)WEIGHTS_DATA(g0::tensor_data5), (TfLiteIntArray*)&g0::tensor_dimension5, 3072, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant5))}, },
+{ kTfLiteMmapRo, kTfLiteInt32, (int32_t*)WEIGHTS_DATA(g0::tensor_data6), (TfLiteIntArray*)&g0::tensor_dimension6, 384, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant6))}, },
+{ kTfLiteMmapRo, kTfLiteInt8, (int32_t*)WEIGHTS_DATA(g0::tensor_data7), (TfLiteIntArray*)&g0::tensor_dimension7, 1536, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant7))}, },
+{ kTfLiteMmapRo, kTfLiteInt32, (int32_t*)WEIGHTS_DATA(g0::tensor_data8), (TfLiteIntArray*)&g0::tensor_dimension8, 64, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant8))}, },
+{ kTfLiteMmapRo, kTfLiteInt8, (int32_t*)WEIGHTS_DATA(g0::tensor_data9), (TfLiteIntArray*)&g0::tensor_dimension9, 1536, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant9))}, },
+{ kTfLiteMmapRo, kTfLiteInt32, (int32_t*)WEIGHTS_DATA(g0::tensor_data10), (TfLiteIntArray*)&g0::tensor_dimension6, 384, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant10))}, },
+{ kTfLiteMmapRo, kTfLiteInt8, (int32_t*)WEIGHTS_DATA(g0::tensor_data11), (TfLiteIntArray*)&g0::tensor_dimension11, 864, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant11))}, },
+{ kTfLiteMmapRo, kTfLiteInt32, (int32_t*)WEIGHTS_DATA(g0::tensor_data12), (TfLiteIntArray*)&g0::tensor_dimension6, 384, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant12))}, },
+{ kTfLiteMmapRo, kTfLiteInt8, (int32_t*)WEIGHTS_DATA(g0::tensor_data13), (TfLiteIntArray*)&g0::tensor_dimension7, 1536, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant13))}, },
+{ kTfLiteMmapRo, kTfLiteInt32, (int32_t*)WEIGHTS_DATA(g0::tensor_data14), (TfLiteIntArray*)&g0::tensor_dimension8, 64, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant14))}, },
+{ kTfLiteMmapRo, kTfLiteInt8, (int32_t*)WEIGHTS_DATA(g0::tensor_data15), (TfLiteIntArray*)&g0::tensor_dimension9, 1536, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant15))}, },
+{ kTfLiteMmapRo, kTfLiteInt32, (int32_t*)WEIGHTS_DATA(g0::tensor_data16), (TfLiteIntArray*)&g0::tensor_dimension6, 384, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant16))}, },
+{ kTfLiteMmapRo, kTfLiteInt8, (int32_t*)WEIGHTS_DATA(g0::tensor_data17), (TfLiteIntArray*)&g0::tensor_dimension11, 864, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant17))}, },
+{ kTfLiteMmapRo, kTfLiteInt32, (int32_t*)WEIGHTS_DATA(g0::tensor_data18), (TfLiteIntArray*)&g0::tensor_dimension6, 384, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant18))}, },
+{ kTfLiteMmapRo, kTfLiteInt8, (int32_t*)WEIGHTS_DATA(g0::tensor_data19), (TfLiteIntArray*)&g0::tensor_dimension7, 1536, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant19))}, },
+{ kTfLiteMmapRo, kTfLiteInt32, (int32_t*)WEIGHTS_DATA(g0::tensor_data20), (TfLiteIntArray*)&g0::tensor_dimension8, 64, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant20))}, },
+{ kTfLiteMmapRo, kTfLiteInt8, (int32_t*)WEIGHTS_DATA(g0::tensor_data21), (TfLiteIntArray*)&g0::tensor_dimension21, 768, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant21))}, },
+{ kTfLiteMmapRo, kTfLiteInt32, (int32_t*)WEIGHTS_DATA(g0::tensor_data22), (TfLiteIntArray*)&g0::tensor_dimension22, 192, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant22))}, },
+{ kTfLiteMmapRo, kTfLiteInt8, (int32_t*)WEIGHTS_DATA(g0::tensor_data23), (TfLiteIntArray*)&g0::tensor_dimension23, 432, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant23))}, },
+{ kTfLiteMmapRo, kTfLiteInt32, (int32_t*)WEIGHTS_DATA(g0::tensor_data24), (TfLiteIntArray*)&g0::tensor_dimension22, 192, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant24))}, },
+{ kTfLiteMmapRo, kTfLiteInt8, (int32_t*)WEIGHTS_DATA(g0::tensor_data25), (TfLiteIntArray*)&g0::tensor_dimension25, 384, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant25))}, },
+{ kTfLiteMmapRo, kTfLiteInt32, (int32_t*)WEIGHTS_DATA(g0::tensor_data26), (TfLiteIntArray*)&g0::tensor_dimension26, 32, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant26))}, },
+{ kTfLiteMmapRo, kTfLiteInt8, (int32_t*)WEIGHTS_DATA(g0::tensor_data27), (TfLiteIntArray*)&g0::tensor_dimension27, 384, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant27))}, },
+{ kTfLiteMmapRo, kTfLiteInt32, (int32_t*)WEIGHTS_DATA(g0::tensor_data28), (TfLiteIntArray*)&g0::tensor_dimension22, 192, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant28))}, },
+{ kTfLiteMmapRo, kTfLiteInt8, (int32_t*)WEIGHTS_DATA(g0::tensor_data29), (TfLiteIntArray*)&g0::tensor_dimension23, 432, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant29))}, },
+{ kTfLiteMmapRo, kTfLiteInt32, (int32_t*)WEIGHTS_DATA(g0::tensor_data30), (TfLiteIntArray*)&g0::tensor_dimension22, 192, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant30))}, },
+{ kTfLiteMmapRo, kTfLiteInt8, (int32_t*)WEIGHTS_DATA(g0::tensor_data31), (TfLiteIntArray*)&g0::tensor_dimension25, 384, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant31))}, },
+{ kTfLiteMmapRo, kTfLiteInt32, (int32_t*)WEIGHTS_DATA(g0::tensor_data32), (TfLiteIntArray*)&g0::tensor_dimension26, 32, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant32))}, },
+{ kTfLiteMmapRo, kTfLiteInt8, (int32_t*)WEIGHTS_DATA(g0::tensor_data33), (TfLiteIntArray*)&g0::tensor_dimension27, 384, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant33))}, },
+{ kTfLiteMmapRo, kTfLiteInt32, (int32_t*)WEIGHTS_DATA(g0::tensor_data34), (TfLiteIntArray*)&g0::tensor_dimension22, 192, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant34))}, },
+{ kTfLiteMmapRo, kTfLiteInt8, (int32_t*)WEIGHTS_DATA(g0::tensor_data35), (TfLiteIntArray*)&g0::tensor_dimension23, 432, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant35))}, },
+{ kTfLiteMmapRo, kTfLiteInt32, (int32_t*)WEIGHTS_DATA(g0::tensor_data36), (TfLiteIntArray*)&g0::tensor_dimension22, 192, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant36))}, },
+{ kTfLiteMmapRo, kTfLiteInt8, (int32_t*)WEIGHTS_DATA(g0::tensor_data37), (TfLiteIntArray*)&g0::tensor_dimension25, 384, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant37))}, },
+{ kTfLiteMmapRo, kTfLiteInt32, (int32_t*)WEIGHTS_DATA(g0::tensor_data38), (TfLiteIntArray*)&g0::tensor_dimension26, 32, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant38))}, },
+{ kTfLiteMmapRo, kTfLiteInt8, (int32_t*)WEIGHTS_DATA(g0::tensor_data39), (TfLiteIntArray*)&g0::tensor_dimension39, 128, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant39))}, },
+{ kTfLiteMmapRo, kTfLiteInt32, (int32_t*)WEIGHTS_DATA(g0::tensor_data40), (TfLiteIntArray*)&g0::tensor_dimension8, 64, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant40))}, },
+{ kTfLiteMmapRo, kTfLiteInt8, (int32_t*)WEIGHTS_DATA(g0::tensor_data41), (TfLiteIntArray*)&g0::tensor_dimension41, 144, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant41))}, },
+{ kTfLiteMmapRo, kTfLiteInt32, (int32_t*)WEIGHTS_DATA(g0::tensor_data42), (TfLiteIntArray*)&g0::tensor_dimension8, 64, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant42))}, },
+{ kTfLiteMmapRo, kTfLiteInt8, (int32_t*)WEIGHTS_DATA(g0::tensor_data43), (TfLiteIntArray*)&g0::tensor_dimension43, 144, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant43))}, },
 { kTfLiteArenaRw, kTfLiteInt8, (int32_t*)(tensor_arena + 36864), (TfLiteIntArray*)&g0::tensor_dimension44, 36864, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant44))}, },
 { kTfLiteArenaRw, kTfLiteInt8, (int32_t*)(tensor_arena + 0), (TfLiteIntArray*)&g0::tensor_dimension44, 36864, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant44))}, },
 { kTfLiteArenaRw, kTfLiteInt8, (int32_t*)(tensor_arena + 36864), (TfLiteIntArray*)&g0::tensor_dimension46, 18432, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant46))}, },
@@ -1149,6 +1299,26 @@ TensorInfo_t tensorData[] = {
 { kTfLiteArenaRw, kTfLiteInt8, (int32_t*)(tensor_arena + 0), (TfLiteIntArray*)&g0::tensor_dimension69, 1008, {kTfLiteAffineQuantization, const_cast<void*>(static_cast<const void*>(&g0::quant70))}, },
 };
 
+// constant tensors, in the order tflite_learn_891896_6_weights lists them
+static const int16_t weights_tensors[43] = {
+  1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16,
+  17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32,
+  33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43
+};
+static const void* const weights_builtin[43] = {
+  WEIGHTS_DATA(g0::tensor_data1), WEIGHTS_DATA(g0::tensor_data2), WEIGHTS_DATA(g0::tensor_data3), WEIGHTS_DATA(g0::tensor_data4),
+  WEIGHTS_DATA(g0::tensor_data5), WEIGHTS_DATA(g0::tensor_data6), WEIGHTS_DATA(g0::tensor_data7), WEIGHTS_DATA(g0::tensor_data8),
+  WEIGHTS_DATA(g0::tensor_data9), WEIGHTS_DATA(g0::tensor_data10), WEIGHTS_DATA(g0::tensor_data11), WEIGHTS_DATA(g0::tensor_data12),
+  WEIGHTS_DATA(g0::tensor_data13), WEIGHTS_DATA(g0::tensor_data14), WEIGHTS_DATA(g0::tensor_data15), WEIGHTS_DATA(g0::tensor_data16),
+  WEIGHTS_DATA(g0::tensor_data17), WEIGHTS_DATA(g0::tensor_data18), WEIGHTS_DATA(g0::tensor_data19), WEIGHTS_DATA(g0::tensor_data20),
+  WEIGHTS_DATA(g0::tensor_data21), WEIGHTS_DATA(g0::tensor_data22), WEIGHTS_DATA(g0::tensor_data23), WEIGHTS_DATA(g0::tensor_data24),
+  WEIGHTS_DATA(g0::tensor_data25), WEIGHTS_DATA(g0::tensor_data26), WEIGHTS_DATA(g0::tensor_data27), WEIGHTS_DATA(g0::tensor_data28),
+  WEIGHTS_DATA(g0::tensor_data29), WEIGHTS_DATA(g0::tensor_data30), WEIGHTS_DATA(g0::tensor_data31), WEIGHTS_DATA(g0::tensor_data32),
+  WEIGHTS_DATA(g0::tensor_data33), WEIGHTS_DATA(g0::tensor_data34), WEIGHTS_DATA(g0::tensor_data35), WEIGHTS_DATA(g0::tensor_data36),
+  WEIGHTS_DATA(g0::tensor_data37), WEIGHTS_DATA(g0::tensor_data38), WEIGHTS_DATA(g0::tensor_data39), WEIGHTS_DATA(g0::tensor_data40),
+  WEIGHTS_DATA(g0::tensor_data41), WEIGHTS_DATA(g0::tensor_data42), WEIGHTS_DATA(g0::tensor_data43)
+};
+
 #ifndef TF_LITE_STATIC_MEMORY
 TfLiteNode tflNodes[27] = {
 { (TfLiteIntArray*)&g0::inputs0, (TfLiteIntArray*)&g0::outputs0, (TfLiteIntArray*)&g0::inputs0, nullptr, nullptr, const_cast<void*>(static_cast<const void*>(&g0::opdata0)), nullptr, 0, },
@@ -1215,6 +1385,42 @@ used_operators_e used_ops[] =
 {OP_CONV_2D, OP_DEPTHWISE_CONV_2D, OP_CONV_2D, OP_CONV_2D, OP_PAD, OP_DEPTHWISE_CONV_2D, OP_CONV_2D, OP_CONV_2D, OP_DEPTHWISE_CONV_2D, OP_CONV_2D, OP_ADD, OP_CONV_2D, OP_PAD, OP_DEPTHWISE_CONV_2D, OP_CONV_2D, OP_CONV_2D, OP_DEPTHWISE_CONV_2D, OP_CONV_2D, OP_ADD, OP_CONV_2D, OP_DEPTHWISE_CONV_2D, OP_CONV_2D, OP_ADD, OP_CONV_2D, OP_CONV_2D, OP_CONV_2D, OP_SOFTMAX, };
 
 
+#if EI_CLASSIFIER_TFLITE_FIXED_SHAPE_KERNELS == 1
+namespace fixed = tflite::ei_fixed;
+// Kernels instantiated for the shape of every node, { nullptr, nullptr } runs the generic kernel
+const fixed::Kernel fixed_kernels[27] = {
+  { &fixed::SetupConv, &fixed::Conv<3, 3, 1, 16, 2, 96, 48> },
+  { &fixed::SetupDepthwiseConv, &fixed::DepthwiseConv<3, 3, 16, 1, 48, 48> },
+  { &fixed::SetupConv, &fixed::PointwiseConv<16, 8> },
+  { &fixed::SetupConv, &fixed::PointwiseConv<8, 48> },
+  { nullptr, nullptr },
+  { &fixed::SetupDepthwiseConv, &fixed::DepthwiseConv<3, 3, 48, 2, 49, 24> },
+  { &fixed::SetupConv, &fixed::PointwiseConv<48, 8> },
+  { &fixed::SetupConv, &fixed::PointwiseConv<8, 48> },
+  { &fixed::SetupDepthwiseConv, &fixed::DepthwiseConv<3, 3, 48, 1, 24, 24> },
+  { &fixed::SetupConv, &fixed::PointwiseConv<48, 8> },
+  { &fixed::SetupAdd, &fixed::Add<4608> },
+  { &fixed::SetupConv, &fixed::PointwiseConv<8, 48> },
+  { nullptr, nullptr },
+  { &fixed::SetupDepthwiseConv, &fixed::DepthwiseConv<3, 3, 48, 2, 25, 12> },
+  { &fixed::SetupConv, &fixed::PointwiseConv<48, 16> },
+  { &fixed::SetupConv, &fixed::PointwiseConv<16, 96> },
+  { &fixed::SetupDepthwiseConv, &fixed::DepthwiseConv<3, 3, 96, 1, 12, 12> },
+  { &fixed::SetupConv, &fixed::PointwiseConv<96, 16> },
+  { &fixed::SetupAdd, &fixed::Add<2304> },
+  { &fixed::SetupConv, &fixed::PointwiseConv<16, 96> },
+  { &fixed::SetupDepthwiseConv, &fixed::DepthwiseConv<3, 3, 96, 1, 12, 12> },
+  { &fixed::SetupConv, &fixed::PointwiseConv<96, 16> },
+  { &fixed::SetupAdd, &fixed::Add<2304> },
+  { &fixed::SetupConv, &fixed::PointwiseConv<16, 96> },
+  { &fixed::SetupConv, &fixed::PointwiseConv<96, 32> },
+  { &fixed::SetupConv, &fixed::PointwiseConv<32, 7> },
+  { nullptr, nullptr },
+};
+// quantization parameters of the fixed shape kernels, in the persistent part of the arena
+void* fixed_kernel_data[27];
+#endif // EI_CLASSIFIER_TFLITE_FIXED_SHAPE_KERNELS
+
 // Indices into tflTensors and tflNodes for subgraphs
 const size_t tflTensors_subgraph_index[] = {0, 71, };
 const size_t tflNodes_subgraph_index[] = {0, 27, };
@@ -1231,6 +1437,295 @@ static const int out_tensor_indices[] = {
 
 size_t current_subgraph_index = 0;
 
+#if defined(EI_CLASSIFIER_ALLOCATION_HEAP)
+static uintptr_t tensor_offset(size_t i) {
+  if (memory_plan) {
+    return memory_plan->tensor_offsets[i];
+  }
+  return (uintptr_t)tensorData[i].data;
+}
+
+// Patch-based execution of the first layers (see tflite_learn_891896_6_patch_stage). The stage
+// output is computed in bands of rows, every band pulls the rows it needs through the whole
+// chain of nodes, so the intermediate tensors of the stage only ever hold one tile.
+typedef struct {
+  int start;
+  int end;
+} row_range_t;
+
+static ei_patch_stage_t patch_stage;
+static bool patch_stage_searched = false;
+
+// views on a tile, handed to the kernels by GetEvalTensor while the stage runs
+typedef struct {
+  int index;
+  uint8_t* data;
+  TfArray<4, int> dims;
+} patch_view_t;
+static patch_view_t patch_views[2];
+static size_t patch_views_count = 0;
+
+static void patch_find_stage();
+static size_t patch_tile_bytes(const ei_patch_stage_t *stage, int tile_rows, uint32_t *tile_bytes);
+
+static bool patch_tiled() {
+  if (!memory_plan || memory_plan->patch_tile_rows == 0) {
+    return false;
+  }
+  // plans compiled into the model only carry the tile size, the stage is found on first use
+  if (!patch_stage_searched) {
+    patch_find_stage();
+  }
+  if (patch_stage.first_node < 0 || memory_plan->patch_tile_rows >= patch_stage.out_height) {
+    return false;
+  }
+  if (patch_stage.tile_rows != memory_plan->patch_tile_rows) {
+    patch_stage.tile_rows = (uint16_t)memory_plan->patch_tile_rows;
+    patch_tile_bytes(&patch_stage, patch_stage.tile_rows, patch_stage.tile_bytes);
+  }
+  return true;
+}
+
+static size_t tensor_row_bytes(int i) {
+  return tensorData[i].bytes / tensorData[i].dims->data[1];
+}
+
+// index of an intermediate tensor of the stage, -1 for the stage input/output and all other tensors
+static int patch_intermediate(int i) {
+  for (int k = 0; k < patch_stage.last_node - patch_stage.first_node; k++) {
+    if (patch_stage.tensors[k] == i) {
+      return k;
+    }
+  }
+  return -1;
+}
+
+static void patch_conv_params(size_t node, int *stride, int *dilation, TfLitePadding *padding) {
+  if (used_ops[node] == OP_CONV_2D) {
+    const TfLiteConvParams *params = (const TfLiteConvParams*)tflNodes[node].builtin_data;
+    *stride = params->stride_height;
+    *dilation = params->dilation_height_factor;
+    *padding = params->padding;
+  }
+  else {
+    const TfLiteDepthwiseConvParams *params = (const TfLiteDepthwiseConvParams*)tflNodes[node].builtin_data;
+    *stride = params->stride_height;
+    *dilation = params->dilation_height_factor;
+    *padding = params->padding;
+  }
+}
+
+// rows of the activation input of a node that are needed to compute rows `out` of its output
+static row_range_t patch_input_rows(size_t node, row_range_t out) {
+  const TfLiteIntArray *inputs = tflNodes[node].inputs;
+  const int in_height = tensorData[inputs->data[0]].dims->data[1];
+  row_range_t in = { 0, 0 };
+  if (out.start >= out.end) {
+    return in;
+  }
+
+  if (used_ops[node] == OP_PAD) {
+    const int32_t *paddings = (const int32_t*)tensorData[inputs->data[1]].data;
+    in.start = out.start - paddings[2];
+    in.end = out.end - paddings[2];
+  }
+  else {
+    int stride, dilation;
+    TfLitePadding padding;
+    patch_conv_params(node, &stride, &dilation, &padding);
+    const int filter_height = tensorData[inputs->data[1]].dims->data[1];
+    in.start = out.start * stride;
+    in.end = (out.end - 1) * stride + (filter_height - 1) * dilation + 1;
+  }
+
+  in.start = in.start < 0 ? 0 : in.start;
+  in.end = in.end > in_height ? in_height : in.end;
+  if (in.start >= in.end) {
+    in.start = in.end = 0;
+  }
+  return in;
+}
+
+static bool patch_tensor_tileable(int i) {
+  const TfLiteIntArray *dims = tensorData[i].dims;
+  return tensorData[i].allocation_type == kTfLiteArenaRw && tensorData[i].type == kTfLiteInt8 &&
+    dims->size == 4 && dims->data[0] == 1;
+}
+
+static bool patch_node_tileable(size_t node) {
+  const TfLiteIntArray *inputs = tflNodes[node].inputs;
+  const TfLiteIntArray *outputs = tflNodes[node].outputs;
+  if (inputs->size < 2 || outputs->size != 1 ||
+      !patch_tensor_tileable(inputs->data[0]) || !patch_tensor_tileable(outputs->data[0])) {
+    return false;
+  }
+  // weights, bias and paddings, everything but the activation has to be constant
+  for (int ix = 1; ix < inputs->size; ix++) {
+    if (inputs->data[ix] >= 0 && tensorData[inputs->data[ix]].allocation_type != kTfLiteMmapRo) {
+      return false;
+    }
+  }
+
+  if (used_ops[node] == OP_PAD) {
+    const int32_t *paddings = (const int32_t*)tensorData[inputs->data[1]].data;
+    return paddings[0] == 0 && paddings[1] == 0;
+  }
+  if (used_ops[node] == OP_CONV_2D || used_ops[node] == OP_DEPTHWISE_CONV_2D) {
+    int stride, dilation;
+    TfLitePadding padding;
+    patch_conv_params(node, &stride, &dilation, &padding);
+    if (padding != kTfLitePaddingSame) {
+      return true;
+    }
+    // tiles start at a row of the input, so the kernel must not pad at the top
+    const int in_height = tensorData[inputs->data[0]].dims->data[1];
+    const int out_height = tensorData[outputs->data[0]].dims->data[1];
+    const int filter_height = tensorData[inputs->data[1]].dims->data[1];
+    const int total_padding = (out_height - 1) * stride + (filter_height - 1) * dilation + 1 - in_height;
+    return total_padding / 2 <= 0;
+  }
+  return false;
+}
+
+static bool patch_chain_valid(size_t first, size_t last) {
+  for (size_t node = first; node <= last; node++) {
+    if (!patch_node_tileable(node)) {
+      return false;
+    }
+    if (node == first) {
+      continue;
+    }
+    // every intermediate is written by the previous node and only read by this one
+    const int t = tflNodes[node - 1].outputs->data[0];
+    if (tflNodes[node].inputs->data[0] != t || t == out_tensor_indices[0]) {
+      return false;
+    }
+    for (size_t n = 0; n < 27; n++) {
+      const TfLiteIntArray *inputs = tflNodes[n].inputs;
+      for (int ix = 0; ix < inputs->size; ix++) {
+        if (n != node && inputs->data[ix] == t) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+// bytes of the stage when the intermediates only hold a tile of `tile_rows` output rows
+static size_t patch_tile_bytes(const ei_patch_stage_t *stage, int tile_rows, uint32_t *tile_bytes) {
+  const int n = stage->last_node - stage->first_node + 1;
+  for (int k = 0; k < n - 1; k++) {
+    tile_bytes[k] = 0;
+  }
+  for (int start = 0; start < stage->out_height; start += tile_rows) {
+    row_range_t rows = { start, start + tile_rows < stage->out_height ? start + tile_rows : stage->out_height };
+    for (int k = n - 1; k > 0; k--) {
+      rows = patch_input_rows(stage->first_node + k, rows);
+      uint32_t bytes = (rows.end - rows.start) * tensor_row_bytes(stage->tensors[k - 1]);
+      if (bytes > tile_bytes[k - 1]) {
+        tile_bytes[k - 1] = bytes;
+      }
+    }
+  }
+
+  size_t total = tensorData[stage->input_tensor].bytes + tensorData[stage->tensors[n - 1]].bytes;
+  for (int k = 0; k < n - 1; k++) {
+    total += tile_bytes[k];
+  }
+  return total;
+}
+
+// The stage is a chain of tileable nodes around the node with the most live activations,
+// the one whose input, output and one-row tiles take the least memory.
+static void patch_find_stage() {
+  patch_stage_searched = true;
+  memset(&patch_stage, 0, sizeof(patch_stage));
+  patch_stage.first_node = -1;
+
+  int16_t first_use[71];
+  int16_t last_use[71];
+  for (size_t i = 0; i < 71; i++) {
+    first_use[i] = -1;
+    last_use[i] = -1;
+  }
+  for (size_t n = 0; n < 27; n++) {
+    const TfLiteIntArray *arrays[] = { tflNodes[n].inputs, tflNodes[n].outputs };
+    for (size_t a = 0; a < 2; a++) {
+      for (int ix = 0; ix < arrays[a]->size; ix++) {
+        int t = arrays[a]->data[ix];
+        if (t < 0) {
+          continue;
+        }
+        if (first_use[t] < 0) {
+          first_use[t] = (int16_t)n;
+        }
+        last_use[t] = (int16_t)n;
+      }
+    }
+  }
+
+  int peak_node = -1;
+  size_t peak_bytes = 0;
+  for (int n = 0; n < 27; n++) {
+    size_t live_bytes = 0;
+    for (size_t i = 0; i < 71; i++) {
+      if (tensorData[i].allocation_type == kTfLiteArenaRw && first_use[i] <= n && n <= last_use[i]) {
+        live_bytes += tensorData[i].bytes;
+      }
+    }
+    if (live_bytes > peak_bytes) {
+      peak_bytes = live_bytes;
+      peak_node = n;
+    }
+  }
+
+  size_t best_bytes = 0;
+  for (int first = peak_node - EI_MAX_PATCH_NODES + 2; first < peak_node; first++) {
+    for (int last = peak_node + 1; last < 27 && last - first < EI_MAX_PATCH_NODES; last++) {
+      if (first < 0 || !patch_chain_valid(first, last)) {
+        continue;
+      }
+      ei_patch_stage_t stage;
+      memset(&stage, 0, sizeof(stage));
+      stage.first_node = first;
+      stage.last_node = last;
+      stage.input_tensor = tflNodes[first].inputs->data[0];
+      for (int node = first; node <= last; node++) {
+        stage.tensors[node - first] = tflNodes[node].outputs->data[0];
+      }
+      stage.out_height = tensorData[stage.tensors[last - first]].dims->data[1];
+      size_t bytes = patch_tile_bytes(&stage, 1, stage.tile_bytes);
+      if (patch_stage.first_node < 0 || bytes < best_bytes) {
+        best_bytes = bytes;
+        patch_stage = stage;
+      }
+    }
+  }
+
+  if (patch_stage.first_node >= 0) {
+    const int n = patch_stage.last_node - patch_stage.first_node + 1;
+    patch_stage.untiled_bytes = tensorData[patch_stage.input_tensor].bytes;
+    for (int k = 0; k < n; k++) {
+      patch_stage.untiled_bytes += tensorData[patch_stage.tensors[k]].bytes;
+    }
+  }
+}
+#endif // EI_CLASSIFIER_ALLOCATION_HEAP
+
+// bytes the arena layout reserves for a tensor, intermediates of a tiled stage only hold one tile
+static size_t tensor_bytes(int i) {
+#if defined(EI_CLASSIFIER_ALLOCATION_HEAP)
+  if (patch_tiled()) {
+    int k = patch_intermediate(i);
+    if (k >= 0) {
+      return patch_stage.tile_bytes[k];
+    }
+  }
+#endif // EI_CLASSIFIER_ALLOCATION_HEAP
+  return tensorData[i].bytes;
+}
+
 static void init_tflite_tensor(size_t i, TfLiteTensor *tensor) {
   tensor->type = tensorData[i].type;
   tensor->is_variable = false;
@@ -1245,7 +1740,7 @@ static void init_tflite_tensor(size_t i, TfLiteTensor *tensor) {
 
 #if defined(EI_CLASSIFIER_ALLOCATION_HEAP)
   if(tensor->allocation_type == kTfLiteArenaRw){
-    uint8_t* start = (uint8_t*) ((uintptr_t)tensorData[i].data + (uintptr_t) tensor_arena);
+    uint8_t* start = arena_ptr(tensor_offset(i));
 
     tensor->data.data =  start;
   }
@@ -1268,12 +1763,22 @@ static void init_tflite_eval_tensor(int i, TfLiteEvalTensor *tensor) {
 
   tensor->type = tensorData[i].type;
 
+#if defined(EI_CLASSIFIER_ALLOCATION_HEAP)
+  for (size_t ix = 0; ix < patch_views_count; ix++) {
+    if (patch_views[ix].index == i) {
+      tensor->dims = (TfLiteIntArray*)&patch_views[ix].dims;
+      tensor->data.data = patch_views[ix].data;
+      return;
+    }
+  }
+#endif // EI_CLASSIFIER_ALLOCATION_HEAP
+
   tensor->dims = tensorData[i].dims;
 
 #if defined(EI_CLASSIFIER_ALLOCATION_HEAP)
   auto allocation_type = tensorData[i].allocation_type;
   if(allocation_type == kTfLiteArenaRw) {
-    uint8_t* start = (uint8_t*) ((uintptr_t)tensorData[i].data + (uintptr_t) tensor_arena);
+    uint8_t* start = arena_ptr(tensor_offset(i));
 
     tensor->data.data =  start;
   }
@@ -1287,8 +1792,7 @@ static void init_tflite_eval_tensor(int i, TfLiteEvalTensor *tensor) {
 
 static void* overflow_buffers[EI_MAX_OVERFLOW_BUFFER_COUNT];
 static size_t overflow_buffers_ix = 0;
-static void * AllocatePersistentBufferImpl(struct TfLiteContext* ctx,
-                                       size_t bytes) {
+static void * AllocateFromArenaTop(size_t bytes) {
   void *ptr;
   uint32_t align_bytes = (bytes % 16) ? 16 - (bytes % 16) : 0;
 
@@ -1322,6 +1826,19 @@ static void * AllocatePersistentBufferImpl(struct TfLiteContext* ctx,
   return ptr;
 }
 
+// node being prepared, scratch buffer requests are attributed to it
+static int16_t current_node = -1;
+// what the kernels asked for during the last init, used to compute a memory plan
+static size_t persistent_bytes_requested = 0;
+static ei_scratch_buffer_plan_t scratch_requests[EI_MAX_SCRATCH_BUFFER_COUNT];
+static size_t scratch_requests_count = 0;
+
+static void * AllocatePersistentBufferImpl(struct TfLiteContext* ctx,
+                                       size_t bytes) {
+  persistent_bytes_requested += (bytes + 15) & ~(size_t)15;
+  return AllocateFromArenaTop(bytes);
+}
+
 typedef struct {
   size_t bytes;
   void *ptr;
@@ -1341,7 +1858,22 @@ static TfLiteStatus RequestScratchBufferInArenaImpl(struct TfLiteContext* ctx, s
   scratch_buffer_t b;
   b.bytes = bytes;
 
-  b.ptr = AllocatePersistentBufferImpl(ctx, b.bytes);
+  scratch_requests[scratch_buffers_ix].node = current_node;
+  scratch_requests[scratch_buffers_ix].bytes = bytes;
+  scratch_requests[scratch_buffers_ix].offset = 0;
+
+#if defined(EI_CLASSIFIER_ALLOCATION_HEAP)
+  // planned scratch buffers share the arena with activations that are not live during this node
+  if (memory_plan && scratch_buffers_ix < memory_plan->scratch_count &&
+      memory_plan->scratch[scratch_buffers_ix].node == current_node &&
+      memory_plan->scratch[scratch_buffers_ix].bytes >= bytes) {
+    b.ptr = arena_ptr(memory_plan->scratch[scratch_buffers_ix].offset);
+  }
+  else
+#endif // EI_CLASSIFIER_ALLOCATION_HEAP
+  {
+    b.ptr = AllocateFromArenaTop(b.bytes);
+  }
   if (!b.ptr) {
     ei_printf("ERR: Failed to allocate scratch buffer of size %d\n",
       (int)bytes);
@@ -1456,21 +1988,155 @@ class EonMicroContext : public MicroContext {
 
 };
 
+static TfLiteStatus invoke_node(size_t i) {
+#if EI_CLASSIFIER_TFLITE_FIXED_SHAPE_KERNELS == 1
+  if (fixed_kernel_data[i] && fixed_kernels[i].invoke(&ctx, &tflNodes[i], fixed_kernel_data[i])) {
+    return kTfLiteOk;
+  }
+#endif
+  return registrations[used_ops[i]].invoke(&ctx, &tflNodes[i]);
+}
+
+#if defined(EI_CLASSIFIER_ALLOCATION_HEAP)
+static void patch_set_view(patch_view_t *view, int index, uint8_t *data, int rows) {
+  const TfLiteIntArray *dims = tensorData[index].dims;
+  view->index = index;
+  view->data = data;
+  view->dims.sz = 4;
+  for (int ix = 0; ix < 4; ix++) {
+    view->dims.elem[ix] = dims->data[ix];
+  }
+  view->dims.elem[1] = rows;
+}
+
+// PAD over a band of rows, so the input never has to be materialised at full size
+static void patch_pad(size_t node, const uint8_t *in, row_range_t in_rows, uint8_t *out, row_range_t out_rows) {
+  const TfLiteIntArray *inputs = tflNodes[node].inputs;
+  const int32_t *paddings = (const int32_t*)tensorData[inputs->data[1]].data;
+  const TfLiteIntArray *in_dims = tensorData[inputs->data[0]].dims;
+  const TfLiteIntArray *out_dims = tensorData[tflNodes[node].outputs->data[0]].dims;
+  const int in_width = in_dims->data[2];
+  const int in_depth = in_dims->data[3];
+  const int out_row_bytes = out_dims->data[2] * out_dims->data[3];
+  const int out_depth = out_dims->data[3];
+
+  int8_t pad_value;
+  if (inputs->size > 2 && inputs->data[2] >= 0) {
+    pad_value = *(const int8_t*)tensorData[inputs->data[2]].data;
+  }
+  else {
+    TfLiteAffineQuantization const* quant =
+      (TfLiteAffineQuantization const*)tensorData[tflNodes[node].outputs->data[0]].quantization.params;
+    pad_value = (int8_t)quant->zero_point->data[0];
+  }
+
+  for (int y = out_rows.start; y < out_rows.end; y++) {
+    uint8_t *dst = out + (y - out_rows.start) * out_row_bytes;
+    const int src_y = y - paddings[2];
+    if (src_y < in_rows.start || src_y >= in_rows.end) {
+      memset(dst, pad_value, out_row_bytes);
+      continue;
+    }
+    const uint8_t *src = in + (src_y - in_rows.start) * in_width * in_depth;
+    memset(dst, pad_value, paddings[4] * out_depth);
+    dst += paddings[4] * out_depth;
+    for (int x = 0; x < in_width; x++) {
+      memset(dst, pad_value, paddings[6]);
+      memcpy(dst + paddings[6], src, in_depth);
+      memset(dst + paddings[6] + in_depth, pad_value, paddings[7]);
+      dst += out_depth;
+      src += in_depth;
+    }
+    memset(dst, pad_value, paddings[5] * out_depth);
+  }
+}
+
+// Runs nodes first_node..last_node of the patch stage band by band. Kernels see a view of the
+// tile (fewer rows, data pointer into the tile buffer) and the padding they computed in prepare,
+// which is why only nodes without top padding can be part of the stage.
+static TfLiteStatus invoke_patch_stage() {
+  const int n = patch_stage.last_node - patch_stage.first_node + 1;
+  row_range_t rows[EI_MAX_PATCH_NODES];
+  const int out_tensor = patch_stage.tensors[n - 1];
+
+  for (int start = 0; start < patch_stage.out_height; start += patch_stage.tile_rows) {
+    rows[n - 1].start = start;
+    rows[n - 1].end = start + patch_stage.tile_rows < patch_stage.out_height ?
+      start + patch_stage.tile_rows : patch_stage.out_height;
+    for (int k = n - 1; k > 0; k--) {
+      rows[k - 1] = patch_input_rows(patch_stage.first_node + k, rows[k]);
+    }
+    row_range_t in_rows = patch_input_rows(patch_stage.first_node, rows[0]);
+
+    for (int k = 0; k < n; k++) {
+      const size_t node = patch_stage.first_node + k;
+      const int in_index = k == 0 ? patch_stage.input_tensor : patch_stage.tensors[k - 1];
+      const int out_index = patch_stage.tensors[k];
+      const row_range_t src_rows = k == 0 ? in_rows : rows[k - 1];
+      if (rows[k].start >= rows[k].end) {
+        continue;
+      }
+
+      uint8_t *src = arena_ptr(tensor_offset(in_index));
+      if (k == 0) {
+        src += src_rows.start * tensor_row_bytes(in_index);
+      }
+      uint8_t *dst = arena_ptr(tensor_offset(out_index));
+      if (out_index == out_tensor) {
+        dst += rows[k].start * tensor_row_bytes(out_index);
+      }
+
+      if (used_ops[node] == OP_PAD) {
+        patch_pad(node, src, src_rows, dst, rows[k]);
+        continue;
+      }
+
+      patch_set_view(&patch_views[0], in_index, src, src_rows.end - src_rows.start);
+      patch_set_view(&patch_views[1], out_index, dst, rows[k].end - rows[k].start);
+      patch_views_count = 2;
+      ResetTensors();
+      TfLiteStatus status = invoke_node(node);
+      patch_views_count = 0;
+      if (status != kTfLiteOk) {
+        return status;
+      }
+    }
+  }
+  return kTfLiteOk;
+}
+#endif // EI_CLASSIFIER_ALLOCATION_HEAP
 
 } // namespace
 
 TfLiteStatus tflite_learn_891896_6_init( void*(*alloc_fnc)(size_t,size_t) ) {
-#ifdef EI_CLASSIFIER_ALLOCATION_HEAP
-  tensor_arena = (uint8_t*) alloc_fnc(16, kTensorArenaSize);
-  if (!tensor_arena) {
-    ei_printf("ERR: failed to allocate tensor arena\n");
+  if (!weights_set) {
+    ei_printf("ERR: constant tensors have no data, set the weights before init\n");
     return kTfLiteError;
   }
+
+#ifdef EI_CLASSIFIER_ALLOCATION_HEAP
+  if (arena_regions_count > 0) {
+    // arena is split over externally placed regions, persistent and scratch buffers get their own area
+    tensor_arena = NULL;
+    tensor_boundary = persistent_area;
+    current_location = persistent_area + persistent_area_bytes;
+  }
+  else {
+    size_t arena_size = tflite_learn_891896_6_arena_size();
+    tensor_arena = (uint8_t*) alloc_fnc(16, arena_size);
+    if (!tensor_arena) {
+      ei_printf("ERR: failed to allocate tensor arena\n");
+      return kTfLiteError;
+    }
+    tensor_boundary = tensor_arena;
+    current_location = tensor_arena + arena_size;
+  }
 #else
   memset(tensor_arena, 0, kTensorArenaSize);
-#endif
   tensor_boundary = tensor_arena;
   current_location = tensor_arena + kTensorArenaSize;
+#endif
+  persistent_bytes_requested = 0;
 
   EonMicroContext micro_context_;
   
@@ -1488,13 +2154,24 @@ TfLiteStatus tflite_learn_891896_6_init( void*(*alloc_fnc)(size_t,size_t) ) {
   for (size_t i = 0; i < 71; ++i) {
     TfLiteTensor tensor;
     init_tflite_tensor(i, &tensor);
+#ifdef EI_CLASSIFIER_ALLOCATION_HEAP
+    if (arena_regions_count > 0) {
+      continue;
+    }
+#endif
     if (tensor.allocation_type == kTfLiteArenaRw) {
-      auto data_end_ptr = (uint8_t*)tensor.data.data + tensorData[i].bytes;
+      auto data_end_ptr = (uint8_t*)tensor.data.data + tensor_bytes(i);
       if (data_end_ptr > tensor_boundary) {
         tensor_boundary = data_end_ptr;
       }
     }
   }
+#ifdef EI_CLASSIFIER_ALLOCATION_HEAP
+  // planned scratch buffers live below the high water mark of the plan as well
+  if (memory_plan && arena_regions_count == 0 && tensor_arena + memory_plan->planned_bytes > tensor_boundary) {
+    tensor_boundary = tensor_arena + memory_plan->planned_bytes;
+  }
+#endif
 
   if (tensor_boundary > current_location /* end of arena size */) {
     ei_printf("ERR: tensor arena is too small, does not fit model - even without scratch buffers\n");
@@ -1522,14 +2199,25 @@ TfLiteStatus tflite_learn_891896_6_init( void*(*alloc_fnc)(size_t,size_t) ) {
     for(size_t i = tflNodes_subgraph_index[g]; i < tflNodes_subgraph_index[g+1]; ++i) {
       if (registrations[used_ops[i]].prepare) {
         ResetTensors();
+        current_node = (int16_t)i;
         TfLiteStatus status = registrations[used_ops[i]].prepare(&ctx, &tflNodes[i]);
+        current_node = -1;
         if (status != kTfLiteOk) {
           return status;
         }
       }
+#if EI_CLASSIFIER_TFLITE_FIXED_SHAPE_KERNELS == 1
+      // nodes that cannot be set up (e.g. other types) keep running the generic kernel
+      fixed_kernel_data[i] = NULL;
+      if (fixed_kernels[i].setup) {
+        ResetTensors();
+        fixed_kernel_data[i] = fixed_kernels[i].setup(&ctx, &tflNodes[i]);
+      }
+#endif
     }
   }
   current_subgraph_index = 0;
+  scratch_requests_count = scratch_buffers_ix;
 
   return kTfLiteOk;
 }
@@ -1540,15 +2228,28 @@ TfLiteStatus tflite_learn_891896_6_input(int index, TfLiteTensor *tensor) {
 }
 
 TfLiteStatus tflite_learn_891896_6_output(int index, TfLiteTensor *tensor) {
-  init_tflite_tensor(out_tensor_indices[index], tensor);
+  int tensor_index = out_tensor_indices[index];
+  if (skip_final_softmax && tensor_index == tflNodes[26].outputs->data[0]) {
+    tensor_index = tflNodes[26].inputs->data[0];
+  }
+  init_tflite_tensor(tensor_index, tensor);
   return kTfLiteOk;
 }
 
 TfLiteStatus tflite_learn_891896_6_invoke() {
-  for (size_t i = 0; i < 27; ++i) {
+  const size_t nodes_count = skip_final_softmax ? 26 : 27;
+  for (size_t i = 0; i < nodes_count; ++i) {
     ResetTensors();
 
-    TfLiteStatus status = registrations[used_ops[i]].invoke(&ctx, &tflNodes[i]);
+    TfLiteStatus status;
+#if defined(EI_CLASSIFIER_ALLOCATION_HEAP)
+    if (patch_tiled() && (int)i == patch_stage.first_node) {
+      status = invoke_patch_stage();
+      i = patch_stage.last_node;
+    }
+    else
+#endif // EI_CLASSIFIER_ALLOCATION_HEAP
+    status = invoke_node(i);
 
 #if EI_CLASSIFIER_PRINT_STATE
     ei_printf("layer %lu\n", i);
@@ -1559,7 +2260,11 @@ TfLiteStatus tflite_learn_891896_6_invoke() {
       size_t data_ptr = (size_t)d.data;
 
       if (d.allocation_type == kTfLiteArenaRw) {
+#ifdef EI_CLASSIFIER_ALLOCATION_HEAP
+        data_ptr = (size_t)arena_ptr(tensor_offset(tflNodes[i].inputs->data[ix]));
+#else
         data_ptr = (size_t)tensor_arena + data_ptr;
+#endif
       }
 
       if (d.type == TfLiteType::kTfLiteInt8) {
@@ -1587,7 +2292,11 @@ TfLiteStatus tflite_learn_891896_6_invoke() {
       size_t data_ptr = (size_t)d.data;
 
       if (d.allocation_type == kTfLiteArenaRw) {
+#ifdef EI_CLASSIFIER_ALLOCATION_HEAP
+        data_ptr = (size_t)arena_ptr(tensor_offset(tflNodes[i].outputs->data[ix]));
+#else
         data_ptr = (size_t)tensor_arena + data_ptr;
+#endif
       }
 
       if (d.type == TfLiteType::kTfLiteInt8) {
@@ -1612,13 +2321,35 @@ TfLiteStatus tflite_learn_891896_6_invoke() {
     if (status != kTfLiteOk) {
       return status;
     }
+
+    // a tiled stage only completes its last output, nodes inside it are never tapped
+    if (tap_fn && (int)i == tap_node) {
+      TfLiteTensor out;
+      init_tflite_tensor(tflNodes[i].outputs->data[0], &out);
+      ei_tensor_tap_t tap;
+      tap.node = (int16_t)i;
+      tap.tensor = (int16_t)tflNodes[i].outputs->data[0];
+      tap.type = (uint8_t)out.type;
+      tap.height = (uint16_t)out.dims->data[1];
+      tap.width = (uint16_t)out.dims->data[2];
+      tap.channels = (uint16_t)out.dims->data[3];
+      tap.scale = out.params.scale;
+      tap.zero_point = out.params.zero_point;
+      tap.data = out.data.data;
+      tap.bytes = out.bytes;
+      tap_fn(&tap, tap_ctx);
+    }
   }
   return kTfLiteOk;
 }
 
 TfLiteStatus tflite_learn_891896_6_reset( void (*free_fnc)(void* ptr) ) {
 #ifdef EI_CLASSIFIER_ALLOCATION_HEAP
-  free_fnc(tensor_arena);
+  // placed regions are owned by whoever called tflite_learn_891896_6_set_arena_regions
+  if (arena_regions_count == 0) {
+    free_fnc(tensor_arena);
+  }
+  tensor_arena = NULL;
 #endif
 
   // scratch buffers are allocated within the arena, so just reset the counter so memory can be reused
@@ -1631,3 +2362,328 @@ TfLiteStatus tflite_learn_891896_6_reset( void (*free_fnc)(void* ptr) ) {
   overflow_buffers_ix = 0;
   return kTfLiteOk;
 }
+
+size_t tflite_learn_891896_6_tensor_lifetimes(ei_tensor_lifetime_t *lifetimes, size_t max_count) {
+  const size_t tensors_count = 71;
+  size_t count = tensors_count < max_count ? tensors_count : max_count;
+
+  for (size_t i = 0; i < count; i++) {
+    ei_tensor_lifetime_t *l = &lifetimes[i];
+    TfLiteTensor tensor;
+    init_tflite_tensor(i, &tensor);
+    l->in_arena = tensor.allocation_type == kTfLiteArenaRw;
+#if defined(EI_CLASSIFIER_ALLOCATION_HEAP)
+    l->offset = l->in_arena ? (size_t)tensor_offset(i) : 0;
+#else
+    l->offset = l->in_arena ? (size_t)((uint8_t*)tensorData[i].data - tensor_arena) : 0;
+#endif
+    l->bytes = tensor_bytes(i);
+    l->first_node = -1;
+    l->last_node = -1;
+    l->accesses = 0;
+  }
+
+  for (size_t n = 0; n < 27; n++) {
+    const TfLiteIntArray *arrays[] = { tflNodes[n].inputs, tflNodes[n].outputs };
+    for (size_t a = 0; a < 2; a++) {
+      for (int ix = 0; ix < arrays[a]->size; ix++) {
+        int t = arrays[a]->data[ix];
+        if (t < 0 || (size_t)t >= count) {
+          continue;
+        }
+        ei_tensor_lifetime_t *l = &lifetimes[t];
+        if (l->first_node < 0) {
+          l->first_node = (int16_t)n;
+        }
+        l->last_node = (int16_t)n;
+        l->accesses++;
+      }
+    }
+  }
+
+#if defined(EI_CLASSIFIER_ALLOCATION_HEAP)
+  // a tiled stage keeps its input, output and tiles alive while the stage runs
+  if (patch_tiled()) {
+    const int n = patch_stage.last_node - patch_stage.first_node + 1;
+    for (int k = -1; k < n; k++) {
+      int t = k < 0 ? patch_stage.input_tensor : patch_stage.tensors[k];
+      if ((size_t)t >= count) {
+        continue;
+      }
+      ei_tensor_lifetime_t *l = &lifetimes[t];
+      if (l->first_node < 0 || l->first_node > patch_stage.first_node) {
+        l->first_node = patch_stage.first_node;
+      }
+      if (l->last_node < patch_stage.last_node) {
+        l->last_node = patch_stage.last_node;
+      }
+    }
+  }
+
+  // with a memory plan the scratch buffers are part of the arena layout as well
+  if (memory_plan) {
+    for (size_t ix = 0; ix < memory_plan->scratch_count; ix++) {
+      if (tensors_count + ix >= max_count) {
+        break;
+      }
+      ei_tensor_lifetime_t *l = &lifetimes[tensors_count + ix];
+      l->offset = memory_plan->scratch[ix].offset;
+      l->bytes = memory_plan->scratch[ix].bytes;
+      l->first_node = memory_plan->scratch[ix].node;
+      l->last_node = memory_plan->scratch[ix].node;
+      l->accesses = 2;
+      l->in_arena = true;
+    }
+    return tensors_count + memory_plan->scratch_count;
+  }
+#endif // EI_CLASSIFIER_ALLOCATION_HEAP
+
+  return tensors_count;
+}
+
+TfLiteStatus tflite_learn_891896_6_set_arena_regions(const ei_arena_region_t *regions, size_t regions_count,
+                                                     uint8_t *persistent, size_t persistent_bytes) {
+#ifdef EI_CLASSIFIER_ALLOCATION_HEAP
+  if (regions_count > EI_MAX_ARENA_REGION_COUNT) {
+    ei_printf("ERR: too many arena regions (%d), max is EI_MAX_ARENA_REGION_COUNT (%d)\n",
+      (int)regions_count, (int)EI_MAX_ARENA_REGION_COUNT);
+    return kTfLiteError;
+  }
+
+  // every arena tensor (and planned scratch buffer) has to fall entirely within a single region
+  size_t scratch_count = memory_plan ? memory_plan->scratch_count : 0;
+  for (size_t i = 0; regions_count > 0 && i < 71 + scratch_count; i++) {
+    size_t offset, bytes;
+    if (i < 71) {
+      if (tensorData[i].allocation_type != kTfLiteArenaRw || tensorData[i].bytes == 0) {
+        continue;
+      }
+      offset = (size_t)tensor_offset(i);
+      bytes = tensor_bytes(i);
+    }
+    else {
+      offset = memory_plan->scratch[i - 71].offset;
+      bytes = memory_plan->scratch[i - 71].bytes;
+    }
+    bool found = false;
+    for (size_t ix = 0; ix < regions_count; ix++) {
+      if (offset >= regions[ix].offset && offset + bytes <= regions[ix].offset + regions[ix].bytes) {
+        found = true;
+        break;
+      }
+    }
+    if (!found) {
+      ei_printf("ERR: tensor %d (offset %d, %d bytes) is not covered by a single arena region\n",
+        (int)i, (int)offset, (int)bytes);
+      return kTfLiteError;
+    }
+  }
+
+  for (size_t ix = 0; ix < regions_count; ix++) {
+    arena_regions[ix] = regions[ix];
+  }
+  arena_regions_count = regions_count;
+  persistent_area = persistent;
+  persistent_area_bytes = persistent_bytes;
+  return kTfLiteOk;
+#else
+  ei_printf("ERR: arena regions are only supported with heap allocation\n");
+  return kTfLiteError;
+#endif
+}
+
+size_t tflite_learn_891896_6_scratch_requests(ei_scratch_buffer_plan_t *requests, size_t max_count, size_t *persistent_bytes) {
+  size_t count = scratch_requests_count < max_count ? scratch_requests_count : max_count;
+  for (size_t ix = 0; ix < count; ix++) {
+    requests[ix] = scratch_requests[ix];
+  }
+  if (persistent_bytes) {
+    *persistent_bytes = persistent_bytes_requested;
+  }
+  return scratch_requests_count;
+}
+
+TfLiteStatus tflite_learn_891896_6_set_memory_plan(const ei_memory_plan_t *plan) {
+#ifdef EI_CLASSIFIER_ALLOCATION_HEAP
+  if (arena_regions_count > 0) {
+    ei_printf("ERR: cannot change the memory plan while arena regions are set\n");
+    return kTfLiteError;
+  }
+  if (plan) {
+    if (plan->tensors_count != 71 || plan->scratch_count > EI_MAX_SCRATCH_BUFFER_COUNT) {
+      ei_printf("ERR: memory plan does not match this model\n");
+      return kTfLiteError;
+    }
+    uint32_t tile_bytes[EI_MAX_PATCH_NODES] = { 0 };
+    if (plan->patch_tile_rows > 0) {
+      if (!patch_stage_searched) {
+        patch_find_stage();
+      }
+      if (patch_stage.first_node < 0 || plan->patch_tile_rows >= patch_stage.out_height) {
+        ei_printf("ERR: memory plan asks for %d row tiles, but the model has no stage that can run tiled\n",
+          (int)plan->patch_tile_rows);
+        return kTfLiteError;
+      }
+      patch_tile_bytes(&patch_stage, plan->patch_tile_rows, tile_bytes);
+    }
+    for (size_t i = 0; i < 71; i++) {
+      int k = plan->patch_tile_rows > 0 ? patch_intermediate(i) : -1;
+      size_t bytes = k >= 0 ? tile_bytes[k] : tensorData[i].bytes;
+      if (tensorData[i].allocation_type == kTfLiteArenaRw &&
+          plan->tensor_offsets[i] + bytes > plan->planned_bytes) {
+        ei_printf("ERR: memory plan places tensor %d outside of the planned area\n", (int)i);
+        return kTfLiteError;
+      }
+    }
+  }
+  memory_plan = plan;
+  return kTfLiteOk;
+#else
+  ei_printf("ERR: memory plans are only supported with heap allocation\n");
+  return kTfLiteError;
+#endif
+}
+
+const ei_memory_plan_t* tflite_learn_891896_6_compiled_memory_plan() {
+#if defined(EI_CLASSIFIER_TFLITE_MEMORY_PLAN)
+  return &tflite_learn_891896_6_memory_plan;
+#else
+  return NULL;
+#endif
+}
+
+size_t tflite_learn_891896_6_arena_size() {
+#ifdef EI_CLASSIFIER_ALLOCATION_HEAP
+  if (memory_plan) {
+    return memory_plan->planned_bytes + memory_plan->persistent_bytes;
+  }
+#endif
+  return kTensorArenaSize;
+}
+
+TfLiteStatus tflite_learn_891896_6_patch_stage(size_t budget_bytes, ei_patch_stage_t *stage) {
+#ifdef EI_CLASSIFIER_ALLOCATION_HEAP
+  if (!patch_stage_searched) {
+    patch_find_stage();
+  }
+  if (patch_stage.first_node < 0) {
+    return kTfLiteError;
+  }
+
+  *stage = patch_stage;
+  const int n = stage->last_node - stage->first_node + 1;
+  stage->tile_rows = 0;
+  stage->tiled_bytes = stage->untiled_bytes;
+  for (int k = 0; k < n; k++) {
+    stage->tile_bytes[k] = tensorData[stage->tensors[k]].bytes;
+  }
+  if (budget_bytes == 0 || budget_bytes >= stage->untiled_bytes) {
+    return kTfLiteOk;
+  }
+
+  // the largest tiles that fit, fewer tiles means less halo recomputed; one row tiles if nothing fits
+  for (int rows = stage->out_height - 1; rows > 0; rows--) {
+    stage->tile_rows = (uint16_t)rows;
+    stage->tiled_bytes = patch_tile_bytes(stage, rows, stage->tile_bytes);
+    if (stage->tiled_bytes <= budget_bytes) {
+      break;
+    }
+  }
+  return kTfLiteOk;
+#else
+  ei_printf("ERR: patch based execution is only supported with heap allocation\n");
+  return kTfLiteError;
+#endif
+}
+
+TfLiteStatus tflite_learn_891896_6_skip_final_softmax(bool skip) {
+  if (!skip) {
+    skip_final_softmax = false;
+    return kTfLiteOk;
+  }
+
+  // only an int8 softmax over the last axis can be left to the post-processing, the logits
+  // tensor then stands in for the output (same shape, its own quantization)
+  if (used_ops[26] != OP_SOFTMAX) {
+    return kTfLiteError;
+  }
+  const TensorInfo_t &logits = tensorData[tflNodes[26].inputs->data[0]];
+  const TensorInfo_t &probs = tensorData[tflNodes[26].outputs->data[0]];
+  if (logits.type != kTfLiteInt8 || probs.type != kTfLiteInt8 || logits.bytes != probs.bytes) {
+    return kTfLiteError;
+  }
+  skip_final_softmax = true;
+  return kTfLiteOk;
+}
+
+TfLiteStatus tflite_learn_891896_6_set_tap(int node, ei_tensor_tap_fn fn, void *ctx) {
+  if (!fn) {
+    tap_node = -1;
+    tap_fn = NULL;
+    tap_ctx = NULL;
+    return kTfLiteOk;
+  }
+
+  // only a 4D (NHWC) activation with per-tensor quantization can be handed out as a feature map
+  if (node < 0 || node >= 27) {
+    return kTfLiteError;
+  }
+  const TensorInfo_t &info = tensorData[tflNodes[node].outputs->data[0]];
+  if (info.allocation_type != kTfLiteArenaRw || info.dims->size != 4 ||
+      info.quantization.type != kTfLiteAffineQuantization) {
+    return kTfLiteError;
+  }
+  tap_node = node;
+  tap_fn = fn;
+  tap_ctx = ctx;
+  return kTfLiteOk;
+}
+
+size_t tflite_learn_891896_6_weights(ei_weights_tensor_t *tensors, size_t max_count) {
+  const size_t weights_count = 43;
+  size_t count = weights_count < max_count ? weights_count : max_count;
+
+  for (size_t ix = 0; ix < count; ix++) {
+    const TensorInfo_t &info = tensorData[weights_tensors[ix]];
+    tensors[ix].index = weights_tensors[ix];
+    tensors[ix].type = (uint8_t)info.type;
+    tensors[ix].bytes = (uint32_t)info.bytes;
+    tensors[ix].data = weights_set ? info.data : NULL;
+  }
+  return weights_count;
+}
+
+TfLiteStatus tflite_learn_891896_6_set_weights(const ei_weights_tensor_t *tensors, size_t count) {
+  if (!tensors) {
+    for (size_t ix = 0; ix < 43; ix++) {
+      tensorData[weights_tensors[ix]].data = const_cast<void*>(weights_builtin[ix]);
+    }
+    weights_set = EI_CLASSIFIER_WEIGHTS_BLOB == 0;
+    return kTfLiteOk;
+  }
+
+  // same tensors in the same order as tflite_learn_891896_6_weights, data is used in place so it
+  // has to be aligned like the compiled in arrays
+  if (count != 43) {
+    ei_printf("ERR: weights list %d constant tensors, the model has 43\n", (int)count);
+    return kTfLiteError;
+  }
+  for (size_t ix = 0; ix < 43; ix++) {
+    const TensorInfo_t &info = tensorData[weights_tensors[ix]];
+    if (tensors[ix].index != weights_tensors[ix] || tensors[ix].type != (uint8_t)info.type ||
+        tensors[ix].bytes != info.bytes) {
+      ei_printf("ERR: weights for tensor %d do not match the model\n", (int)tensors[ix].index);
+      return kTfLiteError;
+    }
+    if (!tensors[ix].data || ((uintptr_t)tensors[ix].data & 15) != 0) {
+      ei_printf("ERR: weights for tensor %d are not 16 byte aligned\n", (int)tensors[ix].index);
+      return kTfLiteError;
+    }
+  }
+
+  for (size_t ix = 0; ix < 43; ix++) {
+    tensorData[weights_tensors[ix]].data = const_cast<void*>(tensors[ix].data);
+  }
+  weights_set = true;
+  return kTfLiteOk;
+}
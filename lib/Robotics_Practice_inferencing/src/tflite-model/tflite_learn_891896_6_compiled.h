@@ -34,6 +34,7 @@
 #define tflite_learn_891896_6_GEN_H
 
 #include "edge-impulse-sdk/tensorflow/lite/c/common.h"
+#include "edge-impulse-sdk/classifier/ei_arena_types.h"
 
 // Sets up the model with init and prepare steps.
 TfLiteStatus tflite_learn_891896_6_init( void*(*alloc_fnc)(size_t,size_t) );
@@ -45,6 +46,29 @@ TfLiteStatus tflite_learn_891896_6_output(int index, TfLiteTensor* tensor);
 TfLiteStatus tflite_learn_891896_6_invoke();
 //Frees memory allocated
 TfLiteStatus tflite_learn_891896_6_reset( void (*free)(void* ptr) );
+// Fills the arena offset, size and node lifetime of every tensor, returns the number of tensors.
+size_t tflite_learn_891896_6_tensor_lifetimes(ei_tensor_lifetime_t *lifetimes, size_t max_count);
+// Places slices of the arena layout at separate addresses, call before init (0 regions to restore).
+TfLiteStatus tflite_learn_891896_6_set_arena_regions(const ei_arena_region_t *regions, size_t regions_count,
+                                                     uint8_t *persistent, size_t persistent_bytes);
+// Returns the scratch buffers requested during the last init, and the bytes of persistent buffers.
+size_t tflite_learn_891896_6_scratch_requests(ei_scratch_buffer_plan_t *requests, size_t max_count, size_t *persistent_bytes);
+// Lays out activations and scratch buffers according to a memory plan, call before init (NULL to restore).
+TfLiteStatus tflite_learn_891896_6_set_memory_plan(const ei_memory_plan_t *plan);
+// Returns the memory plan compiled in with EI_CLASSIFIER_TFLITE_MEMORY_PLAN, or NULL.
+const ei_memory_plan_t* tflite_learn_891896_6_compiled_memory_plan();
+// Returns the number of bytes init allocates for the tensor arena.
+size_t tflite_learn_891896_6_arena_size();
+// Finds the stage that can run tile by tile, and the tile size that keeps it within budget_bytes.
+TfLiteStatus tflite_learn_891896_6_patch_stage(size_t budget_bytes, ei_patch_stage_t *stage);
+// Stops invoke before the final softmax, output then returns the int8 logits that would feed it.
+TfLiteStatus tflite_learn_891896_6_skip_final_softmax(bool skip);
+// Calls fn with the output of node right after invoke runs it, call before invoke (NULL fn to stop).
+TfLiteStatus tflite_learn_891896_6_set_tap(int node, ei_tensor_tap_fn fn, void *ctx);
+// Fills the index, type, size and data of every constant tensor, returns the number of constant tensors.
+size_t tflite_learn_891896_6_weights(ei_weights_tensor_t *tensors, size_t max_count);
+// Reads the constant tensors in place from external memory, call before init (NULL to restore).
+TfLiteStatus tflite_learn_891896_6_set_weights(const ei_weights_tensor_t *tensors, size_t count);
 
 
 // Returns the number of input tensors.
@@ -0,0 +1,25 @@
+// Memory plan for tflite_learn_891896_6, generated by ei_memory_plan_print_source()
+// activations + scratch: 73728 bytes, persistent: 9392 bytes
+#pragma once
+
+#include "edge-impulse-sdk/classifier/ei_arena_types.h"
+
+static const uint32_t tflite_learn_891896_6_plan_tensor_offsets[71] = {
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 36864, 0, 41904, 21168,
+  0, 64944, 60336, 27648, 0, 27648, 0, 30000, 0, 30000, 36912, 13824,
+  0, 13824, 27648, 13824, 0, 16128, 13824, 0, 13824, 1008, 0,
+};
+
+static const ei_scratch_buffer_plan_t tflite_learn_891896_6_plan_scratch[1] = {
+  { 26, 48, 2016 },
+};
+
+static const ei_memory_plan_t tflite_learn_891896_6_memory_plan = {
+  tflite_learn_891896_6_plan_tensor_offsets, 71,
+  tflite_learn_891896_6_plan_scratch, 1,
+  73728, 9392,
+  4
+};
@@ -26,6 +26,20 @@
 #define HREF_GPIO_NUM 23      // Horizontal sync
 #define PCLK_GPIO_NUM 22      // Pixel clock
 
+// Формат кадру: GRAYSCALE, або YUV422 / RGB565 для кольорового стріму -
+// інференція сама дістає з них сірий кадр (InferenceHandler.h)
+#ifndef CAMERA_PIXEL_FORMAT
+#define CAMERA_PIXEL_FORMAT PIXFORMAT_GRAYSCALE
+#endif
+
+// Розмір кадру: 96x96 як у моделі, або більший сірий (напр. FRAMESIZE_240X240) -
+// тоді інференція усереднює його до 96x96 по площі, що чесніше за пропуск пікселів. Це заради
+// якості: у дробовому відношенні (240 -> 96) зменшення повільніше за білінійне, швидше лише в
+// цілому (192x192, FRAMESIZE_VGA після обрізання до 480x480)
+#ifndef CAMERA_FRAME_SIZE
+#define CAMERA_FRAME_SIZE FRAMESIZE_96X96
+#endif
+
 bool initCamera() {
     camera_config_t config;
     
@@ -60,11 +74,11 @@ bool initCamera() {
     // Clock frequency: Reduced to 10MHz to prevent VSYNC overflow
     config.xclk_freq_hz = 10000000;  // 10MHz instead of 20MHz
     
-    // Frame format - GRAYSCALE for AI inference
-    config.pixel_format = PIXFORMAT_GRAYSCALE;
+    // Frame format - GRAYSCALE for AI inference (CAMERA_PIXEL_FORMAT)
+    config.pixel_format = CAMERA_PIXEL_FORMAT;
     
-    // Frame size - 96x96 for Edge Impulse model
-    config.frame_size = FRAMESIZE_96X96;
+    // Frame size - 96x96 for Edge Impulse model (CAMERA_FRAME_SIZE)
+    config.frame_size = CAMERA_FRAME_SIZE;
     
     // JPEG quality for streaming (0-63, lower = faster)
     config.jpeg_quality = 15;  // Reduced quality for faster transfer
@@ -112,4 +126,19 @@ bool initCamera() {
     }
 }
 
+// Ручна експозиція: вимикає AEC/AGC сенсора і ставить значення (OV2640: exposure 0..1200, gain 0..30).
+// manual = false повертає автоматику сенсора
+bool setCameraExposure(bool manual, uint16_t exposure, uint8_t gain) {
+    sensor_t *s = esp_camera_sensor_get();
+    if (s == NULL) return false;
+
+    s->set_exposure_ctrl(s, manual ? 0 : 1);
+    s->set_gain_ctrl(s, manual ? 0 : 1);
+    if (manual) {
+        s->set_aec_value(s, exposure);
+        s->set_agc_gain(s, gain);
+    }
+    return true;
+}
+
 #endif
\ No newline at end of file
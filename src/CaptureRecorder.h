@@ -0,0 +1,334 @@
+#ifndef _CAPTURE_RECORDER_H_
+#define _CAPTURE_RECORDER_H_
+
+#include <Arduino.h>
+#include <atomic>
+#include <Robotics_Practice_inferencing.h>
+#include "edge-impulse-sdk/classifier/ei_capture.h"
+#include "Hal.h"
+#include "Telemetry.h"
+
+// Запис кадрів з поля у форматі SDK (classifier/ei_capture.h): сирий кадр камери і результат,
+// який отримав пристрій, щоб прогнати ті самі кадри на хості й порівняти (tools/capture_replay.cpp).
+//
+// Забрати запис можна двома шляхами:
+//   Serial - рядок "capture start" у порт: записи йдуть пакетами телеметрії (TELEMETRY_PACKET_CAPTURE)
+//     з її ж фонової задачі, між записами телеметрії; "capture stop" - кінець. Пакет - один цілий
+//     запис, тож пакет, зіпсований у дорозі, губить лише свій кадр. Лише з TELEMETRY_BINARY=1.
+//       python3 tools/telemetry_decode.py --port /dev/ttyUSB0 --capture field.cap
+//     Запис 96x96 - ~9.4 КБ, на 115200 бод це ~0.8 с: кадри, що приходять, поки слот зайнятий,
+//     рахуються як втрачені (dropped).
+//   HTTP (збірка з WEB_SERVER=1) - GET /api/capture/start: заголовок і записи за CAPTURE_HTTP_WINDOW_MS,
+//     далі кожен GET /api/capture - наступне вікно. Обробник тримає задачу httpd лише на вікно, між
+//     запитами сервер відповідає на інші маршрути. Без запитів CAPTURE_HTTP_IDLE_MS запис зупиняється,
+//     після цього /api/capture відповідає 410.
+//       curl -s http://<ip>/api/capture/start > field.cap
+//       while curl -sf http://<ip>/api/capture >> field.cap; do :; done
+//
+// Цикл кадру не чекає ні на порт, ні на мережу: запис кадру кодується в один слот у PSRAM,
+// відправник (задача телеметрії або обробник HTTP) відправляє його і звільняє слот. Поки слот
+// зайнятий, кадр лише рахується як втрачений (dropped наступного запису). Слот виділяється під час
+// запису, без нього пам'яті не займає; звільняє його цикл кадру, коли запис зупинено.
+// Записуються лише сірі кадри (камера прошивки - PIXFORMAT_GRAYSCALE).
+//
+// До кожного запису з результатом додається і вихідний тензор детектора таким, яким його залишили
+// ядра пристрою (int8 12x12x7 для FOMO), - tools/golden_check.cpp --device звіряє його з хостом
+// біт у біт.
+
+// Шматки, якими відправляється запис (як кадри стріму)
+#define CAPTURE_CHUNK_SIZE 2048
+// Скільки один запит HTTP віддає записи
+#define CAPTURE_HTTP_WINDOW_MS 1000
+// Без запитів HTTP довше - запис зупиняється
+#define CAPTURE_HTTP_IDLE_MS 5000
+
+enum CaptureSlotState : uint8_t {
+    CAPTURE_OFF = 0,        // запис не йде, слот не виділено
+    CAPTURE_FREE = 1,       // цикл кадру може заповнити слот
+    CAPTURE_FILLING = 2,    // цикл кадру кодує запис (або зупиняє запис)
+    CAPTURE_FULL = 3,       // запис готовий до відправки
+    CAPTURE_SENDING = 4,    // відправник передає запис
+};
+
+enum CaptureSink : uint8_t {
+    CAPTURE_SINK_NONE = 0,
+    CAPTURE_SINK_SERIAL = 1,
+    CAPTURE_SINK_HTTP = 2,
+};
+
+static std::atomic<uint8_t> capture_state(CAPTURE_OFF);
+static std::atomic<uint8_t> capture_sink(CAPTURE_SINK_NONE);
+static std::atomic<bool> capture_stop_requested(false);
+static std::atomic<bool> capture_header_pending(false);    // Serial: заголовок ще не відправлено
+static std::atomic<bool> capture_http_busy(false);         // обробник HTTP зараз у вікні
+static std::atomic<uint32_t> capture_http_last_ms(0);      // кінець останнього вікна
+static std::atomic<uint32_t> capture_records(0);
+// Слот належить циклу кадру в FILLING, відправнику - в SENDING
+static uint8_t* capture_slot = NULL;
+static size_t capture_slot_size = 0;
+static size_t capture_slot_bytes = 0;
+static uint16_t capture_dropped = 0;        // пише лише цикл кадру
+// Вихідний тензор детектора з поточного кадру (PSRAM, ~1 КБ). Виділяється з першим записом і
+// лишається: його пише run_classifier поза станом FILLING
+static uint8_t* capture_raw = NULL;
+static size_t capture_raw_size = 0;
+static size_t capture_raw_bytes = 0;        // 0 - у цьому кадрі ще не знято
+
+struct CaptureBuffer {
+    uint8_t* data;
+    size_t size;
+    size_t len;
+};
+
+static size_t captureBufferWrite(const void* data, size_t len, void* ctx) {
+    CaptureBuffer* buf = (CaptureBuffer*)ctx;
+    if (buf->len + len > buf->size) return 0;
+    memcpy(buf->data + buf->len, data, len);
+    buf->len += len;
+    return len;
+}
+
+static size_t captureHttpWrite(const void* data, size_t len, void* ctx) {
+    hal_http_req_t* req = (hal_http_req_t*)ctx;
+    for (size_t offset = 0; offset < len; offset += CAPTURE_CHUNK_SIZE) {
+        size_t chunk_len = len - offset > CAPTURE_CHUNK_SIZE ? CAPTURE_CHUNK_SIZE : len - offset;
+        if (halHttpSendChunk(req, (const char*)data + offset, chunk_len) != HAL_OK) return 0;
+    }
+    return len;
+}
+
+#if EI_CLASSIFIER_COMPILED == 1
+// Викликається з run_classifier у циклі кадру. Перший вихід після запису кадру - детектор:
+// верифікатор запускається в тому ж кадрі пізніше і свого виходу сюди не пише
+static void captureOutputTap(uint32_t learn_block_index, const ei_tensor_tap_t* output, void* ctx) {
+    (void)ctx;
+    if (capture_state.load() == CAPTURE_OFF || capture_raw_bytes != 0 ||
+        learn_block_index != 0 || output->tensor != 0 || output->bytes > UINT16_MAX) {
+        return;
+    }
+    if (output->bytes > capture_raw_size) {
+        halFree(capture_raw);
+        capture_raw = (uint8_t*)halAllocExternal(output->bytes);
+        capture_raw_size = capture_raw != NULL ? output->bytes : 0;
+        if (capture_raw == NULL) return;
+    }
+    memcpy(capture_raw, output->data, output->bytes);
+    capture_raw_bytes = output->bytes;
+}
+#endif
+
+#if TELEMETRY_BINARY == 1
+static size_t captureSerialWrite(const void* data, size_t len, void* ctx) {
+    telemetryStreamWrite((TelemetryStream*)ctx, data, len);
+    return len;
+}
+
+// З задачі телеметрії після черги записів: заголовок, далі готовий запис, якщо є
+static void captureSerialSend() {
+    if (capture_sink.load() != CAPTURE_SINK_SERIAL) return;
+    static TelemetryStream stream;
+    if (capture_header_pending.load()) {
+        ei_capture_writer_t writer;
+        ei_capture_writer_init(&writer, ei_default_impulse.impulse, EI_CAPTURE_PIXEL_GRAY8, captureSerialWrite, &stream);
+        telemetryStreamBegin(&stream, TELEMETRY_PACKET_CAPTURE);
+        ei_capture_write_header(&writer);
+        telemetryStreamEnd(&stream);
+        capture_header_pending.store(false);
+    }
+    uint8_t expected = CAPTURE_FULL;
+    if (!capture_state.compare_exchange_strong(expected, CAPTURE_SENDING)) return;
+    telemetryStreamBegin(&stream, TELEMETRY_PACKET_CAPTURE);
+    telemetryStreamWrite(&stream, capture_slot, capture_slot_bytes);
+    telemetryStreamEnd(&stream);
+    capture_records.fetch_add(1);
+    capture_state.store(CAPTURE_FREE);
+}
+#endif
+
+// Підключення до класифікатора і телеметрії, з setup() до telemetryBegin()
+void captureBegin() {
+#if EI_CLASSIFIER_COMPILED == 1
+    ei_set_output_tap(captureOutputTap, NULL);
+#endif
+#if TELEMETRY_BINARY == 1
+    telemetrySetExtra(captureSerialSend);
+#endif
+}
+
+// Почати запис для відправника sink. false - запис уже йде
+static bool captureStart(CaptureSink sink) {
+    uint8_t expected = CAPTURE_OFF;
+    if (!capture_state.compare_exchange_strong(expected, CAPTURE_FREE)) return false;
+    capture_records.store(0);
+    capture_stop_requested.store(false);
+    capture_header_pending.store(sink == CAPTURE_SINK_SERIAL);
+    capture_http_last_ms.store(halMillis());
+    capture_sink.store(sink);
+    return true;
+}
+
+// Команда "capture start" з Serial (цикл кадру)
+bool captureSerialStart() {
+#if TELEMETRY_BINARY == 1
+    // друкується до старту: потім порт ділить пакет заголовка
+    if (capture_state.load() != CAPTURE_OFF) {
+        Serial.println("[CAPTURE] Already recording");
+        return false;
+    }
+    Serial.println("[CAPTURE] Recording to Serial");
+    return captureStart(CAPTURE_SINK_SERIAL);
+#else
+    Serial.println("[CAPTURE] Serial recording needs TELEMETRY_BINARY=1");
+    return false;
+#endif
+}
+
+// Команда "capture stop": запис зупиниться на наступному кадрі. Нічого не друкує -
+// задача телеметрії може бути посеред пакета запису
+void captureSerialStop() {
+    if (capture_sink.load() == CAPTURE_SINK_SERIAL) {
+        capture_stop_requested.store(true);
+    }
+}
+
+// Зупинка запису з циклу кадру: за командою або коли клієнт HTTP зник. Незабраний запис
+// відкидається; слот, який зараз відправляється, - зупинка на наступному кадрі
+static void captureStopIfDone() {
+    const uint8_t sink = capture_sink.load();
+    if (sink == CAPTURE_SINK_NONE) return;
+    bool stop = capture_stop_requested.load();
+    if (sink == CAPTURE_SINK_HTTP && !capture_http_busy.load() &&
+        halMillis() - capture_http_last_ms.load() > CAPTURE_HTTP_IDLE_MS) {
+        stop = true;
+    }
+    if (!stop) return;
+    uint8_t expected = CAPTURE_FREE;
+    if (!capture_state.compare_exchange_strong(expected, CAPTURE_FILLING)) {
+        expected = CAPTURE_FULL;
+        if (!capture_state.compare_exchange_strong(expected, CAPTURE_FILLING)) return;
+    }
+    halFree(capture_slot);
+    capture_slot = NULL;
+    capture_slot_size = 0;
+    capture_dropped = 0;
+    capture_sink.store(CAPTURE_SINK_NONE);
+    capture_stop_requested.store(false);
+    capture_state.store(CAPTURE_OFF);
+    if (sink == CAPTURE_SINK_HTTP) {
+        Serial.printf("[CAPTURE] Recording ended after %lu frames\n", (unsigned long)capture_records.load());
+    }
+}
+
+// Кадр для запису, з циклу кадру до halCameraReturn. result - NULL, якщо класифікатор не
+// запускався (кадр відкинуто або помилка); fusion_reset - перед цим запуском історію злиття скинуто
+void captureRecord(const hal_frame_t* fb, const TelemetryRecord* rec, const ei_impulse_result_t* result,
+                   uint32_t frame_us, bool fusion_reset) {
+    // вихід детектора належить лише цьому кадру
+    const size_t raw_bytes = result != NULL ? capture_raw_bytes : 0;
+    capture_raw_bytes = 0;
+    captureStopIfDone();
+    uint8_t expected = CAPTURE_FREE;
+    if (!capture_state.compare_exchange_strong(expected, CAPTURE_FILLING)) {
+        if ((expected == CAPTURE_FULL || expected == CAPTURE_SENDING) && capture_dropped < UINT16_MAX) {
+            capture_dropped++;
+        }
+        return;
+    }
+
+    const size_t frame_bytes = fb->width * fb->height;
+    if (halFrameFormat(fb) != HAL_PIXEL_GRAY || fb->len < frame_bytes) {
+        capture_state.store(CAPTURE_FREE);
+        return;
+    }
+    const ei_impulse_t* impulse = ei_default_impulse.impulse;
+    const size_t record_bytes = ei_capture_record_bytes(impulse, frame_bytes, result, raw_bytes);
+    if (record_bytes > capture_slot_size) {
+        halFree(capture_slot);
+        capture_slot = (uint8_t*)halAllocExternal(record_bytes);
+        capture_slot_size = capture_slot != NULL ? record_bytes : 0;
+        if (capture_slot == NULL) {
+            if (capture_dropped < UINT16_MAX) capture_dropped++;
+            capture_state.store(CAPTURE_FREE);
+            return;
+        }
+    }
+
+    CaptureBuffer buf = { capture_slot, capture_slot_size, 0 };
+    ei_capture_writer_t writer;
+    ei_capture_writer_init(&writer, impulse, EI_CAPTURE_PIXEL_GRAY8, captureBufferWrite, &buf);
+    ei_capture_frame_t frame = {
+        fb->buf, (uint32_t)frame_bytes, (uint16_t)fb->width, (uint16_t)fb->height,
+        rec->frame_id, rec->timestamp_ms, frame_us, rec->status, capture_dropped,
+        capture_raw, (uint16_t)raw_bytes, fusion_reset
+    };
+    if (ei_capture_write_record(&writer, &frame, result, (EI_IMPULSE_ERROR)rec->classifier_error) != EI_IMPULSE_OK) {
+        capture_state.store(CAPTURE_FREE);
+        return;
+    }
+    capture_slot_bytes = buf.len;
+    capture_dropped = 0;
+    capture_state.store(CAPTURE_FULL);
+}
+
+// Записи, готові за CAPTURE_HTTP_WINDOW_MS, одним chunked тілом
+static hal_err_t captureHttpWindow(hal_http_req_t* req) {
+    const uint32_t start = halMillis();
+    hal_err_t res = HAL_OK;
+    while (halMillis() - start < CAPTURE_HTTP_WINDOW_MS) {
+        uint8_t expected = CAPTURE_FULL;
+        if (!capture_state.compare_exchange_strong(expected, CAPTURE_SENDING)) {
+            if (expected == CAPTURE_OFF) break;
+            halDelay(10);
+            continue;
+        }
+        const bool sent = captureHttpWrite(capture_slot, capture_slot_bytes, req) == capture_slot_bytes;
+        capture_state.store(CAPTURE_FREE);
+        if (!sent) {
+            res = HAL_FAIL;
+            break;
+        }
+        capture_records.fetch_add(1);
+    }
+    capture_http_last_ms.store(halMillis());
+    capture_http_busy.store(false);
+    if (res == HAL_OK) {
+        res = halHttpSendChunk(req, NULL, 0);
+    }
+    return res;
+}
+
+// Початок запису: заголовок файлу і перше вікно. Один клієнт за раз
+hal_err_t capture_start_handler(hal_http_req_t *req) {
+    if (!captureStart(CAPTURE_SINK_HTTP)) {
+        halHttpSetType(req, "application/json");
+        halHttpSetStatus(req, "409 Conflict");
+        return halHttpSend(req, "{\"error\":\"capture already running\"}", -1);
+    }
+    capture_http_busy.store(true);
+    Serial.println("[CAPTURE] Recording started");
+    halHttpSetType(req, "application/octet-stream");
+    ei_capture_writer_t writer;
+    ei_capture_writer_init(&writer, ei_default_impulse.impulse, EI_CAPTURE_PIXEL_GRAY8, captureHttpWrite, req);
+    if (ei_capture_write_header(&writer) != EI_IMPULSE_OK) {
+        capture_stop_requested.store(true);
+        capture_http_busy.store(false);
+        return HAL_FAIL;
+    }
+    return captureHttpWindow(req);
+}
+
+// Наступне вікно запису, що вже йде
+hal_err_t capture_handler(hal_http_req_t *req) {
+    capture_http_busy.store(true);
+    if (capture_sink.load() != CAPTURE_SINK_HTTP || capture_state.load() == CAPTURE_OFF) {
+        capture_http_busy.store(false);
+        halHttpSetType(req, "application/json");
+        halHttpSetStatus(req, "410 Gone");
+        return halHttpSend(req, "{\"error\":\"capture not running, GET /api/capture/start\"}", -1);
+    }
+    capture_http_last_ms.store(halMillis());
+    halHttpSetType(req, "application/octet-stream");
+    return captureHttpWindow(req);
+}
+
+#endif
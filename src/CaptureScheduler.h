@@ -0,0 +1,173 @@
+#ifndef _CAPTURE_SCHEDULER_H_
+#define _CAPTURE_SCHEDULER_H_
+
+#include <stdint.h>
+#include <atomic>
+
+// Планувальник захоплення кадрів.
+// Інтервал між кадрами інференції залежить від:
+//   - активності сцени: купюра в кадрі - швидкий темп, давно нічого - повільний
+//   - виміряної тривалості кадру: інференція не займає більше max_duty_percent часу (бюджет енергії)
+//   - запасу heap: нижче min_free_heap темп і стрімінг сповільнюються
+// Камеру ділять інференція і стрімінг, інференція має пріоритет: коли кадр на підході,
+// стрімінг не бере нових кадрів, доки інференція не відпустить камеру.
+//
+// Без залежностей від Arduino/FreeRTOS - час передається ззовні, тож логіку можна
+// проганяти в симуляції на хості (tools/capture_sched_sim.cpp).
+
+struct CaptureSchedulerConfig {
+    uint32_t active_interval_ms;        // темп, поки в кадрі є купюра
+    uint32_t idle_interval_ms;          // темп, коли давно нічого не було
+    uint32_t idle_after_ms;             // скільки чекати після останньої детекції до повільного темпу
+    uint32_t max_duty_percent;          // частка часу під інференцію, 1..100
+    uint32_t min_free_heap;             // нижче цього - режим економії пам'яті
+    uint32_t low_heap_interval_ms;      // мінімальний інтервал у режимі економії
+    uint32_t stream_interval_ms;        // пауза між кадрами стріму
+    uint32_t low_heap_stream_interval_ms;
+    uint32_t stream_guard_ms;           // стрім не бере кадр, якщо інференція почнеться раніше
+};
+
+enum CameraClient : uint8_t {
+    CAMERA_FREE = 0,
+    CAMERA_INFERENCE = 1,
+    CAMERA_STREAM = 2,
+};
+
+class CaptureScheduler {
+public:
+    explicit CaptureScheduler(const CaptureSchedulerConfig& config)
+        : config(config), owner(CAMERA_FREE), inference_waiting(false), capture_now(false),
+          next_capture_ms(0), last_activity_ms(0), has_activity(false),
+          frame_ms_avg_x16(0), last_frame_ms(0), low_heap(false), interval_ms(config.idle_interval_ms) {
+    }
+
+    void setConfig(const CaptureSchedulerConfig& new_config) {
+        config = new_config;
+    }
+
+    const CaptureSchedulerConfig& getConfig() const {
+        return config;
+    }
+
+    // Чи час робити кадр інференції
+    bool due(uint32_t now_ms) const {
+        return capture_now.load() || (int32_t)(now_ms - next_capture_ms.load()) >= 0;
+    }
+
+    // Скільки можна спати до наступного кадру
+    uint32_t msUntilDue(uint32_t now_ms) const {
+        if (due(now_ms)) return 0;
+        return next_capture_ms.load() - now_ms;
+    }
+
+    // Позачерговий кадр (кнопка сканування). Запит під час кадру інференції чекає на наступний
+    void requestCapture() {
+        capture_now.store(true);
+    }
+
+    // Камера для клієнта. Інференція, що не отримала камеру, лишається в черзі, і стрім
+    // вже не візьме наступний кадр
+    bool tryAcquire(CameraClient client, uint32_t now_ms) {
+        if (client == CAMERA_STREAM) {
+            if (inference_waiting.load()) return false;
+            // кадр стріму тримає камеру, поки відправляється, тож не починаємо його впритул до інференції
+            // чи коли чекає позачерговий кадр
+            if (capture_now.load() || (int32_t)(next_capture_ms.load() - now_ms) < (int32_t)config.stream_guard_ms) {
+                return false;
+            }
+        }
+        uint8_t expected = CAMERA_FREE;
+        if (owner.compare_exchange_strong(expected, (uint8_t)client)) {
+            if (client == CAMERA_INFERENCE) {
+                inference_waiting.store(false);
+                // цей кадр і є позачерговим
+                capture_now.store(false);
+            }
+            return true;
+        }
+        if (client == CAMERA_INFERENCE) inference_waiting.store(true);
+        return false;
+    }
+
+    void release(CameraClient client) {
+        uint8_t expected = (uint8_t)client;
+        owner.compare_exchange_strong(expected, (uint8_t)CAMERA_FREE);
+    }
+
+    // Пауза між кадрами стріму
+    uint32_t streamIntervalMs() const {
+        return low_heap.load() ? config.low_heap_stream_interval_ms : config.stream_interval_ms;
+    }
+
+    // Кадр інференції завершено: оновлює оцінку тривалості і планує наступний
+    // start_ms - коли кадр почався, frame_us - скільки тривав (захоплення + інференція)
+    // activity - у кадрі є купюра
+    void frameDone(uint32_t start_ms, uint32_t frame_us, bool activity, uint32_t free_heap) {
+        const uint32_t frame_ms = (frame_us + 999) / 1000;
+        // ковзне середнє 1/4, у фіксованій точці x16
+        if (frame_ms_avg_x16 == 0) {
+            frame_ms_avg_x16 = frame_ms * 16;
+        } else {
+            frame_ms_avg_x16 += ((int32_t)(frame_ms * 16) - (int32_t)frame_ms_avg_x16) / 4;
+        }
+        last_frame_ms = frame_ms;
+
+        const uint32_t now_ms = start_ms + frame_ms;
+        if (activity) {
+            last_activity_ms = now_ms;
+            has_activity = true;
+        }
+        low_heap.store(free_heap < config.min_free_heap);
+
+        interval_ms = computeInterval(now_ms);
+        next_capture_ms.store(start_ms + interval_ms);
+    }
+
+    // Найдовша пауза між кадрами інференції, поки сцена активна: активний темп з бюджетом і малим
+    // heap, плюс кадр стріму, на який може чекати інференція. Довша пауза - сцена могла змінитися
+    // (повільний темп без активності, відкинуті кадри)
+    uint32_t activeGapMs() const {
+        return intervalFor(true) + config.stream_guard_ms;
+    }
+
+    uint32_t intervalMs() const { return interval_ms; }
+    uint32_t frameMsAverage() const { return frame_ms_avg_x16 / 16; }
+    bool lowHeap() const { return low_heap.load(); }
+
+private:
+    uint32_t computeInterval(uint32_t now_ms) const {
+        return intervalFor(has_activity && now_ms - last_activity_ms < config.idle_after_ms);
+    }
+
+    uint32_t intervalFor(bool active) const {
+        uint32_t interval = active ? config.active_interval_ms : config.idle_interval_ms;
+
+        // бюджет: кадр тривалістю T не частіше ніж раз на T * 100 / duty. T - більше з середнього
+        // і останнього кадру: середнє наздоганяє уповільнення кілька кадрів, і весь цей час бюджет
+        // перевищувався б
+        const uint32_t duty = config.max_duty_percent == 0 ? 1 :
+                              config.max_duty_percent > 100 ? 100 : config.max_duty_percent;
+        const uint32_t frame_x16 = last_frame_ms * 16 > frame_ms_avg_x16 ? last_frame_ms * 16 : frame_ms_avg_x16;
+        const uint32_t min_by_duty = (frame_x16 * 100 / duty + 15) / 16;
+        if (interval < min_by_duty) interval = min_by_duty;
+
+        if (low_heap.load() && interval < config.low_heap_interval_ms) {
+            interval = config.low_heap_interval_ms;
+        }
+        return interval;
+    }
+
+    CaptureSchedulerConfig config;
+    std::atomic<uint8_t> owner;
+    std::atomic<bool> inference_waiting;
+    std::atomic<bool> capture_now;
+    std::atomic<uint32_t> next_capture_ms;
+    uint32_t last_activity_ms;
+    bool has_activity;
+    uint32_t frame_ms_avg_x16;
+    uint32_t last_frame_ms;
+    std::atomic<bool> low_heap;     // читає задача стріму
+    uint32_t interval_ms;
+};
+
+#endif
@@ -0,0 +1,196 @@
+#ifndef _FRAME_QUALITY_H_
+#define _FRAME_QUALITY_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Оцінка якості кадру перед інференцією і керування експозицією.
+// Один прохід по gray8 кадру в цілих числах: середнє, дисперсія (контраст),
+// дисперсія лапласіана (різкість) і частка пересвічених/провалених пікселів.
+// Кадр, що не пройшов, до run_classifier не доходить.
+//
+// ExposureController веде експозицію і підсилення сенсора сам (AEC/AGC сенсора вимкнені):
+// крок до цільової яскравості, поки кадр не стабільний, потім фіксує значення
+// і не чіпає їх, доки сцена помітно не зміниться. Сенсор більше не "полює" за
+// експозицією між кадрами, а довга витримка обмежена, щоб не змазувати купюру в русі.
+//
+// Без залежностей від Arduino - логіку можна проганяти на хості.
+
+enum FrameQualityReject : uint8_t {
+    FRAME_QUALITY_OK = 0,
+    FRAME_QUALITY_CLIPPED = 1,      // забагато пікселів у 0 або 255
+    FRAME_QUALITY_DARK = 2,
+    FRAME_QUALITY_BRIGHT = 3,
+    FRAME_QUALITY_LOW_CONTRAST = 4,
+    FRAME_QUALITY_BLURRED = 5,
+};
+
+#define FRAME_QUALITY_REJECT_REASONS 5
+
+struct FrameQualityConfig {
+    uint8_t min_mean;
+    uint8_t max_mean;
+    uint16_t min_variance;          // дисперсія яскравості
+    uint16_t min_sharpness;         // дисперсія лапласіана
+    uint16_t max_clip_permille;     // пікселі <= clip_low або >= clip_high, на 1000
+    uint8_t clip_low;
+    uint8_t clip_high;
+};
+
+struct FrameQuality {
+    uint8_t mean;
+    uint16_t variance;              // насичується на UINT16_MAX
+    uint16_t sharpness;
+    uint16_t clip_permille;
+    FrameQualityReject reject;
+};
+
+static inline uint16_t frameQualitySaturate16(uint64_t value) {
+    return value > UINT16_MAX ? UINT16_MAX : (uint16_t)value;
+}
+
+// Метрики кадру width x height (gray8, рядки підряд). Лапласіан 4-сусідів по внутрішніх пікселях
+static void frameQualityMeasure(const uint8_t* frame, size_t width, size_t height,
+                                const FrameQualityConfig& config, FrameQuality* out) {
+    uint32_t sum = 0;
+    uint64_t sum_sq = 0;
+    uint32_t clipped = 0;
+    int64_t lap_sum = 0;
+    uint64_t lap_sum_sq = 0;
+
+    for (size_t y = 0; y < height; y++) {
+        const uint8_t* row = frame + y * width;
+        for (size_t x = 0; x < width; x++) {
+            const uint32_t p = row[x];
+            sum += p;
+            sum_sq += p * p;
+            clipped += (p <= config.clip_low) | (p >= config.clip_high);
+        }
+        if (y == 0 || y + 1 == height) continue;
+        const uint8_t* up = row - width;
+        const uint8_t* down = row + width;
+        for (size_t x = 1; x + 1 < width; x++) {
+            const int32_t lap = 4 * (int32_t)row[x] - row[x - 1] - row[x + 1] - up[x] - down[x];
+            lap_sum += lap;
+            lap_sum_sq += (uint64_t)((int64_t)lap * lap);
+        }
+    }
+
+    const uint32_t count = (uint32_t)(width * height);
+    const uint32_t inner = width > 2 && height > 2 ? (uint32_t)((width - 2) * (height - 2)) : 0;
+    out->mean = count ? (uint8_t)(sum / count) : 0;
+    out->variance = count ? frameQualitySaturate16(
+        (sum_sq - (uint64_t)sum * sum / count) / count) : 0;
+    out->sharpness = inner ? frameQualitySaturate16(
+        (lap_sum_sq - (uint64_t)(lap_sum * lap_sum) / inner) / inner) : 0;
+    out->clip_permille = count ? (uint16_t)((uint64_t)clipped * 1000 / count) : 0;
+
+    // Порядок важливий: пересвітлений кадр має і низьку різкість, причина - експозиція
+    if (out->clip_permille > config.max_clip_permille) {
+        out->reject = FRAME_QUALITY_CLIPPED;
+    } else if (out->mean < config.min_mean) {
+        out->reject = FRAME_QUALITY_DARK;
+    } else if (out->mean > config.max_mean) {
+        out->reject = FRAME_QUALITY_BRIGHT;
+    } else if (out->variance < config.min_variance) {
+        out->reject = FRAME_QUALITY_LOW_CONTRAST;
+    } else if (out->sharpness < config.min_sharpness) {
+        out->reject = FRAME_QUALITY_BLURRED;
+    } else {
+        out->reject = FRAME_QUALITY_OK;
+    }
+}
+
+static inline const char* frameQualityRejectName(FrameQualityReject reject) {
+    switch (reject) {
+        case FRAME_QUALITY_OK: return "ok";
+        case FRAME_QUALITY_CLIPPED: return "clipped";
+        case FRAME_QUALITY_DARK: return "dark";
+        case FRAME_QUALITY_BRIGHT: return "bright";
+        case FRAME_QUALITY_LOW_CONTRAST: return "low contrast";
+        case FRAME_QUALITY_BLURRED: return "blurred";
+    }
+    return "?";
+}
+
+struct ExposureControllerConfig {
+    uint8_t target_mean;
+    uint8_t lock_tolerance;         // |ціль - середнє| для фіксації
+    uint8_t unlock_tolerance;       // відхилення, після якого зафіксоване значення відпускається
+    uint8_t lock_frames;            // стільки кадрів поспіль у допуску - фіксація
+    uint8_t unlock_frames;          // стільки кадрів поспіль поза допуском - знову регулювання
+    uint16_t min_exposure;
+    uint16_t max_exposure;          // межа витримки проти змазування, далі росте підсилення
+    uint8_t max_gain;
+    uint16_t initial_exposure;
+};
+
+// Підсилення gain дає яскравість (16 + gain) / 16, тож рівень = exposure * (16 + gain) / 16
+class ExposureController {
+public:
+    explicit ExposureController(const ExposureControllerConfig& config)
+        : config(config), exposure_value(config.initial_exposure), gain_value(0),
+          is_locked(false), stable_count(0), unstable_count(0) {
+    }
+
+    // Оновити за середнім кадру. true - експозицію або підсилення змінено, треба застосувати до сенсора
+    bool update(uint8_t mean) {
+        const int32_t error = (int32_t)config.target_mean - mean;
+        const uint32_t abs_error = error < 0 ? -error : error;
+
+        if (is_locked) {
+            unstable_count = abs_error > config.unlock_tolerance ? unstable_count + 1 : 0;
+            if (unstable_count < config.unlock_frames) return false;
+            is_locked = false;
+            unstable_count = 0;
+            stable_count = 0;
+        }
+
+        if (abs_error <= config.lock_tolerance) {
+            if (++stable_count >= config.lock_frames) {
+                is_locked = true;
+                stable_count = 0;
+            }
+            return false;
+        }
+        stable_count = 0;
+
+        // Пропорційний крок, не більше ніж удвічі за кадр (середнє 0 теж дає подвоєння)
+        const uint32_t level = (uint32_t)exposure_value * (16 + gain_value) / 16;
+        uint32_t next = mean ? level * config.target_mean / mean : level * 2;
+        if (next > level * 2) next = level * 2;
+        if (next < level / 2) next = level / 2;
+        return setLevel(next);
+    }
+
+    uint16_t exposure() const { return exposure_value; }
+    uint8_t gain() const { return gain_value; }
+    bool locked() const { return is_locked; }
+
+private:
+    // Спочатку витримка (менше шуму), підсилення - лише понад max_exposure
+    bool setLevel(uint32_t level) {
+        uint32_t exposure = level;
+        uint32_t gain = 0;
+        if (exposure > config.max_exposure) {
+            exposure = config.max_exposure;
+            gain = (level * 16 + exposure - 1) / exposure - 16;
+            if (gain > config.max_gain) gain = config.max_gain;
+        }
+        if (exposure < config.min_exposure) exposure = config.min_exposure;
+
+        const bool changed = exposure != exposure_value || gain != gain_value;
+        exposure_value = (uint16_t)exposure;
+        gain_value = (uint8_t)gain;
+        return changed;
+    }
+
+    ExposureControllerConfig config;
+    uint16_t exposure_value;
+    uint8_t gain_value;
+    bool is_locked;
+    uint8_t stable_count;
+    uint8_t unstable_count;
+};
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef _HAL_H_
+#define _HAL_H_
+
+// Тонкий шар платформи для прошивки: камера, пам'ять, час, задачі та HTTP.
+// Прошивка не викликає esp_camera_*, heap_caps_*, httpd_*, WiFi чи FreeRTOS напряму,
+// тож той самий loop() збирається і для ESP32, і як віртуальний пристрій на Linux.
+//
+//   ESP32 (Arduino)            - hal/HalEsp32.h
+//   Linux, VIRTUAL_DEVICE=1    - host/HalHost.h (камера з файлу запису, HTTP без мережі)
+//
+// Обидві реалізації дають однакові імена:
+//   hal_frame_t, hal_task_t, hal_http_req_t, hal_err_t, HAL_OK, HAL_FAIL
+//   halCameraInit / halCameraGet / halCameraReturn / halCameraSetExposure / halFrameFormat
+//   halMillis / halMicros / halDelay
+//   halAllocExternal / halAllocAligned / halFree / halFreeHeap / halMinFreeHeap / halFreePsram / halPsramSize / halPlatformName
+//   halWeightsMap
+//   halTaskStart / halTaskNotify / halTaskWait
+//   HalHttpRoute, halHttpStart / halHttpSetType / halHttpSetHeader / halHttpSetStatus / halHttpSend / halHttpSendChunk
+//   halWifiConnect / halWifiAddress
+
+#if defined(VIRTUAL_DEVICE) && VIRTUAL_DEVICE == 1
+#include "host/HalHost.h"
+#else
+#include "hal/HalEsp32.h"
+#endif
+
+#endif
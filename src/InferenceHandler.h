@@ -2,8 +2,16 @@
 #define _INFERENCE_HANDLER_H_
 
 #include <Arduino.h>
-#include "esp_camera.h"
+#include <atomic>
+#include "Hal.h"
 #include <Robotics_Practice_inferencing.h>
+#include "edge-impulse-sdk/dsp/image/processing.hpp"
+#include "Telemetry.h"
+#include "FrameQuality.h"
+#ifdef ANOMALY_MODEL
+// Кластери з tools/fit_anomaly.cpp
+#include "AnomalyModel.h"
+#endif
 
 #define EI_CAMERA_RAW_FRAME_BUFFER_COLS 96
 #define EI_CAMERA_RAW_FRAME_BUFFER_ROWS 96
@@ -11,161 +19,400 @@
 
 // Один буфер для 8-біт граyscale (96x96 = 9216 байт)
 static uint8_t *gray_buffer = NULL;
-
-// Функція для отримання даних - просто нормалізуємо от 0 до 1
-static int ei_camera_get_data(size_t offset, size_t length, float *out_ptr) {
-    for (size_t i = 0; i < length; i++) {
-        out_ptr[i] = (float)gray_buffer[offset + i] / 255.0f;
-    }
-    return 0;
-}
+// false - буфер належить політиці розміщення пам'яті, тут його не звільняємо
+static bool gray_buffer_owned = false;
 
 // Ініціалізація буфера при першому запиту
-bool ei_camera_init() {
+// placed_buffer - буфер кадру з ei_memory_placement_apply (або NULL - виділити в PSRAM)
+bool ei_camera_init(uint8_t *placed_buffer = NULL) {
     if (gray_buffer != NULL) return true;
-    
-    gray_buffer = (uint8_t *)ps_malloc(EI_CAMERA_RAW_FRAME_SIZE);
+
+    if (placed_buffer != NULL) {
+        gray_buffer = placed_buffer;
+        gray_buffer_owned = false;
+        return true;
+    }
+
+    gray_buffer = (uint8_t *)halAllocExternal(EI_CAMERA_RAW_FRAME_SIZE);
     if (gray_buffer == NULL) {
         Serial.println("Failed to allocate gray buffer");
         return false;
     }
+    gray_buffer_owned = true;
     return true;
 }
 
-// Захоплення кадру - камера вже дає Grayscale, просто копіюємо
-bool ei_camera_capture(camera_fb_t* fb) {
+// Сірий кадр з YUV422/RGB565 більшого розміру, перш ніж його зменшити до входу моделі (PSRAM,
+// росте до найбільшого кадру)
+static uint8_t *convert_buffer = NULL;
+static size_t convert_buffer_bytes = 0;
+
+// Сірий кадр w x h у gray_buffer: розмір моделі копіюється, більший (від 192 по короткій стороні)
+// обрізається по центру й усереднюється до 96x96 по площі просто з джерела
+static bool ei_camera_fit_gray(const uint8_t* gray, size_t w, size_t h) {
+    using namespace ei::image::processing;
+    if (w == EI_CAMERA_RAW_FRAME_BUFFER_COLS && h == EI_CAMERA_RAW_FRAME_BUFFER_ROWS) {
+        memcpy(gray_buffer, gray, EI_CAMERA_RAW_FRAME_SIZE);
+        return true;
+    }
+    // менше ніж удвічі resize_image_using_mode копіює в gray_buffer весь crop - він туди не влазить
+    if (w < 2 * EI_CAMERA_RAW_FRAME_BUFFER_COLS || h < 2 * EI_CAMERA_RAW_FRAME_BUFFER_ROWS) {
+        return false;
+    }
+    return resize_image_using_mode(gray, (int)w, (int)h, gray_buffer,
+                                   EI_CAMERA_RAW_FRAME_BUFFER_COLS, EI_CAMERA_RAW_FRAME_BUFFER_ROWS, 1,
+                                   EI_CLASSIFIER_RESIZE_FIT_SHORTEST,
+                                   EI_CLASSIFIER_RESIZE_FILTER_AREA) == ei::EIDSP_OK;
+}
+
+// Захоплення кадру в gray_buffer. Grayscale береться як є, з YUV422 - площина Y, RGB565
+// перераховується в яскравість (конвертери SDK, SIMD/SWAR де є). Кадр розміру моделі
+// конвертується просто в gray_buffer, більший - спершу цілим у convert_buffer, далі як сірий
+bool ei_camera_capture(hal_frame_t* fb) {
     if (!fb || !gray_buffer) return false;
-    
-    // Якщо камера налаштована на PIXFORMAT_GRAYSCALE, 
-    // fb->buf містить 8-біт grayscale дані (9216 байт для 96x96)
-    if (fb->len != EI_CAMERA_RAW_FRAME_SIZE) {
-        // Якщо розмір не збігається, це може бути додатковий header
-        if (fb->len >= EI_CAMERA_RAW_FRAME_SIZE) {
-            memcpy(gray_buffer, fb->buf, EI_CAMERA_RAW_FRAME_SIZE);
-        } else {
-            return false;
+
+    using namespace ei::image::processing;
+    const size_t w = fb->width, h = fb->height;
+    const bool model_size = w == EI_CAMERA_RAW_FRAME_BUFFER_COLS && h == EI_CAMERA_RAW_FRAME_BUFFER_ROWS;
+    const HalPixelFormat format = halFrameFormat(fb);
+    if (format == HAL_PIXEL_GRAY) {
+        // Якщо розмір більший, це може бути додатковий header
+        if (fb->len < w * h) return false;
+        return ei_camera_fit_gray(fb->buf, w, h);
+    }
+    if (format != HAL_PIXEL_YUV422 && format != HAL_PIXEL_RGB565) {
+        return false;
+    }
+    // 2 байти на піксель в обох форматах
+    if (fb->len < 2 * w * h) return false;
+    if (!model_size && (w < 2 * EI_CAMERA_RAW_FRAME_BUFFER_COLS || h < 2 * EI_CAMERA_RAW_FRAME_BUFFER_ROWS)) {
+        return false;
+    }
+
+    uint8_t* gray = gray_buffer;
+    if (!model_size) {
+        if (convert_buffer_bytes < w * h) {
+            halFree(convert_buffer);
+            convert_buffer = (uint8_t *)halAllocExternal(w * h);
+            convert_buffer_bytes = convert_buffer ? w * h : 0;
+            if (convert_buffer == NULL) return false;
         }
+        gray = convert_buffer;
+    }
+    const int res = format == HAL_PIXEL_YUV422
+        ? yuv422_to_gray(gray, fb->buf, (unsigned int)(2 * w * h), YUYV_ORDER)
+        : rgb565_to_gray(gray, fb->buf, (unsigned int)(2 * w * h), RGB565_BIG_ENDIAN);
+    if (res != ei::EIDSP_OK) return false;
+    return model_size || ei_camera_fit_gray(gray, w, h);
+}
+
+// Оцінка якості кадру перед інференцією: темні, пересвічені, безконтрастні та змазані кадри
+// до класифікатора не доходять
+static const FrameQualityConfig frame_quality_config = {
+    40,     // min_mean
+    210,    // max_mean
+    144,    // min_variance (σ = 12)
+    40,     // min_sharpness
+    150,    // max_clip_permille
+    4,      // clip_low
+    251,    // clip_high
+};
+
+// Експозиція під купюру: ціль - середня яскравість 110, витримка не довше 800 (далі підсилення)
+static const ExposureControllerConfig exposure_config = {
+    110,    // target_mean
+    12,     // lock_tolerance
+    40,     // unlock_tolerance
+    2,      // lock_frames
+    3,      // unlock_frames
+    20,     // min_exposure
+    800,    // max_exposure
+    30,     // max_gain
+    300,    // initial_exposure
+};
+static ExposureController exposure_controller(exposure_config);
+static uint16_t frame_quality_rejected[FRAME_QUALITY_REJECT_REASONS] = { 0 };
+
+// Ручна експозиція з початковими значеннями регулятора (після halCameraInit)
+bool ei_camera_exposure_init() {
+    return halCameraSetExposure(true, exposure_controller.exposure(), exposure_controller.gain());
+}
+
+// Текст останнього результату для веб-статусу, без String конкатенацій.
+// Два буфери по черзі, щоб читач не бачив рядок посеред запису
+static char inference_result_text[2][48];
+static uint8_t inference_result_ix = 0;
+
+// Підсумки сесії для веб-статусу. Стан блоку label totals змінює run_classifier у циклі кадру,
+// тож задача httpd його не чіпає: цикл публікує копію після кожного кадру (лічильник непарний,
+// поки копія пишеться - читач повторює), а скидання лише просить - цикл скидає між кадрами
+static ei_label_totals_t label_totals_published;
+static std::atomic<uint32_t> label_totals_seq(0);
+static std::atomic<bool> label_totals_reset_requested(false);
+
+static void labelTotalsPublish(const ei_label_totals_t& totals) {
+    label_totals_seq.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    memcpy(&label_totals_published, &totals, sizeof(totals));
+    label_totals_seq.fetch_add(1, std::memory_order_release);
+}
+
+// Копія підсумків з будь-якої задачі; false - цикл кадру ще нічого не опублікував
+bool labelTotalsRead(ei_label_totals_t* totals) {
+    for (;;) {
+        const uint32_t seq = label_totals_seq.load(std::memory_order_acquire);
+        if (seq == 0) return false;
+        if (seq & 1) continue;
+        memcpy(totals, &label_totals_published, sizeof(*totals));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (label_totals_seq.load(std::memory_order_relaxed) == seq) return true;
+    }
+}
+
+// Нова сесія з будь-якої задачі: скидання - перед наступним кадром
+void labelTotalsRequestReset() {
+    label_totals_reset_requested.store(true);
+}
+
+// Додати детекцію до запису телеметрії, лишаючи TELEMETRY_MAX_DETECTIONS найкращих
+static void telemetryAddDetection(TelemetryRecord* rec, const ei_impulse_result_bounding_box_t& bb) {
+    uint8_t confidence = (uint8_t)(bb.value * 255.0f + 0.5f);
+    uint8_t slot = rec->detection_count;
+    if (slot == TELEMETRY_MAX_DETECTIONS) {
+        slot = TELEMETRY_MAX_DETECTIONS - 1;
+        if (confidence <= rec->detections[slot].confidence) return;
     } else {
-        memcpy(gray_buffer, fb->buf, EI_CAMERA_RAW_FRAME_SIZE);
+        rec->detection_count++;
     }
-    
-    return true;
+    // вставка зі зсувом, записи відсортовані за впевненістю
+    while (slot > 0 && rec->detections[slot - 1].confidence < confidence) {
+        rec->detections[slot] = rec->detections[slot - 1];
+        slot--;
+    }
+    TelemetryDetection& d = rec->detections[slot];
+    d.label = 0xFF;
+    for (uint8_t i = 0; i < EI_CLASSIFIER_LABEL_COUNT; i++) {
+        if (ei_classifier_inferencing_categories[i] == bb.label) {
+            d.label = i;
+            break;
+        }
+    }
+    d.confidence = confidence;
+    d.x = bb.x > 255 ? 255 : bb.x;
+    d.y = bb.y > 255 ? 255 : bb.y;
+    d.width = bb.width > 255 ? 255 : bb.width;
+    d.height = bb.height > 255 ? 255 : bb.height;
 }
 
-// Перевірка чи label є валідна UAH номінал
-bool isValidUAHLabel(const String& label) {
-    // Перевіряємо наявність '_UAH' у label
-    if (label.indexOf("_UAH") == -1) {
-        return false;
+#ifdef ANOMALY_MODEL
+// Незвичність купюри без другого проходу мережі: ознаки детектора (карта вузла anomaly_model.tap_node)
+// копіюються під час invoke, після детекції клітинка під центром рамки порівнюється з кластерами
+// справжніх купюр у int8
+static int8_t anomaly_map[ANOMALY_MAP_BYTES];
+static ei_anomaly_fixed_state_t anomaly_state;
+
+bool ei_anomaly_init() {
+    return ei_anomaly_fixed_attach(ei_default_impulse.impulse, 0, &anomaly_model, &anomaly_state,
+                                   anomaly_map, sizeof(anomaly_map)) == EI_IMPULSE_OK;
+}
+
+static void scoreAnomaly(const TelemetryDetection& d, TelemetryRecord* rec) {
+    ei_impulse_result_bounding_box_t bb = { 0 };
+    bb.x = d.x;
+    bb.y = d.y;
+    bb.width = d.width;
+    bb.height = d.height;
+    uint32_t start_us = halMicros();
+    float score;
+    if (ei_anomaly_fixed_score_box(&anomaly_state, &bb, EI_CLASSIFIER_INPUT_WIDTH, EI_CLASSIFIER_INPUT_HEIGHT,
+                                   &score) != EI_IMPULSE_OK) {
+        return;
+    }
+    float milli = score * 1000.0f;
+    rec->anomaly_milli = milli >= INT16_MAX ? INT16_MAX : milli <= INT16_MIN + 1 ? INT16_MIN + 1 : (int16_t)milli;
+    uint32_t us = halMicros() - start_us;
+    rec->anomaly_us = us > UINT16_MAX ? UINT16_MAX : (uint16_t)us;
+}
+#endif // ANOMALY_MODEL
+
+// Друга модель (VERIFY_IMPULSE - хендл з експорту кількох імпульсів, напр. -DVERIFY_IMPULSE=impulse_handle_...):
+// класифікатор справжності отримує найкращу детекцію номіналу. Кроп квадрата навколо центру рамки
+// FOMO читається прямо з gray_buffer і масштабується на льоту під вхід верифікатора, без копії.
+// Обидві моделі ділять одне розміщення арени (ei_memory_placement_apply_shared у main.cpp):
+// виконуються по черзі, тож арена розміром з більшу з них
+#ifdef VERIFY_IMPULSE
+// Сторона квадрата кропу у пікселях кадру 96x96 (купюра, а не лише клітинка центроїда FOMO)
+#ifndef VERIFY_CROP_SIZE
+#define VERIFY_CROP_SIZE 48
+#endif
+
+static void runVerifier(const TelemetryDetection& d, uint32_t detection_start_us, TelemetryRecord* rec) {
+    using namespace ei::image::processing;
+    const ei_impulse_t* verifier = VERIFY_IMPULSE.impulse;
+
+    int size = VERIFY_CROP_SIZE;
+    if (size > EI_CAMERA_RAW_FRAME_BUFFER_COLS) size = EI_CAMERA_RAW_FRAME_BUFFER_COLS;
+    if (size > EI_CAMERA_RAW_FRAME_BUFFER_ROWS) size = EI_CAMERA_RAW_FRAME_BUFFER_ROWS;
+    int x = d.x + d.width / 2 - size / 2;
+    int y = d.y + d.height / 2 - size / 2;
+    x = x < 0 ? 0 : x > EI_CAMERA_RAW_FRAME_BUFFER_COLS - size ? EI_CAMERA_RAW_FRAME_BUFFER_COLS - size : x;
+    y = y < 0 ? 0 : y > EI_CAMERA_RAW_FRAME_BUFFER_ROWS - size ? EI_CAMERA_RAW_FRAME_BUFFER_ROWS - size : y;
+
+    crop_resize_t crop;
+    int filter = size >= (int)verifier->input_width ? EI_CLASSIFIER_RESIZE_FILTER_AREA : EI_CLASSIFIER_RESIZE_FILTER_BILINEAR;
+    if (crop_resize_init(&crop, gray_buffer, EI_CAMERA_RAW_FRAME_BUFFER_COLS, EI_CAMERA_RAW_FRAME_BUFFER_ROWS, 1,
+                         x, y, size, size, (int)verifier->input_width, (int)verifier->input_height,
+                         EI_CLASSIFIER_RESIZE_FIT_SHORTEST, filter) != ei::EIDSP_OK) {
+        rec->verify_error = (int8_t)EI_IMPULSE_INVALID_SIZE;
+        return;
+    }
+    ei::signal_view<ei::signal_source_crop_resize> signal = ei::signal_view_from_crop(crop);
+
+    uint32_t start_us = halMicros();
+    ei_impulse_result_t result = { 0 };
+    EI_IMPULSE_ERROR res = run_classifier(&VERIFY_IMPULSE, &signal, &result, false);
+    uint32_t end_us = halMicros();
+    rec->verify_us = end_us - start_us;
+    if (res != EI_IMPULSE_OK) {
+        rec->verify_error = (int8_t)res;
+        return;
     }
-    
-    // Перелік допустимих номіналів
-    const char* valid_labels[] = {
-        "5_UAH", "10_UAH", "20_UAH", "50_UAH", 
-        "100_UAH", "200_UAH", "500_UAH", "1000_UAH"
-    };
-    
-    for (int i = 0; i < 8; i++) {
-        if (label.equals(valid_labels[i])) {
-            return true;
+
+    uint16_t labels = verifier->label_count < EI_CLASSIFIER_LABEL_COUNT ? verifier->label_count : EI_CLASSIFIER_LABEL_COUNT;
+    for (uint16_t i = 0; i < labels; i++) {
+        uint8_t confidence = (uint8_t)(result.classification[i].value * 255.0f + 0.5f);
+        if (rec->verdict_label == TELEMETRY_NO_VERDICT || confidence > rec->verdict_confidence) {
+            rec->verdict_label = (uint8_t)i;
+            rec->verdict_confidence = confidence;
         }
     }
-    
-    return false;
+    rec->verdict_latency_us = end_us - detection_start_us;
 }
+#endif // VERIFY_IMPULSE
 
-// Запуск інференції з обробкою labels та логуванням
-String runInference(camera_fb_t* fb) {
-    if (!fb) {
-        Serial.println("[INFERENCE] ERROR: Frame buffer is NULL");
-        return "Frame NULL";
+// Запуск інференції. Нічого не друкує: таймінги, детекції та підсумки йдуть у rec.
+// *ran - чи запускався класифікатор і чи result заповнено (для запису кадрів)
+const char* runInference(hal_frame_t* fb, TelemetryRecord* rec, ei_impulse_result_t* result, bool* ran) {
+    *ran = false;
+    if (label_totals_reset_requested.exchange(false) && reset_label_totals() == EI_IMPULSE_OK) {
+        ei_label_totals_t totals;
+        if (get_label_totals(&totals) == EI_IMPULSE_OK) {
+            labelTotalsPublish(totals);
+        }
     }
-    
-    if (fb->buf == NULL || fb->len == 0) {
-        Serial.printf("[INFERENCE] ERROR: Invalid frame - buf=%p len=%u\n", fb->buf, fb->len);
+    if (!fb || fb->buf == NULL || fb->len == 0 || !gray_buffer || !ei_camera_capture(fb)) {
+        rec->status = TELEMETRY_INVALID_FRAME;
         return "Frame Invalid";
     }
-    
-    if (!ei_camera_capture(fb)) {
-        Serial.println("[INFERENCE] ERROR: Failed to capture frame to grayscale buffer");
-        return "Capture Failed";
+
+    // Якість кадру; експозиція регулюється за кожним кадром, навіть відкинутим
+    FrameQuality quality;
+    frameQualityMeasure(gray_buffer, EI_CAMERA_RAW_FRAME_BUFFER_COLS, EI_CAMERA_RAW_FRAME_BUFFER_ROWS,
+                        frame_quality_config, &quality);
+    if (exposure_controller.update(quality.mean)) {
+        halCameraSetExposure(true, exposure_controller.exposure(), exposure_controller.gain());
+    }
+    if (quality.reject != FRAME_QUALITY_OK && frame_quality_rejected[quality.reject - 1] < UINT16_MAX) {
+        frame_quality_rejected[quality.reject - 1]++;
     }
 
-    // Перевірка попередньої за буфером
-    if (gray_buffer == NULL) {
-        Serial.println("[INFERENCE] ERROR: Grayscale buffer not allocated!");
-        return "Buffer Error";
+    rec->quality_reject = quality.reject;
+    rec->quality_mean = quality.mean;
+    rec->quality_variance = quality.variance;
+    rec->quality_sharpness = quality.sharpness;
+    rec->quality_clip_permille = quality.clip_permille;
+    rec->exposure = exposure_controller.exposure();
+    rec->gain = exposure_controller.gain();
+    rec->exposure_locked = exposure_controller.locked();
+    memcpy(rec->rejected, frame_quality_rejected, sizeof(frame_quality_rejected));
+
+    if (quality.reject != FRAME_QUALITY_OK) {
+        rec->status = TELEMETRY_REJECTED;
+        if (!exposure_controller.locked()) return "Adjusting exposure...";
+        if (quality.reject == FRAME_QUALITY_BLURRED) return "Hold still...";
+        return "Scanning...";
     }
 
     // Підготовка сигналу для класифікатора    
-    ei::signal_t signal;
-    signal.total_length = EI_CAMERA_RAW_FRAME_SIZE;
-    signal.get_data = &ei_camera_get_data;
+    ei::signal_view<ei::signal_source_gray8> signal = ei::signal_view_from_gray8(gray_buffer, EI_CAMERA_RAW_FRAME_SIZE);
 
-    ei_impulse_result_t result = { 0 };
-    
-    uint32_t start_time = millis();
-    EI_IMPULSE_ERROR res = run_classifier(&signal, &result, false);
-    uint32_t inference_time = millis() - start_time;
+#ifdef VERIFY_IMPULSE
+    uint32_t detection_start_us = halMicros();
+#endif
+#ifdef ANOMALY_MODEL
+    ei_anomaly_fixed_begin(&anomaly_state);
+#endif
+    memset(result, 0, sizeof(ei_impulse_result_t));
+    EI_IMPULSE_ERROR res = run_classifier(&signal, result, false);
+
+    rec->dsp_us = (uint32_t)result->timing.dsp_us;
+    rec->classification_us = (uint32_t)result->timing.classification_us;
+    rec->postprocessing_us = (uint32_t)result->timing.postprocessing_us;
 
     if (res != EI_IMPULSE_OK) {
-        Serial.print("[INFERENCE] ERROR: Classifier failed with code: ");
-        Serial.println(res);
+        rec->status = TELEMETRY_CLASSIFIER_ERROR;
+        rec->classifier_error = (int8_t)res;
         return "Classifier Error";
     }
-    
-    Serial.printf("[INFERENCE] Completed in %lu ms\n", inference_time);
+    *ran = true;
 
-    float best_val = 0.0f;
-    String best_label = "";
+    ei_label_totals_t totals;
+    if (get_label_totals(&totals) == EI_IMPULSE_OK) {
+        rec->total_uah = totals.total;
+        rec->notes = (uint16_t)totals.objects;
+        labelTotalsPublish(totals);
+    }
+
+    // Подія "купюру розпізнано": усереднена впевненість за вікно кадрів, одна на купюру в кадрі
+    ei_detection_trigger_t trigger;
+    if (get_detection_trigger(&trigger) == EI_IMPULSE_OK) {
+        if (trigger.label_ix >= 0 && trigger.label_ix < EI_CLASSIFIER_LABEL_COUNT) {
+            rec->trigger_label = (uint8_t)trigger.label_ix;
+            rec->trigger_confidence = (uint8_t)(trigger.confidence * 255.0f + 0.5f);
+        }
+        rec->trigger_events = trigger.events > UINT16_MAX ? UINT16_MAX : (uint16_t)trigger.events;
+    }
+
+    ei_fomo_fusion_stats_t fusion;
+    if (get_fomo_fusion_stats(&fusion) == EI_IMPULSE_OK) {
+        rec->fusion_us = fusion.last_us > UINT16_MAX ? UINT16_MAX : (uint16_t)fusion.last_us;
+        rec->fusion_frames = fusion.frames > UINT16_MAX ? UINT16_MAX : (uint16_t)fusion.frames;
+    }
 
     // Модель використовує FOMO (об'єктна детекція)
-    if (result.bounding_boxes_count > 0) {
-        Serial.printf("[INFERENCE] Found %u bounding boxes\n", result.bounding_boxes_count);
-        
-        for (uint32_t i = 0; i < result.bounding_boxes_count; i++) {
-            if (result.bounding_boxes[i].label == NULL) {
-                Serial.printf("[DETECTION] Box %u: NULL label, confidence: %.2f\n",
-                             i, result.bounding_boxes[i].value);
-                continue;
-            }
-            
-            Serial.printf("[DETECTION] Box %u: %s (%.2f)\n",
-                         i, 
-                         result.bounding_boxes[i].label,
-                         result.bounding_boxes[i].value);
-            
-            if (result.bounding_boxes[i].value > best_val) {
-                best_val = result.bounding_boxes[i].value;
-                best_label = String(result.bounding_boxes[i].label);
-            }
+    for (uint32_t i = 0; i < result->bounding_boxes_count; i++) {
+        if (result->bounding_boxes[i].label != NULL) {
+            telemetryAddDetection(rec, result->bounding_boxes[i]);
         }
-    } else {
-        Serial.println("[INFERENCE] No objects detected (empty bounding boxes)");
     }
 
     // Поріг довіри 50%
-    if (best_val > 0.50f) {
-        // Перевіряємо чи це валідна UAH номіналу
-        if (isValidUAHLabel(best_label)) {
-            String result_str = best_label + " " + String((int)(best_val * 100)) + "%";
-            Serial.print("[RECOGNIZED] ");
-            Serial.println(result_str);
-            return result_str;
-        } else {
-            Serial.print("[UNRECOGNIZED_LABEL] ");
-            Serial.println(best_label);
-            return "Invalid: " + best_label;
-        }
+    if (rec->detection_count > 0 && rec->detections[0].confidence > 127 &&
+        rec->detections[0].label < EI_CLASSIFIER_LABEL_COUNT) {
+#ifdef ANOMALY_MODEL
+        scoreAnomaly(rec->detections[0], rec);
+#endif
+#ifdef VERIFY_IMPULSE
+        runVerifier(rec->detections[0], detection_start_us, rec);
+#endif
+        char* text = inference_result_text[inference_result_ix];
+        inference_result_ix ^= 1;
+        // Поза всіма кластерами справжніх купюр - на перевірку
+        snprintf(text, sizeof(inference_result_text[0]), "%s %d%%%s",
+                 ei_classifier_inferencing_categories[rec->detections[0].label],
+                 (int)rec->detections[0].confidence * 100 / 255,
+                 rec->anomaly_milli != TELEMETRY_NO_ANOMALY && rec->anomaly_milli > 0 ? " (check)" : "");
+        return text;
     }
 
-    Serial.printf("[INFERENCE] Confidence %.2f below threshold (50%%)\n", best_val);
     return "Scanning...";
 }
 
 void ei_camera_deinit() {
     if (gray_buffer != NULL) {
-        free(gray_buffer);
+        if (gray_buffer_owned) {
+            halFree(gray_buffer);
+        }
         gray_buffer = NULL;
     }
 }
@@ -0,0 +1,298 @@
+#ifndef _TELEMETRY_H_
+#define _TELEMETRY_H_
+
+#include <Arduino.h>
+#include <atomic>
+#include <Robotics_Practice_inferencing.h>
+#include "Hal.h"
+#include "FrameQuality.h"
+
+// Телеметрія кадрів: цикл кадру лише заповнює запис фіксованого розміру і кладе його в
+// кільцевий буфер (один писач, один читач, без блокувань і без heap).
+// Фонова задача з низьким пріоритетом на ядрі 0 забирає записи і відправляє в Serial.
+//
+// Формат пакета (TELEMETRY_BINARY = 1): 0x00, COBS(запис + CRC16-CCITT little endian), 0x00.
+// Нулі розділяють пакети, тому текст з setup() і пакети можна змішувати в одному порті.
+// Перший байт запису - його версія; пакет з першим байтом TELEMETRY_PACKET_CAPTURE несе
+// запис кадру (CaptureRecorder.h) замість запису телеметрії.
+// Декодер: tools/telemetry_decode.py (текст або CSV, записи кадрів - у файл).
+
+// 1 - бінарні пакети, 0 - текстові рядки (форматує фонова задача, не цикл кадру)
+#ifndef TELEMETRY_BINARY
+#define TELEMETRY_BINARY 1
+#endif
+
+#define TELEMETRY_VERSION 6
+// Скільки найкращих детекцій потрапляє в запис
+#define TELEMETRY_MAX_DETECTIONS 4
+// verdict_label, коли верифікатор не запускався
+#define TELEMETRY_NO_VERDICT 0xFF
+// anomaly_milli, коли оцінки незвичності немає
+#define TELEMETRY_NO_ANOMALY INT16_MIN
+// Довжина черги, степінь двійки
+#define TELEMETRY_QUEUE_LEN 16
+// Перший байт пакета з записом кадру (версії записів телеметрії - 1..TELEMETRY_VERSION)
+#define TELEMETRY_PACKET_CAPTURE 0xCA
+
+enum TelemetryStatus : uint8_t {
+    TELEMETRY_OK = 0,
+    TELEMETRY_NO_FRAME = 1,         // halCameraGet повернув NULL
+    TELEMETRY_INVALID_FRAME = 2,    // порожній або закороткий кадр
+    TELEMETRY_CLASSIFIER_ERROR = 3, // run_classifier не EI_IMPULSE_OK (код у classifier_error)
+    TELEMETRY_REJECTED = 4,         // кадр не пройшов оцінку якості (причина в quality_reject)
+};
+
+struct __attribute__((packed)) TelemetryDetection {
+    uint8_t label;          // індекс у ei_classifier_inferencing_categories
+    uint8_t confidence;     // 0..255 = 0..1
+    uint8_t x;              // координати рамки у вхідних пікселях моделі (96x96)
+    uint8_t y;
+    uint8_t width;
+    uint8_t height;
+};
+
+struct __attribute__((packed)) TelemetryRecord {
+    uint8_t version;
+    uint8_t status;             // TelemetryStatus
+    int8_t classifier_error;    // EI_IMPULSE_ERROR
+    uint8_t detection_count;    // заповнені елементи detections
+    uint32_t frame_id;
+    uint32_t timestamp_ms;      // halMillis() на момент захоплення
+    uint32_t frame_us;          // захоплення + інференція + постобробка
+    uint32_t dsp_us;
+    uint32_t classification_us;
+    uint32_t postprocessing_us;
+    uint32_t free_heap;
+    uint32_t min_free_heap;
+    uint32_t free_psram;
+    uint32_t ei_memory_in_use;  // 0 без EI_CLASSIFIER_USE_POOL_ALLOCATOR
+    uint32_t ei_memory_peak;
+    uint32_t total_uah;         // підсумок сесії з блоку label totals
+    uint16_t notes;
+    uint16_t dropped;           // записи, втрачені перед цим через повну чергу
+    uint8_t quality_reject;     // FrameQualityReject
+    uint8_t quality_mean;
+    uint16_t quality_variance;
+    uint16_t quality_sharpness; // дисперсія лапласіана
+    uint16_t quality_clip_permille;
+    uint16_t exposure;          // значення, з яким знято наступні кадри
+    uint8_t gain;
+    uint8_t exposure_locked;
+    uint16_t rejected[FRAME_QUALITY_REJECT_REASONS];    // відкинуті кадри з запуску, за причинами
+    uint16_t fusion_us;         // злиття теплових карт FOMO, частина postprocessing_us
+    uint16_t fusion_frames;     // кадрів у накопичувачі злиття (насичується)
+    uint8_t verdict_label;      // клас верифікатора (VERIFY_IMPULSE) для найкращої детекції, або TELEMETRY_NO_VERDICT
+    uint8_t verdict_confidence; // 0..255 = 0..1
+    int8_t verify_error;        // EI_IMPULSE_ERROR верифікатора
+    uint32_t verify_us;         // run_classifier верифікатора
+    uint32_t verdict_latency_us;    // від запуску детектора до вердикту
+    int16_t anomaly_milli;      // незвичність найкращої детекції x1000 (ANOMALY_MODEL), > 0 - поза кластерами, або TELEMETRY_NO_ANOMALY
+    uint16_t anomaly_us;
+    uint8_t trigger_label;      // купюра, розпізнана в цьому кадрі (блок detection trigger), або TELEMETRY_NO_VERDICT
+    uint8_t trigger_confidence; // усереднена за вікно, 0..255 = 0..1
+    uint16_t trigger_events;    // подій з запуску (насичується)
+    TelemetryDetection detections[TELEMETRY_MAX_DETECTIONS];
+};
+
+static_assert((TELEMETRY_QUEUE_LEN & (TELEMETRY_QUEUE_LEN - 1)) == 0, "TELEMETRY_QUEUE_LEN must be a power of two");
+
+static TelemetryRecord telemetry_queue[TELEMETRY_QUEUE_LEN];
+static std::atomic<uint32_t> telemetry_head(0);   // пише лише цикл кадру
+static std::atomic<uint32_t> telemetry_tail(0);   // пише лише задача телеметрії
+static uint16_t telemetry_dropped = 0;
+static hal_task_t telemetry_task = NULL;
+// Що ще задача телеметрії відправляє після черги записів (запис кадрів у Serial)
+static void (*telemetry_extra)() = NULL;
+
+// Запис для наступного кадру, або NULL якщо черга повна (запис буде врахований у dropped)
+TelemetryRecord* telemetryAcquire() {
+    uint32_t head = telemetry_head.load(std::memory_order_relaxed);
+    if (head - telemetry_tail.load(std::memory_order_acquire) >= TELEMETRY_QUEUE_LEN) {
+        if (telemetry_dropped < UINT16_MAX) telemetry_dropped++;
+        return NULL;
+    }
+    TelemetryRecord* rec = &telemetry_queue[head & (TELEMETRY_QUEUE_LEN - 1)];
+    memset(rec, 0, sizeof(TelemetryRecord));
+    rec->version = TELEMETRY_VERSION;
+    rec->dropped = telemetry_dropped;
+    rec->verdict_label = TELEMETRY_NO_VERDICT;
+    rec->anomaly_milli = TELEMETRY_NO_ANOMALY;
+    rec->trigger_label = TELEMETRY_NO_VERDICT;
+    return rec;
+}
+
+// Віддати заповнений запис задачі телеметрії
+void telemetryCommit() {
+    telemetry_dropped = 0;
+    telemetry_head.store(telemetry_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    if (telemetry_task != NULL) {
+        halTaskNotify(telemetry_task);
+    }
+}
+
+static uint16_t telemetryCrc16Update(uint16_t crc, uint8_t byte) {
+    crc ^= (uint16_t)byte << 8;
+    for (int b = 0; b < 8; b++) {
+        crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+    return crc;
+}
+
+static uint16_t telemetryCrc16(const uint8_t* data, size_t len) {
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < len; i++) {
+        crc = telemetryCrc16Update(crc, data[i]);
+    }
+    return crc;
+}
+
+// COBS: жодного нуля всередині пакета. out має вміщати len + len / 254 + 1 байт
+static size_t telemetryCobsEncode(const uint8_t* in, size_t len, uint8_t* out) {
+    size_t code_ix = 0;
+    size_t out_ix = 1;
+    uint8_t code = 1;
+    for (size_t i = 0; i < len; i++) {
+        if (in[i] == 0) {
+            out[code_ix] = code;
+            code_ix = out_ix++;
+            code = 1;
+            continue;
+        }
+        out[out_ix++] = in[i];
+        if (++code == 0xFF) {
+            out[code_ix] = code;
+            code_ix = out_ix++;
+            code = 1;
+        }
+    }
+    out[code_ix] = code;
+    return out_ix;
+}
+
+#if TELEMETRY_BINARY == 1
+// Пакет, що кодується на льоту, без буфера на все тіло (запис кадру - кілобайти): COBS блоками
+// до 254 байтів прямо в Serial, CRC16 рахується по дорозі. Лише з задачі телеметрії
+struct TelemetryStream {
+    uint8_t block[255];
+    size_t len;         // block[0] - код блоку, далі len - 1 байтів
+    uint16_t crc;
+};
+
+static void telemetryStreamPut(TelemetryStream* stream, uint8_t byte) {
+    if (byte != 0) {
+        stream->block[stream->len++] = byte;
+    }
+    if (byte == 0 || stream->len == 0xFF) {
+        stream->block[0] = (uint8_t)stream->len;
+        Serial.write(stream->block, stream->len);
+        stream->len = 1;
+    }
+}
+
+static void telemetryStreamWrite(TelemetryStream* stream, const void* data, size_t len) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    for (size_t i = 0; i < len; i++) {
+        stream->crc = telemetryCrc16Update(stream->crc, bytes[i]);
+        telemetryStreamPut(stream, bytes[i]);
+    }
+}
+
+static void telemetryStreamBegin(TelemetryStream* stream, uint8_t kind) {
+    static const uint8_t delimiter = 0;
+    Serial.write(&delimiter, 1);
+    stream->len = 1;
+    stream->crc = 0xFFFF;
+    telemetryStreamWrite(stream, &kind, 1);
+}
+
+static void telemetryStreamEnd(TelemetryStream* stream) {
+    static const uint8_t delimiter = 0;
+    const uint16_t crc = stream->crc;
+    telemetryStreamPut(stream, crc & 0xFF);
+    telemetryStreamPut(stream, crc >> 8);
+    stream->block[0] = (uint8_t)stream->len;
+    Serial.write(stream->block, stream->len);
+    Serial.write(&delimiter, 1);
+}
+
+static void telemetrySend(const TelemetryRecord* rec) {
+    static uint8_t raw[sizeof(TelemetryRecord) + 2];
+    static uint8_t packet[sizeof(raw) + sizeof(raw) / 254 + 3];
+
+    memcpy(raw, rec, sizeof(TelemetryRecord));
+    uint16_t crc = telemetryCrc16(raw, sizeof(TelemetryRecord));
+    raw[sizeof(TelemetryRecord)] = crc & 0xFF;
+    raw[sizeof(TelemetryRecord) + 1] = crc >> 8;
+
+    packet[0] = 0;
+    size_t len = 1 + telemetryCobsEncode(raw, sizeof(raw), packet + 1);
+    packet[len++] = 0;
+    Serial.write(packet, len);
+}
+#else
+static void telemetrySend(const TelemetryRecord* rec) {
+    Serial.printf("[FRAME %lu] t=%lu ms status=%u err=%d frame=%lu us dsp=%lu us nn=%lu us pp=%lu us\n",
+                  (unsigned long)rec->frame_id, (unsigned long)rec->timestamp_ms, rec->status,
+                  rec->classifier_error, (unsigned long)rec->frame_us, (unsigned long)rec->dsp_us,
+                  (unsigned long)rec->classification_us, (unsigned long)rec->postprocessing_us);
+    for (uint8_t i = 0; i < rec->detection_count; i++) {
+        const TelemetryDetection& d = rec->detections[i];
+        const char* label = d.label < EI_CLASSIFIER_LABEL_COUNT ? ei_classifier_inferencing_categories[d.label] : "?";
+        Serial.printf("  %s %u%% [x: %u, y: %u, width: %u, height: %u]\n",
+                      label, (unsigned)(d.confidence * 100 / 255), d.x, d.y, d.width, d.height);
+    }
+    Serial.printf("  total %lu UAH (%u notes), heap %lu (min %lu), psram %lu, ei %lu (peak %lu), dropped %u\n",
+                  (unsigned long)rec->total_uah, rec->notes, (unsigned long)rec->free_heap,
+                  (unsigned long)rec->min_free_heap, (unsigned long)rec->free_psram,
+                  (unsigned long)rec->ei_memory_in_use, (unsigned long)rec->ei_memory_peak, rec->dropped);
+    Serial.printf("  quality %s mean %u var %u sharp %u clip %u/1000, exposure %u gain %u%s, rejected",
+                  frameQualityRejectName((FrameQualityReject)rec->quality_reject), rec->quality_mean,
+                  rec->quality_variance, rec->quality_sharpness, rec->quality_clip_permille,
+                  rec->exposure, rec->gain, rec->exposure_locked ? " locked" : "");
+    for (uint8_t i = 0; i < FRAME_QUALITY_REJECT_REASONS; i++) {
+        Serial.printf(" %s %u", frameQualityRejectName((FrameQualityReject)(i + 1)), rec->rejected[i]);
+    }
+    Serial.printf("\n  fusion %u us over %u frames\n", rec->fusion_us, rec->fusion_frames);
+    if (rec->verdict_label != TELEMETRY_NO_VERDICT || rec->verify_error != 0) {
+        Serial.printf("  verdict %u %u%% err=%d, verify %lu us, detection to verdict %lu us\n",
+                      rec->verdict_label, (unsigned)(rec->verdict_confidence * 100 / 255), rec->verify_error,
+                      (unsigned long)rec->verify_us, (unsigned long)rec->verdict_latency_us);
+    }
+    if (rec->trigger_label < EI_CLASSIFIER_LABEL_COUNT) {
+        Serial.printf("  recognised %s %u%% (event %u)\n", ei_classifier_inferencing_categories[rec->trigger_label],
+                      (unsigned)(rec->trigger_confidence * 100 / 255), rec->trigger_events);
+    }
+    if (rec->anomaly_milli != TELEMETRY_NO_ANOMALY) {
+        Serial.printf("  anomaly %d/1000 in %u us\n", rec->anomaly_milli, rec->anomaly_us);
+    }
+}
+#endif // TELEMETRY_BINARY
+
+static void telemetryTask(void* arg) {
+    for (;;) {
+        halTaskWait(1000);
+        uint32_t tail = telemetry_tail.load(std::memory_order_relaxed);
+        while (tail != telemetry_head.load(std::memory_order_acquire)) {
+            telemetrySend(&telemetry_queue[tail & (TELEMETRY_QUEUE_LEN - 1)]);
+            tail++;
+            telemetry_tail.store(tail, std::memory_order_release);
+        }
+        if (telemetry_extra != NULL) {
+            telemetry_extra();
+        }
+    }
+}
+
+// Додаткові пакети після черги записів, до telemetryBegin()
+void telemetrySetExtra(void (*fn)()) {
+    telemetry_extra = fn;
+}
+
+// Запуск задачі телеметрії: ядро 0, пріоритет 1 - цикл кадру на ядрі 1 її не чекає
+bool telemetryBegin() {
+    if (telemetry_task != NULL) return true;
+    telemetry_task = halTaskStart(telemetryTask, "telemetry", 3072, 1, 0);
+    return telemetry_task != NULL;
+}
+
+#endif
@@ -1,13 +1,13 @@
 #pragma once
 #include <Arduino.h>
-#include <WiFi.h>
-#include "esp_http_server.h"
-#include "esp_camera.h"
-#include "StreamHandler.h"
+#include <Robotics_Practice_inferencing.h>
+#include "Hal.h"
+#include "InferenceHandler.h"
+#include "CaptureScheduler.h"
+#include "CaptureRecorder.h"
 
-extern String global_result;
-extern volatile bool scan_request;
-extern volatile bool inference_active;  // Флаг для паузи стрімінгу під час AI
+extern const char* volatile global_result;
+extern CaptureScheduler capture_scheduler;  // ділить камеру між стрімом та інференцією
 
 // Компактна HTML сторінка з потоковим відео
 static const char* index_html = R"rawtext(
@@ -25,9 +25,11 @@ button:hover{background:#00AA00;}
     <h1>UAH Banknote Scanner 2.0</h1>
     <img src="/stream" class="stream" alt="Live Stream">
     <div class="status" id="status">READY</div>
+    <div class="status" id="total">TOTAL: 0 UAH</div>
     <div>
         <button onclick="scan()">START SCAN</button>
         <button onclick="location.reload()">REFRESH</button>
+        <button onclick="fetch('/api/reset', {method:'POST'})">RESET TOTAL</button>
     </div>
     <p id="memory" style="font-size:12px;color:#888;"></p>
     
@@ -38,6 +40,7 @@ button:hover{background:#00AA00;}
                 .then(d => {
                     document.getElementById('status').innerText = d.result || 'SCANNING...';
                     document.getElementById('memory').innerText = 'Free RAM: ' + d.heap + ' bytes';
+                    document.getElementById('total').innerText = 'TOTAL: ' + d.total + ' UAH (' + d.notes + ' notes)';
                 })
                 .catch(e => console.log('Status error:', e));
         }, 1000);
@@ -53,60 +56,81 @@ button:hover{background:#00AA00;}
 </body></html>
 )rawtext";
 
-static httpd_handle_t server = NULL;
+// Статус, пам'ять та підсумки сесії
+hal_err_t status_handler(hal_http_req_t *req) {
+    // копія з циклу кадру (InferenceHandler.h): стан блоку підсумків тут не читається
+    ei_label_totals_t totals;
+    if (!labelTotalsRead(&totals)) {
+        memset(&totals, 0, sizeof(totals));
+    }
 
-// Статус та пам'ять
-esp_err_t status_handler(httpd_req_t *req) {
-    char json[256];
-    snprintf(json, sizeof(json), 
-        "{\"result\":\"%s\",\"heap\":%lu}", 
-        global_result.c_str(),
-        esp_get_free_heap_size());
-    httpd_resp_set_type(req, "application/json");
-    return httpd_resp_send(req, json, -1);
+    char json[512];
+    int len = snprintf(json, sizeof(json),
+        "{\"result\":\"%s\",\"heap\":%lu,\"total\":%lu,\"notes\":%lu,\"counts\":{",
+        global_result,
+        (unsigned long)halFreeHeap(),
+        (unsigned long)totals.total,
+        (unsigned long)totals.objects);
+    for (uint16_t i = 0; i < totals.label_count && len < (int)sizeof(json); i++) {
+        len += snprintf(json + len, sizeof(json) - len, "%s\"%s\":%lu", i ? "," : "",
+            ei_classifier_inferencing_categories[i], (unsigned long)totals.counts[i]);
+    }
+    if (len < (int)sizeof(json)) {
+        snprintf(json + len, sizeof(json) - len, "}}");
+    }
+    halHttpSetType(req, "application/json");
+    return halHttpSend(req, json, -1);
 }
 
 // Запуск сканування
-esp_err_t scan_handler(httpd_req_t *req) {
+hal_err_t scan_handler(hal_http_req_t *req) {
     Serial.println("[WEBSERVER] Scan request received");
-    scan_request = true;
-    return httpd_resp_send(req, "{\"status\":\"scanning\"}", -1);
+    capture_scheduler.requestCapture();
+    return halHttpSend(req, "{\"status\":\"scanning\"}", -1);
+}
+
+// Нова сесія - підсумки з нуля
+hal_err_t reset_handler(hal_http_req_t *req) {
+    Serial.println("[WEBSERVER] Totals reset");
+    labelTotalsRequestReset();
+    return halHttpSend(req, "{\"status\":\"reset\"}", -1);
 }
 
 // Головна сторінка
-esp_err_t index_handler(httpd_req_t *req) {
-    httpd_resp_set_type(req, "text/html; charset=utf-8");
-    return httpd_resp_send(req, index_html, -1);
+hal_err_t index_handler(hal_http_req_t *req) {
+    halHttpSetType(req, "text/html; charset=utf-8");
+    return halHttpSend(req, index_html, -1);
 }
 
 // MJPEG потокова трансляція (мінімальна пам'ять)
-esp_err_t stream_handler(httpd_req_t *req) {
-    httpd_resp_set_type(req, "multipart/x-mixed-replace; boundary=frame");
-    httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
+hal_err_t stream_handler(hal_http_req_t *req) {
+    halHttpSetType(req, "multipart/x-mixed-replace; boundary=frame");
+    halHttpSetHeader(req, "Access-Control-Allow-Origin", "*");
     
     int frame_count = 0;
     const int MAX_FRAMES = 600;  // Max 600 frames before restart (2 min @ 5fps)
     
     // Потокова передача кадрів
     while (frame_count < MAX_FRAMES) {
-        // КРИТИЧНО: Якщо працює AI інференція, приостановити стрімінг
-        // Це запобігає VSYNC overflow та socket errors
-        if (inference_active) {
-            // Чекаємо, поки AI закінчить роботу
-            vTaskDelay(100 / portTICK_PERIOD_MS);
+        // Інференція має пріоритет: коли її кадр на підході або камера зайнята,
+        // стрім чекає (це також запобігає VSYNC overflow та socket errors)
+        if (!capture_scheduler.tryAcquire(CAMERA_STREAM, halMillis())) {
+            halDelay(10);
             continue;
         }
         
-        camera_fb_t* fb = esp_camera_fb_get();
+        hal_frame_t* fb = halCameraGet();
         if (!fb) {
+            capture_scheduler.release(CAMERA_STREAM);
             Serial.println("[STREAM] Failed to get frame");
-            vTaskDelay(10 / portTICK_PERIOD_MS);
+            halDelay(10);
             continue;
         }
         
         if (fb->len == 0 || fb->buf == NULL) {
+            halCameraReturn(fb);
+            capture_scheduler.release(CAMERA_STREAM);
             Serial.println("[STREAM] Invalid frame data");
-            esp_camera_fb_return(fb);
             continue;
         }
         
@@ -117,70 +141,67 @@ esp_err_t stream_handler(httpd_req_t *req) {
             fb->len);
         
         // Надіслання header
-        if (httpd_resp_send_chunk(req, frame_header, header_len) != ESP_OK) {
+        if (halHttpSendChunk(req, frame_header, header_len) != HAL_OK) {
             Serial.println("[STREAM] Failed to send header");
-            esp_camera_fb_return(fb);
+            halCameraReturn(fb);
+            capture_scheduler.release(CAMERA_STREAM);
             break;
         }
         
         // Надіслання JPEG даних по чанках (економія RAM)
         size_t offset = 0;
-        esp_err_t error_code = ESP_OK;
+        hal_err_t error_code = HAL_OK;
         const size_t CHUNK_SIZE = 2048;  // Reduced chunk size to prevent socket errors
         
-        while (offset < fb->len && error_code == ESP_OK) {
+        while (offset < fb->len && error_code == HAL_OK) {
             size_t chunk_len = (fb->len - offset > CHUNK_SIZE) ? CHUNK_SIZE : (fb->len - offset);
-            error_code = httpd_resp_send_chunk(req, (const char*)fb->buf + offset, chunk_len);
-            if (error_code != ESP_OK) {
+            error_code = halHttpSendChunk(req, (const char*)fb->buf + offset, chunk_len);
+            if (error_code != HAL_OK) {
                 Serial.printf("[STREAM] Error sending chunk at offset %zu: %d\n", offset, error_code);
                 break;
             }
             offset += chunk_len;
             // Small delay to allow other tasks to run
             if (offset % (CHUNK_SIZE * 4) == 0) {
-                vTaskDelay(1 / portTICK_PERIOD_MS);
+                halDelay(1);
             }
         }
         
         // Завершення frame
-        if (error_code == ESP_OK) {
-            error_code = httpd_resp_send_chunk(req, "\r\n", 2);
+        if (error_code == HAL_OK) {
+            error_code = halHttpSendChunk(req, "\r\n", 2);
         }
         
-        esp_camera_fb_return(fb);
+        halCameraReturn(fb);
+        capture_scheduler.release(CAMERA_STREAM);
         
         // Перевірка помилки підключення
-        if (error_code != ESP_OK) {
+        if (error_code != HAL_OK) {
             Serial.printf("[STREAM] Error occurred: %d\n", error_code);
             break;
         }
         
         frame_count++;
-        vTaskDelay(50 / portTICK_PERIOD_MS);  // 50ms delay to prevent VSYNC overflow
+        // Пауза від планувальника: довша, коли бракує heap
+        halDelay(capture_scheduler.streamIntervalMs());
     }
     
     Serial.printf("[STREAM] Stream ended after %d frames\n", frame_count);
-    return ESP_OK;
+    return HAL_OK;
 }
 
 void startWebServer() {
-    httpd_config_t config = HTTPD_DEFAULT_CONFIG();
-    config.stack_size = 4096;  // Stack size for memory efficiency
-    config.backlog_conn = 2;   // Reduce backlog to prevent socket errors
-    config.recv_wait_timeout = 5;  // Receive timeout in seconds
-    config.send_wait_timeout = 5;  // Send timeout in seconds
-    
-    if (httpd_start(&server, &config) == ESP_OK) {
-        httpd_uri_t handlers[] = {
-            {"/", HTTP_GET, index_handler, NULL},
-            {"/stream", HTTP_GET, stream_handler, NULL},
-            {"/api/scan", HTTP_POST, scan_handler, NULL},
-            {"/api/status", HTTP_GET, status_handler, NULL},
-        };
-        
-        for (int i = 0; i < sizeof(handlers)/sizeof(handlers[0]); i++) {
-            httpd_register_uri_handler(server, &handlers[i]);
-        }
+    static const HalHttpRoute routes[] = {
+        {"/", HAL_HTTP_GET, index_handler},
+        {"/stream", HAL_HTTP_GET, stream_handler},
+        {"/api/scan", HAL_HTTP_POST, scan_handler},
+        {"/api/status", HAL_HTTP_GET, status_handler},
+        {"/api/reset", HAL_HTTP_POST, reset_handler},
+        {"/api/capture/start", HAL_HTTP_GET, capture_start_handler},
+        {"/api/capture", HAL_HTTP_GET, capture_handler},
+    };
+
+    if (halHttpStart(routes, sizeof(routes) / sizeof(routes[0]))) {
         Serial.println("[WEBSERVER] All endpoints registered");
     }
 }
@@ -0,0 +1,213 @@
+#ifndef _HAL_ESP32_H_
+#define _HAL_ESP32_H_
+
+// Реалізація Hal.h для ESP32-CAM (Arduino + ESP-IDF)
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include "esp_camera.h"
+#include "esp_heap_caps.h"
+#include "esp_http_server.h"
+#include "esp_partition.h"
+#include "CameraHandler.h"
+
+typedef camera_fb_t hal_frame_t;
+typedef TaskHandle_t hal_task_t;
+typedef httpd_req_t hal_http_req_t;
+typedef esp_err_t hal_err_t;
+
+#define HAL_OK ESP_OK
+#define HAL_FAIL ESP_FAIL
+
+#include "hal/HalTypes.h"
+
+// Камера
+
+inline bool halCameraInit() {
+    return initCamera();
+}
+
+inline hal_frame_t* halCameraGet() {
+    return esp_camera_fb_get();
+}
+
+inline void halCameraReturn(hal_frame_t* fb) {
+    esp_camera_fb_return(fb);
+}
+
+inline HalPixelFormat halFrameFormat(const hal_frame_t* fb) {
+    switch (fb->format) {
+        case PIXFORMAT_GRAYSCALE: return HAL_PIXEL_GRAY;
+        case PIXFORMAT_YUV422: return HAL_PIXEL_YUV422;
+        case PIXFORMAT_RGB565: return HAL_PIXEL_RGB565;
+        default: return HAL_PIXEL_OTHER;
+    }
+}
+
+// manual = false - автоматична експозиція сенсора
+inline bool halCameraSetExposure(bool manual, uint16_t exposure, uint8_t gain) {
+    return setCameraExposure(manual, exposure, gain);
+}
+
+// Час
+
+inline uint32_t halMillis() {
+    return millis();
+}
+
+inline uint32_t halMicros() {
+    return micros();
+}
+
+inline void halDelay(uint32_t ms) {
+    delay(ms);
+}
+
+// Пам'ять
+
+inline void* halAllocExternal(size_t size) {
+    return ps_malloc(size);
+}
+
+// internal - внутрішня SRAM, інакше PSRAM
+inline void* halAllocAligned(size_t align, size_t size, bool internal) {
+    return heap_caps_aligned_alloc(align, size,
+        (internal ? MALLOC_CAP_INTERNAL : MALLOC_CAP_SPIRAM) | MALLOC_CAP_8BIT);
+}
+
+inline void halFree(void* ptr) {
+    heap_caps_free(ptr);
+}
+
+inline uint32_t halFreeHeap() {
+    return esp_get_free_heap_size();
+}
+
+inline uint32_t halMinFreeHeap() {
+    return esp_get_minimum_free_heap_size();
+}
+
+inline uint32_t halFreePsram() {
+    return heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
+}
+
+inline uint32_t halPsramSize() {
+    return ESP.getPsramSize();
+}
+
+inline const char* halPlatformName() {
+    return ESP.getChipModel();
+}
+
+// Ваги моделі (EI_CLASSIFIER_WEIGHTS_BLOB=1): розділ "model" з partitions_model.csv,
+// відображений у адресний простір даних. Ядра читають ваги прямо з флешу через кеш, без копії в RAM
+inline const void* halWeightsMap(size_t* size) {
+    static const void* weights = NULL;
+    static size_t weights_size = 0;
+    if (weights == NULL) {
+        const esp_partition_t* part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                                               ESP_PARTITION_SUBTYPE_ANY, "model");
+        if (part == NULL) return NULL;
+        spi_flash_mmap_handle_t handle;
+        if (esp_partition_mmap(part, 0, part->size, ESP_PARTITION_MMAP_DATA, &weights, &handle) != ESP_OK) {
+            weights = NULL;
+            return NULL;
+        }
+        weights_size = part->size;
+    }
+    *size = weights_size;
+    return weights;
+}
+
+// Задачі
+
+inline hal_task_t halTaskStart(void (*fn)(void*), const char* name, uint32_t stack_size,
+                               uint32_t priority, int core) {
+    TaskHandle_t task = NULL;
+    if (xTaskCreatePinnedToCore(fn, name, stack_size, NULL, priority, &task, core) != pdPASS) {
+        return NULL;
+    }
+    return task;
+}
+
+inline void halTaskNotify(hal_task_t task) {
+    xTaskNotifyGive(task);
+}
+
+// Чекати на halTaskNotify для поточної задачі, не довше timeout_ms
+inline void halTaskWait(uint32_t timeout_ms) {
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(timeout_ms));
+}
+
+// HTTP
+
+// Запуск HTTP сервера з маршрутами (таблиця копіюється при реєстрації)
+inline bool halHttpStart(const HalHttpRoute* routes, size_t count) {
+    static httpd_handle_t server = NULL;
+    if (server != NULL) return true;
+
+    httpd_config_t config = HTTPD_DEFAULT_CONFIG();
+    config.stack_size = 4096;  // Stack size for memory efficiency
+    config.backlog_conn = 2;   // Reduce backlog to prevent socket errors
+    config.recv_wait_timeout = 5;  // Receive timeout in seconds
+    config.send_wait_timeout = 5;  // Send timeout in seconds
+    if (count > config.max_uri_handlers) {
+        config.max_uri_handlers = count;
+    }
+    if (httpd_start(&server, &config) != ESP_OK) {
+        return false;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        httpd_uri_t uri = {
+            routes[i].uri,
+            routes[i].method == HAL_HTTP_POST ? HTTP_POST : HTTP_GET,
+            routes[i].handler,
+            NULL
+        };
+        httpd_register_uri_handler(server, &uri);
+    }
+    return true;
+}
+
+inline hal_err_t halHttpSetType(hal_http_req_t* req, const char* type) {
+    return httpd_resp_set_type(req, type);
+}
+
+inline hal_err_t halHttpSetHeader(hal_http_req_t* req, const char* field, const char* value) {
+    return httpd_resp_set_hdr(req, field, value);
+}
+
+// Рядок статусу відповіді, напр. "410 Gone" (без виклику - 200 OK). Рядок має жити до відправки
+inline hal_err_t halHttpSetStatus(hal_http_req_t* req, const char* status) {
+    return httpd_resp_set_status(req, status);
+}
+
+// len = -1 - рядок до нуля
+inline hal_err_t halHttpSend(hal_http_req_t* req, const char* data, int len) {
+    return httpd_resp_send(req, data, len);
+}
+
+inline hal_err_t halHttpSendChunk(hal_http_req_t* req, const char* data, size_t len) {
+    return httpd_resp_send_chunk(req, data, len);
+}
+
+// WiFi (станція). Чекає на підключення не довше timeout_ms
+inline bool halWifiConnect(const char* ssid, const char* password, uint32_t timeout_ms) {
+    WiFi.mode(WIFI_STA);
+    WiFi.setSleep(false);
+    WiFi.begin(ssid, password);
+    const uint32_t start = millis();
+    while (WiFi.status() != WL_CONNECTED) {
+        if (millis() - start >= timeout_ms) return false;
+        delay(100);
+    }
+    return true;
+}
+
+// IP адреса станції рядком
+inline void halWifiAddress(char* out, size_t len) {
+    snprintf(out, len, "%s", WiFi.localIP().toString().c_str());
+}
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef _HAL_TYPES_H_
+#define _HAL_TYPES_H_
+
+// Спільні типи Hal.h. Реалізація включає цей файл після того, як оголосила
+// hal_http_req_t та hal_err_t
+
+#include <stdint.h>
+#include <stddef.h>
+
+enum HalHttpMethod : uint8_t {
+    HAL_HTTP_GET = 0,
+    HAL_HTTP_POST = 1,
+};
+
+// Формат кадру камери
+enum HalPixelFormat : uint8_t {
+    HAL_PIXEL_GRAY = 0,
+    HAL_PIXEL_YUV422 = 1,       // Y0 U Y1 V
+    HAL_PIXEL_RGB565 = 2,       // старший байт першим
+    HAL_PIXEL_OTHER = 3,        // JPEG та інші, інференція їх не приймає
+};
+
+typedef hal_err_t (*hal_http_handler_t)(hal_http_req_t *req);
+
+struct HalHttpRoute {
+    const char* uri;
+    HalHttpMethod method;
+    hal_http_handler_t handler;
+};
+
+#endif
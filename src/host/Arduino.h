@@ -0,0 +1,69 @@
+#ifndef _HOST_ARDUINO_H_
+#define _HOST_ARDUINO_H_
+
+// Заміна Arduino.h для віртуального пристрою: лише Serial (вивід у stdout, ввід - рядки, які
+// підкладає host_main.cpp) і стандартні заголовки. Решту платформи прошивка бере з Hal.h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <math.h>
+
+class HostSerial {
+public:
+    void begin(unsigned long baud) { (void)baud; }
+
+    // Ввід, ніби його надіслали в порт (лише з потоку loop(), до або між викликами)
+    void hostInput(const char* text) {
+        size_t len = strlen(text);
+        if (len > sizeof(input) - input_len) len = sizeof(input) - input_len;
+        memcpy(input + input_len, text, len);
+        input_len += len;
+    }
+
+    int available() {
+        return (int)(input_len - input_pos);
+    }
+
+    int read() {
+        if (input_pos == input_len) return -1;
+        int c = (uint8_t)input[input_pos++];
+        if (input_pos == input_len) input_pos = input_len = 0;
+        return c;
+    }
+
+    size_t write(const uint8_t* data, size_t len) {
+        size_t written = fwrite(data, 1, len, stdout);
+        fflush(stdout);
+        return written;
+    }
+
+    size_t print(const char* text) {
+        return write((const uint8_t*)text, strlen(text));
+    }
+
+    size_t println(const char* text = "") {
+        return print(text) + print("\n");
+    }
+
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3))) {
+        va_list args;
+        va_start(args, format);
+        int len = vprintf(format, args);
+        va_end(args);
+        fflush(stdout);
+        return len < 0 ? 0 : (size_t)len;
+    }
+
+private:
+    char input[256];
+    size_t input_len = 0;
+    size_t input_pos = 0;
+};
+
+extern HostSerial Serial;
+
+#endif
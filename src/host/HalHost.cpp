@@ -0,0 +1,441 @@
+#include "HalHost.h"
+#include <Arduino.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+HostSerial Serial;
+
+static HostDeviceConfig device_config = { NULL, 96, 96, 10, false, 320 * 1024, 4 * 1024 * 1024, HAL_PIXEL_GRAY, NULL };
+
+// Час
+
+static const std::chrono::steady_clock::time_point boot_time = std::chrono::steady_clock::now();
+
+uint64_t halMicros64() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - boot_time).count();
+}
+
+uint32_t halMillis() {
+    return (uint32_t)(halMicros64() / 1000);
+}
+
+uint32_t halMicros() {
+    return (uint32_t)halMicros64();
+}
+
+void halDelay(uint32_t ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+// Камера
+
+static std::vector<uint8_t> capture_frames;
+static size_t capture_frame_size = 0;
+static uint32_t capture_count = 0;
+
+static std::mutex camera_mutex;
+static std::condition_variable camera_cv;
+static bool camera_started = false;
+static bool camera_held = false;        // fb_count = 1, як на платі: кадр видається одному клієнту
+static uint64_t sensor_start_us = 0;
+static int64_t last_sequence = -1;      // номер кадру сенсора, відданий останнім
+static uint32_t camera_delivered = 0;
+static thread_local uint64_t thread_frame_timestamp_us = 0;
+static thread_local uint64_t thread_frame_returned_us = 0;
+static bool camera_exhausted = false;
+static hal_frame_t camera_fb;
+static bool camera_manual_exposure = false;
+static uint32_t camera_level = HOST_CAMERA_REFERENCE_EXPOSURE;    // exposure * (16 + gain) / 16
+static std::vector<uint8_t> camera_exposed_frame;
+static std::vector<uint8_t> camera_format_frame;
+
+// gray8 кадр у форматі сенсора: YUV422 без кольору (U = V = 128), RGB565 сірий
+static void convertCameraFrame(const uint8_t* gray, size_t pixels) {
+    camera_format_frame.resize(pixels * 2);
+    uint8_t* out = camera_format_frame.data();
+    for (size_t i = 0; i < pixels; i++) {
+        if (device_config.pixel_format == HAL_PIXEL_YUV422) {
+            out[2 * i] = gray[i];
+            out[2 * i + 1] = 128;
+        } else {
+            uint16_t p = (uint16_t)((gray[i] >> 3) << 11 | (gray[i] >> 2) << 5 | (gray[i] >> 3));
+            out[2 * i] = (uint8_t)(p >> 8);
+            out[2 * i + 1] = (uint8_t)p;
+        }
+    }
+}
+
+// Сцена без запису: градієнт і світлий прямокутник 30x20, що пробігає кадр за 10 с
+static void generateSyntheticCapture() {
+    const uint32_t width = device_config.width;
+    const uint32_t height = device_config.height;
+    capture_count = device_config.fps * 10;
+    capture_frames.resize((size_t)capture_count * capture_frame_size);
+    for (uint32_t f = 0; f < capture_count; f++) {
+        uint8_t* frame = &capture_frames[(size_t)f * capture_frame_size];
+        const uint32_t left = f * (width + 30) / capture_count;
+        for (uint32_t y = 0; y < height; y++) {
+            for (uint32_t x = 0; x < width; x++) {
+                bool inside = x + 30 >= left && x < left && y >= height / 3 && y < height / 3 + 20;
+                frame[y * width + x] = inside ? 235 : (uint8_t)((x * 3 + y * 5) & 0x7F);
+            }
+        }
+    }
+}
+
+static bool loadCapture() {
+    capture_frame_size = (size_t)device_config.width * device_config.height;
+    if (capture_frame_size == 0 || device_config.fps == 0) {
+        return false;
+    }
+    if (device_config.capture_path == NULL) {
+        generateSyntheticCapture();
+        return true;
+    }
+
+    FILE* file = fopen(device_config.capture_path, "rb");
+    if (file == NULL) {
+        fprintf(stderr, "[HOST] Cannot open capture %s\n", device_config.capture_path);
+        return false;
+    }
+    capture_frames.clear();
+    uint8_t chunk[4096];
+    size_t len;
+    while ((len = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        capture_frames.insert(capture_frames.end(), chunk, chunk + len);
+    }
+    fclose(file);
+
+    if (capture_frames.empty() || capture_frames.size() % capture_frame_size != 0) {
+        fprintf(stderr, "[HOST] Capture size %zu is not a multiple of %ux%u gray frames\n",
+                capture_frames.size(), device_config.width, device_config.height);
+        return false;
+    }
+    capture_count = (uint32_t)(capture_frames.size() / capture_frame_size);
+    return true;
+}
+
+bool halHostBegin(const HostDeviceConfig& config) {
+    device_config = config;
+    return loadCapture();
+}
+
+bool halCameraInit() {
+    std::lock_guard<std::mutex> lock(camera_mutex);
+    if (capture_count == 0 && !loadCapture()) {
+        return false;
+    }
+    if (!camera_started) {
+        sensor_start_us = halMicros64();
+        camera_started = true;
+    }
+    return true;
+}
+
+static uint64_t sensorFrameTime(int64_t sequence) {
+    return sensor_start_us + (uint64_t)sequence * 1000000ULL / device_config.fps;
+}
+
+hal_frame_t* halCameraGet() {
+    std::unique_lock<std::mutex> lock(camera_mutex);
+    if (!camera_started) return NULL;
+
+    // Найсвіжіший кадр, новіший за відданий останнім; якщо його ще немає - чекаємо на сенсор
+    int64_t sequence;
+    for (;;) {
+        camera_cv.wait(lock, [] { return !camera_held; });
+        if (!device_config.loop && last_sequence + 1 >= (int64_t)capture_count) {
+            camera_exhausted = true;
+            return NULL;
+        }
+        uint64_t now_us = halMicros64();
+        sequence = (int64_t)((now_us - sensor_start_us) * device_config.fps / 1000000ULL);
+        if (sequence > last_sequence) break;
+
+        uint64_t ready_us = sensorFrameTime(last_sequence + 1);
+        lock.unlock();
+        std::this_thread::sleep_for(std::chrono::microseconds(ready_us - now_us));
+        lock.lock();
+    }
+    if (!device_config.loop && sequence >= (int64_t)capture_count) {
+        sequence = capture_count - 1;
+    }
+
+    camera_held = true;
+    last_sequence = sequence;
+    camera_delivered++;
+    thread_frame_timestamp_us = sensorFrameTime(sequence);
+
+    camera_fb.index = (uint32_t)(sequence % capture_count);
+    camera_fb.buf = &capture_frames[(size_t)camera_fb.index * capture_frame_size];
+    if (camera_manual_exposure && camera_level != HOST_CAMERA_REFERENCE_EXPOSURE) {
+        camera_exposed_frame.resize(capture_frame_size);
+        for (size_t i = 0; i < capture_frame_size; i++) {
+            uint32_t p = camera_fb.buf[i] * camera_level / HOST_CAMERA_REFERENCE_EXPOSURE;
+            camera_exposed_frame[i] = p > 255 ? 255 : (uint8_t)p;
+        }
+        camera_fb.buf = camera_exposed_frame.data();
+    }
+    camera_fb.len = capture_frame_size;
+    if (device_config.pixel_format != HAL_PIXEL_GRAY) {
+        convertCameraFrame(camera_fb.buf, capture_frame_size);
+        camera_fb.buf = camera_format_frame.data();
+        camera_fb.len = camera_format_frame.size();
+    }
+    camera_fb.width = device_config.width;
+    camera_fb.height = device_config.height;
+    camera_fb.timestamp_us = thread_frame_timestamp_us;
+    return &camera_fb;
+}
+
+void halCameraReturn(hal_frame_t* fb) {
+    if (fb == NULL) return;
+    thread_frame_returned_us = halMicros64();
+    {
+        std::lock_guard<std::mutex> lock(camera_mutex);
+        camera_held = false;
+    }
+    camera_cv.notify_one();
+}
+
+bool halCameraSetExposure(bool manual, uint16_t exposure, uint8_t gain) {
+    std::lock_guard<std::mutex> lock(camera_mutex);
+    camera_manual_exposure = manual;
+    camera_level = (uint32_t)exposure * (16 + gain) / 16;
+    return true;
+}
+
+HalPixelFormat halFrameFormat(const hal_frame_t* fb) {
+    (void)fb;
+    return device_config.pixel_format;
+}
+
+HostCameraStats halHostCameraStats() {
+    std::lock_guard<std::mutex> lock(camera_mutex);
+    HostCameraStats stats;
+    stats.frames_in_capture = capture_count;
+    stats.sensor_frames = camera_started ?
+        (uint32_t)((halMicros64() - sensor_start_us) * device_config.fps / 1000000ULL + 1) : 0;
+    if (!device_config.loop && stats.sensor_frames > capture_count) {
+        stats.sensor_frames = capture_count;
+    }
+    stats.delivered = camera_delivered;
+    stats.dropped = (uint32_t)(last_sequence + 1) - camera_delivered;
+    stats.exhausted = camera_exhausted;
+    return stats;
+}
+
+void halHostThreadFrameTimes(uint64_t* sensor_us, uint64_t* returned_us) {
+    *sensor_us = thread_frame_timestamp_us;
+    *returned_us = thread_frame_returned_us;
+}
+
+// Пам'ять: справжній malloc, але облік за регіонами, щоб halFreeHeap поводився як на платі
+
+struct HostAllocation {
+    size_t size;
+    bool internal;
+};
+
+static std::mutex heap_mutex;
+static std::unordered_map<void*, HostAllocation> heap_allocations;
+static size_t heap_used = 0;
+static size_t heap_peak = 0;
+static size_t psram_used = 0;
+
+static void* hostAlloc(size_t align, size_t size, bool internal) {
+    std::lock_guard<std::mutex> lock(heap_mutex);
+    size_t& used = internal ? heap_used : psram_used;
+    const size_t limit = internal ? device_config.heap_size : device_config.psram_size;
+    if (size == 0 || used + size > limit) {
+        return NULL;
+    }
+    if (align < sizeof(void*)) align = sizeof(void*);
+    void* ptr = NULL;
+    if (posix_memalign(&ptr, align, size) != 0) {
+        return NULL;
+    }
+    heap_allocations[ptr] = { size, internal };
+    used += size;
+    if (heap_used > heap_peak) heap_peak = heap_used;
+    return ptr;
+}
+
+void* halAllocExternal(size_t size) {
+    return hostAlloc(sizeof(void*), size, false);
+}
+
+void* halAllocAligned(size_t align, size_t size, bool internal) {
+    return hostAlloc(align, size, internal);
+}
+
+void halFree(void* ptr) {
+    if (ptr == NULL) return;
+    std::lock_guard<std::mutex> lock(heap_mutex);
+    auto it = heap_allocations.find(ptr);
+    if (it != heap_allocations.end()) {
+        (it->second.internal ? heap_used : psram_used) -= it->second.size;
+        heap_allocations.erase(it);
+    }
+    free(ptr);
+}
+
+uint32_t halFreeHeap() {
+    std::lock_guard<std::mutex> lock(heap_mutex);
+    return (uint32_t)(device_config.heap_size - heap_used);
+}
+
+uint32_t halMinFreeHeap() {
+    std::lock_guard<std::mutex> lock(heap_mutex);
+    return (uint32_t)(device_config.heap_size - heap_peak);
+}
+
+uint32_t halFreePsram() {
+    std::lock_guard<std::mutex> lock(heap_mutex);
+    return (uint32_t)(device_config.psram_size - psram_used);
+}
+
+uint32_t halPsramSize() {
+    return device_config.psram_size;
+}
+
+const char* halPlatformName() {
+    return "Linux virtual device";
+}
+
+// Ваги моделі: файл лише для читання, відображений один раз на весь час роботи
+
+const void* halWeightsMap(size_t* size) {
+    static const void* weights = NULL;
+    static size_t weights_size = 0;
+    if (weights == NULL && device_config.weights_path != NULL) {
+        int fd = open(device_config.weights_path, O_RDONLY);
+        if (fd < 0) {
+            fprintf(stderr, "[HOST] Cannot open weights %s\n", device_config.weights_path);
+            return NULL;
+        }
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* ptr = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (ptr != MAP_FAILED) {
+                weights = ptr;
+                weights_size = (size_t)st.st_size;
+            }
+        }
+        close(fd);
+    }
+    *size = weights_size;
+    return weights;
+}
+
+// Задачі: потік на задачу, ядро і пріоритет ігноруються
+
+struct HostTask {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool notified = false;
+};
+
+static thread_local HostTask* current_task = NULL;
+
+hal_task_t halTaskStart(void (*fn)(void*), const char* name, uint32_t stack_size,
+                        uint32_t priority, int core) {
+    (void)name; (void)stack_size; (void)priority; (void)core;
+    HostTask* task = new HostTask();
+    std::thread([task, fn] {
+        current_task = task;
+        fn(NULL);
+    }).detach();
+    return task;
+}
+
+void halTaskNotify(hal_task_t task) {
+    {
+        std::lock_guard<std::mutex> lock(task->mutex);
+        task->notified = true;
+    }
+    task->cv.notify_one();
+}
+
+void halTaskWait(uint32_t timeout_ms) {
+    HostTask* task = current_task;
+    if (task == NULL) {
+        halDelay(timeout_ms);
+        return;
+    }
+    std::unique_lock<std::mutex> lock(task->mutex);
+    task->cv.wait_for(lock, std::chrono::milliseconds(timeout_ms), [task] { return task->notified; });
+    task->notified = false;
+}
+
+// HTTP
+
+static std::vector<HalHttpRoute> http_routes;
+
+bool halHttpStart(const HalHttpRoute* routes, size_t count) {
+    http_routes.assign(routes, routes + count);
+    return true;
+}
+
+hal_err_t halHostHttpRequest(const char* uri, HalHttpMethod method, hal_http_req_t* req) {
+    for (const HalHttpRoute& route : http_routes) {
+        if (route.method == method && strcmp(route.uri, uri) == 0) {
+            req->uri = route.uri;
+            return route.handler(req);
+        }
+    }
+    return HAL_FAIL;
+}
+
+hal_err_t halHttpSetType(hal_http_req_t* req, const char* type) {
+    req->content_type = type;
+    return HAL_OK;
+}
+
+hal_err_t halHttpSetHeader(hal_http_req_t* req, const char* field, const char* value) {
+    (void)req; (void)field; (void)value;
+    return HAL_OK;
+}
+
+hal_err_t halHttpSetStatus(hal_http_req_t* req, const char* status) {
+    req->status = status;
+    return HAL_OK;
+}
+
+hal_err_t halHttpSendChunk(hal_http_req_t* req, const char* data, size_t len) {
+    if (req->cancel != NULL && req->cancel->load()) {
+        return HAL_FAIL;
+    }
+    if (req->body != NULL && fwrite(data, 1, len, req->body) != len) {
+        return HAL_FAIL;
+    }
+    req->bytes.fetch_add(len);
+    req->sends.fetch_add(1);
+    if (req->link_bytes_per_s > 0) {
+        std::this_thread::sleep_for(std::chrono::microseconds((uint64_t)len * 1000000ULL / req->link_bytes_per_s));
+    }
+    return HAL_OK;
+}
+
+hal_err_t halHttpSend(hal_http_req_t* req, const char* data, int len) {
+    return halHttpSendChunk(req, data, len < 0 ? strlen(data) : (size_t)len);
+}
+
+bool halWifiConnect(const char* ssid, const char* password, uint32_t timeout_ms) {
+    (void)ssid; (void)password; (void)timeout_ms;
+    return true;
+}
+
+void halWifiAddress(char* out, size_t len) {
+    snprintf(out, len, "127.0.0.1");
+}
@@ -0,0 +1,120 @@
+#ifndef _HAL_HOST_H_
+#define _HAL_HOST_H_
+
+// Реалізація Hal.h для віртуального пристрою на Linux (VIRTUAL_DEVICE=1).
+//   - камера віддає кадри із запису (сирі gray8 кадри підряд) з заданим fps;
+//     сенсор іде своїм годинником, кадри, які ніхто не встиг забрати, рахуються як пропущені;
+//     ручна експозиція масштабує яскравість запису відносно HOST_CAMERA_REFERENCE_EXPOSURE;
+//     pixel_format - у якому форматі сенсор віддає кадри (gray8 запису перетворюється при видачі)
+//   - heap імітується: halAlloc* рахують зайняте від заданого розміру
+//   - розділ ваг моделі - файл, відображений через mmap
+//   - задачі - потоки, сповіщення - прапорець з умовною змінною
+//   - HTTP без мережі (WiFi - заглушка): обробники викликає клієнт усередині процесу (halHostHttpRequest),
+//     відправлене рахується (і пишеться у файл, якщо заданий), з опційним обмеженням швидкості каналу
+// Код - у HalHost.cpp, точка входу - host_main.cpp
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <atomic>
+
+// Експозиція, з якою записано кадри (gain 0)
+#define HOST_CAMERA_REFERENCE_EXPOSURE 300
+
+struct hal_frame_t {
+    uint8_t* buf;
+    size_t len;
+    size_t width;
+    size_t height;
+    uint64_t timestamp_us;      // коли сенсор видав кадр (halMicros64)
+    uint32_t index;             // номер кадру в записі
+};
+
+struct HostTask;
+typedef HostTask* hal_task_t;
+
+// Запит до HTTP заміни. Заповнює клієнт, обробник лише відправляє
+struct HostHttpRequest {
+    const char* uri;
+    uint32_t link_bytes_per_s;  // 0 - без обмеження
+    std::atomic<bool>* cancel;  // клієнт відключився: наступна відправка поверне HAL_FAIL
+    const char* content_type;
+    const char* status;         // halHttpSetStatus, NULL - 200 OK
+    std::atomic<uint64_t> bytes;    // відправлено тіла відповіді, клієнт читає під час запиту
+    std::atomic<uint32_t> sends;    // викликів halHttpSend / halHttpSendChunk
+    FILE* body;                 // NULL - тіло лише рахується, інакше пишеться у файл
+};
+typedef HostHttpRequest hal_http_req_t;
+typedef int hal_err_t;
+
+#define HAL_OK 0
+#define HAL_FAIL -1
+
+#include "hal/HalTypes.h"
+
+struct HostDeviceConfig {
+    const char* capture_path;   // NULL - синтетична сцена (світлий прямокутник, що рухається)
+    uint16_t width;
+    uint16_t height;
+    uint32_t fps;               // темп сенсора
+    bool loop;                  // по кінці запису почати спочатку
+    uint32_t heap_size;         // імітований heap, байт
+    uint32_t psram_size;
+    HalPixelFormat pixel_format;
+    const char* weights_path;   // блоб ваг моделі (tools/pack_weights.cpp) для halWeightsMap, NULL - немає
+};
+
+struct HostCameraStats {
+    uint32_t frames_in_capture;
+    uint32_t sensor_frames;     // видав сенсор з моменту halCameraInit
+    uint32_t delivered;         // віддано через halCameraGet
+    uint32_t dropped;           // видані сенсором, але нікому не віддані
+    bool exhausted;             // запис закінчився (без loop)
+};
+
+// Налаштувати пристрій до setup(). false - запис не читається
+bool halHostBegin(const HostDeviceConfig& config);
+HostCameraStats halHostCameraStats();
+// Останній кадр потоку, що кличе: коли його видав сенсор і коли потік повернув його камері
+void halHostThreadFrameTimes(uint64_t* sensor_us, uint64_t* returned_us);
+uint64_t halMicros64();
+// Виконати запит до зареєстрованого маршруту в потоці того, хто кличе
+hal_err_t halHostHttpRequest(const char* uri, HalHttpMethod method, hal_http_req_t* req);
+
+bool halCameraInit();
+hal_frame_t* halCameraGet();
+void halCameraReturn(hal_frame_t* fb);
+bool halCameraSetExposure(bool manual, uint16_t exposure, uint8_t gain);
+HalPixelFormat halFrameFormat(const hal_frame_t* fb);
+
+uint32_t halMillis();
+uint32_t halMicros();
+void halDelay(uint32_t ms);
+
+void* halAllocExternal(size_t size);
+void* halAllocAligned(size_t align, size_t size, bool internal);
+void halFree(void* ptr);
+uint32_t halFreeHeap();
+uint32_t halMinFreeHeap();
+uint32_t halFreePsram();
+uint32_t halPsramSize();
+const char* halPlatformName();
+// Блоб ваг, відображений через mmap (аналог розділу "model" на платі)
+const void* halWeightsMap(size_t* size);
+
+hal_task_t halTaskStart(void (*fn)(void*), const char* name, uint32_t stack_size,
+                        uint32_t priority, int core);
+void halTaskNotify(hal_task_t task);
+void halTaskWait(uint32_t timeout_ms);
+
+bool halHttpStart(const HalHttpRoute* routes, size_t count);
+hal_err_t halHttpSetType(hal_http_req_t* req, const char* type);
+hal_err_t halHttpSetHeader(hal_http_req_t* req, const char* field, const char* value);
+hal_err_t halHttpSetStatus(hal_http_req_t* req, const char* status);
+hal_err_t halHttpSend(hal_http_req_t* req, const char* data, int len);
+hal_err_t halHttpSendChunk(hal_http_req_t* req, const char* data, size_t len);
+// Мережі немає: "підключення" завжди вдається, адреса - localhost
+bool halWifiConnect(const char* ssid, const char* password, uint32_t timeout_ms);
+void halWifiAddress(char* out, size_t len);
+
+#endif
@@ -0,0 +1,276 @@
+// Віртуальний пристрій: setup() і loop() прошивки на Linux з камерою із запису.
+// Телеметрія кадрів іде в stdout, як у Serial на платі (tools/telemetry_decode.py),
+// підсумок бенчмарку - у stderr.
+//
+//   uah_scanner [capture.gray] [--size 96x96] [--fps 10] [--loop] [--seconds 30] [--format gray]
+//               [--interval-ms N] [--stream] [--link-kbps 1000] [--status-ms 1000] [--weights model.bin]
+//               [--record field.cap] [--serial-capture]
+//
+// capture.gray - сирі gray8 кадри підряд (без файлу - синтетична сцена на 10 с).
+// --format gray|yuv422|rgb565 - формат, у якому камера віддає кадри запису.
+// --interval-ms задає сталий темп інференції замість планувальника прошивки (0 - якнайшвидше;
+//   тоді інференція чекає на камеру щоразу, і --stream кадрів не отримує).
+// --weights - блоб ваг моделі для збірки з EI_CLASSIFIER_WEIGHTS_BLOB=1 (tools/pack_weights.cpp).
+// --stream / --status-ms - клієнти HTTP заміни: MJPEG стрім і опитування /api/status.
+// --record - клієнт /api/capture/start, далі /api/capture: кадри з результатами у файл
+//   (tools/capture_replay.cpp).
+// --serial-capture - команда "capture start" у Serial: записи кадрів ідуть пакетами в stdout
+//   (tools/telemetry_decode.py --capture field.cap).
+
+#include <Arduino.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "Hal.h"
+#include "CaptureScheduler.h"
+
+// Прошивка (main.cpp). SDK моделі визначає функції в заголовках, тож тут його не включаємо
+void setup();
+void loop();
+void startWebServer();
+extern uint32_t frame_id;
+extern CaptureScheduler capture_scheduler;
+
+struct HostOptions {
+    HostDeviceConfig device;
+    uint32_t seconds;
+    int64_t interval_ms;        // -1 - планувальник прошивки
+    bool stream;
+    uint32_t link_kbps;
+    uint32_t status_ms;         // 0 - без опитування
+    const char* record_path;    // NULL - без запису кадрів
+    bool serial_capture;
+};
+
+static std::atomic<bool> clients_stop(false);
+static std::atomic<uint32_t> status_polls(0);
+// Один запит на всі перепідключення стріму: лічильники накопичуються
+static HostHttpRequest stream_request;
+static HostHttpRequest record_request;
+
+static void usage(const char* name) {
+    fprintf(stderr,
+            "usage: %s [capture.gray] [--size WxH] [--fps N] [--loop] [--seconds N] [--format F]\n"
+            "          [--interval-ms N] [--stream] [--link-kbps N] [--status-ms N] [--weights F]\n"
+            "          [--record F] [--serial-capture]\n", name);
+}
+
+static bool parseOptions(int argc, char** argv, HostOptions* opt) {
+    opt->device = { NULL, 96, 96, 10, false, 320 * 1024, 4 * 1024 * 1024, HAL_PIXEL_GRAY, NULL };
+    opt->seconds = 30;
+    opt->interval_ms = -1;
+    opt->stream = false;
+    opt->link_kbps = 0;
+    opt->status_ms = 0;
+    opt->record_path = NULL;
+    opt->serial_capture = false;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (strcmp(arg, "--loop") == 0) {
+            opt->device.loop = true;
+        } else if (strcmp(arg, "--stream") == 0) {
+            opt->stream = true;
+        } else if (strcmp(arg, "--serial-capture") == 0) {
+            opt->serial_capture = true;
+        } else if (arg[0] == '-' && arg[1] == '-' && value == NULL) {
+            return false;
+        } else if (strcmp(arg, "--size") == 0) {
+            unsigned w, h;
+            if (sscanf(value, "%ux%u", &w, &h) != 2) return false;
+            opt->device.width = (uint16_t)w;
+            opt->device.height = (uint16_t)h;
+            i++;
+        } else if (strcmp(arg, "--format") == 0) {
+            if (strcmp(value, "gray") == 0) opt->device.pixel_format = HAL_PIXEL_GRAY;
+            else if (strcmp(value, "yuv422") == 0) opt->device.pixel_format = HAL_PIXEL_YUV422;
+            else if (strcmp(value, "rgb565") == 0) opt->device.pixel_format = HAL_PIXEL_RGB565;
+            else return false;
+            i++;
+        } else if (strcmp(arg, "--weights") == 0) {
+            opt->device.weights_path = value;
+            i++;
+        } else if (strcmp(arg, "--fps") == 0) {
+            opt->device.fps = (uint32_t)atoi(value);
+            i++;
+        } else if (strcmp(arg, "--seconds") == 0) {
+            opt->seconds = (uint32_t)atoi(value);
+            i++;
+        } else if (strcmp(arg, "--interval-ms") == 0) {
+            opt->interval_ms = atoi(value);
+            i++;
+        } else if (strcmp(arg, "--link-kbps") == 0) {
+            opt->link_kbps = (uint32_t)atoi(value);
+            i++;
+        } else if (strcmp(arg, "--status-ms") == 0) {
+            opt->status_ms = (uint32_t)atoi(value);
+            i++;
+        } else if (strcmp(arg, "--record") == 0) {
+            opt->record_path = value;
+            i++;
+        } else if (arg[0] != '-' && opt->device.capture_path == NULL) {
+            opt->device.capture_path = arg;
+        } else {
+            return false;
+        }
+    }
+    return opt->device.fps > 0 && opt->seconds > 0;
+}
+
+// Клієнт стріму: перепідключається, поки бенчмарк не скінчиться
+static void streamClient(uint32_t link_kbps) {
+    stream_request.cancel = &clients_stop;
+    stream_request.link_bytes_per_s = link_kbps * 1000 / 8;
+    while (!clients_stop.load()) {
+        halHostHttpRequest("/stream", HAL_HTTP_GET, &stream_request);
+    }
+}
+
+static void statusClient(uint32_t period_ms) {
+    while (!clients_stop.load()) {
+        HostHttpRequest req = {};
+        if (halHostHttpRequest("/api/status", HAL_HTTP_GET, &req) == HAL_OK) {
+            status_polls.fetch_add(1);
+        }
+        halDelay(period_ms);
+    }
+}
+
+// Запис кадрів: /api/capture/start, далі /api/capture, поки прогін не скінчиться або
+// обробник не відповість помилкою (запис зупинено). Вікна пишуться в один файл
+static void recordClient() {
+    record_request.cancel = &clients_stop;
+    const char* uri = "/api/capture/start";
+    while (!clients_stop.load()) {
+        record_request.status = NULL;
+        if (halHostHttpRequest(uri, HAL_HTTP_GET, &record_request) != HAL_OK || record_request.status != NULL) {
+            break;
+        }
+        uri = "/api/capture";
+    }
+}
+
+static uint32_t percentile(std::vector<uint32_t>& values, uint32_t percent) {
+    if (values.empty()) return 0;
+    size_t ix = (values.size() - 1) * percent / 100;
+    std::nth_element(values.begin(), values.begin() + ix, values.end());
+    return values[ix];
+}
+
+int main(int argc, char** argv) {
+    HostOptions opt;
+    if (!parseOptions(argc, argv, &opt)) {
+        usage(argv[0]);
+        return 2;
+    }
+    if (!halHostBegin(opt.device)) {
+        return 1;
+    }
+
+    setup();
+
+    if (opt.interval_ms >= 0) {
+        CaptureSchedulerConfig config = capture_scheduler.getConfig();
+        config.active_interval_ms = (uint32_t)opt.interval_ms;
+        config.idle_interval_ms = (uint32_t)opt.interval_ms;
+        config.max_duty_percent = 100;
+        capture_scheduler.setConfig(config);
+    }
+
+    startWebServer();
+    if (opt.serial_capture) {
+        Serial.hostInput("capture start\n");
+    }
+    std::vector<std::thread> clients;
+    if (opt.stream) {
+        clients.emplace_back(streamClient, opt.link_kbps);
+    }
+    if (opt.status_ms > 0) {
+        clients.emplace_back(statusClient, opt.status_ms);
+    }
+    if (opt.record_path != NULL) {
+        record_request.body = fopen(opt.record_path, "wb");
+        if (record_request.body == NULL) {
+            fprintf(stderr, "[HOST] Cannot create %s\n", opt.record_path);
+            return 1;
+        }
+        clients.emplace_back(recordClient);
+    }
+
+    // Кадр інференції завершився, коли loop() змінив frame_id; результат готовий до того,
+    // як кадр повернуто камері, тож час кадру рахується до halCameraReturn, без сну в loop()
+    std::vector<uint32_t> latency_us;
+    std::vector<uint32_t> frame_us;
+    const HostCameraStats start_stats = halHostCameraStats();
+    const uint64_t start_us = halMicros64();
+    const uint64_t end_us = start_us + (uint64_t)opt.seconds * 1000000ULL;
+    while (halMicros64() < end_us && !halHostCameraStats().exhausted) {
+        const uint32_t id = frame_id;
+        const uint64_t loop_start_us = halMicros64();
+        loop();
+        if (frame_id != id) {
+            uint64_t sensor_us, done_us;
+            halHostThreadFrameTimes(&sensor_us, &done_us);
+            // без кадру (кінець запису) камеру в цьому loop() не повертали
+            if (done_us >= loop_start_us) {
+                latency_us.push_back((uint32_t)(done_us - sensor_us));
+                frame_us.push_back((uint32_t)(done_us - loop_start_us));
+            }
+        }
+    }
+    const uint64_t elapsed_us = halMicros64() - start_us;
+    const HostCameraStats stats = halHostCameraStats();
+
+    // Клієнти бачать stop на наступній відправці; стрім, що чекає на камеру, не чекаємо
+    clients_stop.store(true);
+    for (std::thread& client : clients) {
+        client.detach();
+    }
+    halDelay(100);
+
+    const double seconds = elapsed_us / 1e6;
+    const size_t frames = latency_us.size();
+    uint64_t latency_sum = 0;
+    for (uint32_t v : latency_us) latency_sum += v;
+    uint64_t frame_sum = 0;
+    for (uint32_t v : frame_us) frame_sum += v;
+
+    fprintf(stderr, "\n[HOST] %s: %u frames %ux%u, sensor %u fps%s\n",
+            opt.device.capture_path ? opt.device.capture_path : "synthetic scene",
+            stats.frames_in_capture, opt.device.width, opt.device.height, opt.device.fps,
+            opt.device.loop ? ", looped" : "");
+    // усе, що камера віддала не інференції, забрав стрім
+    const uint32_t stream_frames = stats.delivered - start_stats.delivered - (uint32_t)frames;
+    fprintf(stderr, "[HOST] %.1f s: %zu inference frames (%.2f fps), sensor frames %u, camera drops %u\n",
+            seconds, frames, frames / seconds, stats.sensor_frames - start_stats.sensor_frames,
+            stats.dropped - start_stats.dropped);
+    fprintf(stderr, "[HOST] latency sensor->result ms: avg %.1f p50 %.1f p95 %.1f max %.1f\n",
+            frames ? latency_sum / 1e3 / frames : 0.0, percentile(latency_us, 50) / 1e3,
+            percentile(latency_us, 95) / 1e3, percentile(latency_us, 100) / 1e3);
+    fprintf(stderr, "[HOST] frame (capture + inference) ms: avg %.1f p95 %.1f max %.1f\n",
+            frames ? frame_sum / 1e3 / frames : 0.0, percentile(frame_us, 95) / 1e3,
+            percentile(frame_us, 100) / 1e3);
+    fprintf(stderr, "[HOST] heap free %u (min %u), psram free %u\n",
+            (unsigned)halFreeHeap(), (unsigned)halMinFreeHeap(), (unsigned)halFreePsram());
+    if (opt.stream) {
+        fprintf(stderr, "[HOST] stream: %u frames (%.2f fps), %llu bytes\n",
+                stream_frames, stream_frames / seconds,
+                (unsigned long long)stream_request.bytes.load());
+    }
+    if (opt.status_ms > 0) {
+        fprintf(stderr, "[HOST] status polls: %u\n", status_polls.load());
+    }
+    if (opt.record_path != NULL) {
+        // запис, який обробник не встиг дописати, читач відкине як обрізаний
+        fflush(record_request.body);
+        fprintf(stderr, "[HOST] capture: %s, %llu bytes\n", opt.record_path,
+                (unsigned long long)record_request.bytes.load());
+    }
+    fflush(stdout);
+    fflush(stderr);
+
+    // Задача телеметрії і відключені клієнти ще працюють - без деструкторів статиків
+    _Exit(0);
+}
@@ -1,38 +1,120 @@
 #include <Arduino.h>
-#include "CameraHandler.h"
+#include "Hal.h"
 #include "InferenceHandler.h"
+#include "CaptureScheduler.h"
+#include "WebServerHandler.h"
+#include "CaptureRecorder.h"
+#include "edge-impulse-sdk/porting/ei_pool_allocator.h"
+#include "edge-impulse-sdk/classifier/ei_memory_plan.h"
+#include "edge-impulse-sdk/classifier/ei_memory_placement.h"
+#include "edge-impulse-sdk/classifier/ei_weights_blob.h"
 
-String global_result = "Ready";
+// 1 - WiFi і веб-сервер (стрім, /api/*, запис кадрів по HTTP): env esp32cam_web, мережа -
+// з WIFI_SSID / WIFI_PASSWORD. 0 - лише Serial
+#ifndef WEB_SERVER
+#define WEB_SERVER 0
+#endif
+#if WEB_SERVER == 1 && !defined(WIFI_SSID)
+#error "WEB_SERVER=1 needs WIFI_SSID and WIFI_PASSWORD"
+#endif
+
+// Останній результат для веб-статусу (рядок живе до наступного кадру)
+const char* volatile global_result = "Ready";
+uint32_t frame_id = 0;
 int error_count = 0;
 const int MAX_ERRORS = 10;
-const int CAPTURE_INTERVAL_MS = 3000;  // Capture every 3 seconds
-unsigned long last_capture_time = 0;
+// Кадр відкинуто, поки експозиція сходиться: наступний одразу, але не більше стількох поспіль
+const uint8_t MAX_QUALITY_RETRIES = 4;
+static uint8_t quality_retries = 0;
+// Злиття теплових карт FOMO усереднює кадри, не знаючи часу між ними: після паузи, довшої за
+// активний темп (capture_scheduler.activeGapMs()), попередні кадри - вже інша сцена, і історія
+// скидається. Скидання позначається в записі кадру, щоб хост повторив його (tools/capture_replay.cpp)
+static uint32_t last_classifier_ms = 0;
+static bool classifier_ran = false;
+static bool fusion_reset_pending = false;
+
+// Темп захоплення: швидко, поки купюра в кадрі, повільно без активності,
+// не більше 60% часу під інференцію, повільніше при малому heap
+static const CaptureSchedulerConfig capture_config = {
+    500,            // active_interval_ms
+    3000,           // idle_interval_ms
+    5000,           // idle_after_ms
+    60,             // max_duty_percent
+    40 * 1024,      // min_free_heap
+    2000,           // low_heap_interval_ms
+    50,             // stream_interval_ms
+    250,            // low_heap_stream_interval_ms
+    150,            // stream_guard_ms
+};
+CaptureScheduler capture_scheduler(capture_config);
+
+#if EI_CLASSIFIER_USE_POOL_ALLOCATOR == 1
+// Пул для дрібних алокацій класифікатора (внутрішня SRAM)
+static uint8_t ei_pool_arena[16 * 1024] __attribute__((aligned(16)));
+#endif
+
+// Скільки внутрішньої SRAM віддаємо під гарячі буфери моделі, решта - у PSRAM.
+// Активації за планом - один шматок 73728 байт (тензори перетинають будь-яку межу), плюс
+// scratch ~9.4 КБ: з меншим бюджетом активації цілком їдуть у PSRAM
+const size_t EI_INTERNAL_RAM_BUDGET = 96 * 1024;
+static ei_memory_placement_report_t ei_placement;
+// Спільне розміщення активацій і scratch буферів моделі (має жити весь час роботи)
+static ei_memory_plan_storage_t ei_plan;
+// Перші шари виконуються смугами рядків, щоб проміжні тензори 48x48x48 не існували повністю.
+// Менший бюджет дає вужчі смуги, але арену не зменшує: пік плану - 73728 байт поза смугами.
+// Має лишати місце під scratch у EI_INTERNAL_RAM_BUDGET (tools/memory_plan_gen --patch-budget 73728)
+const size_t EI_PATCH_BUDGET = 72 * 1024;
+const size_t EI_SCRATCH_RESERVE = 12 * 1024;
+static_assert(EI_PATCH_BUDGET + EI_SCRATCH_RESERVE <= EI_INTERNAL_RAM_BUDGET,
+              "patch budget must fit in internal RAM next to the scratch buffers");
+
+static void *ei_alloc_internal(size_t align, size_t size) {
+    return halAllocAligned(align, size, true);
+}
+
+static void *ei_alloc_external(size_t align, size_t size) {
+    return halAllocAligned(align, size, false);
+}
+
+static const ei_memory_placement_policy_t ei_placement_policy = {
+    EI_INTERNAL_RAM_BUDGET,
+    EI_CAMERA_RAW_FRAME_SIZE,
+    ei_alloc_internal,
+    ei_alloc_external,
+    halFree
+};
 
 void printSystemInfo() {
     Serial.println("\n========================================");
     Serial.println("    UAH Banknote Scanner v2.0");
+#if WEB_SERVER == 1
+    Serial.println("    Automatic AI Recognition + Web Server");
+#else
     Serial.println("    Automatic AI Recognition (No WiFi)");
+#endif
     Serial.println("========================================");
-    Serial.printf("ESP32 Chip Model: %d\n", ESP.getChipModel());
-    Serial.printf("Flash Size: %d MB\n", ESP.getFlashChipSize() / 1024 / 1024);
-    Serial.printf("Free Heap: %u bytes\n", esp_get_free_heap_size());
-    Serial.printf("PSRAM Size: %u bytes\n", ESP.getPsramSize());
-    Serial.printf("Capture Interval: %d ms\n\n", CAPTURE_INTERVAL_MS);
+    Serial.printf("Platform: %s\n", halPlatformName());
+    Serial.printf("Free Heap: %u bytes\n", (unsigned)halFreeHeap());
+    Serial.printf("PSRAM Size: %u bytes\n", (unsigned)halPsramSize());
+    Serial.printf("Capture Interval: %lu ms active, %lu ms idle, max duty %lu%%\n\n",
+                  (unsigned long)capture_config.active_interval_ms,
+                  (unsigned long)capture_config.idle_interval_ms,
+                  (unsigned long)capture_config.max_duty_percent);
 }
 
 void setup() {
     Serial.begin(115200);
-    delay(1500);
+    halDelay(1500);
     
     printSystemInfo();
     
     // Ініціалізація камери з перевіркою
     Serial.println("[SETUP] Initializing camera...");
     int camera_attempts = 0;
-    while (!initCamera() && camera_attempts < 3) {
+    while (!halCameraInit() && camera_attempts < 3) {
         camera_attempts++;
         Serial.printf("[SETUP] Camera init attempt %d/3 failed, retrying...\n", camera_attempts);
-        delay(500);
+        halDelay(500);
     }
     
     if (camera_attempts >= 3) {
@@ -43,70 +125,248 @@ void setup() {
         Serial.println("  - I2C (SCCB) communication failure");
         Serial.println("  - Camera firmware corrupted");
         while(1) {
-            delay(1000);
+            halDelay(1000);
             Serial.println("[SYSTEM] Waiting for reset...");
         }
     }
     Serial.println("[OK] ✓ Camera initialized");
+    if (!ei_camera_exposure_init()) {
+        Serial.println("[WARNING] Manual exposure unavailable, sensor AEC/AGC stays on");
+    }
+
+#if EI_CLASSIFIER_USE_POOL_ALLOCATOR == 1
+    // Пул має бути готовий до першого виклику ei_malloc
+    ei_pool_config_t pool_config = { ei_pool_arena, sizeof(ei_pool_arena), malloc, free };
+    ei_pool_init(&pool_config);
+    Serial.printf("[OK] ✓ Classifier memory pool: %u bytes\n", (unsigned)sizeof(ei_pool_arena));
+#endif
+
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 1
+    // Ваги моделі - з окремого розділу флешу, не з прошивки (план пам'яті вже запускає init моделі)
+    Serial.println("[SETUP] Mapping model weights...");
+    size_t weights_size = 0;
+    const void* weights = halWeightsMap(&weights_size);
+    EI_IMPULSE_ERROR weights_res = weights == NULL ? EI_IMPULSE_INVALID_SIZE :
+        ei_weights_blob_apply(ei_default_impulse.impulse, 0, weights, weights_size);
+    if (weights_res != EI_IMPULSE_OK) {
+        Serial.printf("[FATAL] Model weights unavailable (%d), flash the \"model\" partition\n", weights_res);
+        while(1) halDelay(1000);
+    }
+    Serial.printf("[OK] ✓ Model weights mapped: %u bytes\n", (unsigned)((const ei_weights_blob_header_t*)weights)->total_bytes);
+#endif
+
+    // План пам'яті: scratch буфери ядер займають місце неживих активацій, арена стає меншою
+    Serial.println("[SETUP] Planning model memory...");
+    // План, згенерований офлайн (tools/memory_plan_gen.cpp, EI_CLASSIFIER_TFLITE_MEMORY_PLAN), якщо він
+    // підходить ядрам цієї збірки; інакше рахуємо на пристрої
+    bool plan_ready = false;
+    const ei_memory_plan_t* compiled_plan = ei_memory_plan_compiled(ei_default_impulse.impulse, 0);
+    if (compiled_plan) {
+        EI_IMPULSE_ERROR check_res = ei_memory_plan_check(ei_default_impulse.impulse, 0, compiled_plan);
+        plan_ready = check_res == EI_IMPULSE_OK;
+        if (plan_ready) {
+            Serial.printf("[OK] ✓ Compiled-in memory plan: arena %u bytes\n",
+                          (unsigned)(compiled_plan->planned_bytes + compiled_plan->persistent_bytes));
+        } else {
+            Serial.printf("[WARNING] Compiled-in memory plan does not fit (%d), planning on device\n", check_res);
+        }
+    }
+    if (!plan_ready) {
+        EI_IMPULSE_ERROR plan_res = ei_memory_plan_compute(ei_default_impulse.impulse, 0, EI_PATCH_BUDGET, &ei_plan);
+        if (plan_res == EI_IMPULSE_OK) {
+            plan_res = ei_memory_plan_apply(ei_default_impulse.impulse, 0, &ei_plan.plan);
+        }
+        if (plan_res != EI_IMPULSE_OK) {
+            Serial.printf("[WARNING] Memory plan failed (%d), using built-in layout\n", plan_res);
+        } else {
+            ei_memory_plan_print(&ei_plan);
+        }
+    }
+
+    // Розміщення арени моделі: гарячі буфери - у внутрішню SRAM, холодні - у PSRAM.
+    // З верифікатором обидві моделі ділять ті самі буфери, розміром з більшу
+    Serial.println("[SETUP] Placing model memory...");
+#ifdef VERIFY_IMPULSE
+    const ei_memory_placement_block_t placement_blocks[] = {
+        { ei_default_impulse.impulse, 0 },
+        { VERIFY_IMPULSE.impulse, 0 },
+    };
+    EI_IMPULSE_ERROR placement_res = ei_memory_placement_apply_shared(placement_blocks, 2,
+                                                                       &ei_placement_policy, &ei_placement);
+#else
+    EI_IMPULSE_ERROR placement_res = ei_memory_placement_apply(ei_default_impulse.impulse, 0,
+                                                                &ei_placement_policy, &ei_placement);
+#endif
+    if (placement_res != EI_IMPULSE_OK) {
+        // Не фатально - арена виділятиметься як раніше, на кожен inference
+        Serial.printf("[WARNING] Memory placement failed (%d), using default arena\n", placement_res);
+    } else {
+        ei_memory_placement_print(&ei_placement);
+        // Активації поза SRAM - кожен шар читає й пише PSRAM, інференс у рази повільніший
+        if (ei_placement.demoted_bytes > 0) {
+            Serial.printf("[WARNING] %u bytes of activations/scratch are in PSRAM, internal budget %u bytes "
+                          "is too small\n", (unsigned)ei_placement.demoted_bytes, (unsigned)EI_INTERNAL_RAM_BUDGET);
+        }
+    }
 
     // Ініціалізація grayscale буфера
     Serial.println("[SETUP] Allocating grayscale buffer...");
-    if (!ei_camera_init()) {
+    if (!ei_camera_init(ei_memory_placement_find(&ei_placement, EI_MEMORY_REGION_INPUT_FRAME))) {
         Serial.println("[FATAL] Failed to allocate grayscale buffer!");
-        Serial.printf("[DIAGNOSTIC] Available heap: %u bytes\n", esp_get_free_heap_size());
-        while(1) delay(1000);
+        Serial.printf("[DIAGNOSTIC] Available heap: %u bytes\n", (unsigned)halFreeHeap());
+        while(1) halDelay(1000);
     }
     Serial.println("[OK] ✓ Grayscale buffer allocated");
 
     // Ініціалізація класифікатора
     Serial.println("[SETUP] Initializing classifier...");
     run_classifier_init();
+    captureBegin();
+#ifdef VERIFY_IMPULSE
+    run_classifier_init(&VERIFY_IMPULSE);
+#endif
     Serial.println("[OK] ✓ Classifier initialized");
+#ifdef ANOMALY_MODEL
+    if (!ei_anomaly_init()) {
+        Serial.println("[WARNING] Anomaly scoring unavailable, detections are not screened");
+    }
+#endif
+
+    // Телеметрія кадрів: бінарні пакети з фонової задачі (декодер - tools/telemetry_decode.py)
+    if (!telemetryBegin()) {
+        Serial.println("[WARNING] Telemetry task failed to start, frames are not reported");
+    }
     
+#if WEB_SERVER == 1
+    Serial.println("[SETUP] Connecting to WiFi...");
+    if (halWifiConnect(WIFI_SSID, WIFI_PASSWORD, 15000)) {
+        char address[16];
+        halWifiAddress(address, sizeof(address));
+        Serial.printf("[OK] ✓ WiFi connected: http://%s/\n", address);
+        startWebServer();
+    } else {
+        Serial.println("[WARNING] WiFi connection failed, web server is off");
+    }
+#endif
+
     Serial.println("\n[READY] ✓ System ready!");
-    Serial.println("[INFO] Automatic scanning enabled - camera captures every %d ms", CAPTURE_INTERVAL_MS);
-    Serial.println("[INFO] Results output to Serial Monitor only\n");
-    
-    last_capture_time = millis();
+    Serial.println("[INFO] Automatic scanning enabled - capture rate follows scene activity and inference time");
+    Serial.printf("[INFO] Frame telemetry: %s\n", TELEMETRY_BINARY ? "binary (COBS packets)" : "text");
+    Serial.println("[INFO] Serial commands: capture start, capture stop\n");
+}
+
+// Команди з Serial, по рядку: лише запис кадрів (CaptureRecorder.h)
+static void serialPollCommands() {
+    static char line[32];
+    static size_t line_len = 0;
+    while (Serial.available() > 0) {
+        const int c = Serial.read();
+        if (c < 0) break;
+        if (c != '\n' && c != '\r') {
+            if (line_len < sizeof(line) - 1) line[line_len++] = (char)c;
+            continue;
+        }
+        line[line_len] = '\0';
+        if (strcmp(line, "capture start") == 0) {
+            captureSerialStart();
+        } else if (strcmp(line, "capture stop") == 0) {
+            captureSerialStop();
+        }
+        line_len = 0;
+    }
 }
 
 void loop() {
-    unsigned long current_time = millis();
+    serialPollCommands();
+    uint32_t current_time = halMillis();
     
-    // Automatic capture every CAPTURE_INTERVAL_MS
-    if (current_time - last_capture_time >= CAPTURE_INTERVAL_MS) {
-        last_capture_time = current_time;
-        
-        camera_fb_t* fb = esp_camera_fb_get();
+    if (capture_scheduler.due(current_time)) {
+        // Камеру ще тримає кадр стріму - нових він уже не бере, чекаємо на нього
+        if (!capture_scheduler.tryAcquire(CAMERA_INFERENCE, current_time)) {
+            halDelay(5);
+            return;
+        }
+
+        // Цикл кадру нічого не друкує: усе йде одним записом телеметрії.
+        // Якщо черга повна - кадр все одно обробляється, запис лише рахується як втрачений
+        TelemetryRecord scratch_record;
+        TelemetryRecord* rec = telemetryAcquire();
+        bool queued = rec != NULL;
+        if (!queued) {
+            rec = &scratch_record;
+            memset(rec, 0, sizeof(TelemetryRecord));
+            rec->verdict_label = TELEMETRY_NO_VERDICT;
+            rec->anomaly_milli = TELEMETRY_NO_ANOMALY;
+            rec->trigger_label = TELEMETRY_NO_VERDICT;
+        }
+        rec->frame_id = frame_id++;
+        rec->timestamp_ms = current_time;
+        uint32_t start_us = halMicros();
+
+        hal_frame_t* fb = halCameraGet();
         if (!fb) {
-            Serial.println("[ERROR] Failed to get camera frame");
+            rec->status = TELEMETRY_NO_FRAME;
             error_count++;
             global_result = "Frame error";
         } else {
-            Serial.println("\n[FRAME] =====================================");
-            Serial.println("[INFERENCE] Starting AI processing...");
-            Serial.printf("[TIME] Captured at: %lu ms\n", current_time);
-            
-            String inference_result = runInference(fb);
-            
-            esp_camera_fb_return(fb);
+            // Результат живе до наступного run_classifier, кадр - до halCameraReturn
+            static ei_impulse_result_t result;
+            if (classifier_ran && current_time - last_classifier_ms > capture_scheduler.activeGapMs()) {
+                reset_fomo_fusion();
+                classifier_ran = false;
+                fusion_reset_pending = true;
+            }
+            bool ran;
+            const char* inference_result = runInference(fb, rec, &result, &ran);
+            captureRecord(fb, rec, ran ? &result : NULL, halMicros() - start_us, ran && fusion_reset_pending);
+            if (ran) {
+                last_classifier_ms = current_time;
+                classifier_ran = true;
+                fusion_reset_pending = false;
+            }
             
-            Serial.print("[RESULT] ");
-            Serial.println(inference_result);
+            halCameraReturn(fb);
             
             global_result = inference_result;
             error_count = 0;  // Reset error count on success
-            Serial.println("[INFO] Free Heap: %u bytes", esp_get_free_heap_size());
-            Serial.println("[FRAME] =====================================\n");
+        }
+
+        capture_scheduler.release(CAMERA_INFERENCE);
+
+        rec->frame_us = halMicros() - start_us;
+        rec->free_heap = halFreeHeap();
+        rec->min_free_heap = halMinFreeHeap();
+        rec->free_psram = halFreePsram();
+#if EI_CLASSIFIER_USE_POOL_ALLOCATOR == 1
+        rec->ei_memory_in_use = ei_memory_in_use;
+        rec->ei_memory_peak = ei_memory_peak_use;
+#endif
+        if (queued) {
+            telemetryCommit();
+        }
+
+        // Поріг активності той самий, що й для результату: 50%
+        bool activity = rec->detection_count > 0 && rec->detections[0].confidence > 127;
+        capture_scheduler.frameDone(current_time, rec->frame_us, activity, rec->free_heap);
+        if (rec->status == TELEMETRY_REJECTED && !rec->exposure_locked && quality_retries < MAX_QUALITY_RETRIES) {
+            quality_retries++;
+            capture_scheduler.requestCapture();
+        } else {
+            quality_retries = 0;
         }
         
         // Check for too many errors
         if (error_count >= MAX_ERRORS) {
             Serial.println("[CRITICAL] Too many consecutive errors!");
             Serial.println("[SYSTEM] Recommend to restart ESP32");
+#if EI_CLASSIFIER_USE_POOL_ALLOCATOR == 1
+            ei_pool_print_stats();
+#endif
             error_count = 0;
         }
     }
     
-    delay(100);  // Small delay to prevent watchdog issues
+    // Спимо до наступного кадру, але не довше 100 мс, щоб позачерговий кадр не чекав
+    uint32_t wait_ms = capture_scheduler.msUntilDue(halMillis());
+    halDelay(wait_ms == 0 ? 1 : wait_ms > 100 ? 100 : wait_ms);
 }
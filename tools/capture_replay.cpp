@@ -0,0 +1,207 @@
+// Прогін запису кадрів з пристрою (src/CaptureRecorder.h, формат edge-impulse-sdk/classifier/ei_capture.h)
+// через модель на хості: кожен кадр, для якого пристрій запускав класифікатор, іде в run_classifier
+// прямо з mmap файлу (signal_view, без копій), результат порівнюється із записаним на пристрої.
+// Лише кадр, який треба зменшити в дробове число разів (320x240 -> 96x96), спершу зменшується
+// в буфер тим самим resize_image_using_mode, що й у прошивці.
+// Наприкінці - розбіжності і таймінги пристрою проти хоста.
+//
+//   python3 tools/telemetry_decode.py --port /dev/ttyUSB0 --capture field.cap   ("capture start" у порт;
+//       по HTTP - /api/capture/start і /api/capture, або віртуальний пристрій з --record)
+//   g++ -std=gnu++17 -O2 <build_flags env:native> -Ilib/Robotics_Practice_inferencing/src
+//       tools/capture_replay.cpp <джерела lib/Robotics_Practice_inferencing/src> -o capture_replay -lm
+//   ./capture_replay field.cap [--tolerance 0.01] [--verbose]
+//
+// Без --tolerance впевненості мають збігатися біт у біт. Блоки постобробки зі станом (злиття
+// теплових карт, тригер) бачать ті самі кадри в тому ж порядку, лише поки в записі немає
+// втрачених кадрів: після пропуску (dropped) розбіжності очікувані, вони рахуються окремо.
+// Історію злиття, яку пристрій скинув після паузи (EI_CAPTURE_FLAG_STATE_RESET), хост скидає там же.
+
+#include <algorithm>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "edge-impulse-sdk/classifier/ei_run_classifier.h"
+#include "edge-impulse-sdk/classifier/ei_capture_mmap.h"
+
+struct ReplayTotals {
+    uint32_t frames;
+    uint32_t matched;
+    uint32_t mismatched;
+    uint32_t mismatched_after_gap;
+    uint32_t errors;
+    uint32_t skipped;
+    uint32_t resized;           // кадри, зменшені в буфер (дробовий масштаб)
+    uint64_t device_us[3];      // dsp, nn, постобробка
+    uint64_t host_us[3];
+};
+
+static bool close_enough(float a, float b, float tolerance) {
+    return tolerance == 0.0f ? memcmp(&a, &b, sizeof(float)) == 0 : fabsf(a - b) <= tolerance;
+}
+
+// Записаний результат проти результату хоста; перша розбіжність - у why
+static bool compare(const ei_capture_view_t& view, const ei_impulse_result_t& result, float tolerance,
+                    char* why, size_t why_size) {
+    const ei_impulse_t* impulse = ei_default_impulse.impulse;
+    ei_capture_box_t box;
+    uint32_t count = 0;
+    for (uint32_t ix = 0; ix < result.bounding_boxes_count; ix++) {
+        if (!ei_capture_box_from_result(impulse, &result.bounding_boxes[ix], &box)) continue;
+        if (count >= view.record->boxes_count) {
+            snprintf(why, why_size, "%u boxes on device, more on host", (unsigned)view.record->boxes_count);
+            return false;
+        }
+        const ei_capture_box_t& dev = view.boxes[count++];
+        if (dev.label_ix != box.label_ix || dev.x != box.x || dev.y != box.y ||
+            dev.width != box.width || dev.height != box.height || !close_enough(dev.value, box.value, tolerance)) {
+            snprintf(why, why_size, "box %u: device %u %.6f [%u,%u %ux%u], host %u %.6f [%u,%u %ux%u]",
+                     (unsigned)(count - 1), dev.label_ix, dev.value, dev.x, dev.y, dev.width, dev.height,
+                     box.label_ix, box.value, box.x, box.y, box.width, box.height);
+            return false;
+        }
+    }
+    if (count != view.record->boxes_count) {
+        snprintf(why, why_size, "%u boxes on device, %u on host", (unsigned)view.record->boxes_count, (unsigned)count);
+        return false;
+    }
+    for (uint16_t ix = 0; ix < view.record->classification_count && ix < impulse->label_count; ix++) {
+        if (!close_enough(view.classification[ix], result.classification[ix].value, tolerance)) {
+            snprintf(why, why_size, "%s: device %.6f, host %.6f", impulse->categories[ix],
+                     view.classification[ix], result.classification[ix].value);
+            return false;
+        }
+    }
+    if (!close_enough(view.record->anomaly, result.anomaly, tolerance)) {
+        snprintf(why, why_size, "anomaly: device %.6f, host %.6f", view.record->anomaly, result.anomaly);
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    const char* path = NULL;
+    float tolerance = 0.0f;
+    bool verbose = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc) {
+            tolerance = (float)atof(argv[++i]);
+        } else if (strcmp(argv[i], "--verbose") == 0) {
+            verbose = true;
+        } else if (argv[i][0] != '-' && path == NULL) {
+            path = argv[i];
+        } else {
+            path = NULL;
+            break;
+        }
+    }
+    if (path == NULL) {
+        fprintf(stderr, "usage: %s field.cap [--tolerance T] [--verbose]\n", argv[0]);
+        return 2;
+    }
+
+    ei_capture_file_t file;
+    if (ei_capture_file_open(&file, path) != EI_IMPULSE_OK) {
+        return 1;
+    }
+    const ei_impulse_t* impulse = ei_default_impulse.impulse;
+    const ei_capture_header_t* header = file.reader.header;
+    printf("%s: project %u impulse %u v%u, input %ux%u, %u labels\n", path,
+           (unsigned)header->project_id, (unsigned)header->impulse_id, (unsigned)header->deploy_version,
+           header->input_width, header->input_height, header->label_count);
+    if (header->project_id != impulse->project_id || header->impulse_id != impulse->impulse_id ||
+        header->input_width != impulse->input_width || header->input_height != impulse->input_height ||
+        header->label_count != impulse->label_count) {
+        fprintf(stderr, "Capture was recorded with another impulse (project %u impulse %u, %ux%u)\n",
+                (unsigned)impulse->project_id, (unsigned)impulse->impulse_id,
+                (unsigned)impulse->input_width, (unsigned)impulse->input_height);
+        ei_capture_file_close(&file);
+        return 1;
+    }
+    if (header->deploy_version != impulse->deploy_version) {
+        printf("note: recorded with deploy v%u, replaying v%u\n",
+               (unsigned)header->deploy_version, (unsigned)impulse->deploy_version);
+    }
+
+    run_classifier_init();
+
+    ReplayTotals totals;
+    memset(&totals, 0, sizeof(totals));
+    bool after_gap = false;
+    std::vector<uint8_t> input;
+    ei_capture_view_t view;
+    while (ei_capture_reader_next(&file.reader, &view)) {
+        const ei_capture_record_t* record = view.record;
+        after_gap = after_gap || record->dropped > 0;
+        // кадр, на якому пристрій не запускав модель, не чіпає і стан постобробки
+        if (!(record->flags & EI_CAPTURE_FLAG_RESULT) || record->error != EI_IMPULSE_OK) {
+            totals.skipped++;
+            continue;
+        }
+
+        if (record->flags & EI_CAPTURE_FLAG_STATE_RESET) {
+            reset_fomo_fusion();
+        }
+        ei_impulse_result_t result;
+        memset(&result, 0, sizeof(result));
+        // кадр розміру входу моделі і кадр, зменшений у ціле число разів, читаються прямо з mmap;
+        // дробове зменшення - у буфер, так само, як на пристрої. Буфер росте до найбільшого кадру:
+        // менше ніж удвічі зменшений кадр спершу копіюється в нього цілим crop-ом
+        input.resize(std::max(input.size(), ei_capture_resize_buffer_bytes(&file.reader, &view)));
+        EI_IMPULSE_ERROR res = ei_capture_run_classifier(&ei_default_impulse, &file.reader, &view, &result,
+                                                         input.data(), input.size());
+        if (res == EI_IMPULSE_INVALID_SIZE) {
+            totals.skipped++;
+            continue;
+        }
+        ei::image::processing::crop_resize_t crop;
+        ei_capture_crop_init(&crop, &file.reader, &view);
+        if (crop.win_width % crop.out_width != 0 || crop.win_height % crop.out_height != 0) {
+            totals.resized++;
+        }
+        totals.frames++;
+        if (res != EI_IMPULSE_OK) {
+            totals.errors++;
+            printf("[FRAME %u] run_classifier failed (%d)\n", (unsigned)record->frame_id, res);
+            continue;
+        }
+
+        totals.device_us[0] += record->dsp_us;
+        totals.device_us[1] += record->classification_us;
+        totals.device_us[2] += record->postprocessing_us;
+        totals.host_us[0] += (uint64_t)result.timing.dsp_us;
+        totals.host_us[1] += (uint64_t)result.timing.classification_us;
+        totals.host_us[2] += (uint64_t)result.timing.postprocessing_us;
+
+        char why[160];
+        if (compare(view, result, tolerance, why, sizeof(why))) {
+            totals.matched++;
+            if (verbose) {
+                printf("[FRAME %u] match, %u boxes\n", (unsigned)record->frame_id, (unsigned)record->boxes_count);
+            }
+        } else {
+            if (after_gap) totals.mismatched_after_gap++;
+            else totals.mismatched++;
+            printf("[FRAME %u] %s%s\n", (unsigned)record->frame_id, why, after_gap ? " (after dropped frames)" : "");
+        }
+    }
+
+    printf("%u records (%u corrupt%s), %u replayed (%u resized into a buffer), %u skipped (no device result)\n",
+           (unsigned)file.reader.records, (unsigned)file.reader.corrupt,
+           file.reader.truncated ? ", last one cut short" : "", (unsigned)totals.frames,
+           (unsigned)totals.resized, (unsigned)totals.skipped);
+    printf("match %u, mismatch %u, mismatch after dropped frames %u, host errors %u\n",
+           (unsigned)totals.matched, (unsigned)totals.mismatched, (unsigned)totals.mismatched_after_gap,
+           (unsigned)totals.errors);
+    if (totals.frames > totals.errors) {
+        const double n = totals.frames - totals.errors;
+        printf("avg us        dsp      nn      pp\n");
+        printf("device   %7.0f %7.0f %7.0f\n", totals.device_us[0] / n, totals.device_us[1] / n, totals.device_us[2] / n);
+        printf("host     %7.0f %7.0f %7.0f\n", totals.host_us[0] / n, totals.host_us[1] / n, totals.host_us[2] / n);
+    }
+
+    ei_capture_file_close(&file);
+    return totals.mismatched == 0 && totals.errors == 0 ? 0 : 1;
+}
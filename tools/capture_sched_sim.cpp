@@ -0,0 +1,357 @@
+// Симуляція планувальника захоплення (src/CaptureScheduler.h) на хості, з мілісекундним кроком.
+// Дві задачі ділять камеру так само, як у прошивці:
+//  - цикл інференції (loop() у src/main.cpp): коли кадр на часі - tryAcquire, якщо камера зайнята -
+//    повтор через 5 мс; кадр триває скільки скаже траса затримок; release, frameDone; сон до
+//    наступного кадру, але не довше 100 мс;
+//  - стрім (streamHandler у src/WebServerHandler.h): tryAcquire, якщо ні - повтор через 10 мс;
+//    кадр тримає камеру, поки відправляється; пауза streamIntervalMs().
+// Сцена задана фазами: активність (купюра в кадрі), затримка кадру, вільний heap, час відправки
+// кадру стріму, натискання кнопки сканування. Порядок задач в одну мілісекунду випадковий.
+//
+// Перевіряється:
+//  - камеру ніколи не тримають двоє, стрім не бере кадр, поки інференція чекає на камеру;
+//  - кадр інференції починається не раніше запланованого і не пізніше, ніж найдовший кадр стріму;
+//  - темп по фазах: повільний без активності, швидкий з купюрою, обмежений часткою часу на
+//    інференцію при довгих кадрах, сповільнений при малому heap (і стрім теж);
+//  - частка часу на інференцію не більша за max_duty_percent ні в середньому, ні для кожного кадру;
+//  - кадр на кнопку - одразу після кадру, який тримав камеру, або за 100 мс сну циклу.
+//
+//   g++ -std=gnu++17 -O2 -Isrc tools/capture_sched_sim.cpp -o capture_sched_sim
+//   ./capture_sched_sim [--seed 1] [--verbose]
+//
+// --verbose - кожен кадр інференції в stdout (CSV). Код виходу 1 - щось не зійшлося.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+#include "CaptureScheduler.h"
+
+// Як capture_config у src/main.cpp
+static const CaptureSchedulerConfig sim_config = {
+    500,            // active_interval_ms
+    3000,           // idle_interval_ms
+    5000,           // idle_after_ms
+    60,             // max_duty_percent
+    40 * 1024,      // min_free_heap
+    2000,           // low_heap_interval_ms
+    50,             // stream_interval_ms
+    250,            // low_heap_stream_interval_ms
+    150,            // stream_guard_ms
+};
+
+// Фаза сцени
+struct SimPhase {
+    const char* name;
+    uint32_t start_ms;
+    uint32_t end_ms;
+    bool activity;              // купюра в кадрі
+    uint32_t frame_ms;          // затримка кадру інференції, +-20%
+    uint32_t free_heap;
+    uint32_t stream_send_ms;    // відправка кадру стріму, зрідка вдвічі-втричі довша
+    uint32_t expect_min_ms;     // очікуваний інтервал між кадрами інференції (медіана)
+    uint32_t expect_max_ms;
+};
+
+// Межі очікувань: duty 60% при кадрі 700 мс +-20% - інтервал від 560 / 0.6 до 840 / 0.6 мс
+static const SimPhase sim_phases[] = {
+    { "idle",      0,      20000,  false, 150, 120000, 40,  2950, 3050 },
+    { "active",    20000,  40000,  true,  150, 120000, 120, 495,  505 },
+    { "slow",      40000,  60000,  true,  700, 120000, 40,  1000, 1400 },
+    { "cooldown",  60000,  80000,  false, 150, 120000, 40,  2950, 3050 },
+    { "low_heap",  80000,  100000, true,  150, 30000,  40,  2000, 2050 },
+    { "buttons",   100000, 120000, false, 150, 120000, 40,  0,    0 },
+};
+#define SIM_PHASES (sizeof(sim_phases) / sizeof(sim_phases[0]))
+
+// Кнопка сканування (/api/scan) посеред повільного темпу
+static const uint32_t sim_buttons[] = { 101500, 105250, 111100 };
+#define SIM_BUTTONS (sizeof(sim_buttons) / sizeof(sim_buttons[0]))
+
+#define SIM_END_MS          120000
+#define SIM_SETTLE_MS       6000    // темп перелаштовується: старий інтервал до 3 с і кілька кадрів середнього
+#define SIM_LOOP_RETRY_MS   5       // loop(): камера зайнята
+#define SIM_LOOP_MAX_SLEEP  100     // loop(): найдовший сон
+#define SIM_STREAM_RETRY_MS 10      // стрім: камера зайнята
+
+struct SimFrame {
+    uint32_t due_ms;            // коли кадр став на часі
+    uint32_t start_ms;          // коли інференція отримала камеру
+    uint32_t frame_ms;
+    uint32_t scheduled_ms;      // інтервал, який планувальник дав після попереднього кадру
+    bool requested;             // позачерговий (кнопка)
+    size_t phase;
+};
+
+static int failures = 0;
+
+#define CHECK(cond, ...) do { \
+    if (!(cond)) { \
+        fprintf(stderr, "FAIL %s:%d: ", __FILE__, __LINE__); \
+        fprintf(stderr, __VA_ARGS__); \
+        fprintf(stderr, "\n"); \
+        failures++; \
+    } \
+} while (0)
+
+static uint64_t rng_state = 1;
+
+static uint32_t rng() {
+    rng_state = rng_state * 6364136223846793005ull + 1442695040888963407ull;
+    return (uint32_t)(rng_state >> 33);
+}
+
+static size_t phase_at(uint32_t t) {
+    for (size_t ix = 0; ix < SIM_PHASES; ix++) {
+        if (t >= sim_phases[ix].start_ms && t < sim_phases[ix].end_ms) return ix;
+    }
+    return SIM_PHASES - 1;
+}
+
+static uint32_t jitter(uint32_t ms, uint32_t percent) {
+    const uint32_t span = ms * percent / 100;
+    return ms - span + rng() % (2 * span + 1);
+}
+
+static uint32_t median(std::vector<uint32_t> v) {
+    if (v.empty()) return 0;
+    std::nth_element(v.begin(), v.begin() + v.size() / 2, v.end());
+    return v[v.size() / 2];
+}
+
+int main(int argc, char** argv) {
+    bool verbose = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            rng_state = strtoull(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--verbose") == 0) {
+            verbose = true;
+        } else {
+            fprintf(stderr, "usage: %s [--seed 1] [--verbose]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    CaptureScheduler scheduler(sim_config);
+    CameraClient holder = CAMERA_FREE;
+
+    // цикл інференції
+    uint32_t inf_wake = 0;
+    uint32_t inf_busy_until = 0;
+    bool inf_busy = false;
+    bool inf_waiting = false;   // на часі, але камеру тримає стрім
+    SimFrame frame = {};
+    uint32_t scheduled_ms = 0;
+    std::vector<SimFrame> frames;
+
+    // стрім
+    uint32_t stream_wake = 0;
+    uint32_t stream_busy_until = 0;
+    bool stream_busy = false;
+    uint32_t stream_hold_max = 0;
+    uint32_t stream_frames[SIM_PHASES] = { 0 };
+    uint32_t stream_steady_frames[SIM_PHASES] = { 0 };
+    uint32_t stream_guard_violations = 0;
+
+    size_t button_ix = 0;
+    std::vector<uint32_t> button_latency;
+    bool button_pending = false;
+    uint32_t button_ms = 0;
+    uint32_t button_busy_ms = 0;    // скільки ще камеру тримав поточний кадр, коли натиснули
+
+    for (uint32_t t = 0; t < SIM_END_MS; t++) {
+        const SimPhase& phase = sim_phases[phase_at(t)];
+
+        if (button_ix < SIM_BUTTONS && t == sim_buttons[button_ix]) {
+            scheduler.requestCapture();
+            button_pending = true;
+            button_ms = t;
+            button_busy_ms = inf_busy ? inf_busy_until - t : stream_busy ? stream_busy_until - t : 0;
+            button_ix++;
+        }
+
+        // кінці кадрів - до того, як задачі в цю мілісекунду візьмуться за камеру
+        if (inf_busy && t >= inf_busy_until) {
+            scheduler.release(CAMERA_INFERENCE);
+            holder = CAMERA_FREE;
+            inf_busy = false;
+            const SimPhase& start_phase = sim_phases[frame.phase];
+            scheduler.frameDone(frame.start_ms, frame.frame_ms * 1000, start_phase.activity, start_phase.free_heap);
+            scheduled_ms = scheduler.intervalMs();
+            const uint32_t wait_ms = scheduler.msUntilDue(t);
+            inf_wake = t + (wait_ms == 0 ? 1 : wait_ms > SIM_LOOP_MAX_SLEEP ? SIM_LOOP_MAX_SLEEP : wait_ms);
+        }
+        if (stream_busy && t >= stream_busy_until) {
+            scheduler.release(CAMERA_STREAM);
+            holder = CAMERA_FREE;
+            stream_busy = false;
+            stream_wake = t + scheduler.streamIntervalMs();
+        }
+
+        // обидві задачі прокидаються в одну мілісекунду - порядок випадковий
+        const bool inference_first = (rng() & 1) != 0;
+        for (int turn = 0; turn < 2; turn++) {
+            if ((turn == 0) == inference_first) {
+                if (inf_busy || t < inf_wake) continue;
+                if (!scheduler.due(t)) {
+                    const uint32_t wait_ms = scheduler.msUntilDue(t);
+                    inf_wake = t + (wait_ms > SIM_LOOP_MAX_SLEEP ? SIM_LOOP_MAX_SLEEP : wait_ms);
+                    continue;
+                }
+                if (!inf_waiting) {
+                    frame = {};
+                    frame.due_ms = t;
+                    frame.requested = button_pending;
+                }
+                if (!scheduler.tryAcquire(CAMERA_INFERENCE, t)) {
+                    CHECK(holder != CAMERA_FREE, "t=%u: inference refused a free camera", t);
+                    inf_waiting = true;
+                    inf_wake = t + SIM_LOOP_RETRY_MS;
+                    continue;
+                }
+                CHECK(holder == CAMERA_FREE, "t=%u: inference got the camera held by %d", t, (int)holder);
+                holder = CAMERA_INFERENCE;
+                inf_waiting = false;
+                inf_busy = true;
+                frame.start_ms = t;
+                frame.frame_ms = jitter(phase.frame_ms, 20);
+                frame.scheduled_ms = scheduled_ms;
+                frame.phase = phase_at(t);
+                inf_busy_until = t + frame.frame_ms;
+                frames.push_back(frame);
+                if (button_pending && frame.requested) {
+                    // кадр, що вже йшов, не рахується: після нього - одразу позачерговий
+                    CHECK(t - button_ms <= button_busy_ms + SIM_LOOP_MAX_SLEEP + SIM_LOOP_RETRY_MS,
+                          "t=%u: scan request waited %u ms, the camera was busy for %u ms more", t,
+                          t - button_ms, button_busy_ms);
+                    button_latency.push_back(t - button_ms);
+                    button_pending = false;
+                }
+            } else {
+                if (stream_busy || t < stream_wake) continue;
+                const bool guard_open = scheduler.msUntilDue(t) >= sim_config.stream_guard_ms;
+                if (!scheduler.tryAcquire(CAMERA_STREAM, t)) {
+                    stream_wake = t + SIM_STREAM_RETRY_MS;
+                    continue;
+                }
+                CHECK(holder == CAMERA_FREE, "t=%u: stream got the camera held by %d", t, (int)holder);
+                CHECK(!inf_waiting, "t=%u: stream took a frame while inference waits for the camera", t);
+                if (!guard_open) {
+                    stream_guard_violations++;
+                }
+                holder = CAMERA_STREAM;
+                stream_busy = true;
+                uint32_t send_ms = rng() % 50 == 0 ? phase.stream_send_ms * (2 + rng() % 2) : jitter(phase.stream_send_ms, 25);
+                stream_busy_until = t + send_ms;
+                if (send_ms > stream_hold_max) stream_hold_max = send_ms;
+                stream_frames[phase_at(t)]++;
+                if (t >= phase.start_ms + SIM_SETTLE_MS) {
+                    stream_steady_frames[phase_at(t)]++;
+                }
+            }
+        }
+    }
+
+    CHECK(stream_guard_violations == 0, "stream took %u frames within stream_guard_ms of an inference frame",
+          stream_guard_violations);
+
+    // кадри: не раніше запланованого, не пізніше найдовшого кадру стріму; темп і duty по фазах
+    std::vector<uint32_t> gaps[SIM_PHASES];
+    uint64_t busy_ms[SIM_PHASES] = { 0 };
+    uint32_t waited = 0, waited_max = 0;
+    if (verbose) {
+        printf("frame,phase,due_ms,start_ms,frame_ms,scheduled_ms,gap_ms,requested\n");
+    }
+    for (size_t ix = 0; ix < frames.size(); ix++) {
+        const SimFrame& f = frames[ix];
+        const uint32_t wait_ms = f.start_ms - f.due_ms;
+        if (wait_ms > 0) waited++;
+        if (wait_ms > waited_max) waited_max = wait_ms;
+        CHECK(wait_ms <= stream_hold_max, "frame %u: waited %u ms for the camera, longest stream frame %u ms",
+              (unsigned)ix, wait_ms, stream_hold_max);
+        // час кадру всередині усталеної частини фази
+        for (size_t px = 0; px < SIM_PHASES; px++) {
+            const uint32_t from = sim_phases[px].start_ms + SIM_SETTLE_MS;
+            const uint32_t to = sim_phases[px].end_ms;
+            const uint32_t a = f.start_ms > from ? f.start_ms : from;
+            const uint32_t b = f.start_ms + f.frame_ms < to ? f.start_ms + f.frame_ms : to;
+            if (b > a) busy_ms[px] += b - a;
+        }
+
+        uint32_t gap = 0;
+        if (ix > 0) {
+            const SimFrame& prev = frames[ix - 1];
+            gap = f.start_ms - prev.start_ms;
+            if (!f.requested) {
+                // бюджет кожного кадру, а не лише в середньому
+                CHECK(gap * sim_config.max_duty_percent + 100 > prev.frame_ms * 100,
+                      "frame %u: %u ms after a %u ms frame, over %u%% of the time", (unsigned)ix, gap,
+                      prev.frame_ms, sim_config.max_duty_percent);
+                CHECK(f.due_ms - prev.start_ms >= f.scheduled_ms, "frame %u: due %u ms after the previous, scheduled %u ms",
+                      (unsigned)ix, f.due_ms - prev.start_ms, f.scheduled_ms);
+                CHECK(f.due_ms - prev.start_ms <= (f.scheduled_ms > prev.frame_ms ? f.scheduled_ms : prev.frame_ms) + 1,
+                      "frame %u: due %u ms after the previous, scheduled %u ms", (unsigned)ix,
+                      f.due_ms - prev.start_ms, f.scheduled_ms);
+            }
+            if (!f.requested && !prev.requested && prev.phase == f.phase &&
+                prev.start_ms >= sim_phases[f.phase].start_ms + SIM_SETTLE_MS) {
+                gaps[f.phase].push_back(gap);
+            }
+        }
+        if (verbose) {
+            printf("%u,%s,%u,%u,%u,%u,%u,%d\n", (unsigned)ix, sim_phases[f.phase].name, f.due_ms, f.start_ms,
+                   f.frame_ms, f.scheduled_ms, gap, f.requested ? 1 : 0);
+        }
+    }
+
+    printf("phase      frames  interval ms (median)  duty %%  stream fps   (без перших %u мс фази)\n", SIM_SETTLE_MS);
+    for (size_t ix = 0; ix < SIM_PHASES; ix++) {
+        const SimPhase& p = sim_phases[ix];
+        uint32_t count = 0;
+        for (const SimFrame& f : frames) {
+            if (f.phase == ix) count++;
+        }
+        const uint32_t interval = median(gaps[ix]);
+        const uint32_t steady_ms = p.end_ms - p.start_ms - SIM_SETTLE_MS;
+        const float duty = 100.0f * busy_ms[ix] / steady_ms;
+        const float stream_fps = 1000.0f * stream_steady_frames[ix] / steady_ms;
+        printf("%-10s %6u  %20u  %6.1f  %10.1f\n", p.name, count, interval, duty, stream_fps);
+
+        if (p.expect_max_ms > 0) {
+            CHECK(!gaps[ix].empty(), "%s: no steady frames", p.name);
+            CHECK(interval >= p.expect_min_ms && interval <= p.expect_max_ms, "%s: interval %u ms, expected %u..%u",
+                  p.name, interval, p.expect_min_ms, p.expect_max_ms);
+        }
+        CHECK(duty <= sim_config.max_duty_percent + 2, "%s: inference takes %.1f%% of the time, budget %u%%",
+              p.name, duty, sim_config.max_duty_percent);
+        CHECK(stream_frames[ix] > 0, "%s: the stream got no frames", p.name);
+    }
+
+    // малий heap: стрім сповільнюється до low_heap_stream_interval_ms
+    const size_t low_heap_ix = 4;
+    const float low_heap_fps = 1000.0f * stream_steady_frames[low_heap_ix] /
+        (sim_phases[low_heap_ix].end_ms - sim_phases[low_heap_ix].start_ms - SIM_SETTLE_MS);
+    CHECK(low_heap_fps < 1000.0f / sim_config.low_heap_stream_interval_ms,
+          "low heap: stream at %.1f fps, expected under %.1f", low_heap_fps, 1000.0f / sim_config.low_heap_stream_interval_ms);
+
+    CHECK(button_latency.size() == SIM_BUTTONS, "%u of %u scan requests got a frame",
+          (unsigned)button_latency.size(), (unsigned)SIM_BUTTONS);
+    uint32_t button_max = 0;
+    for (uint32_t latency : button_latency) {
+        if (latency > button_max) button_max = latency;
+    }
+    CHECK(button_max <= SIM_LOOP_MAX_SLEEP + stream_hold_max, "scan request waited %u ms", button_max);
+
+    printf("inference frames %u, waited for the camera %u (max %u ms), longest stream frame %u ms\n",
+           (unsigned)frames.size(), waited, waited_max, stream_hold_max);
+    printf("scan requests %u, longest wait %u ms\n", (unsigned)button_latency.size(), button_max);
+
+    if (failures > 0) {
+        fprintf(stderr, "%d checks failed\n", failures);
+        return 1;
+    }
+    printf("ok\n");
+    return 0;
+}
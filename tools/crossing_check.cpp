@@ -0,0 +1,255 @@
+// Перевірка лічильника перетинів ліній (CrossingCounter з
+// edge-impulse-sdk/classifier/postprocessing/ei_object_counting.h) на синтетичних треках. У цьому
+// експорті трекінг і підрахунок вимкнені, тож у прошивку лічильник не потрапляє - тут він
+// збирається окремо від трекера і ганяється на хості:
+//  - ручні випадки з відомою відповіддю: перетин туди й назад, центроїд, що зупинився на лінії,
+//    мітка не з категорій (лише загальний лічильник лінії), та сама мітка іншим вказівником,
+//    координати за межею EI_OBJECT_COUNTING_COORD_LIMIT, заміна ліній через set_segments;
+//  - випадкові треки на сітці входу (багато точок рівно на лініях і на їхніх кінцях) і зрідка
+//    далеко за кадром: лічильники по лініях і по мітках звіряються з прямим підрахунком в int64
+//    без відсікання по габаритах.
+//
+//   L=lib/Robotics_Practice_inferencing/src
+//   g++ -std=gnu++17 -O2 -DEI_PORTING_CLIB=1 -I$L -I$L/edge-impulse-sdk tools/crossing_check.cpp
+//       $L/edge-impulse-sdk/porting/clib/ei_classifier_porting.cpp $L/edge-impulse-sdk/dsp/memory.cpp
+//       -o crossing_check
+//   ./crossing_check [--tracks 64] [--frames 20000] [--seed 1]
+//
+// Код виходу 1 - щось не зійшлося, кожна розбіжність у stderr.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <tuple>
+#include <vector>
+#include "edge-impulse-sdk/classifier/postprocessing/ei_object_counting.h"
+
+#if EI_CLASSIFIER_OBJECT_COUNTING_ENABLED == 1
+#error "crossing_check builds CrossingCounter without the tracker, leave EI_CLASSIFIER_OBJECT_COUNTING_ENABLED off"
+#endif
+
+// Мітки моделі (model-parameters/model_variables.h)
+static const char* check_labels[] = { "1000_UAH", "100_UAH", "200_UAH", "20_UAH", "500_UAH", "50_UAH" };
+#define CHECK_LABELS (sizeof(check_labels) / sizeof(check_labels[0]))
+
+static_assert(CHECK_LABELS <= EI_OBJECT_COUNTING_MAX_LABELS, "labels don't fit the counter");
+
+// Трек у тому вигляді, в якому його читає CrossingCounter::update
+struct SynthTrace {
+    const char* label;
+    std::tuple<int, int, int, int> last_centroid_segment;
+};
+
+static int failures = 0;
+
+#define CHECK(cond, ...) do { \
+    if (!(cond)) { \
+        fprintf(stderr, "FAIL %s:%d: ", __FILE__, __LINE__); \
+        fprintf(stderr, __VA_ARGS__); \
+        fprintf(stderr, "\n"); \
+        failures++; \
+    } \
+} while (0)
+
+static uint64_t rng_state = 1;
+
+static uint32_t rng() {
+    rng_state = rng_state * 6364136223846793005ull + 1442695040888963407ull;
+    return (uint32_t)(rng_state >> 33);
+}
+
+static int64_t clamp_ref(int v) {
+    if (v > EI_OBJECT_COUNTING_COORD_LIMIT) return EI_OBJECT_COUNTING_COORD_LIMIT;
+    if (v < -EI_OBJECT_COUNTING_COORD_LIMIT) return -EI_OBJECT_COUNTING_COORD_LIMIT;
+    return v;
+}
+
+// P строго ліворуч від AB (точка на прямій - ні), як у лічильнику
+static bool left_of(int64_t ax, int64_t ay, int64_t bx, int64_t by, int64_t px, int64_t py) {
+    return (bx - ax) * (py - ay) - (by - ay) * (px - ax) > 0;
+}
+
+// Прямий підрахунок: рух CD перетинає лінію AB
+static bool crosses_ref(const std::tuple<int, int, int, int>& line, int x0, int y0, int x1, int y1) {
+    int64_t ax = clamp_ref(std::get<0>(line)), ay = clamp_ref(std::get<1>(line));
+    int64_t bx = clamp_ref(std::get<2>(line)), by = clamp_ref(std::get<3>(line));
+    int64_t cx = clamp_ref(x0), cy = clamp_ref(y0), dx = clamp_ref(x1), dy = clamp_ref(y1);
+    if (cx == dx && cy == dy) {
+        return false;
+    }
+    return left_of(ax, ay, bx, by, cx, cy) != left_of(ax, ay, bx, by, dx, dy) &&
+           left_of(cx, cy, dx, dy, ax, ay) != left_of(cx, cy, dx, dy, bx, by);
+}
+
+// Лінії каси на вході 96x96: горизонталь, вертикаль, діагональ і коротка похила
+static const std::vector<std::tuple<int, int, int, int>> check_segments = {
+    std::make_tuple(0, 48, 95, 48),
+    std::make_tuple(48, 0, 48, 95),
+    std::make_tuple(10, 80, 80, 10),
+    std::make_tuple(60, 60, 90, 75),
+};
+
+static void move(CrossingCounter& counter, const char* label, int x0, int y0, int x1, int y1) {
+    SynthTrace trace = { label, std::make_tuple(x0, y0, x1, y1) };
+    counter.update(&trace, 1);
+}
+
+static void check_cases() {
+    CrossingCounter counter(check_segments, check_labels, CHECK_LABELS);
+    CHECK(counter.segments_count == check_segments.size(), "segments %u", (unsigned)counter.segments_count);
+    CHECK(counter.labels_count == CHECK_LABELS, "labels %u", (unsigned)counter.labels_count);
+
+    // вниз через горизонталь і назад: два перетини лінії 0
+    move(counter, check_labels[1], 20, 20, 20, 60);
+    move(counter, check_labels[1], 20, 60, 20, 20);
+    CHECK(counter.counts[0] == 2 && counter.label_counts[0][1] == 2, "back and forth: %u / %u",
+          counter.counts[0], counter.label_counts[0][1]);
+    CHECK(counter.counts[1] == 0 && counter.counts[2] == 0 && counter.counts[3] == 0, "back and forth hit other lines");
+
+    // центроїд зупинився рівно на лінії, потім пішов далі: один перетин
+    move(counter, check_labels[2], 30, 40, 30, 48);
+    move(counter, check_labels[2], 30, 48, 30, 48);
+    move(counter, check_labels[2], 30, 48, 30, 56);
+    CHECK(counter.label_counts[0][2] == 1, "stop on the line: %u", counter.label_counts[0][2]);
+
+    // мітка не з категорій і без мітки - лише загальний лічильник
+    move(counter, "unknown", 40, 5, 56, 5);
+    move(counter, NULL, 56, 5, 40, 5);
+    uint32_t labelled = 0;
+    for (size_t lx = 0; lx < CHECK_LABELS; lx++) {
+        labelled += counter.label_counts[1][lx];
+    }
+    CHECK(counter.counts[1] == 2 && labelled == 0, "unlabelled: %u / %u", counter.counts[1], labelled);
+
+    // та сама мітка з іншого буфера знаходиться порівнянням рядків
+    char copy[16];
+    strcpy(copy, check_labels[4]);
+    move(counter, copy, 10, 10, 70, 70);
+    CHECK(counter.label_counts[2][4] == 1, "label by name: %u", counter.label_counts[2][4]);
+    CHECK(counter.label_counts[0][4] == 1 && counter.label_counts[1][4] == 1, "diagonal move: %u %u",
+          counter.label_counts[0][4], counter.label_counts[1][4]);
+
+    // координати далеко за межею обрізаються, перетин лишається
+    move(counter, check_labels[0], 5, -1000000, 5, 1000000);
+    CHECK(counter.label_counts[0][0] == 1, "clamped move: %u", counter.label_counts[0][0]);
+
+    // ті самі лінії в іншому місці - лічильники лишаються, інша кількість ліній - скидаються
+    const uint32_t kept = counter.counts[0];
+    std::vector<std::tuple<int, int, int, int>> shifted = check_segments;
+    std::get<1>(shifted[0]) = 50;
+    std::get<3>(shifted[0]) = 50;
+    CHECK(counter.set_segments(shifted), "set_segments failed");
+    CHECK(counter.counts[0] == kept, "counts lost on the same number of lines");
+    std::vector<std::tuple<int, int, int, int>> out;
+    counter.get_segments(out);
+    CHECK(out == shifted, "get_segments differs");
+    shifted.pop_back();
+    CHECK(counter.set_segments(shifted), "set_segments failed");
+    CHECK(counter.segments_count == shifted.size() && counter.counts[0] == 0, "counts kept on fewer lines");
+    std::vector<std::tuple<int, int, int, int>> too_many(EI_OBJECT_COUNTING_MAX_SEGMENTS + 1, check_segments[0]);
+    CHECK(!counter.set_segments(too_many), "set_segments took %u lines", (unsigned)too_many.size());
+}
+
+static void check_random(int tracks, int frames) {
+    CrossingCounter counter(check_segments, check_labels, CHECK_LABELS);
+    const size_t lines = check_segments.size();
+    std::vector<uint32_t> ref_counts(lines, 0);
+    std::vector<uint32_t> ref_label_counts(lines * CHECK_LABELS, 0);
+
+    std::vector<SynthTrace> traces(tracks);
+    std::vector<int> xs(tracks), ys(tracks), label_ixs(tracks);
+    for (int t = 0; t < tracks; t++) {
+        xs[t] = (int)(rng() % 96);
+        ys[t] = (int)(rng() % 96);
+        label_ixs[t] = (int)(rng() % (CHECK_LABELS + 1)) - 1;
+    }
+
+    uint64_t moves = 0;
+    for (int frame = 0; frame < frames; frame++) {
+        for (int t = 0; t < tracks; t++) {
+            int x1, y1;
+            if (rng() % 500 == 0) {
+                // зрідка центроїд стрибає далеко за кадр
+                x1 = (int)(rng() % 40001) - 20000;
+                y1 = (int)(rng() % 40001) - 20000;
+            } else {
+                // крок на сітці, часто нульовий по одній осі
+                x1 = xs[t] + (int)(rng() % 17) - 8;
+                y1 = ys[t] + (int)(rng() % 17) - 8;
+                x1 = x1 < 0 ? 0 : x1 > 95 ? 95 : x1;
+                y1 = y1 < 0 ? 0 : y1 > 95 ? 95 : y1;
+            }
+            if (rng() % 200 == 0) {
+                // новий трек на місці старого
+                label_ixs[t] = (int)(rng() % (CHECK_LABELS + 1)) - 1;
+            }
+            traces[t].label = label_ixs[t] < 0 ? "unknown" : check_labels[label_ixs[t]];
+            traces[t].last_centroid_segment = std::make_tuple(xs[t], ys[t], x1, y1);
+
+            for (size_t ix = 0; ix < lines; ix++) {
+                if (crosses_ref(check_segments[ix], xs[t], ys[t], x1, y1)) {
+                    ref_counts[ix]++;
+                    if (label_ixs[t] >= 0) {
+                        ref_label_counts[ix * CHECK_LABELS + label_ixs[t]]++;
+                    }
+                }
+            }
+            if (x1 > 95 || x1 < 0 || y1 > 95 || y1 < 0) {
+                x1 = (int)(rng() % 96);
+                y1 = (int)(rng() % 96);
+            }
+            xs[t] = x1;
+            ys[t] = y1;
+        }
+        counter.update(traces.data(), traces.size());
+        moves += tracks;
+    }
+
+    uint32_t total = 0;
+    for (size_t ix = 0; ix < lines; ix++) {
+        CHECK(counter.counts[ix] == ref_counts[ix], "line %u: %u crossings, expected %u",
+              (unsigned)ix, counter.counts[ix], ref_counts[ix]);
+        for (size_t lx = 0; lx < CHECK_LABELS; lx++) {
+            CHECK(counter.label_counts[ix][lx] == ref_label_counts[ix * CHECK_LABELS + lx],
+                  "line %u label %s: %u crossings, expected %u", (unsigned)ix, check_labels[lx],
+                  counter.label_counts[ix][lx], ref_label_counts[ix * CHECK_LABELS + lx]);
+        }
+        total += counter.counts[ix];
+    }
+    printf("random: %llu moves, %u crossings on %u lines\n", (unsigned long long)moves, total, (unsigned)lines);
+    for (size_t ix = 0; ix < lines; ix++) {
+        printf("  line %u:", (unsigned)ix);
+        for (size_t lx = 0; lx < CHECK_LABELS; lx++) {
+            printf(" %s=%u", check_labels[lx], counter.label_counts[ix][lx]);
+        }
+        printf(" total=%u\n", counter.counts[ix]);
+    }
+}
+
+int main(int argc, char** argv) {
+    int tracks = 64;
+    int frames = 20000;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--tracks") == 0 && i + 1 < argc) {
+            tracks = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            frames = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            rng_state = strtoull(argv[++i], NULL, 0);
+        } else {
+            fprintf(stderr, "usage: %s [--tracks 64] [--frames 20000] [--seed 1]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    check_cases();
+    check_random(tracks, frames);
+
+    if (failures > 0) {
+        fprintf(stderr, "%d checks failed\n", failures);
+        return 1;
+    }
+    printf("ok\n");
+    return 0;
+}
@@ -0,0 +1,220 @@
+// Навчає кластери для оцінки незвичності купюр (edge-impulse-sdk/classifier/ei_anomaly_fixed.h) і
+// пише їх заголовком для прошивки. Ембединг - int8 вихід одного вузла детектора (за замовчуванням
+// 24, ознаки 12x12x32 перед останньою згорткою FOMO) у клітинці під центром кожної детекції.
+// K-means на цих векторах, радіус кластера - найбільша відстань до його членів, тож оцінка
+// (d^2 - r^2) / середнє r^2 додатна лише поза всіма кластерами.
+//
+// Запис - сирі gray8 кадри підряд, як для віртуального пристрою, на справжніх купюрах. Більший
+// кадр зменшується до входу моделі так само, як у прошивці (по центру, усереднення по площі).
+// Збирається як tools/pack_weights.cpp (джерела SDK, прапорці env:native, лише цей файл замість src/):
+//
+//   ./fit_anomaly notes.gray --size 96x96 --clusters 8 -o src/AnomalyModel.h
+//   pio run -e esp32cam (з -DANOMALY_MODEL=1 у build_flags)
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "edge-impulse-sdk/classifier/ei_run_classifier.h"
+#include "edge-impulse-sdk/classifier/ei_anomaly_fixed.h"
+#include "edge-impulse-sdk/classifier/postprocessing/ei_postprocessing_thresholds.h"
+
+static const int ITERATIONS = 30;
+
+struct Collector {
+    std::vector<int8_t> map;
+    uint16_t height, width, channels;
+    bool valid;
+};
+
+static void collectTap(const ei_tensor_tap_t* tap, void* ctx) {
+    Collector* c = (Collector*)ctx;
+    if (tap->type != kTfLiteInt8) return;
+    c->map.assign((const int8_t*)tap->data, (const int8_t*)tap->data + tap->bytes);
+    c->height = tap->height;
+    c->width = tap->width;
+    c->channels = tap->channels;
+    c->valid = true;
+}
+
+static float distance2(const float* a, const int8_t* b, size_t dims) {
+    float d2 = 0;
+    for (size_t d = 0; d < dims; d++) {
+        float diff = a[d] - b[d];
+        d2 += diff * diff;
+    }
+    return d2;
+}
+
+int main(int argc, char** argv) {
+    const char* capture = NULL;
+    const char* out_path = "AnomalyModel.h";
+    int width = 96, height = 96, clusters = 8, node = 24;
+    float threshold = -1;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--size") && i + 1 < argc) sscanf(argv[++i], "%dx%d", &width, &height);
+        else if (!strcmp(argv[i], "--clusters") && i + 1 < argc) clusters = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--node") && i + 1 < argc) node = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--threshold") && i + 1 < argc) threshold = (float)atof(argv[++i]);
+        else if (!strcmp(argv[i], "-o") && i + 1 < argc) out_path = argv[++i];
+        else capture = argv[i];
+    }
+    if (!capture || clusters < 1 || clusters > EI_ANOMALY_FIXED_MAX_CLUSTERS ||
+        width < EI_CLASSIFIER_INPUT_WIDTH || height < EI_CLASSIFIER_INPUT_HEIGHT) {
+        fprintf(stderr, "usage: %s capture.gray [--size 96x96] [--clusters 8] [--node 24] [--threshold 0.5] [-o AnomalyModel.h]\n", argv[0]);
+        return 2;
+    }
+
+    const ei_impulse_t* impulse = ei_default_impulse.impulse;
+    const ei_learning_block_config_tflite_graph_t* block_config =
+        (const ei_learning_block_config_tflite_graph_t*)impulse->learning_blocks[0].config;
+    const ei_config_tflite_eon_graph_t* graph = (const ei_config_tflite_eon_graph_t*)block_config->graph_config;
+    Collector collector = {};
+    if (!block_config->compiled || !graph->model_set_tap ||
+        graph->model_set_tap(node, &collectTap, &collector) != kTfLiteOk) {
+        fprintf(stderr, "Node %d can't be tapped\n", node);
+        return 1;
+    }
+    // Поріг детекції для збору (за замовчуванням - як у моделі)
+    if (threshold >= 0) {
+        for (size_t i = 0; i < impulse->postprocessing_blocks_size; i++) {
+            set_threshold_postprocessing(&impulse->postprocessing_blocks[i], "min_score", threshold);
+        }
+    }
+
+    FILE* file = fopen(capture, "rb");
+    if (!file) {
+        fprintf(stderr, "Cannot open %s\n", capture);
+        return 1;
+    }
+    std::vector<uint8_t> frame((size_t)width * height);
+    std::vector<int8_t> samples;
+    size_t dims = 0, frames = 0;
+    run_classifier_init();
+    while (fread(frame.data(), 1, frame.size(), file) == frame.size()) {
+        ei::image::processing::crop_resize_t crop;
+        ei::image::processing::crop_resize_init(&crop, frame.data(), width, height, 1, 0, 0, width, height,
+                                                EI_CLASSIFIER_INPUT_WIDTH, EI_CLASSIFIER_INPUT_HEIGHT,
+                                                EI_CLASSIFIER_RESIZE_FIT_SHORTEST, EI_CLASSIFIER_RESIZE_FILTER_AREA);
+        ei::signal_view<ei::signal_source_crop_resize> signal = ei::signal_view_from_crop(crop);
+        ei_impulse_result_t result = { 0 };
+        collector.valid = false;
+        if (run_classifier(&signal, &result, false) != EI_IMPULSE_OK || !collector.valid) {
+            continue;
+        }
+        frames++;
+        dims = collector.channels;
+        for (uint32_t i = 0; i < result.bounding_boxes_count; i++) {
+            const ei_impulse_result_bounding_box_t& bb = result.bounding_boxes[i];
+            if (bb.value == 0) continue;
+            uint32_t cx = (bb.x + bb.width / 2) * collector.width / EI_CLASSIFIER_INPUT_WIDTH;
+            uint32_t cy = (bb.y + bb.height / 2) * collector.height / EI_CLASSIFIER_INPUT_HEIGHT;
+            const int8_t* e = &collector.map[((size_t)cy * collector.width + cx) * dims];
+            samples.insert(samples.end(), e, e + dims);
+        }
+    }
+    fclose(file);
+    graph->model_set_tap(-1, NULL, NULL);
+
+    const size_t count = dims ? samples.size() / dims : 0;
+    if (dims > EI_ANOMALY_FIXED_MAX_DIMS || count < (size_t)clusters) {
+        fprintf(stderr, "%zu detections of %zu dims in %zu frames, need at least %d\n", count, dims, frames, clusters);
+        return 1;
+    }
+
+    // Початкові центри: найвіддаленіші точки (детерміновано), далі ітерації Ллойда
+    std::vector<float> centres((size_t)clusters * dims);
+    std::vector<float> nearest(count, INFINITY);
+    std::vector<int> member(count, 0);
+    size_t pick = 0;
+    for (int k = 0; k < clusters; k++) {
+        for (size_t d = 0; d < dims; d++) centres[k * dims + d] = samples[pick * dims + d];
+        for (size_t i = 0; i < count; i++) {
+            float d2 = distance2(&centres[k * dims], &samples[i * dims], dims);
+            if (d2 < nearest[i]) nearest[i] = d2;
+            if (nearest[i] > nearest[pick]) pick = i;
+        }
+    }
+    for (int it = 0; it < ITERATIONS; it++) {
+        for (size_t i = 0; i < count; i++) {
+            float best = INFINITY;
+            for (int k = 0; k < clusters; k++) {
+                float d2 = distance2(&centres[k * dims], &samples[i * dims], dims);
+                if (d2 < best) {
+                    best = d2;
+                    member[i] = k;
+                }
+            }
+        }
+        std::vector<double> sum((size_t)clusters * dims, 0.0);
+        std::vector<size_t> members(clusters, 0);
+        for (size_t i = 0; i < count; i++) {
+            members[member[i]]++;
+            for (size_t d = 0; d < dims; d++) sum[member[i] * dims + d] += samples[i * dims + d];
+        }
+        for (int k = 0; k < clusters; k++) {
+            if (members[k] == 0) continue;
+            for (size_t d = 0; d < dims; d++) centres[k * dims + d] = (float)(sum[k * dims + d] / members[k]);
+        }
+    }
+
+    // Квантовані центри (dimension-major) і радіуси, рахуються вже від квантованих центрів
+    std::vector<int8_t> q((size_t)clusters * dims);
+    for (int k = 0; k < clusters; k++) {
+        for (size_t d = 0; d < dims; d++) {
+            long v = lroundf(centres[k * dims + d]);
+            q[d * clusters + k] = (int8_t)(v < -128 ? -128 : v > 127 ? 127 : v);
+        }
+    }
+    ei_anomaly_fixed_model_t model = { (int16_t)node, (uint16_t)dims, (uint16_t)clusters, q.data(), NULL, NULL, 1.0f };
+    std::vector<int32_t> radius2(clusters, 0);
+    for (size_t i = 0; i < count; i++) {
+        int32_t d2 = 0;
+        for (size_t d = 0; d < dims; d++) {
+            int32_t diff = samples[i * dims + d] - q[d * clusters + member[i]];
+            d2 += diff * diff;
+        }
+        if (d2 > radius2[member[i]]) radius2[member[i]] = d2;
+    }
+    double mean_radius2 = 0;
+    for (int k = 0; k < clusters; k++) mean_radius2 += radius2[k];
+    mean_radius2 = mean_radius2 / clusters < 1.0 ? 1.0 : mean_radius2 / clusters;
+
+    // Самоперевірка: кожна навчальна точка всередині свого кластера
+    std::vector<int32_t> bias(clusters);
+    for (int k = 0; k < clusters; k++) bias[k] = -radius2[k];
+    model.bias = bias.data();
+    int32_t worst = INT32_MIN;
+    for (size_t i = 0; i < count; i++) {
+        int32_t s = ei_anomaly_fixed_score_raw(&model, &samples[i * dims]);
+        if (s > worst) worst = s;
+    }
+
+    FILE* out = fopen(out_path, "w");
+    if (!out) {
+        fprintf(stderr, "Cannot write %s\n", out_path);
+        return 1;
+    }
+    fprintf(out, "// Згенеровано tools/fit_anomaly.cpp з %s (детекцій: %zu, кадрів: %zu, кластерів: %d).\n",
+            capture, count, frames, clusters);
+    fprintf(out, "// Оцінка = (d^2 - r^2) / %.1f, додатна поза всіма кластерами.\n\n", mean_radius2);
+    fprintf(out, "#ifndef _ANOMALY_MODEL_H_\n#define _ANOMALY_MODEL_H_\n\n");
+    fprintf(out, "#include \"edge-impulse-sdk/classifier/ei_anomaly_fixed.h\"\n\n");
+    fprintf(out, "// Байти карти ознак вузла %d (%ux%ux%zu)\n", node, collector.height, collector.width, dims);
+    fprintf(out, "#define ANOMALY_MAP_BYTES %zu\n\n", (size_t)collector.height * collector.width * dims);
+    fprintf(out, "static const int8_t anomaly_centres[%zu] = {", q.size());
+    for (size_t i = 0; i < q.size(); i++) fprintf(out, "%s%d,", i % clusters ? " " : "\n    ", q[i]);
+    fprintf(out, "\n};\n\nstatic const int32_t anomaly_bias[%d] = {\n   ", clusters);
+    for (int k = 0; k < clusters; k++) fprintf(out, " %d,", bias[k]);
+    fprintf(out, "\n};\n\nstatic const ei_anomaly_fixed_model_t anomaly_model = {\n");
+    fprintf(out, "    %d,     // tap_node\n    %zu,     // dims\n    %d,      // clusters\n", node, dims, clusters);
+    fprintf(out, "    anomaly_centres,\n    NULL,   // weights (K-means)\n    anomaly_bias,\n");
+    fprintf(out, "    %.9ef,  // score_scale\n};\n\n#endif\n", 1.0 / mean_radius2);
+    fclose(out);
+
+    printf("%s: %zu detections in %zu frames, %d clusters of %zu dims, mean r^2 %.1f, worst training score %d\n",
+           out_path, count, frames, clusters, dims, mean_radius2, worst);
+    return worst <= 0 ? 0 : 1;
+}
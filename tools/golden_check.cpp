@@ -0,0 +1,432 @@
+// Золоті виходи моделі: перш ніж оптимізоване ядро (ESP-NN, SIMD хоста, злиті чи потайлові шари)
+// піде на пристрій, сирі вихідні тензори скомпільованого графа на корпусі записаних кадрів мають
+// збігтися біт у біт з еталонними. Корпус - запис кадрів у форматі SDK (classifier/ei_capture.h:
+// src/CaptureRecorder.h на пристрої або віртуальний пристрій з --record), еталон - вихід тих самих
+// кадрів, отриманий еталонними ядрами (збірка хоста без оптимізацій, без --patch-budget).
+//
+// Порівнюється вихід графа до постобробки - ті байти, що отримує result->_raw_outputs (для FOMO
+// int8 12x12x7). Знімається він через ei_set_output_tap, бо _raw_outputs звільняється ще всередині
+// run_classifier. Блок fomo_i8_logits вимикає фінальний softmax графа, тож у цій конфігурації це
+// логіти - саме те, що рахує пристрій.
+//
+//   g++ -std=gnu++17 -O2 <build_flags env:native> -Ilib/Robotics_Practice_inferencing/src
+//       tools/golden_check.cpp <джерела lib/Robotics_Practice_inferencing/src> -o golden_check -lm
+//   ./golden_check corpus.cap --write goldens.bin                  еталонна збірка
+//   ./golden_check corpus.cap --check goldens.bin [--patch-budget 73728] [--timings frames.csv]
+//   ./golden_check field.cap --device                              вихід пристрою проти хоста
+//
+// --patch-budget вмикає план пам'яті з потайловим виконанням перших шарів (як EI_PATCH_BUDGET
+// у прошивці). --timings пише по рядку на кадр: час dsp/nn/pp еталону і поточної збірки.
+// --device порівнює вихід, який пристрій записав разом із кадром (src/CaptureRecorder.h),
+// з виходом хоста на тому ж кадрі. Код виходу 1 - є розбіжності або помилки.
+//
+// tools/golden - корпус, що звіряє CI: 8 кадрів з віртуального пристрою (96x96, 200x200, 160x120)
+// і їхній еталон. Після зміни моделі еталон перезаписується еталонною збіркою:
+//   ./golden_check tools/golden/corpus.cap --write tools/golden/goldens.bin
+
+#include <algorithm>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "edge-impulse-sdk/classifier/ei_run_classifier.h"
+#include "edge-impulse-sdk/classifier/ei_capture_mmap.h"
+#include "edge-impulse-sdk/classifier/ei_memory_plan.h"
+
+#define GOLDEN_MAGIC    0x44474945  // "EIGD"
+#define GOLDEN_VERSION  1
+
+// Файл еталону, little endian: GoldenHeader, далі frames разів GoldenFrame + output_bytes байтів
+struct GoldenHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t header_bytes;
+    uint32_t project_id;
+    uint32_t impulse_id;
+    uint32_t deploy_version;
+    uint32_t frames;
+    uint32_t corpus_checksum;   // FNV-1a контрольних сум записів корпусу
+    uint32_t patch_budget;      // з яким планом пам'яті знято еталон, 0 - без плану
+    uint32_t output_bytes;      // усі виходи кадру підряд
+    uint8_t output_type;        // TfLiteType першого виходу
+    uint8_t outputs;
+    uint16_t output_height;
+    uint16_t output_width;
+    uint16_t output_channels;
+};
+
+struct GoldenFrame {
+    uint32_t frame_id;
+    uint32_t dsp_us;
+    uint32_t classification_us;
+    uint32_t postprocessing_us;
+};
+
+// Виходи одного прогону в порядку, в якому їх віддав граф
+struct OutputCapture {
+    std::vector<uint8_t> bytes;
+    ei_tensor_tap_t first;
+    uint32_t outputs;
+};
+
+static void outputTap(uint32_t learn_block_index, const ei_tensor_tap_t* output, void* ctx) {
+    (void)learn_block_index;
+    OutputCapture* capture = (OutputCapture*)ctx;
+    if (capture->outputs++ == 0) capture->first = *output;
+    const uint8_t* data = (const uint8_t*)output->data;
+    capture->bytes.insert(capture->bytes.end(), data, data + output->bytes);
+}
+
+struct Totals {
+    uint32_t frames;
+    uint32_t matched;
+    uint32_t mismatched;
+    uint32_t errors;
+    uint32_t skipped;
+    uint64_t golden_us[3];      // dsp, nn, постобробка
+    uint64_t host_us[3];
+};
+
+// Перша розбіжність і найбільша різниця (як int8 для int8 виходу), false - якщо байти однакові
+static bool describe_diff(const uint8_t* expected, const uint8_t* actual, size_t bytes,
+                          const ei_tensor_tap_t& shape, char* why, size_t why_size) {
+    size_t first = bytes, count = 0;
+    int max_diff = 0;
+    for (size_t ix = 0; ix < bytes; ix++) {
+        if (expected[ix] == actual[ix]) continue;
+        if (first == bytes) first = ix;
+        count++;
+        int diff = shape.type == kTfLiteInt8 ? abs((int8_t)expected[ix] - (int8_t)actual[ix])
+                                              : abs(expected[ix] - actual[ix]);
+        if (diff > max_diff) max_diff = diff;
+    }
+    if (count == 0) return false;
+    // позиція в першому виході (NHWC), якщо розбіжність у ньому і він з байтовими елементами
+    const size_t first_elems = (size_t)shape.height * shape.width * shape.channels;
+    if (first_elems == shape.bytes && first < shape.bytes) {
+        snprintf(why, why_size, "%u of %u bytes differ, first at y=%u x=%u c=%u (%d vs %d), max diff %d",
+                 (unsigned)count, (unsigned)bytes, (unsigned)(first / shape.channels / shape.width),
+                 (unsigned)(first / shape.channels % shape.width), (unsigned)(first % shape.channels),
+                 (int8_t)expected[first], (int8_t)actual[first], max_diff);
+    } else {
+        snprintf(why, why_size, "%u of %u bytes differ, first at byte %u, max diff %d",
+                 (unsigned)count, (unsigned)bytes, (unsigned)first, max_diff);
+    }
+    return true;
+}
+
+// Контрольна сума корпусу - кадрів, які піде в модель (не менших за вхід), без зсуву читача
+static uint32_t corpus_checksum(const ei_capture_reader_t& reader, uint32_t* frames) {
+    ei_capture_reader_t scan = reader;
+    ei_capture_view_t view;
+    uint32_t hash = 2166136261u;
+    *frames = 0;
+    while (ei_capture_reader_next(&scan, &view)) {
+        if (view.record->frame_width < scan.header->input_width ||
+            view.record->frame_height < scan.header->input_height) {
+            continue;
+        }
+        hash = ei_capture_fnv1a(hash, &view.record->checksum, sizeof(view.record->checksum));
+        (*frames)++;
+    }
+    return hash;
+}
+
+static bool write_all(FILE* f, const void* data, size_t bytes) {
+    return fwrite(data, 1, bytes, f) == bytes;
+}
+
+static bool read_all(FILE* f, void* data, size_t bytes) {
+    return fread(data, 1, bytes, f) == bytes;
+}
+
+static void usage(const char* argv0) {
+    fprintf(stderr,
+            "usage: %s corpus.cap --write goldens.bin [--patch-budget N]\n"
+            "       %s corpus.cap --check goldens.bin [--patch-budget N] [--timings frames.csv] [--verbose]\n"
+            "       %s field.cap --device [--patch-budget N] [--verbose]\n",
+            argv0, argv0, argv0);
+}
+
+int main(int argc, char** argv) {
+    const char* path = NULL;
+    const char* write_path = NULL;
+    const char* check_path = NULL;
+    const char* timings_path = NULL;
+    bool device = false;
+    bool verbose = false;
+    uint32_t patch_budget = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--write") == 0 && i + 1 < argc) {
+            write_path = argv[++i];
+        } else if (strcmp(argv[i], "--check") == 0 && i + 1 < argc) {
+            check_path = argv[++i];
+        } else if (strcmp(argv[i], "--timings") == 0 && i + 1 < argc) {
+            timings_path = argv[++i];
+        } else if (strcmp(argv[i], "--patch-budget") == 0 && i + 1 < argc) {
+            patch_budget = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--device") == 0) {
+            device = true;
+        } else if (strcmp(argv[i], "--verbose") == 0) {
+            verbose = true;
+        } else if (argv[i][0] != '-' && path == NULL) {
+            path = argv[i];
+        } else {
+            path = NULL;
+            break;
+        }
+    }
+    if (path == NULL || (write_path != NULL) + (check_path != NULL) + device != 1 ||
+        (timings_path != NULL && check_path == NULL)) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    ei_capture_file_t file;
+    if (ei_capture_file_open(&file, path) != EI_IMPULSE_OK) {
+        return 1;
+    }
+    const ei_impulse_t* impulse = ei_default_impulse.impulse;
+    const ei_capture_header_t* header = file.reader.header;
+    if (header->project_id != impulse->project_id || header->impulse_id != impulse->impulse_id ||
+        header->input_width != impulse->input_width || header->input_height != impulse->input_height) {
+        fprintf(stderr, "%s was recorded with another impulse (project %u impulse %u, %ux%u)\n", path,
+                (unsigned)header->project_id, (unsigned)header->impulse_id,
+                (unsigned)header->input_width, (unsigned)header->input_height);
+        ei_capture_file_close(&file);
+        return 1;
+    }
+
+    // Еталон читається цілком наперед: кадрів у корпусі сотні, виходи - по ~1 КБ
+    GoldenHeader golden;
+    memset(&golden, 0, sizeof(golden));
+    std::vector<GoldenFrame> golden_frames;
+    std::vector<uint8_t> golden_outputs;
+    if (check_path != NULL) {
+        FILE* f = fopen(check_path, "rb");
+        if (f == NULL) {
+            fprintf(stderr, "Cannot open %s\n", check_path);
+            ei_capture_file_close(&file);
+            return 1;
+        }
+        bool ok = read_all(f, &golden, sizeof(golden)) && golden.magic == GOLDEN_MAGIC &&
+                  golden.version == GOLDEN_VERSION && golden.header_bytes == sizeof(GoldenHeader);
+        if (ok) {
+            golden_frames.resize(golden.frames);
+            golden_outputs.resize((size_t)golden.frames * golden.output_bytes);
+            for (uint32_t ix = 0; ok && ix < golden.frames; ix++) {
+                ok = read_all(f, &golden_frames[ix], sizeof(GoldenFrame)) &&
+                     read_all(f, golden_outputs.data() + (size_t)ix * golden.output_bytes, golden.output_bytes);
+            }
+        }
+        fclose(f);
+        if (!ok) {
+            fprintf(stderr, "%s is not a golden output file or is cut short\n", check_path);
+            ei_capture_file_close(&file);
+            return 1;
+        }
+        if (golden.project_id != impulse->project_id || golden.impulse_id != impulse->impulse_id ||
+            golden.deploy_version != impulse->deploy_version) {
+            fprintf(stderr, "Goldens are for project %u impulse %u v%u, this build is project %u impulse %u v%u\n",
+                    (unsigned)golden.project_id, (unsigned)golden.impulse_id, (unsigned)golden.deploy_version,
+                    (unsigned)impulse->project_id, (unsigned)impulse->impulse_id, (unsigned)impulse->deploy_version);
+            ei_capture_file_close(&file);
+            return 1;
+        }
+        printf("%s: %u frames, %u output bytes each, taken with patch budget %u\n", check_path,
+               (unsigned)golden.frames, (unsigned)golden.output_bytes, (unsigned)golden.patch_budget);
+        uint32_t frames;
+        const uint32_t checksum = corpus_checksum(file.reader, &frames);
+        if (frames != golden.frames || checksum != golden.corpus_checksum) {
+            fprintf(stderr, "%s has %u frames (checksum %08x), goldens were taken on %u frames (checksum %08x)\n",
+                    path, (unsigned)frames, (unsigned)checksum, (unsigned)golden.frames,
+                    (unsigned)golden.corpus_checksum);
+            ei_capture_file_close(&file);
+            return 1;
+        }
+    }
+
+    static ei_memory_plan_storage_t plan;
+    if (patch_budget > 0) {
+        EI_IMPULSE_ERROR res = ei_memory_plan_compute(impulse, 0, patch_budget, &plan);
+        if (res == EI_IMPULSE_OK) {
+            res = ei_memory_plan_apply(impulse, 0, &plan.plan);
+        }
+        if (res != EI_IMPULSE_OK) {
+            fprintf(stderr, "Memory plan with patch budget %u failed (%d)\n", (unsigned)patch_budget, res);
+            ei_capture_file_close(&file);
+            return 1;
+        }
+        ei_memory_plan_print(&plan);
+    }
+
+    run_classifier_init();
+    OutputCapture capture;
+    capture.outputs = 0;
+    ei_set_output_tap(outputTap, &capture);
+
+    FILE* out = NULL;
+    if (write_path != NULL) {
+        out = fopen(write_path, "wb");
+        if (out == NULL) {
+            fprintf(stderr, "Cannot create %s\n", write_path);
+            ei_capture_file_close(&file);
+            return 1;
+        }
+        // заголовок переписується наприкінці, коли відомі кадри і розмір виходу
+        golden.magic = GOLDEN_MAGIC;
+        golden.version = GOLDEN_VERSION;
+        golden.header_bytes = sizeof(GoldenHeader);
+        golden.project_id = impulse->project_id;
+        golden.impulse_id = impulse->impulse_id;
+        golden.deploy_version = impulse->deploy_version;
+        golden.patch_budget = patch_budget;
+        uint32_t frames;
+        golden.corpus_checksum = corpus_checksum(file.reader, &frames);
+        write_all(out, &golden, sizeof(golden));
+    }
+    FILE* timings = NULL;
+    if (timings_path != NULL) {
+        timings = fopen(timings_path, "w");
+        if (timings == NULL) {
+            fprintf(stderr, "Cannot create %s\n", timings_path);
+            ei_capture_file_close(&file);
+            return 1;
+        }
+        fprintf(timings, "frame_id,golden_dsp_us,golden_nn_us,golden_pp_us,dsp_us,nn_us,pp_us,match\n");
+    }
+
+    Totals totals;
+    memset(&totals, 0, sizeof(totals));
+    std::vector<uint8_t> input;
+    ei_capture_view_t view;
+    while (ei_capture_reader_next(&file.reader, &view)) {
+        const ei_capture_record_t* record = view.record;
+        if (device && view.raw_output == NULL) {
+            totals.skipped++;
+            continue;
+        }
+
+        ei_impulse_result_t result;
+        memset(&result, 0, sizeof(result));
+        capture.bytes.clear();
+        capture.outputs = 0;
+        input.resize(std::max(input.size(), ei_capture_resize_buffer_bytes(&file.reader, &view)));
+        EI_IMPULSE_ERROR res = ei_capture_run_classifier(&ei_default_impulse, &file.reader, &view, &result,
+                                                         input.data(), input.size());
+        if (res == EI_IMPULSE_INVALID_SIZE) {
+            totals.skipped++;
+            continue;
+        }
+        const uint32_t frame_ix = totals.frames++;
+        if (res != EI_IMPULSE_OK || capture.outputs == 0) {
+            totals.errors++;
+            printf("[FRAME %u] run_classifier failed (%d)\n", (unsigned)record->frame_id, res);
+            if (out != NULL) break;
+            continue;
+        }
+        const uint32_t host_us[3] = {
+            (uint32_t)result.timing.dsp_us, (uint32_t)result.timing.classification_us,
+            (uint32_t)result.timing.postprocessing_us
+        };
+        for (int ix = 0; ix < 3; ix++) totals.host_us[ix] += host_us[ix];
+
+        if (out != NULL) {
+            if (frame_ix == 0) {
+                golden.output_bytes = (uint32_t)capture.bytes.size();
+                golden.output_type = capture.first.type;
+                golden.outputs = (uint8_t)capture.outputs;
+                golden.output_height = capture.first.height;
+                golden.output_width = capture.first.width;
+                golden.output_channels = capture.first.channels;
+            } else if (capture.bytes.size() != golden.output_bytes) {
+                totals.errors++;
+                printf("[FRAME %u] %u output bytes, first frame had %u\n", (unsigned)record->frame_id,
+                       (unsigned)capture.bytes.size(), (unsigned)golden.output_bytes);
+                break;
+            }
+            GoldenFrame frame = { record->frame_id, host_us[0], host_us[1], host_us[2] };
+            write_all(out, &frame, sizeof(frame));
+            write_all(out, capture.bytes.data(), capture.bytes.size());
+            totals.matched++;
+            continue;
+        }
+
+        const uint8_t* expected;
+        size_t expected_bytes;
+        if (device) {
+            expected = view.raw_output;
+            expected_bytes = record->raw_output_bytes;
+            totals.golden_us[0] += record->dsp_us;
+            totals.golden_us[1] += record->classification_us;
+            totals.golden_us[2] += record->postprocessing_us;
+        } else {
+            const GoldenFrame& frame = golden_frames[frame_ix];
+            expected = golden_outputs.data() + (size_t)frame_ix * golden.output_bytes;
+            expected_bytes = golden.output_bytes;
+            totals.golden_us[0] += frame.dsp_us;
+            totals.golden_us[1] += frame.classification_us;
+            totals.golden_us[2] += frame.postprocessing_us;
+        }
+
+        char why[160];
+        bool match = false;
+        if (expected_bytes != capture.bytes.size()) {
+            snprintf(why, sizeof(why), "%u output bytes expected, %u on host",
+                     (unsigned)expected_bytes, (unsigned)capture.bytes.size());
+        } else {
+            match = !describe_diff(expected, capture.bytes.data(), expected_bytes, capture.first, why, sizeof(why));
+        }
+        if (match) {
+            totals.matched++;
+            if (verbose) printf("[FRAME %u] match\n", (unsigned)record->frame_id);
+        } else {
+            totals.mismatched++;
+            printf("[FRAME %u] %s\n", (unsigned)record->frame_id, why);
+        }
+        if (timings != NULL) {
+            const GoldenFrame& frame = golden_frames[frame_ix];
+            fprintf(timings, "%u,%u,%u,%u,%u,%u,%u,%d\n", (unsigned)record->frame_id,
+                    (unsigned)frame.dsp_us, (unsigned)frame.classification_us, (unsigned)frame.postprocessing_us,
+                    (unsigned)host_us[0], (unsigned)host_us[1], (unsigned)host_us[2], match ? 1 : 0);
+        }
+    }
+    ei_set_output_tap(NULL, NULL);
+
+    if (timings != NULL) {
+        fclose(timings);
+    }
+    if (out != NULL) {
+        golden.frames = totals.matched;
+        bool ok = totals.errors == 0 && fseek(out, 0, SEEK_SET) == 0 && write_all(out, &golden, sizeof(golden));
+        ok = fclose(out) == 0 && ok;
+        if (!ok) {
+            remove(write_path);
+            fprintf(stderr, "Goldens not written\n");
+            ei_capture_file_close(&file);
+            return 1;
+        }
+        printf("%s: %u frames, %u outputs, %u bytes per frame (type %u, first %ux%ux%u)\n", write_path,
+               (unsigned)golden.frames, (unsigned)golden.outputs, (unsigned)golden.output_bytes,
+               (unsigned)golden.output_type, golden.output_height, golden.output_width, golden.output_channels);
+    } else {
+        printf("%u frames checked, %u skipped (%s), match %u, mismatch %u, errors %u\n",
+               (unsigned)totals.frames, (unsigned)totals.skipped,
+               device ? "no device output" : "smaller than the input", (unsigned)totals.matched,
+               (unsigned)totals.mismatched, (unsigned)totals.errors);
+    }
+    if (totals.frames > totals.errors) {
+        const double n = totals.frames - totals.errors;
+        printf("avg us        dsp      nn      pp\n");
+        if (out == NULL) {
+            printf("%-8s %7.0f %7.0f %7.0f\n", device ? "device" : "golden",
+                   totals.golden_us[0] / n, totals.golden_us[1] / n, totals.golden_us[2] / n);
+        }
+        printf("host     %7.0f %7.0f %7.0f\n", totals.host_us[0] / n, totals.host_us[1] / n, totals.host_us[2] / n);
+    }
+
+    ei_capture_file_close(&file);
+    // порожній прогін нічого не доводить
+    return totals.frames > 0 && totals.mismatched == 0 && totals.errors == 0 ? 0 : 1;
+}
@@ -0,0 +1,382 @@
+// Перевірка і бенчмарк конвертерів кольору та зменшення кадру SDK (dsp/image/processing.cpp) на хості.
+// Кожен бекенд (SWAR, SSE2, AVX2) має давати побайтово той самий результат, що й скалярний,
+// зокрема на місці (in place) і на розмірах, не кратних кроку. Час конвертерів - мс на мегапіксель,
+// зменшення до 96x96 (білінійне проти усереднення по площі) - мс на кадр.
+//
+//   g++ -std=gnu++17 -O2 -march=native -DEI_PORTING_CLIB=1 -Ilib/Robotics_Practice_inferencing/src
+//       tools/image_convert_bench.cpp
+//       lib/Robotics_Practice_inferencing/src/edge-impulse-sdk/dsp/image/processing.cpp
+//       lib/Robotics_Practice_inferencing/src/edge-impulse-sdk/porting/clib/ei_classifier_porting.cpp
+//       -o image_convert_bench
+//   ./image_convert_bench [--width 1600] [--height 1200] [--runs 20]
+//
+// Код виходу 1 - є розбіжності.
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "edge-impulse-sdk/dsp/image/processing.hpp"
+
+using namespace ei::image::processing;
+
+enum Converter { YUV_TO_RGB, YUV_TO_GRAY, RGB565_TO_RGB, RGB565_TO_GRAY };
+
+static const char* converter_names[] = { "yuv422->rgb888", "yuv422->gray", "rgb565->rgb888", "rgb565->gray" };
+static const char* backend_names[] = { "auto", "scalar", "swar", "sse2", "avx2" };
+
+static const YUV_OPTIONS yuv_options[] = {
+    (YUV_OPTIONS)0,
+    BIG_ENDIAN_ORDER,
+    (YUV_OPTIONS)(BIG_ENDIAN_ORDER | PAD_4B),
+    PAD_4B,
+    YUYV_ORDER,
+    (YUV_OPTIONS)(YUYV_ORDER | BIG_ENDIAN_ORDER | PAD_4B),
+};
+static const YUV_OPTIONS rgb565_options[] = {
+    (YUV_OPTIONS)0,
+    RGB565_BIG_ENDIAN,
+    (YUV_OPTIONS)(RGB565_BIG_ENDIAN | BIG_ENDIAN_ORDER),
+    (YUV_OPTIONS)(RGB565_BIG_ENDIAN | BIG_ENDIAN_ORDER | PAD_4B),
+    PAD_4B,
+};
+
+// Вихідних байтів на піксель
+static size_t outputBpp(Converter converter, YUV_OPTIONS opts) {
+    if (converter == YUV_TO_GRAY || converter == RGB565_TO_GRAY) return 1;
+    return (opts & PAD_4B) ? 4 : 3;
+}
+
+// Розмір входу кратний макропікселю YUV422 (4 B), тож кількість пікселів парна
+static int convert(Converter converter, uint8_t* out, const uint8_t* in, size_t pixels,
+                   YUV_OPTIONS opts, CONVERT_BACKEND backend) {
+    unsigned int size = (unsigned int)(pixels * 2);
+    switch (converter) {
+        case YUV_TO_RGB: return yuv422_to_rgb888(out, in, size, opts, backend);
+        case YUV_TO_GRAY: return yuv422_to_gray(out, in, size, opts, backend);
+        case RGB565_TO_RGB: return rgb565_to_rgb888(out, in, size, opts, backend);
+        case RGB565_TO_GRAY: return rgb565_to_gray(out, in, size, opts, backend);
+    }
+    return -1;
+}
+
+// Результат у вихідному буфері або на місці (вхід на початку спільного буфера)
+static std::vector<uint8_t> run(Converter converter, const std::vector<uint8_t>& input, YUV_OPTIONS opts,
+                                CONVERT_BACKEND backend, bool in_place) {
+    size_t pixels = input.size() / 2;
+    size_t out_size = pixels * outputBpp(converter, opts);
+    std::vector<uint8_t> out(in_place ? std::max(out_size, input.size()) : out_size, 0xa5);
+    if (in_place) {
+        memcpy(out.data(), input.data(), input.size());
+        convert(converter, out.data(), out.data(), pixels, opts, backend);
+    } else {
+        convert(converter, out.data(), input.data(), pixels, opts, backend);
+    }
+    out.resize(out_size);
+    return out;
+}
+
+static uint32_t mismatches = 0;
+
+static void checkExact(Converter converter, const std::vector<uint8_t>& input, YUV_OPTIONS opts,
+                       CONVERT_BACKEND backend) {
+    for (int in_place = 0; in_place < 2; in_place++) {
+        std::vector<uint8_t> expected = run(converter, input, opts, CONVERT_SCALAR, in_place);
+        std::vector<uint8_t> actual = run(converter, input, opts, backend, in_place);
+        for (size_t i = 0; i < expected.size(); i++) {
+            if (expected[i] != actual[i]) {
+                printf("MISMATCH %s %s opts %d%s: %zu pixels, byte %zu = %u, scalar %u\n",
+                       converter_names[converter], backend_names[backend], opts, in_place ? " in place" : "",
+                       input.size() / 2, i, actual[i], expected[i]);
+                mismatches++;
+                break;
+            }
+        }
+    }
+}
+
+// Плавний градієнт з шумом: на чистому шумі білінійне і по площі не порівняти за якістю
+static std::vector<uint8_t> sceneInput(size_t width, size_t height, size_t bpp, uint32_t seed) {
+    std::vector<uint8_t> input(width * height * bpp);
+    for (size_t y = 0; y < height; y++) {
+        for (size_t x = 0; x < width * bpp; x++) {
+            seed = seed * 1664525u + 1013904223u;
+            int v = (int)((x / bpp) * 160 / width + y * 64 / height) + (int)(seed >> 28) - 8;
+            input[y * width * bpp + x] = (uint8_t)(v < 0 ? 0 : (v > 255 ? 255 : v));
+        }
+    }
+    return input;
+}
+
+// Результат бекенду в окремому буфері і на місці проти скалярного в окремому
+static uint32_t resizeMismatches(const std::vector<uint8_t>& input, int w, int h, int dw, int dh, int bpp,
+                                 CONVERT_BACKEND backend) {
+    std::vector<uint8_t> expected((size_t)dw * dh * bpp), separate(expected.size()), shared(input);
+    resize_image_area(input.data(), w, h, expected.data(), dw, dh, bpp, CONVERT_SCALAR);
+    if (resize_image_area(input.data(), w, h, separate.data(), dw, dh, bpp, backend) != 0 ||
+        resize_image_area(shared.data(), w, h, shared.data(), dw, dh, bpp, backend) != 0) {
+        return 1;
+    }
+    return (memcmp(expected.data(), separate.data(), expected.size()) != 0) +
+           (memcmp(expected.data(), shared.data(), expected.size()) != 0);
+}
+
+// Середня абсолютна різниця з точним середнім по блоку (еталон якості для зменшення)
+static double meanError(const std::vector<uint8_t>& src, int w, int h, const uint8_t* dst, int dw, int dh) {
+    double err = 0;
+    for (int y = 0; y < dh; y++) {
+        for (int x = 0; x < dw; x++) {
+            int x0 = x * w / dw, x1 = (x + 1) * w / dw, y0 = y * h / dh, y1 = (y + 1) * h / dh;
+            double sum = 0;
+            for (int yy = y0; yy < y1; yy++)
+                for (int xx = x0; xx < x1; xx++) sum += src[yy * w + xx];
+            double ref = sum / ((x1 - x0) * (y1 - y0));
+            double d = dst[y * dw + x] - ref;
+            err += d < 0 ? -d : d;
+        }
+    }
+    return err / (dw * dh);
+}
+
+// Та сама таблиця квантування, що в crop_resize_quantize_image
+static int8_t quantize(uint8_t v, float scale, int zero_point) {
+    int q = (int)lroundf((float)v / 255.0f / scale) + zero_point;
+    return (int8_t)(q > 127 ? 127 : (q < -128 ? -128 : q));
+}
+
+// Сірий піксель через luma ознак класифікатора (0.299 + 0.587 + 0.114 у 16 біт, тобто v * 65535 >> 16)
+static uint8_t lumaMono(uint8_t v) {
+    return (uint8_t)(((uint32_t)(0.299f * 65536.0f) + (uint32_t)(0.587f * 65536.0f) + (uint32_t)(0.114f * 65536.0f)) * v >> 16);
+}
+
+// Злитий crop + resize + квантування проти двох кроків: resize_image_using_mode у буфер, потім таблиця.
+// Перевіряється і вибірка по пікселю (crop_resize_pixel), на ній працює не-квантований шлях.
+static uint32_t cropResizeMismatches(int w, int h, int bpp, int mode, int filter, int dw, int dh) {
+    const float scale = 1.0f / 255;
+    const int zero_point = -128;
+    std::vector<uint8_t> frame = sceneInput(w, h, bpp, (uint32_t)(w + mode));
+    std::vector<uint8_t> resized(frame.size() + (size_t)dw * dh * bpp);
+    if (resize_image_using_mode(frame.data(), w, h, resized.data(), dw, dh, bpp, mode, filter) != 0) return 1;
+
+    crop_resize_t cr;
+    std::vector<int8_t> fused((size_t)dw * dh * bpp);
+    if (crop_resize_init(&cr, frame.data(), w, h, bpp, 0, 0, w, h, dw, dh, mode, filter) != 0 ||
+        crop_resize_quantize_image(&cr, fused.data(), bpp, scale, zero_point) != 0) {
+        return 1;
+    }
+    uint32_t found = 0;
+    for (size_t i = 0; i < fused.size(); i++) {
+        int8_t expected = quantize(bpp == 1 ? lumaMono(resized[i]) : resized[i], scale, zero_point);
+        if (fused[i] != expected) {
+            printf("MISMATCH crop_resize %dx%d %d B mode %d filter %d: value %zu = %d, two-step %d\n",
+                   w, h, bpp, mode, filter, i, fused[i], expected);
+            found++;
+            break;
+        }
+    }
+    for (int i = 0; i < dw * dh; i++) {
+        uint8_t first = (uint8_t)(crop_resize_pixel(&cr, i % dw, i / dw) >> 16);
+        if (fused[(size_t)i * bpp] != quantize(bpp == 1 ? lumaMono(first) : first, scale, zero_point)) {
+            printf("MISMATCH crop_resize_pixel %dx%d %d B mode %d filter %d at %d\n", w, h, bpp, mode, filter, i);
+            found++;
+            break;
+        }
+    }
+    return found;
+}
+
+static double bestMs(int runs, const std::function<void()>& fn) {
+    double best_ms = 1e9;
+    for (int r = 0; r < runs; r++) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (ms < best_ms) best_ms = ms;
+    }
+    return best_ms;
+}
+
+static std::vector<uint8_t> randomInput(size_t pixels, uint32_t seed) {
+    std::vector<uint8_t> input(pixels * 2);
+    for (size_t i = 0; i < input.size(); i++) {
+        seed = seed * 1664525u + 1013904223u;
+        input[i] = (uint8_t)(seed >> 24);
+    }
+    return input;
+}
+
+int main(int argc, char** argv) {
+    size_t width = 1600, height = 1200;
+    int runs = 20;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--width") == 0) width = (size_t)atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--height") == 0) height = (size_t)atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--runs") == 0) runs = atoi(argv[i + 1]);
+    }
+    const size_t pixels = (width * height) & ~(size_t)1;
+    if (pixels == 0 || runs <= 0) {
+        fprintf(stderr, "usage: %s [--width N] [--height N] [--runs N]\n", argv[0]);
+        return 2;
+    }
+
+    // Бітова точність: усі опції, на місці і ні, розміри з хвостами для кожного кроку
+    const size_t sizes[] = { 2, 6, 14, 30, 62, 98, 96 * 96, 1000 + 66 };
+    for (int c = 0; c < 4; c++) {
+        Converter converter = (Converter)c;
+        const bool yuv = converter == YUV_TO_RGB || converter == YUV_TO_GRAY;
+        const YUV_OPTIONS* options = yuv ? yuv_options : rgb565_options;
+        const size_t option_count = yuv ? sizeof(yuv_options) / sizeof(yuv_options[0])
+                                         : sizeof(rgb565_options) / sizeof(rgb565_options[0]);
+        for (int b = CONVERT_SWAR; b <= CONVERT_AVX2; b++) {
+            if (!convert_backend_available((CONVERT_BACKEND)b)) continue;
+            for (size_t o = 0; o < option_count; o++) {
+                for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+                    std::vector<uint8_t> input = randomInput(sizes[s] & ~(size_t)1, (uint32_t)(s * 31 + o + 1));
+                    checkExact(converter, input, options[o], (CONVERT_BACKEND)b);
+                }
+            }
+        }
+    }
+
+    // Зменшення по площі: бекенди проти скалярного, сірий і RGB, різні множники, з хвостами рядка
+    const int factors[][4] = { { 2, 2, 7, 5 }, { 5, 5, 96, 96 }, { 3, 4, 33, 10 }, { 10, 10, 19, 3 }, { 1, 3, 50, 7 } };
+    for (int b = CONVERT_SWAR; b <= CONVERT_AVX2; b++) {
+        if (!convert_backend_available((CONVERT_BACKEND)b)) continue;
+        for (size_t f = 0; f < sizeof(factors) / sizeof(factors[0]); f++) {
+            for (int bpp = 1; bpp <= 3; bpp += 2) {
+                int dw = factors[f][2], dh = factors[f][3];
+                int w = dw * factors[f][0], h = dh * factors[f][1];
+                std::vector<uint8_t> input = randomInput((size_t)w * h * bpp / 2 + 1, (uint32_t)(f * 7 + bpp));
+                input.resize((size_t)w * h * bpp);
+                if (resizeMismatches(input, w, h, dw, dh, bpp, (CONVERT_BACKEND)b)) {
+                    printf("MISMATCH area %s %dx%d -> %dx%d, %d B\n", backend_names[b], w, h, dw, dh, bpp);
+                    mismatches++;
+                }
+            }
+        }
+    }
+    // Квантований вихід - та сама таблиця, що й у пайплайні: round(v / 255 / scale) + zero_point
+    {
+        std::vector<uint8_t> input = randomInput(40 * 30 / 2, 77);
+        std::vector<uint8_t> u8(8 * 6);
+        std::vector<int8_t> i8(8 * 6);
+        resize_image_area(input.data(), 40, 30, u8.data(), 8, 6, 1);
+        resize_image_area_quantized(input.data(), 40, 30, i8.data(), 8, 6, 1, 1.0f / 255, -128);
+        for (size_t i = 0; i < u8.size(); i++) {
+            if (i8[i] != (int8_t)(u8[i] - 128)) {
+                printf("MISMATCH area quantized at %zu: %d, expected %d\n", i, i8[i], u8[i] - 128);
+                mismatches++;
+                break;
+            }
+        }
+    }
+    // Злитий шлях у тензор: усі режими, обидва фільтри, сірий і RGB.
+    // По площі з дробовим множником блоки інші, ніж у двох кроків, тож тут лише цілі множники.
+    const int crop_cases[][4] = {
+        // w, h, filter, режим (0 - усі)
+        { 320, 240, EI_CLASSIFIER_RESIZE_FILTER_BILINEAR, 0 },
+        { 160, 120, EI_CLASSIFIER_RESIZE_FILTER_BILINEAR, 0 },
+        { 100, 100, EI_CLASSIFIER_RESIZE_FILTER_BILINEAR, EI_CLASSIFIER_RESIZE_SQUASH },
+        { 640, 480, EI_CLASSIFIER_RESIZE_FILTER_AREA, EI_CLASSIFIER_RESIZE_FIT_SHORTEST },
+        { 480, 288, EI_CLASSIFIER_RESIZE_FILTER_AREA, EI_CLASSIFIER_RESIZE_SQUASH },
+        { 96 * 4, 96 * 2, EI_CLASSIFIER_RESIZE_FILTER_AREA, EI_CLASSIFIER_RESIZE_FIT_LONGEST },
+    };
+    for (size_t c = 0; c < sizeof(crop_cases) / sizeof(crop_cases[0]); c++) {
+        for (int mode = EI_CLASSIFIER_RESIZE_FIT_SHORTEST; mode <= EI_CLASSIFIER_RESIZE_SQUASH; mode++) {
+            if (crop_cases[c][3] && crop_cases[c][3] != mode) continue;
+            for (int bpp = 1; bpp <= 3; bpp += 2) {
+                mismatches += cropResizeMismatches(crop_cases[c][0], crop_cases[c][1], bpp, mode, crop_cases[c][2], 96, 96);
+            }
+        }
+    }
+    printf("bit-exact check: %u mismatches\n\n", mismatches);
+
+    // Бенчмарк на кадрі width x height (варіанти esp32-camera: YUYV, RGB565 big endian)
+    std::vector<uint8_t> input = randomInput(pixels, 12345);
+    std::vector<uint8_t> out(pixels * 4);
+    const YUV_OPTIONS bench_options[] = {
+        (YUV_OPTIONS)(YUYV_ORDER | BIG_ENDIAN_ORDER), YUYV_ORDER,
+        (YUV_OPTIONS)(RGB565_BIG_ENDIAN | BIG_ENDIAN_ORDER), RGB565_BIG_ENDIAN,
+    };
+    printf("%zux%zu, %d runs, ms per megapixel\n", width, height, runs);
+    printf("%-16s", "");
+    for (int b = CONVERT_SCALAR; b <= CONVERT_AVX2; b++) printf("%10s", backend_names[b]);
+    printf("\n");
+    for (int c = 0; c < 4; c++) {
+        printf("%-16s", converter_names[c]);
+        for (int b = CONVERT_SCALAR; b <= CONVERT_AVX2; b++) {
+            if (!convert_backend_available((CONVERT_BACKEND)b)) {
+                printf("%10s", "-");
+                continue;
+            }
+            double best_ms = 1e9;
+            for (int r = 0; r < runs; r++) {
+                auto start = std::chrono::steady_clock::now();
+                convert((Converter)c, out.data(), input.data(), pixels, bench_options[c], (CONVERT_BACKEND)b);
+                double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                if (ms < best_ms) best_ms = ms;
+            }
+            printf("%10.3f", best_ms * 1e6 / pixels);
+        }
+        printf("\n");
+    }
+
+    // Зменшення сірого кадру до 96x96 (fit-shortest): білінійне проти усереднення по площі.
+    // Похибка - середнє відхилення від точного середнього по блоку, у рівнях яскравості.
+    // Усереднення - заради похибки: у дробовому відношенні (320x240) воно повільніше за білінійне,
+    // швидше - лише в цілому (640x480, 480x480).
+    const int frames[][2] = { { 640, 480 }, { 320, 240 }, { 1600, 1200 }, { 96 * 5, 96 * 5 } };
+    printf("\n%-16s%14s%14s%14s%14s\n", "gray -> 96x96", "bilinear ms", "area ms", "bilinear err", "area err");
+    for (size_t f = 0; f < sizeof(frames) / sizeof(frames[0]); f++) {
+        const int w = frames[f][0], h = frames[f][1];
+        std::vector<uint8_t> frame = sceneInput(w, h, 1, 99);
+        std::vector<uint8_t> work(frame.size());
+        int cw, ch;
+        calculate_crop_dims(w, h, 96, 96, cw, ch);
+        std::vector<uint8_t> crop((size_t)cw * ch);
+        for (int y = 0; y < ch; y++) memcpy(&crop[(size_t)y * cw], &frame[(size_t)(y + (h - ch) / 2) * w + (w - cw) / 2], cw);
+
+        double ms[2], err[2];
+        for (int filter = 0; filter < 2; filter++) {
+            // Вихід в окремий буфер розміру кадру: білінійне спершу копіює туди вирізку
+            ms[filter] = bestMs(runs, [&]() {
+                resize_image_using_mode(frame.data(), w, h, work.data(), 96, 96, 1,
+                                        EI_CLASSIFIER_RESIZE_FIT_SHORTEST, filter);
+            });
+            err[filter] = meanError(crop, cw, ch, work.data(), 96, 96);
+        }
+        char name[24];
+        snprintf(name, sizeof(name), "%dx%d", w, h);
+        printf("%-16s%14.3f%14.3f%14.2f%14.2f\n", name, ms[0], ms[1], err[0], err[1]);
+    }
+
+    // Кадр -> int8 тензор 96x96: два кроки (resize у буфер кадру, потім квантування) проти злитого
+    printf("\n%-16s%14s%14s%14s%14s\n", "gray -> int8", "bilinear ms", "fused ms", "area ms", "fused ms");
+    for (size_t f = 0; f < sizeof(frames) / sizeof(frames[0]); f++) {
+        const int w = frames[f][0], h = frames[f][1];
+        std::vector<uint8_t> frame = sceneInput(w, h, 1, 99);
+        std::vector<uint8_t> work(frame.size());
+        std::vector<int8_t> tensor(96 * 96);
+        double ms[4];
+        for (int filter = 0; filter < 2; filter++) {
+            ms[filter * 2] = bestMs(runs, [&]() {
+                resize_image_using_mode(frame.data(), w, h, work.data(), 96, 96, 1,
+                                        EI_CLASSIFIER_RESIZE_FIT_SHORTEST, filter);
+                for (int i = 0; i < 96 * 96; i++) tensor[i] = (int8_t)(lumaMono(work[i]) - 128);
+            });
+            ms[filter * 2 + 1] = bestMs(runs, [&]() {
+                crop_resize_quantize_image(frame.data(), w, h, 1, 0, 0, w, h, tensor.data(), 96, 96, 1,
+                                           EI_CLASSIFIER_RESIZE_FIT_SHORTEST, filter, 1.0f / 255, -128);
+            });
+        }
+        char name[24];
+        snprintf(name, sizeof(name), "%dx%d", w, h);
+        printf("%-16s%14.3f%14.3f%14.3f%14.3f\n", name, ms[0], ms[1], ms[2], ms[3]);
+    }
+    return mismatches ? 1 : 0;
+}
@@ -0,0 +1,73 @@
+// Офлайн план пам'яті моделі: спільне розміщення активацій і scratch буферів ядер
+// (edge-impulse-sdk/classifier/ei_memory_plan.h) рахується тут, на хості, а не на пристрої при
+// кожному старті. Результат - таблиця tflite-model/tflite_learn_891896_6_memory_plan.h, яку граф
+// читає з EI_CLASSIFIER_TFLITE_MEMORY_PLAN=1 (env:esp32cam); прошивка лише перевіряє, що план
+// підходить ядрам збірки, і рахує новий на пристрої тільки тоді, коли не підходить.
+//
+// Розміри scratch буферів залежать від ядер, тому збирати треба з тими ж ядрами, що й прошивка:
+// ESP-NN (загальні оптимізовані *_opt.c, як на ESP32 без S3) і без EI_CLASSIFIER_TFLITE_FIXED_SHAPE_KERNELS.
+// esp_timer.h для ESP-NN на хості - src/host/esp_timer.h. Постійна пам'ять ядер на 64-бітному хості
+// більша, ніж на ESP32 (вказівники у структурах вузлів), тож арена плану виходить з невеликим запасом.
+//
+//   L=lib/Robotics_Practice_inferencing/src
+//   g++ -std=gnu++17 -O2 <build_flags env:native> -Isrc/host -I$L -DEI_CLASSIFIER_TFLITE_ENABLE_ESP_NN=1
+//       -DEI_CLASSIFIER_TFLITE_FIXED_SHAPE_KERNELS=0 tools/memory_plan_gen.cpp <джерела $L>
+//       $L/edge-impulse-sdk/porting/espressif/ESP-NN/src/*/*_{ansi,opt}.c -o memory_plan_gen -lm
+//   ./memory_plan_gen [--patch-budget 73728] > $L/tflite-model/tflite_learn_891896_6_memory_plan.h
+//
+// --patch-budget - як EI_PATCH_BUDGET у src/main.cpp (перші шари виконуються смугами рядків).
+// Таблиця йде в stdout, підсумок плану - в stderr. Код виходу 1 - план не порахувався.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "edge-impulse-sdk/classifier/ei_run_classifier.h"
+#include "edge-impulse-sdk/classifier/ei_memory_plan.h"
+
+#if EI_CLASSIFIER_TFLITE_ENABLE_ESP_NN != 1
+#error "memory_plan_gen needs -DEI_CLASSIFIER_TFLITE_ENABLE_ESP_NN=1, scratch buffers depend on the kernels"
+#endif
+#if EI_CLASSIFIER_TFLITE_FIXED_SHAPE_KERNELS == 1
+#error "memory_plan_gen needs -DEI_CLASSIFIER_TFLITE_FIXED_SHAPE_KERNELS=0, as in env:esp32cam"
+#endif
+
+// Префікс скомпільованої моделі (tflite-model/<name>_compiled.cpp)
+#define PLAN_MODEL_NAME "tflite_learn_891896_6"
+
+static void usage(const char* argv0) {
+    fprintf(stderr, "usage: %s [--patch-budget N] > tflite-model/" PLAN_MODEL_NAME "_memory_plan.h\n", argv0);
+}
+
+int main(int argc, char** argv) {
+    size_t patch_budget = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--patch-budget") == 0 && i + 1 < argc) {
+            patch_budget = (size_t)strtoul(argv[++i], NULL, 0);
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    static ei_memory_plan_storage_t storage;
+    EI_IMPULSE_ERROR res = ei_memory_plan_compute(ei_default_impulse.impulse, 0, patch_budget, &storage);
+    if (res != EI_IMPULSE_OK) {
+        fprintf(stderr, "memory plan failed (%d)\n", res);
+        return 1;
+    }
+
+    const ei_memory_plan_t* plan = &storage.plan;
+    fprintf(stderr, "plan: %u bytes activations + scratch, %u bytes persistent, arena %u bytes (built-in %u)\n",
+            (unsigned)plan->planned_bytes, (unsigned)plan->persistent_bytes,
+            (unsigned)(plan->planned_bytes + plan->persistent_bytes), (unsigned)storage.default_arena_size);
+    if (plan->patch_tile_rows > 0) {
+        fprintf(stderr, "patch stage: nodes %d-%d, tiles of %u rows, %u bytes (untiled %u), budget %u\n",
+                (int)storage.patch.first_node, (int)storage.patch.last_node, (unsigned)storage.patch.tile_rows,
+                (unsigned)storage.patch.tiled_bytes, (unsigned)storage.patch.untiled_bytes, (unsigned)patch_budget);
+    }
+    fprintf(stderr, "%u scratch buffers\n", (unsigned)plan->scratch_count);
+
+    ei_memory_plan_print_source(plan, PLAN_MODEL_NAME);
+    return 0;
+}
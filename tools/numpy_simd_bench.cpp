@@ -0,0 +1,264 @@
+// Перевірка і бенчмарк SSE2/AVX2 ядер матричних примітивів SDK (dsp/dsp_engines/ei_x86_numpy.hpp)
+// проти скалярних циклів numpy.hpp, що лишаються без EIDSP_USE_X86_SIMD (тут - їх копії). dot, scale,
+// add, mean_axis0, std_axis0, transpose і int8_to_float мають збігатися побітово, rms - з точністю
+// до порядку додавання (відносна похибка до 1e-5). Час - мкс на виклик, найкращий з --runs.
+// Без -ffp-contract=off компілятор може злити скалярне множення з додаванням у FMA, і тоді
+// побітового збігу не буде - це скалярний шлях інший, а не ядра.
+//
+//   g++ -std=gnu++17 -O2 -march=native -ffp-contract=off -DEI_PORTING_CLIB=1
+//       -Ilib/Robotics_Practice_inferencing/src tools/numpy_simd_bench.cpp
+//       lib/Robotics_Practice_inferencing/src/edge-impulse-sdk/porting/clib/ei_classifier_porting.cpp
+//       -o numpy_simd_bench
+//   ./numpy_simd_bench [--runs 50]
+//
+// Без -march=native - SSE2, з ним на процесорі з AVX2 - AVX2. Код виходу 1 - є розбіжності.
+
+#include <chrono>
+#include <functional>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "edge-impulse-sdk/dsp/numpy.hpp"
+
+#if !EIDSP_USE_X86_SIMD
+#error "numpy_simd_bench needs EIDSP_USE_X86_SIMD (an x86 host with SSE2)"
+#endif
+
+using ei::matrix_t;
+using ei::numpy;
+
+// Скалярні шляхи numpy.hpp (гілки #else під EIDSP_USE_X86_SIMD)
+namespace scalar {
+
+static void dot(const matrix_t* a, const matrix_t* b, matrix_t* out) {
+    memset(out->buffer, 0, out->rows * out->cols * sizeof(float));
+    for (size_t i = 0; i < a->rows; i++) {
+        const float* row = a->buffer + i * a->cols;
+        for (size_t j = 0; j < b->cols; j++) {
+            float tmp = 0.0f;
+            for (size_t k = 0; k < a->cols; k++) {
+                tmp += row[k] * b->buffer[k * b->cols + j];
+            }
+            out->buffer[i * b->cols + j] += tmp;
+        }
+    }
+}
+
+static void scale_and_add(matrix_t* m, float scale, float add) {
+    for (uint32_t ix = 0; ix < m->rows * m->cols; ix++) {
+        m->buffer[ix] = (m->buffer[ix] * scale) + add;
+    }
+}
+
+static void rms(const matrix_t* m, matrix_t* out) {
+    for (size_t row = 0; row < m->rows; row++) {
+        float sum = 0.0;
+        for (size_t ix = 0; ix < m->cols; ix++) {
+            float v = m->buffer[(row * m->cols) + ix];
+            sum += v * v;
+        }
+        out->buffer[row] = sqrtf(sum / static_cast<float>(m->cols));
+    }
+}
+
+static void mean_axis0(const matrix_t* m, matrix_t* out) {
+    for (size_t col = 0; col < m->cols; col++) {
+        float sum = 0.0f;
+        for (size_t row = 0; row < m->rows; row++) {
+            sum += m->buffer[(row * m->cols) + col];
+        }
+        out->buffer[col] = sum / m->rows;
+    }
+}
+
+static void std_axis0(const matrix_t* m, matrix_t* out) {
+    for (size_t col = 0; col < m->cols; col++) {
+        float sum = 0.0f;
+        for (size_t row = 0; row < m->rows; row++) {
+            sum += m->buffer[(row * m->cols) + col];
+        }
+        float mean = sum / m->rows;
+        float std = 0.0f;
+        for (size_t row = 0; row < m->rows; row++) {
+            float tmp = m->buffer[(row * m->cols) + col] - mean;
+            std += tmp * tmp;
+        }
+        out->buffer[col] = sqrtf(std / m->rows);
+    }
+}
+
+// Через повну тимчасову копію, як numpy::transpose без двигуна
+static void transpose(matrix_t* m) {
+    std::vector<float> temp((size_t)m->rows * m->cols);
+    for (size_t j = 0; j < m->cols; j++) {
+        for (size_t i = 0; i < m->rows; i++) {
+            temp[j * m->rows + i] = m->buffer[i * m->cols + j];
+        }
+    }
+    memcpy(m->buffer, temp.data(), temp.size() * sizeof(float));
+    std::swap(m->rows, m->cols);
+}
+
+static void int8_to_float(const int8_t* input, float* output, size_t length) {
+    for (size_t ix = 0; ix < length; ix++) {
+        output[ix] = static_cast<float>(input[ix]);
+    }
+}
+
+} // namespace scalar
+
+static uint32_t mismatches = 0;
+
+static void fillRandom(float* data, size_t count, uint32_t seed) {
+    for (size_t i = 0; i < count; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        data[i] = (float)(int32_t)(seed >> 8) / (float)(1 << 23) - 1.0f;
+    }
+}
+
+// max_rel 0 - побітово
+static void check(const char* name, size_t rows, size_t cols, const float* actual, const float* expected,
+                  size_t count, double max_rel = 0) {
+    for (size_t i = 0; i < count; i++) {
+        bool same = max_rel == 0 ? memcmp(&actual[i], &expected[i], sizeof(float)) == 0
+                                 : fabs(actual[i] - expected[i]) <= max_rel * fabs(expected[i]) + 1e-30;
+        if (!same) {
+            printf("MISMATCH %s %zux%zu at %zu: %.9g, scalar %.9g\n", name, rows, cols, i, actual[i], expected[i]);
+            mismatches++;
+            return;
+        }
+    }
+}
+
+static double bestUs(int runs, const std::function<void()>& fn) {
+    double best_us = 1e12;
+    for (int r = 0; r < runs; r++) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        if (us < best_us) best_us = us;
+    }
+    return best_us;
+}
+
+// Усі примітиви на одній формі: перевірка, а з bench - ще й час обох шляхів
+static void runShape(size_t rows, size_t cols, int runs, bool bench) {
+    matrix_t a(rows, cols), b(cols, rows), out(rows, rows), ref(rows, rows);
+    fillRandom(a.buffer, rows * cols, (uint32_t)(rows * 131 + cols));
+    fillRandom(b.buffer, rows * cols, (uint32_t)(rows + cols * 17));
+    matrix_t work(rows, cols), expect(rows, cols);
+    matrix_t per_row(rows, 1), per_row_ref(rows, 1), per_col(cols, 1), per_col_ref(cols, 1);
+    std::vector<int8_t> i8(rows * cols);
+    for (size_t i = 0; i < i8.size(); i++) i8[i] = (int8_t)(i * 37 + rows);
+    std::vector<float> f(i8.size()), f_ref(i8.size());
+
+    double us[7][2] = {};
+    const char* names[7] = { "dot MxN*NxM", "scale+add", "rms", "mean_axis0", "std_axis0", "transpose", "int8_to_float" };
+
+    numpy::dot(&a, &b, &out);
+    scalar::dot(&a, &b, &ref);
+    check(names[0], rows, cols, out.buffer, ref.buffer, rows * rows);
+    if (bench) {
+        us[0][0] = bestUs(runs, [&]() { scalar::dot(&a, &b, &ref); });
+        us[0][1] = bestUs(runs, [&]() { numpy::dot(&a, &b, &out); });
+    }
+
+    memcpy(work.buffer, a.buffer, rows * cols * sizeof(float));
+    memcpy(expect.buffer, a.buffer, rows * cols * sizeof(float));
+    numpy::scale(&work, 0.37f);
+    numpy::add(&work, -1.25f);
+    scalar::scale_and_add(&expect, 0.37f, 0.0f);
+    scalar::scale_and_add(&expect, 1.0f, -1.25f);
+    check(names[1], rows, cols, work.buffer, expect.buffer, rows * cols);
+    if (bench) {
+        us[1][0] = bestUs(runs, [&]() { scalar::scale_and_add(&expect, 1.0001f, 0.5f); });
+        us[1][1] = bestUs(runs, [&]() { numpy::scale_and_add(&work, 1.0001f, 0.5f); });
+    }
+
+    numpy::rms(&a, &per_row);
+    scalar::rms(&a, &per_row_ref);
+    check(names[2], rows, cols, per_row.buffer, per_row_ref.buffer, rows, 1e-5);
+    if (bench) {
+        us[2][0] = bestUs(runs, [&]() { scalar::rms(&a, &per_row_ref); });
+        us[2][1] = bestUs(runs, [&]() { numpy::rms(&a, &per_row); });
+    }
+
+    numpy::mean_axis0(&a, &per_col);
+    scalar::mean_axis0(&a, &per_col_ref);
+    check(names[3], rows, cols, per_col.buffer, per_col_ref.buffer, cols);
+    if (bench) {
+        us[3][0] = bestUs(runs, [&]() { scalar::mean_axis0(&a, &per_col_ref); });
+        us[3][1] = bestUs(runs, [&]() { numpy::mean_axis0(&a, &per_col); });
+    }
+
+    numpy::std_axis0(&a, &per_col);
+    scalar::std_axis0(&a, &per_col_ref);
+    check(names[4], rows, cols, per_col.buffer, per_col_ref.buffer, cols);
+    if (bench) {
+        us[4][0] = bestUs(runs, [&]() { scalar::std_axis0(&a, &per_col_ref); });
+        us[4][1] = bestUs(runs, [&]() { numpy::std_axis0(&a, &per_col); });
+    }
+
+    // Обидва шляхи транспонування: numpy::transpose і transpose_in_place
+    memcpy(work.buffer, a.buffer, rows * cols * sizeof(float));
+    memcpy(expect.buffer, a.buffer, rows * cols * sizeof(float));
+    numpy::transpose(&work);
+    scalar::transpose(&expect);
+    check(names[5], rows, cols, work.buffer, expect.buffer, rows * cols);
+    if (work.rows != cols || work.cols != rows) {
+        printf("MISMATCH transpose %zux%zu: shape %ux%u\n", rows, cols, (unsigned)work.rows, (unsigned)work.cols);
+        mismatches++;
+    }
+    memcpy(work.buffer, a.buffer, rows * cols * sizeof(float));
+    work.rows = rows;
+    work.cols = cols;
+    numpy::transpose_in_place(&work);
+    check("transpose_in_place", rows, cols, work.buffer, expect.buffer, rows * cols);
+    if (bench) {
+        us[5][0] = bestUs(runs, [&]() { scalar::transpose(&expect); });
+        us[5][1] = bestUs(runs, [&]() { numpy::transpose(&work); });
+    }
+
+    numpy::int8_to_float(i8.data(), f.data(), i8.size());
+    scalar::int8_to_float(i8.data(), f_ref.data(), i8.size());
+    check(names[6], rows, cols, f.data(), f_ref.data(), f.size());
+    if (bench) {
+        us[6][0] = bestUs(runs, [&]() { scalar::int8_to_float(i8.data(), f_ref.data(), i8.size()); });
+        us[6][1] = bestUs(runs, [&]() { numpy::int8_to_float(i8.data(), f.data(), i8.size()); });
+    }
+
+    if (!bench) return;
+    printf("\n%zux%zu%14s%14s%10s\n", rows, cols, "scalar us", "simd us", "x");
+    for (int i = 0; i < 7; i++) {
+        printf("  %-20s%12.2f%14.2f%10.1f\n", names[i], us[i][0], us[i][1], us[i][0] / us[i][1]);
+    }
+}
+
+int main(int argc, char** argv) {
+    int runs = 50;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--runs") == 0) runs = atoi(argv[i + 1]);
+    }
+    if (runs <= 0) {
+        fprintf(stderr, "usage: %s [--runs N]\n", argv[0]);
+        return 2;
+    }
+
+    // Форми з хвостами для кожного кроку (1, 4 і 8 ліній, плитки 4x4 і 32x32), квадратні й ні
+    const size_t shapes[][2] = { { 1, 1 }, { 1, 7 }, { 3, 5 }, { 4, 4 }, { 7, 7 }, { 13, 40 }, { 40, 13 },
+                                 { 33, 33 }, { 37, 70 }, { 64, 64 }, { 99, 1 }, { 130, 67 } };
+    for (size_t s = 0; s < sizeof(shapes) / sizeof(shapes[0]); s++) {
+        runShape(shapes[s][0], shapes[s][1], runs, false);
+    }
+    printf("%s, bit-exact check: %u mismatches\n", EIDSP_USE_AVX2 ? "AVX2" : "SSE2", mismatches);
+
+    // Форми DSP блоків: вікна MFCC/MFE (кадри x коефіцієнти), спектрограма, квадрат для транспонування
+    const size_t bench_shapes[][2] = { { 99, 13 }, { 99, 40 }, { 128, 257 }, { 512, 512 } };
+    for (size_t s = 0; s < sizeof(bench_shapes) / sizeof(bench_shapes[0]); s++) {
+        runShape(bench_shapes[s][0], bench_shapes[s][1], runs, true);
+    }
+    return mismatches ? 1 : 0;
+}
@@ -0,0 +1,63 @@
+// Пакує ваги моделі (константні тензори скомпільованого EON графа) у блоб для розділу "model".
+// Прошивка, зібрана з EI_CLASSIFIER_WEIGHTS_BLOB=1 (env:esp32cam_weights), не містить ваг і
+// читає їх прямо з флешу через esp_partition_mmap (віртуальний пристрій - mmap файлу, --weights).
+// Формат блобу - edge-impulse-sdk/classifier/ei_weights_blob.h. Сам інструмент збирається з вагами
+// в прошивці (без EI_CLASSIFIER_WEIGHTS_BLOB), з тими ж джерелами і прапорцями SDK, що й env:native,
+// лише замість src/ - цей файл:
+//
+//   g++ -std=gnu++17 -O2 <build_flags env:native> -Ilib/Robotics_Practice_inferencing/src
+//       tools/pack_weights.cpp <джерела lib/Robotics_Practice_inferencing/src> -o pack_weights -lm
+//   ./pack_weights model.bin
+//   parttool.py write_partition --partition-name model --input model.bin
+//
+// Після запису блоб перевіряється тим самим ei_weights_blob_apply, що й на платі.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "edge-impulse-sdk/classifier/ei_run_classifier.h"
+#include "edge-impulse-sdk/classifier/ei_weights_blob.h"
+
+#if EI_CLASSIFIER_WEIGHTS_BLOB == 1
+#error "pack_weights needs the weights compiled in, build it without EI_CLASSIFIER_WEIGHTS_BLOB"
+#endif
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s model.bin\n", argv[0]);
+        return 2;
+    }
+    const ei_impulse_t* impulse = ei_default_impulse.impulse;
+
+    size_t blob_bytes = 0;
+    if (ei_weights_blob_pack(impulse, 0, NULL, 0, &blob_bytes) != EI_IMPULSE_OK) {
+        return 1;
+    }
+    uint8_t* blob = (uint8_t*)aligned_alloc(EI_WEIGHTS_BLOB_ALIGNMENT, ei_weights_blob_align(blob_bytes));
+    if (blob == NULL || ei_weights_blob_pack(impulse, 0, blob, blob_bytes, &blob_bytes) != EI_IMPULSE_OK) {
+        fprintf(stderr, "Cannot pack weights\n");
+        return 1;
+    }
+
+    // Та сама перевірка, що й при старті прошивки: заголовок, відбиток моделі, вирівнювання, контрольна сума
+    EI_IMPULSE_ERROR res = ei_weights_blob_apply(impulse, 0, blob, blob_bytes);
+    ei_weights_blob_apply(impulse, 0, NULL, 0);
+    if (res != EI_IMPULSE_OK) {
+        fprintf(stderr, "Packed blob does not validate (%d)\n", res);
+        return 1;
+    }
+
+    FILE* file = fopen(argv[1], "wb");
+    if (file == NULL || fwrite(blob, 1, blob_bytes, file) != blob_bytes || fclose(file) != 0) {
+        fprintf(stderr, "Cannot write %s\n", argv[1]);
+        return 1;
+    }
+
+    const ei_weights_blob_header_t* header = (const ei_weights_blob_header_t*)blob;
+    printf("%s: %u constant tensors, %u bytes, fingerprint %08x, checksum %08x\n", argv[1],
+           (unsigned)header->tensors_count, (unsigned)header->total_bytes,
+           (unsigned)header->fingerprint, (unsigned)header->data_checksum);
+    free(blob);
+    return 0;
+}
@@ -0,0 +1,276 @@
+// Тривалий прогін пулу пам'яті SDK (edge-impulse-sdk/porting/ei_pool_allocator.h): мільйони
+// випадкових malloc/calloc/free змішаних розмірів - дрібні блоки класів, матриці DSP по кілька КБ
+// і арена тензорів на сотні КБ раз на "кадр", як у циклі прошивки. Після кожної операції
+// статистика пулу звіряється з власним обліком: блоки в ужитку по класах і великі, байти в ужитку
+// і пік, найбільший вільний блок (запит такого розміру не має йти до резервного алокатора).
+// Кожен блок заповнюється своїм байтом і перевіряється при звільненні - перекриття блоків видно
+// одразу; кожен вказівник має бути вирівняний на EI_POOL_MIN_BLOCK_SIZE. Резервний алокатор тут
+// навмисно віддає вказівники, вирівняні лише на 8 (як malloc на ESP32).
+//
+//   g++ -std=gnu++17 -O2 -DEI_PORTING_CLIB=1 -DEI_CLASSIFIER_USE_POOL_ALLOCATOR=1
+//       -Ilib/Robotics_Practice_inferencing/src tools/pool_soak.cpp
+//       lib/Robotics_Practice_inferencing/src/edge-impulse-sdk/porting/ei_pool_allocator.cpp
+//       lib/Robotics_Practice_inferencing/src/edge-impulse-sdk/porting/clib/ei_classifier_porting.cpp
+//       lib/Robotics_Practice_inferencing/src/edge-impulse-sdk/dsp/memory.cpp -o pool_soak
+//   ./pool_soak [--ops 2000000] [--seed 1] [--arena 16384]
+//
+// Код виходу 1 - перша розбіжність (операція і що саме не зійшлося).
+
+#include <chrono>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "edge-impulse-sdk/porting/ei_pool_allocator.h"
+
+#if EI_CLASSIFIER_USE_POOL_ALLOCATOR != 1
+#error "pool_soak needs -DEI_CLASSIFIER_USE_POOL_ALLOCATOR=1"
+#endif
+
+// Скільки блоків живе одночасно, поза аренами кадрів
+#define SOAK_MAX_LIVE   384
+
+struct Block {
+    uint8_t* ptr;
+    size_t size;
+    uint8_t fill;
+};
+
+// Резервний алокатор з лічильниками, вказівники зсунуті на 8 від вирівняних malloc
+static uint64_t fallback_allocs = 0;
+static uint64_t fallback_frees = 0;
+
+static void* fallback_malloc(size_t size) {
+    uint8_t* raw = (uint8_t*)malloc(size + 8);
+    if (raw == NULL) return NULL;
+    fallback_allocs++;
+    return raw + 8;
+}
+
+static void fallback_free(void* ptr) {
+    fallback_frees++;
+    free((uint8_t*)ptr - 8);
+}
+
+static uint64_t rng_state = 1;
+
+static uint32_t rng() {
+    rng_state = rng_state * 6364136223846793005ull + 1442695040888963407ull;
+    return (uint32_t)(rng_state >> 33);
+}
+
+// Розміри як у прогоні моделі: здебільшого дрібні, часом матриці, зрідка великі буфери
+static size_t random_size() {
+    uint32_t r = rng() % 100;
+    if (r < 70) return 1 + rng() % EI_POOL_MAX_BLOCK_SIZE;
+    if (r < 95) return EI_POOL_MAX_BLOCK_SIZE + 1 + rng() % (64 * 1024);
+    return 100 * 1024 + rng() % (200 * 1024);
+}
+
+static int size_class(size_t size) {
+    size_t block_size = EI_POOL_MIN_BLOCK_SIZE;
+    for (int ix = 0; ix < EI_POOL_CLASS_COUNT; ix++, block_size <<= 1) {
+        if (size <= block_size) return ix;
+    }
+    return -1;
+}
+
+struct Soak {
+    std::vector<Block> live;
+    uint32_t class_in_use[EI_POOL_CLASS_COUNT];
+    uint32_t large_in_use;
+    size_t bytes_in_use;
+    size_t peak_bytes;
+    uint64_t op;
+    char why[200];
+};
+
+static bool fail(Soak& soak, const char* what, unsigned long long expected, unsigned long long actual) {
+    snprintf(soak.why, sizeof(soak.why), "op %llu: %s: expected %llu, pool says %llu",
+             (unsigned long long)soak.op, what, expected, actual);
+    return false;
+}
+
+static bool take(Soak& soak, size_t size, bool zeroed) {
+    uint8_t* ptr = (uint8_t*)(zeroed ? ei_pool_calloc(1, size) : ei_pool_malloc(size));
+    if (ptr == NULL) {
+        snprintf(soak.why, sizeof(soak.why), "op %llu: %u bytes not allocated", (unsigned long long)soak.op,
+                 (unsigned)size);
+        return false;
+    }
+    if (((uintptr_t)ptr & (EI_POOL_MIN_BLOCK_SIZE - 1)) != 0) {
+        snprintf(soak.why, sizeof(soak.why), "op %llu: %u bytes at %p, not aligned to %d",
+                 (unsigned long long)soak.op, (unsigned)size, (void*)ptr, EI_POOL_MIN_BLOCK_SIZE);
+        return false;
+    }
+    if (zeroed) {
+        for (size_t ix = 0; ix < size; ix++) {
+            if (ptr[ix] != 0) return fail(soak, "calloc byte", 0, ptr[ix]);
+        }
+    }
+    Block block = { ptr, size, (uint8_t)(1 + rng() % 255) };
+    memset(ptr, block.fill, size);
+    soak.live.push_back(block);
+    int class_ix = size_class(size);
+    if (class_ix >= 0) soak.class_in_use[class_ix]++;
+    else soak.large_in_use++;
+    soak.bytes_in_use += size;
+    if (soak.bytes_in_use > soak.peak_bytes) soak.peak_bytes = soak.bytes_in_use;
+    return true;
+}
+
+static bool give_back(Soak& soak, size_t ix) {
+    Block block = soak.live[ix];
+    // початок, середина і кінець - повна перевірка великих блоків коштувала б більше за сам пул
+    const size_t probes[3] = { 0, block.size / 2, block.size - 1 };
+    for (int p = 0; p < 3; p++) {
+        if (block.ptr[probes[p]] != block.fill) {
+            snprintf(soak.why, sizeof(soak.why), "op %llu: block of %u bytes overwritten at %u",
+                     (unsigned long long)soak.op, (unsigned)block.size, (unsigned)probes[p]);
+            return false;
+        }
+    }
+    if (block.size <= 4096) {
+        for (size_t b = 0; b < block.size; b++) {
+            if (block.ptr[b] != block.fill) return fail(soak, "byte of a live block", block.fill, block.ptr[b]);
+        }
+    }
+    ei_pool_free(block.ptr);
+    int class_ix = size_class(block.size);
+    if (class_ix >= 0) soak.class_in_use[class_ix]--;
+    else soak.large_in_use--;
+    soak.bytes_in_use -= block.size;
+    soak.live[ix] = soak.live.back();
+    soak.live.pop_back();
+    return true;
+}
+
+static bool check_stats(Soak& soak) {
+    ei_pool_stats_t s;
+    ei_pool_get_stats(&s);
+    for (int ix = 0; ix < EI_POOL_CLASS_COUNT; ix++) {
+        const ei_pool_class_stats_t& c = s.classes[ix];
+        if (c.in_use != soak.class_in_use[ix]) return fail(soak, "blocks in use in a class", soak.class_in_use[ix], c.in_use);
+        if (c.peak_in_use < c.in_use) return fail(soak, "class peak below in use", c.in_use, c.peak_in_use);
+    }
+    if (s.large_in_use != soak.large_in_use) return fail(soak, "large blocks in use", soak.large_in_use, s.large_in_use);
+    if (s.large_peak_in_use < s.large_in_use) return fail(soak, "large peak below in use", s.large_in_use, s.large_peak_in_use);
+    if (s.large_cached > EI_POOL_LARGE_CACHE_SLOTS) return fail(soak, "cached large blocks", EI_POOL_LARGE_CACHE_SLOTS, s.large_cached);
+    if (s.bytes_in_use != soak.bytes_in_use) return fail(soak, "bytes in use", soak.bytes_in_use, s.bytes_in_use);
+    if (s.peak_bytes_in_use != soak.peak_bytes) return fail(soak, "peak bytes in use", soak.peak_bytes, s.peak_bytes_in_use);
+    if (s.arena_carved > s.arena_size) return fail(soak, "carved arena", s.arena_size, s.arena_carved);
+    if (s.failed_allocs != 0) return fail(soak, "failed allocs", 0, s.failed_allocs);
+    return true;
+}
+
+// Запит розміром з найбільший вільний блок не має йти до резервного алокатора
+static bool check_largest_free(Soak& soak) {
+    ei_pool_stats_t s;
+    ei_pool_get_stats(&s);
+    if (s.largest_free_block == 0) return true;
+    const uint64_t before = fallback_allocs;
+    if (!take(soak, s.largest_free_block, false)) return false;
+    if (fallback_allocs != before) {
+        return fail(soak, "fallback allocs for a request of the largest free block", before, fallback_allocs);
+    }
+    return give_back(soak, soak.live.size() - 1);
+}
+
+// "Кадр": арена тензорів, кілька матриць DSP, усе звільняється в кінці, як у run_classifier
+static bool frame(Soak& soak) {
+    const size_t first = soak.live.size();
+    if (!take(soak, 276 * 1024, false)) return false;
+    for (int ix = 0; ix < 6; ix++) {
+        if (!take(soak, 1 + rng() % (12 * 1024), ix % 2 == 0)) return false;
+    }
+    if (!check_stats(soak)) return false;
+    while (soak.live.size() > first) {
+        if (!give_back(soak, soak.live.size() - 1)) return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    uint64_t ops = 2000000;
+    size_t arena_size = 16 * 1024;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--ops") == 0 && i + 1 < argc) {
+            ops = strtoull(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            rng_state = strtoull(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--arena") == 0 && i + 1 < argc) {
+            arena_size = strtoul(argv[++i], NULL, 0);
+        } else {
+            fprintf(stderr, "usage: %s [--ops N] [--seed S] [--arena BYTES]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    // блок, виділений до ei_pool_init, має звільнитися вже через пул
+    void* early = ei_pool_malloc(100);
+    if (early == NULL || ((uintptr_t)early & (EI_POOL_MIN_BLOCK_SIZE - 1)) != 0) {
+        printf("FAIL: block before ei_pool_init at %p\n", early);
+        return 1;
+    }
+
+    std::vector<uint8_t> arena(arena_size + EI_POOL_MIN_BLOCK_SIZE);
+    // арена навмисно не вирівняна - пул вирівнює її сам
+    ei_pool_config_t config = { arena.data() + 3, arena_size, fallback_malloc, fallback_free };
+    if (!ei_pool_init(&config)) {
+        printf("FAIL: ei_pool_init\n");
+        return 1;
+    }
+    ei_pool_free(early);
+
+    Soak soak;
+    soak.live.reserve(SOAK_MAX_LIVE + 16);
+    memset(soak.class_in_use, 0, sizeof(soak.class_in_use));
+    soak.large_in_use = 0;
+    soak.bytes_in_use = 0;
+    soak.peak_bytes = 0;
+    soak.why[0] = '\0';
+
+    auto start = std::chrono::steady_clock::now();
+    bool ok = true;
+    for (soak.op = 0; ok && soak.op < ops; soak.op++) {
+        const uint32_t r = rng() % 1000;
+        if (r == 0) {
+            ok = frame(soak);
+        } else if (r < 5) {
+            ok = check_largest_free(soak);
+        } else if (soak.live.size() < SOAK_MAX_LIVE && (soak.live.empty() || r < 520)) {
+            ok = take(soak, random_size(), r % 7 == 0);
+        } else {
+            ok = give_back(soak, rng() % soak.live.size());
+        }
+        ok = ok && check_stats(soak);
+    }
+    while (ok && !soak.live.empty()) {
+        ok = give_back(soak, soak.live.size() - 1) && check_stats(soak);
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    ei_pool_stats_t s;
+    ei_pool_get_stats(&s);
+    ei_pool_print_stats();
+    if (ok) {
+        // усе звільнено: лишаються тільки великі блоки в кеші і дрібні з резервного (вони
+        // назавжди на списках класів); після trim - лише дрібні
+        ei_pool_trim();
+        const uint64_t outstanding = fallback_allocs - fallback_frees;
+        if (outstanding != s.small_fallback_blocks) {
+            soak.op = ops;
+            ok = fail(soak, "fallback blocks left after trim", s.small_fallback_blocks, outstanding);
+        }
+    }
+    printf("%llu ops in %.1f s, peak %u bytes in use, %llu fallback allocs, %u large cache hits of %u\n",
+           (unsigned long long)soak.op, seconds, (unsigned)s.peak_bytes_in_use,
+           (unsigned long long)fallback_allocs, (unsigned)s.large_cache_hits, (unsigned)s.large_allocs);
+    if (!ok) {
+        printf("FAIL: %s\n", soak.why);
+        return 1;
+    }
+    printf("OK\n");
+    return 0;
+}
@@ -0,0 +1,242 @@
+// Перевірка і бенчмарк читання підмножини осей сигналу (edge-impulse-sdk/classifier/ei_signal_with_axes.h,
+// numpy::signal_get_data_strided): SignalWithAxes читає сигнал сторінками цілих кадрів
+// (EIDSP_SIGNAL_PAGE_SIZE) або напряму з буфера signal_from_buffer, замість одного get_data на кожен
+// відлік кожної осі, як було раніше (тут - копія того циклу, per_sample_get_data).
+//
+// Спершу обидва шляхи - callback без буфера і буфер - звіряються побітово з циклом по відліку:
+// відсортовані й невідсортовані осі, кадр більший за сторінку (читання по відліку), неповна
+// остання сторінка, довільні зсуви; помилка get_data має дійти до виклику. Потім час: --axes
+// з 9 осей, --frames кадрів, читання по --read відліків, як у DSP блоку; нс на відлік, найкращий
+// з --runs.
+//
+//   L=lib/Robotics_Practice_inferencing/src
+//   g++ -std=gnu++17 -O2 -DEI_PORTING_CLIB=1 -I$L -I$L/edge-impulse-sdk tools/signal_axes_bench.cpp
+//       $L/edge-impulse-sdk/porting/clib/ei_classifier_porting.cpp $L/edge-impulse-sdk/dsp/memory.cpp
+//       -o signal_axes_bench
+//   ./signal_axes_bench [--frames 20000] [--read 300] [--runs 20]
+//
+// Код виходу 1 - є розбіжності.
+
+#include <chrono>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "edge-impulse-sdk/classifier/ei_signal_with_axes.h"
+
+#if EIDSP_SIGNAL_C_FN_POINTER
+#error "signal_axes_bench needs std::function signals (SignalWithAxes)"
+#endif
+
+typedef EI_CLASSIFIER_DSP_AXES_INDEX_TYPE axis_t;
+
+static int failures = 0;
+
+#define CHECK(cond, ...) do { \
+    if (!(cond)) { \
+        fprintf(stderr, "FAIL %s:%d: ", __FILE__, __LINE__); \
+        fprintf(stderr, __VA_ARGS__); \
+        fprintf(stderr, "\n"); \
+        failures++; \
+    } \
+} while (0)
+
+static uint64_t rng_state = 1;
+
+static uint32_t rng() {
+    rng_state = rng_state * 6364136223846793005ull + 1442695040888963407ull;
+    return (uint32_t)(rng_state >> 33);
+}
+
+// SignalWithAxes::get_data до сторінок: get_data на кожен відлік кожної осі
+static int per_sample_get_data(signal_t* signal, size_t stride, const axis_t* axes, size_t axes_count,
+                               size_t offset, size_t length, float* out_ptr) {
+    size_t offset_on_original_signal = offset / axes_count * stride;
+    size_t length_on_original_signal = length / axes_count * stride;
+    size_t out_ptr_ix = 0;
+    for (size_t ix = offset_on_original_signal; ix < offset_on_original_signal + length_on_original_signal; ix += stride) {
+        for (size_t axis_ix = 0; axis_ix < axes_count; axis_ix++) {
+            int r = signal->get_data(ix + axes[axis_ix], 1, &out_ptr[out_ptr_ix++]);
+            if (r != 0) {
+                return r;
+            }
+        }
+    }
+    return 0;
+}
+
+// Сигнал з колбеком, як від драйвера сенсора: буфера SDK не бачить
+static void callback_signal(const std::vector<float>& data, signal_t* signal) {
+    signal->total_length = data.size();
+    const float* ptr = data.data();
+    signal->get_data = [ptr](size_t offset, size_t length, float* out_ptr) {
+        memcpy(out_ptr, ptr + offset, length * sizeof(float));
+        return 0;
+    };
+}
+
+static std::vector<float> random_signal(size_t size) {
+    std::vector<float> data(size);
+    for (float& v : data) {
+        v = (float)(int32_t)rng() / 65536.0f;
+    }
+    return data;
+}
+
+// Одне читання через SignalWithAxes з обох сигналів проти циклу по відліку
+static void check_read(const char* name, size_t stride, const std::vector<axis_t>& axes, size_t frames,
+                       size_t offset_frames, size_t read_frames) {
+    static ei_impulse_t impulse;
+    impulse.raw_samples_per_frame = stride;
+    std::vector<float> data = random_signal(stride * frames);
+    signal_t cb_signal, buf_signal;
+    callback_signal(data, &cb_signal);
+    numpy::signal_from_buffer(data.data(), data.size(), &buf_signal);
+
+    const size_t offset = offset_frames * axes.size();
+    const size_t length = read_frames * axes.size();
+    std::vector<float> expected(length), cb_out(length, -1.0f), buf_out(length, -1.0f);
+    CHECK(per_sample_get_data(&cb_signal, stride, axes.data(), axes.size(), offset, length, expected.data()) == 0,
+          "%s: per-sample read failed", name);
+
+    SignalWithAxes cb_axes(&cb_signal, (axis_t*)axes.data(), axes.size(), &impulse);
+    SignalWithAxes buf_axes(&buf_signal, (axis_t*)axes.data(), axes.size(), &impulse);
+    signal_t* cb_wrapped = cb_axes.get_signal();
+    signal_t* buf_wrapped = buf_axes.get_signal();
+    CHECK(cb_wrapped->total_length == frames * axes.size(), "%s: total_length %u", name, (unsigned)cb_wrapped->total_length);
+    CHECK(cb_wrapped->get_data(offset, length, cb_out.data()) == 0, "%s: paged read failed", name);
+    CHECK(buf_wrapped->get_data(offset, length, buf_out.data()) == 0, "%s: buffer read failed", name);
+    CHECK(memcmp(expected.data(), cb_out.data(), length * sizeof(float)) == 0, "%s: paged read differs", name);
+    CHECK(memcmp(expected.data(), buf_out.data(), length * sizeof(float)) == 0, "%s: buffer read differs", name);
+}
+
+static void check_reads() {
+    const size_t page_frames = EIDSP_SIGNAL_PAGE_SIZE / 9;
+    check_read("3 of 9 axes", 9, { 0, 4, 8 }, 1000, 0, 1000);
+    check_read("unsorted axes", 9, { 8, 1, 3 }, 1000, 17, 500);
+    check_read("repeated axis", 9, { 2, 2, 7 }, 200, 3, 150);
+    check_read("first axes only", 9, { 0, 1 }, 200, 0, 200);
+    check_read("one page", 9, { 5 }, 200, 0, page_frames);
+    check_read("page and a frame", 9, { 5, 6 }, 200, 1, page_frames + 1);
+    check_read("one frame", 9, { 4 }, 200, 199, 1);
+    check_read("frame over a page", EIDSP_SIGNAL_PAGE_SIZE + 72, { 0, 100, EIDSP_SIGNAL_PAGE_SIZE + 71 }, 20, 2, 15);
+    for (int ix = 0; ix < 200; ix++) {
+        const size_t stride = 2 + rng() % 40;
+        std::vector<axis_t> axes(1 + rng() % (stride - 1));
+        for (axis_t& axis : axes) {
+            axis = (axis_t)(rng() % stride);
+        }
+        const size_t frames = 1 + rng() % 300;
+        const size_t offset_frames = rng() % frames;
+        char name[48];
+        snprintf(name, sizeof(name), "random %d (stride %u)", ix, (unsigned)stride);
+        check_read(name, stride, axes, frames, offset_frames, 1 + rng() % (frames - offset_frames));
+    }
+
+    // помилка get_data посеред сторінки доходить до виклику
+    static ei_impulse_t impulse;
+    impulse.raw_samples_per_frame = 9;
+    std::vector<float> data = random_signal(9 * 100);
+    signal_t failing;
+    failing.total_length = data.size();
+    failing.get_data = [&data](size_t offset, size_t length, float* out_ptr) {
+        if (offset + length > 9 * 50) return -1002;
+        memcpy(out_ptr, data.data() + offset, length * sizeof(float));
+        return 0;
+    };
+    std::vector<axis_t> axes = { 1, 2, 3 };
+    std::vector<float> out(100 * axes.size());
+    SignalWithAxes failing_axes(&failing, axes.data(), axes.size(), &impulse);
+    CHECK(failing_axes.get_signal()->get_data(0, out.size(), out.data()) == -1002, "get_data error was lost");
+}
+
+template<typename Fn>
+static double best_ns_per_sample(int runs, size_t samples, Fn fn) {
+    double best = 1e30;
+    for (int run = 0; run < runs; run++) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        if (ns < best) best = ns;
+    }
+    return best / samples;
+}
+
+int main(int argc, char** argv) {
+    size_t frames = 20000;
+    size_t read = 300;
+    int runs = 20;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            frames = strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--read") == 0 && i + 1 < argc) {
+            read = strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--runs") == 0 && i + 1 < argc) {
+            runs = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "usage: %s [--frames 20000] [--read 300] [--runs 20]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    check_reads();
+
+    // 3 з 9 осей (акселерометр з IMU на 9 осей), читання по read відліків підряд
+    const size_t stride = 9;
+    const std::vector<axis_t> axes = { 0, 1, 2 };
+    read -= read % axes.size();
+    if (read == 0 || frames * axes.size() < read) {
+        fprintf(stderr, "--read must fit in --frames * %u\n", (unsigned)axes.size());
+        return 1;
+    }
+    static ei_impulse_t impulse;
+    impulse.raw_samples_per_frame = stride;
+    std::vector<float> data = random_signal(stride * frames);
+    signal_t cb_signal, buf_signal;
+    callback_signal(data, &cb_signal);
+    numpy::signal_from_buffer(data.data(), data.size(), &buf_signal);
+    SignalWithAxes cb_axes(&cb_signal, (axis_t*)axes.data(), axes.size(), &impulse);
+    SignalWithAxes buf_axes(&buf_signal, (axis_t*)axes.data(), axes.size(), &impulse);
+    signal_t* cb_wrapped = cb_axes.get_signal();
+    signal_t* buf_wrapped = buf_axes.get_signal();
+
+    const size_t total = cb_wrapped->total_length - cb_wrapped->total_length % read;
+    std::vector<float> out(total), expected(total);
+    volatile float sink = 0.0f;
+
+    const double per_sample_ns = best_ns_per_sample(runs, total, [&]() {
+        for (size_t offset = 0; offset < total; offset += read) {
+            per_sample_get_data(&cb_signal, stride, axes.data(), axes.size(), offset, read, expected.data() + offset);
+        }
+        sink = sink + expected[total - 1];
+    });
+    const double paged_ns = best_ns_per_sample(runs, total, [&]() {
+        for (size_t offset = 0; offset < total; offset += read) {
+            cb_wrapped->get_data(offset, read, out.data() + offset);
+        }
+        sink = sink + out[total - 1];
+    });
+    CHECK(memcmp(out.data(), expected.data(), total * sizeof(float)) == 0, "bench: paged read differs");
+    memset(out.data(), 0, total * sizeof(float));
+    const double buffer_ns = best_ns_per_sample(runs, total, [&]() {
+        for (size_t offset = 0; offset < total; offset += read) {
+            buf_wrapped->get_data(offset, read, out.data() + offset);
+        }
+        sink = sink + out[total - 1];
+    });
+    CHECK(memcmp(out.data(), expected.data(), total * sizeof(float)) == 0, "bench: buffer read differs");
+
+    printf("%u of %u axes, %u frames, reads of %u samples, page %u floats\n", (unsigned)axes.size(), (unsigned)stride,
+           (unsigned)frames, (unsigned)read, (unsigned)EIDSP_SIGNAL_PAGE_SIZE);
+    printf("  get_data per sample   %6.2f ns/sample\n", per_sample_ns);
+    printf("  paged (callback)      %6.2f ns/sample  x%.1f\n", paged_ns, per_sample_ns / paged_ns);
+    printf("  direct (buffer)       %6.2f ns/sample  x%.1f\n", buffer_ns, per_sample_ns / buffer_ns);
+
+    if (failures > 0) {
+        fprintf(stderr, "%d checks failed\n", failures);
+        return 1;
+    }
+    printf("ok\n");
+    return 0;
+}
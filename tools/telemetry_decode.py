@@ -0,0 +1,249 @@
+#!/usr/bin/env python3
+"""
+Декодер телеметрії кадрів UAH Scanner (src/Telemetry.h).
+
+Пакети: 0x00, COBS(TelemetryRecord + CRC16-CCITT little endian), 0x00.
+Усе, що не є пакетом (текст з setup(), попередження), виводиться як є.
+Пакети записів кадрів (перший байт 0xCA, команда "capture start" у порт, src/CaptureRecorder.h)
+з --capture складаються у файл для tools/capture_replay.cpp, інакше пропускаються.
+
+Приклади:
+    python3 tools/telemetry_decode.py --port /dev/ttyUSB0
+    python3 tools/telemetry_decode.py --port /dev/ttyUSB0 --csv > frames.csv
+    python3 tools/telemetry_decode.py capture.bin --csv
+    python3 tools/telemetry_decode.py --port /dev/ttyUSB0 --capture field.cap
+"""
+
+import argparse
+import csv
+import struct
+import sys
+
+LABELS = ["1000_UAH", "100_UAH", "200_UAH", "20_UAH", "500_UAH", "50_UAH"]
+STATUS = {0: "ok", 1: "no_frame", 2: "invalid_frame", 3: "classifier_error", 4: "rejected"}
+REJECT = ["ok", "clipped", "dark", "bright", "low_contrast", "blurred"]
+
+TELEMETRY_VERSION = 6
+MAX_DETECTIONS = 4
+FIELDS_V1 = ["version", "status", "classifier_error", "detection_count",
+             "frame_id", "timestamp_ms", "frame_us", "dsp_us", "classification_us",
+             "postprocessing_us", "free_heap", "min_free_heap", "free_psram",
+             "ei_memory_in_use", "ei_memory_peak", "total_uah", "notes", "dropped"]
+# v2: оцінка якості кадру, експозиція і лічильники відкинутих кадрів за причинами
+FIELDS_V2 = FIELDS_V1 + ["quality_reject", "quality_mean", "quality_variance", "quality_sharpness",
+                         "quality_clip_permille", "exposure", "gain", "exposure_locked"] + \
+            ["rejected_" + r for r in REJECT[1:]]
+# v3: вартість злиття теплових карт FOMO за кадр
+FIELDS_V3 = FIELDS_V2 + ["fusion_us", "fusion_frames"]
+# v4: вердикт другої моделі (верифікатора) для найкращої детекції і затримка детекція -> вердикт
+FIELDS_V4 = FIELDS_V3 + ["verdict_label", "verdict_confidence", "verify_error", "verify_us", "verdict_latency_us"]
+NO_VERDICT = 0xFF
+# v5: незвичність найкращої детекції (кластери ознак детектора)
+FIELDS_V5 = FIELDS_V4 + ["anomaly", "anomaly_us"]
+NO_ANOMALY = -32768
+# v6: подія "купюру розпізнано" (усереднення за вікно кадрів з придушенням повторів)
+FIELDS_V6 = FIELDS_V5 + ["trigger_label", "trigger_confidence", "trigger_events"]
+# TelemetryRecord, packed, little endian
+RECORDS = {
+    1: (struct.Struct("<BBbB" + "I" * 12 + "HH" + "6s" * MAX_DETECTIONS), FIELDS_V1),
+    2: (struct.Struct("<BBbB" + "I" * 12 + "HH" + "BBHHHHBB" + "H" * 5 + "6s" * MAX_DETECTIONS), FIELDS_V2),
+    3: (struct.Struct("<BBbB" + "I" * 12 + "HH" + "BBHHHHBB" + "H" * 7 + "6s" * MAX_DETECTIONS), FIELDS_V3),
+    4: (struct.Struct("<BBbB" + "I" * 12 + "HH" + "BBHHHHBB" + "H" * 7 + "BBbII" + "6s" * MAX_DETECTIONS),
+        FIELDS_V4),
+    5: (struct.Struct("<BBbB" + "I" * 12 + "HH" + "BBHHHHBB" + "H" * 7 + "BBbII" + "hH" + "6s" * MAX_DETECTIONS),
+        FIELDS_V5),
+    6: (struct.Struct("<BBbB" + "I" * 12 + "HH" + "BBHHHHBB" + "H" * 7 + "BBbII" + "hH" + "BBH" + "6s" * MAX_DETECTIONS),
+        FIELDS_V6),
+}
+FIELDS = RECORDS[TELEMETRY_VERSION][1]
+# Перший байт пакета з записом кадру (TELEMETRY_PACKET_CAPTURE)
+PACKET_CAPTURE = 0xCA
+
+
+def crc16(data):
+    crc = 0xFFFF
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_decode(data):
+    out = bytearray()
+    ix = 0
+    while ix < len(data):
+        code = data[ix]
+        if code == 0 or ix + code > len(data):
+            return None
+        out += data[ix + 1:ix + code]
+        ix += code
+        if code < 0xFF and ix < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def decode_capture(raw):
+    """Capture file bytes from a decoded capture packet, None if it is damaged"""
+    body, crc = raw[:-2], struct.unpack("<H", raw[-2:])[0]
+    return body[1:] if crc16(body) == crc else None
+
+
+def decode_record(raw):
+    body, crc = raw[:-2], struct.unpack("<H", raw[-2:])[0]
+    if body[0] not in RECORDS or crc16(body) != crc:
+        return None
+    record, fields = RECORDS[body[0]]
+    if len(body) != record.size:
+        return None
+    values = record.unpack(body)
+    rec = dict.fromkeys(FIELDS, "")
+    rec.update(zip(fields, values[:len(fields)]))
+    rec["status"] = STATUS.get(rec["status"], str(rec["status"]))
+    if rec["quality_reject"] != "":
+        rec["quality_reject"] = REJECT[rec["quality_reject"]] if rec["quality_reject"] < len(REJECT) else "?"
+    if rec["verdict_label"] != "":
+        rec["verdict_confidence"] = "%.3f" % (rec["verdict_confidence"] / 255.0)
+        if rec["verdict_label"] == NO_VERDICT:
+            rec["verdict_label"] = rec["verdict_confidence"] = ""
+    if rec["anomaly"] != "":
+        rec["anomaly"] = "" if rec["anomaly"] == NO_ANOMALY else "%.3f" % (rec["anomaly"] / 1000.0)
+    if rec["trigger_label"] != "":
+        if rec["trigger_label"] == NO_VERDICT:
+            rec["trigger_label"] = rec["trigger_confidence"] = ""
+        else:
+            rec["trigger_label"] = LABELS[rec["trigger_label"]] if rec["trigger_label"] < len(LABELS) else "?"
+            rec["trigger_confidence"] = "%.3f" % (rec["trigger_confidence"] / 255.0)
+    rec["detections"] = []
+    for det in values[len(fields):len(fields) + min(rec["detection_count"], MAX_DETECTIONS)]:
+        label, confidence, x, y, w, h = det
+        rec["detections"].append({
+            "label": LABELS[label] if label < len(LABELS) else "?",
+            "confidence": confidence / 255.0,
+            "x": x, "y": y, "width": w, "height": h,
+        })
+    return rec
+
+
+def format_text(rec):
+    line = ("[FRAME %d] t=%d ms %s frame=%d us dsp=%d us nn=%d us pp=%d us heap=%d (min %d) "
+            "total=%d UAH (%d notes)" % (
+                rec["frame_id"], rec["timestamp_ms"], rec["status"], rec["frame_us"], rec["dsp_us"],
+                rec["classification_us"], rec["postprocessing_us"], rec["free_heap"],
+                rec["min_free_heap"], rec["total_uah"], rec["notes"]))
+    if rec["status"] == "classifier_error":
+        line += " err=%d" % rec["classifier_error"]
+    if rec["dropped"]:
+        line += " dropped=%d" % rec["dropped"]
+    if rec["version"] >= 2:
+        line += "\n  quality=%s mean=%d var=%d sharp=%d clip=%d/1000 exposure=%d gain=%d%s rejected=%s" % (
+            rec["quality_reject"], rec["quality_mean"], rec["quality_variance"], rec["quality_sharpness"],
+            rec["quality_clip_permille"], rec["exposure"], rec["gain"],
+            " locked" if rec["exposure_locked"] else "",
+            ",".join("%s:%d" % (r, rec["rejected_" + r]) for r in REJECT[1:]))
+    if rec["version"] >= 3:
+        line += "\n  fusion=%d us over %d frames" % (rec["fusion_us"], rec["fusion_frames"])
+    if rec["version"] >= 4 and (rec["verdict_label"] != "" or rec["verify_error"]):
+        line += "\n  verdict=%s (%s) err=%d verify=%d us detection->verdict=%d us" % (
+            rec["verdict_label"], rec["verdict_confidence"], rec["verify_error"], rec["verify_us"],
+            rec["verdict_latency_us"])
+    if rec["version"] >= 5 and rec["anomaly"] != "":
+        line += "\n  anomaly=%s%s (%d us)" % (rec["anomaly"], " unusual" if float(rec["anomaly"]) > 0 else "",
+                                             rec["anomaly_us"])
+    if rec["version"] >= 6 and rec["trigger_label"] != "":
+        line += "\n  recognised=%s (%s) event %d" % (rec["trigger_label"], rec["trigger_confidence"],
+                                                   rec["trigger_events"])
+    for d in rec["detections"]:
+        line += "\n  %s %d%% [x: %d, y: %d, width: %d, height: %d]" % (
+            d["label"], round(d["confidence"] * 100), d["x"], d["y"], d["width"], d["height"])
+    return line
+
+
+def csv_row(rec):
+    row = [rec[f] for f in FIELDS if f not in ("version", "detection_count")]
+    best = rec["detections"][0] if rec["detections"] else None
+    row += [best["label"], "%.3f" % best["confidence"]] if best else ["", ""]
+    row.append(";".join("%s:%.2f@%d,%d" % (d["label"], d["confidence"], d["x"], d["y"])
+                        for d in rec["detections"]))
+    return row
+
+
+def read_chunks(read):
+    """Yields the bytes between 0x00 delimiters"""
+    chunk = bytearray()
+    while True:
+        data = read()
+        if not data:
+            break
+        for b in data:
+            if b == 0:
+                if chunk:
+                    yield bytes(chunk)
+                    chunk = bytearray()
+            else:
+                chunk.append(b)
+    if chunk:
+        yield bytes(chunk)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode UAH Scanner frame telemetry")
+    parser.add_argument("file", nargs="?", help="captured serial bytes (default: stdin)")
+    parser.add_argument("--port", help="serial port to read (needs pyserial)")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--csv", action="store_true", help="one CSV row per frame, text lines are dropped")
+    parser.add_argument("--capture", help="append captured frames (\"capture start\") to this file")
+    args = parser.parse_args()
+
+    if args.port:
+        import serial
+        port = serial.Serial(args.port, args.baud, timeout=None)
+        # blocks for the first byte, then takes whatever else has arrived
+        read = lambda: port.read(max(1, port.in_waiting))
+    else:
+        stream = open(args.file, "rb") if args.file else sys.stdin.buffer
+        read = lambda: stream.read1(4096)
+
+    writer = None
+    if args.csv:
+        writer = csv.writer(sys.stdout)
+        writer.writerow([f for f in FIELDS if f not in ("version", "detection_count")] +
+                        ["best_label", "best_confidence", "detections"])
+
+    capture = open(args.capture, "wb") if args.capture else None
+    captured = damaged = 0
+
+    try:
+        for chunk in read_chunks(read):
+            raw = cobs_decode(chunk)
+            if raw is not None and len(raw) > 3 and raw[0] == PACKET_CAPTURE:
+                data = decode_capture(raw)
+                if data is None:
+                    # запис губиться цілим, файл лишається читабельним
+                    damaged += 1
+                    print("capture: damaged record dropped", file=sys.stderr, flush=True)
+                elif capture:
+                    capture.write(data)
+                    capture.flush()
+                    captured += 1
+                continue
+            rec = decode_record(raw) if raw is not None and len(raw) >= 3 else None
+            if writer:
+                if rec:
+                    writer.writerow(csv_row(rec))
+                    sys.stdout.flush()
+            elif rec:
+                print(format_text(rec), flush=True)
+            else:
+                sys.stdout.write(chunk.decode("utf-8", errors="replace"))
+                sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
+    if capture:
+        capture.close()
+        print("capture: %d packets to %s, %d damaged" % (captured, args.capture, damaged), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()